@@ -0,0 +1,95 @@
+// ----------------------------------------------------------------------------
+// 分簇光照：由 Shader 在编译前展开 #include，需放在 BRDF 函数
+// （DistributionGGX / GeometrySmith / fresnelSchlick）和常量 PI 之后。
+// 缓冲纹理的布局与 LightManager / ClusteredLighting 约定一致：
+//   clusterLightData   : 每个光源 3 个 texel：
+//                        (位置, 半径), (辐射度, 锥形 offset), (方向, 锥形 scale)；半径为 0 表示方向光
+//   clusterTable       : 每簇 (在簇索引区中的起点, 数量)
+//   clusterLightIndices: 前 clusterDirectionalCount 个为方向光下标，其后为各簇的光源下标依次拼接
+uniform samplerBuffer  clusterLightData;
+uniform usamplerBuffer clusterTable;
+uniform usamplerBuffer clusterLightIndices;
+
+uniform mat4  clusterView;          // 世界 → 观察空间
+uniform ivec3 clusterDims;          // tilesX, tilesY, slices
+uniform vec2  clusterScreenSize;    // 视口像素尺寸
+uniform float clusterSliceScale;    // 深度片 = floor(log(depth) * scale + bias)
+uniform float clusterSliceBias;
+uniform int   clusterDirectionalCount;
+
+int clusterIndex(vec3 worldPos)
+{
+    float depth = -(clusterView * vec4(worldPos, 1.0)).z;
+    int slice = int(clamp(floor(log(max(depth, 1e-4)) * clusterSliceScale + clusterSliceBias),
+                          0.0, float(clusterDims.z - 1)));
+    ivec2 tile = ivec2(clamp(gl_FragCoord.xy / clusterScreenSize * vec2(clusterDims.xy),
+                             vec2(0.0), vec2(clusterDims.xy) - 1.0));
+    return tile.x + clusterDims.x * (tile.y + clusterDims.y * slice);
+}
+
+// 平方反比衰减乘以窗口函数，在 radius 处平滑降到 0
+float clusterFalloff(float distance, float radius)
+{
+    float ratio = distance / radius;
+    float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+    return window * window / max(distance * distance, 0.0001);
+}
+
+// 单个光源的 Cook-Torrance 贡献；L 为指向光源的单位向量
+vec3 evaluateLight(vec3 N, vec3 V, vec3 L, vec3 radiance, vec3 albedo, float metallic, float roughness, vec3 F0)
+{
+    vec3 H = normalize(V + L);
+
+    // Cook-Torrance BRDF
+    float NDF = DistributionGGX(N, H, roughness);
+    float G   = GeometrySmith(N, V, L, roughness);
+    vec3 F    = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+    vec3 numerator    = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    vec3 specular = numerator / denominator;
+
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+
+    float NdotL = max(dot(N, L), 0.0);
+    return (kD * albedo / PI + specular) * radiance * NdotL;
+}
+
+// 方向光照亮所有像素；其余光源只遍历当前像素所在簇的列表，返回直接光照 Lo
+vec3 evaluateClusteredLights(vec3 worldPos, vec3 N, vec3 V, vec3 albedo, float metallic, float roughness, vec3 F0)
+{
+    vec3 Lo = vec3(0.0);
+    for (int i = 0; i < clusterDirectionalCount; ++i)
+    {
+        int light = int(texelFetch(clusterLightIndices, i).r);
+        vec3 radiance = texelFetch(clusterLightData, light * 3 + 1).rgb;
+        vec3 direction = texelFetch(clusterLightData, light * 3 + 2).xyz;
+        Lo += evaluateLight(N, V, -direction, radiance, albedo, metallic, roughness, F0);
+    }
+
+    uvec2 range = texelFetch(clusterTable, clusterIndex(worldPos)).xy;
+    int first = int(range.x) + clusterDirectionalCount;
+    for (int i = 0; i < int(range.y); ++i)
+    {
+        int light = int(texelFetch(clusterLightIndices, first + i).r);
+        vec4 positionRadius = texelFetch(clusterLightData, light * 3);
+        vec4 radianceOffset = texelFetch(clusterLightData, light * 3 + 1);
+        vec4 directionScale = texelFetch(clusterLightData, light * 3 + 2);
+
+        // calculate per-light radiance
+        vec3 L = positionRadius.xyz - worldPos;
+        float distance = length(L);
+        if (distance >= positionRadius.w)
+            continue;
+        L /= distance;
+
+        // 聚光锥：点光源 scale = 0、offset = 1，恒为 1
+        float cone = clamp(dot(-L, directionScale.xyz) * directionScale.w + radianceOffset.w, 0.0, 1.0);
+        vec3 radiance = radianceOffset.rgb * clusterFalloff(distance, positionRadius.w) * cone * cone;
+
+        Lo += evaluateLight(N, V, L, radiance, albedo, metallic, roughness, F0);
+    }
+    return Lo;
+}
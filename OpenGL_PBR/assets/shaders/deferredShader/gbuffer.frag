@@ -0,0 +1,62 @@
+#version 330 core
+// G-Buffer 布局（两个颜色附件 + 深度，共 16 字节/像素）：
+//   gAlbedoAo        RGBA8 : albedo.rgb（贴图原值，未做 gamma 解码）, ao
+//   gNormalMetalRough RGBA16: 八面体编码法线 xy（映射到 [0,1]）, metallic, roughness
+//   位置不单独存储，光照阶段由深度重建
+layout (location = 0) out vec4 gAlbedoAo;
+layout (location = 1) out vec4 gNormalMetalRough;
+
+in vec2 TexCoords;
+in vec3 WorldPos;
+in vec3 Normal;
+flat in float Layer;
+
+uniform sampler2DArray albedoMap;
+uniform sampler2DArray normalMap;
+uniform sampler2DArray metallicMap;
+uniform sampler2DArray roughnessMap;
+uniform sampler2DArray aoMap;
+
+// ----------------------------------------------------------------------------
+// 与 pbr.frag 相同：用屏幕空间偏导数构造 TBN，把法线贴图转换到世界空间
+vec3 getNormalFromMap()
+{
+    vec3 tangentNormal = texture(normalMap, vec3(TexCoords, Layer)).xyz * 2.0 - 1.0;
+
+    vec3 Q1  = dFdx(WorldPos);
+    vec3 Q2  = dFdy(WorldPos);
+    vec2 st1 = dFdx(TexCoords);
+    vec2 st2 = dFdy(TexCoords);
+
+    vec3 N   = normalize(Normal);
+    vec3 T  = normalize( Q1 * st2.t - Q2 * st1.t );
+    vec3 B  = -normalize( cross(N, T) );
+    mat3 TBN = mat3(T, B, N);
+
+    return normalize(TBN * tangentNormal);
+}
+
+// ----------------------------------------------------------------------------
+// 八面体编码：单位向量投影到八面体再展开到 [-1,1]^2
+vec2 signNotZero(vec2 v)
+{
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 octEncode(vec3 n)
+{
+    vec2 p = n.xy * (1.0 / (abs(n.x) + abs(n.y) + abs(n.z)));
+    return (n.z <= 0.0) ? ((1.0 - abs(p.yx)) * signNotZero(p)) : p;
+}
+
+// ----------------------------------------------------------------------------
+void main()
+{
+    vec3 coords = vec3(TexCoords, Layer);
+    vec3 N = getNormalFromMap();
+
+    gAlbedoAo = vec4(texture(albedoMap, coords).rgb, texture(aoMap, coords).r);
+    gNormalMetalRough = vec4(octEncode(N) * 0.5 + 0.5,
+                             texture(metallicMap, coords).r,
+                             texture(roughnessMap, coords).r);
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoords;
+
+// G-Buffer（布局见 gbuffer.frag）
+uniform sampler2D gAlbedoAo;
+uniform sampler2D gNormalMetalRough;
+uniform sampler2D gDepth;
+
+// IBL
+uniform samplerCube irradianceMap;
+uniform samplerCube prefilterMap;
+uniform sampler2D brdfLUT;
+
+uniform vec3 camPos;
+uniform mat4 invViewProjection;
+
+const float PI = 3.14159265359;
+// ----------------------------------------------------------------------------
+// 八面体解码（gbuffer.frag 中 octEncode 的逆过程）
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+
+// ----------------------------------------------------------------------------
+// 由深度和屏幕坐标重建世界空间位置
+vec3 reconstructWorldPos(vec2 uv, float depth)
+{
+    vec4 ndc = vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 world = invViewProjection * ndc;
+    return world.xyz / world.w;
+}
+
+// ----------------------------------------------------------------------------
+// 计算NDF发现分布函数
+float DistributionGGX(vec3 N, vec3 H, float roughness)
+{
+    float a = roughness*roughness;
+    float a2 = a*a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH*NdotH;
+
+    float nom   = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+
+    return nom / denom;
+}
+
+// ----------------------------------------------------------------------------
+// 计算几何遮蔽函数，Schlick——GGX
+float GeometrySchlickGGX(float NdotV, float roughness)
+{
+    // k_dierct 直接光照
+    float r = (roughness + 1.0);
+    float k = (r*r) / 8.0;
+
+    float nom   = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
+
+    return nom / denom;
+}
+
+// ----------------------------------------------------------------------------
+// 计算几何遮蔽函数，Smith，组合视线和光线两个方向的几何遮蔽
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
+{
+    float NdotV = max(dot(N, V), 0.0);
+    float NdotL = max(dot(N, L), 0.0);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
+
+    return ggx1 * ggx2;
+}
+
+// ----------------------------------------------------------------------------
+// 计算菲尼尔方程
+vec3 fresnelSchlick(float cosTheta, vec3 F0)
+{
+    // clamp函数限制大小在[0,1]之间
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+// ----------------------------------------------------------------------------
+// 计算菲尼尔方程，考虑粗糙度
+vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
+{
+    return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+// lights：分簇光源列表（见 common/clusteredLights.glsl）
+#include "../common/clusteredLights.glsl"
+
+// ----------------------------------------------------------------------------
+void main()
+{
+    float depth = texture(gDepth, TexCoords).r;
+    // 没有几何体的像素留给天空盒
+    if (depth >= 1.0)
+        discard;
+
+    vec4 albedoAo = texture(gAlbedoAo, TexCoords);
+    vec4 normalMetalRough = texture(gNormalMetalRough, TexCoords);
+
+    // material properties
+    vec3 albedo = pow(albedoAo.rgb, vec3(2.2));// gamma correction
+    float ao = albedoAo.a;
+    float metallic = normalMetalRough.b;
+    float roughness = normalMetalRough.a;
+
+    vec3 WorldPos = reconstructWorldPos(TexCoords, depth);
+    vec3 N = octDecode(normalMetalRough.rg * 2.0 - 1.0);
+    vec3 V = normalize(camPos - WorldPos);
+    vec3 R = reflect(-V, N);
+
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+
+    // reflectance equation：只累加当前簇内的光源
+    vec3 Lo = evaluateClusteredLights(WorldPos, N, V, albedo, metallic, roughness, F0);
+
+    // ambient lighting (IBL)
+    vec3 F = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
+
+    vec3 kS = F;
+    vec3 kD = 1.0 - kS;
+    kD *= 1.0 - metallic;
+
+    vec3 irradiance = texture(irradianceMap, N).rgb;
+    vec3 diffuse      = irradiance * albedo;
+
+    const float MAX_REFLECTION_LOD = 4.0;
+    vec3 prefilteredColor = textureLod(prefilterMap, R,  roughness * MAX_REFLECTION_LOD).rgb;
+    vec2 brdf  = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughness)).rg;
+    vec3 specular = prefilteredColor * (F * brdf.x + brdf.y);
+
+    vec3 ambient = (kD * diffuse + specular) * ao;
+
+    vec3 color = ambient + Lo;
+
+    // HDR tonemapping
+    color = color / (color + vec3(1.0));
+    // gamma correct
+    color = pow(color, vec3(1.0/2.2));
+
+    FragColor = vec4(color , 1.0);
+    // 写回几何深度，之后前向绘制的天空盒 / 光源小球仍能正确做深度测试
+    gl_FragDepth = depth;
+}
\ No newline at end of file
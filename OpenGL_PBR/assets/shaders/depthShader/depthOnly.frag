@@ -0,0 +1,5 @@
+#version 330 core
+// 深度预通道：颜色写入已关闭，只需要光栅化产生的深度
+void main()
+{
+}
@@ -0,0 +1,58 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoords;
+in vec3 WorldPos;
+in vec3 Normal;
+flat in int MaterialIndex;
+
+// 同类贴图缩放到统一分辨率后放进纹理数组，材质只需要记录层号
+uniform sampler2DArray diffuseArray;
+uniform sampler2DArray normalArray;
+uniform sampler2DArray specularArray;
+
+// 每个材质：x = diffuse 层，y = normal 层，z = specular 层（-1 表示没有该贴图）
+const int MAX_MATERIALS = 64;
+uniform ivec4 materialLayers[MAX_MATERIALS];
+
+uniform vec3 lightDir;     // 指向光源的方向（世界空间）
+uniform vec3 lightColor;
+uniform vec3 camPos;
+
+vec3 getNormal(int layer)
+{
+    vec3 N = normalize(Normal);
+    if (layer < 0)
+        return N;
+
+    vec3 tangentNormal = texture(normalArray, vec3(TexCoords, layer)).xyz * 2.0 - 1.0;
+
+    // 与 pbr.frag 相同：用屏幕空间偏导数构造 TBN
+    vec3 Q1  = dFdx(WorldPos);
+    vec3 Q2  = dFdy(WorldPos);
+    vec2 st1 = dFdx(TexCoords);
+    vec2 st2 = dFdy(TexCoords);
+    vec3 T = normalize(Q1 * st2.t - Q2 * st1.t);
+    vec3 B = -normalize(cross(N, T));
+    return normalize(mat3(T, B, N) * tangentNormal);
+}
+
+void main()
+{
+    ivec4 layers = materialLayers[clamp(MaterialIndex, 0, MAX_MATERIALS - 1)];
+
+    vec3 albedo = layers.x >= 0 ? texture(diffuseArray, vec3(TexCoords, layers.x)).rgb : vec3(0.8);
+    float specular = layers.z >= 0 ? texture(specularArray, vec3(TexCoords, layers.z)).r : 0.2;
+
+    vec3 N = getNormal(layers.y);
+    vec3 L = normalize(lightDir);
+    vec3 V = normalize(camPos - WorldPos);
+    vec3 H = normalize(L + V);
+
+    vec3 ambient = 0.15 * albedo;
+    vec3 diffuse = max(dot(N, L), 0.0) * albedo * lightColor;
+    vec3 spec = pow(max(dot(N, H), 0.0), 32.0) * specular * lightColor;
+
+    vec3 color = ambient + diffuse + spec;
+    color = pow(color, vec3(1.0 / 2.2));
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,25 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 7) in int  aMaterial;   // 所属 draw 的材质下标（合并缓冲时按 Mesh 写入）
+
+out vec2 TexCoords;
+out vec3 WorldPos;
+out vec3 Normal;
+flat out int MaterialIndex;
+
+uniform mat4 projection;
+uniform mat4 view;
+uniform mat4 model;
+uniform mat3 normalMatrix;
+
+void main()
+{
+    TexCoords = aTexCoords;
+    WorldPos = vec3(model * vec4(aPos, 1.0));
+    Normal = normalMatrix * aNormal;
+    MaterialIndex = aMaterial;
+
+    gl_Position = projection * view * vec4(WorldPos, 1.0);
+}
@@ -16,10 +16,6 @@ uniform samplerCube irradianceMap;
 uniform samplerCube prefilterMap;
 uniform sampler2D brdfLUT;
 
-// lights
-uniform vec3 lightPositions[4];
-uniform vec3 lightColors[4];
-
 uniform vec3 camPos;
 
 const float PI = 3.14159265359;
@@ -108,6 +104,10 @@ vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness)
 {
     return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
+
+// lights：分簇光源列表（见 common/clusteredLights.glsl）
+#include "../common/clusteredLights.glsl"
+
 // ----------------------------------------------------------------------------
 void main()
 {
@@ -129,41 +129,8 @@ void main()
     vec3 F0 = vec3(0.04);
     F0 = mix(F0, albedo, metallic);
 
-    // reflectance equation
-    vec3 Lo = vec3(0.0);
-    for(int i = 0; i < 4; ++i)
-    {
-        // calculate per-light radiance
-        vec3 L = normalize(lightPositions[i] - WorldPos);
-        vec3 H = normalize(V + L);
-        float distance = length(lightPositions[i] - WorldPos);
-        float attenuation = 1.0 / (distance * distance);
-        vec3 radiance = lightColors[i] * attenuation;
-
-        // Cook-Torrance BRDF
-        float NDF = DistributionGGX(N, H, roughness);
-        float G   = GeometrySmith(N, V, L, roughness);
-        vec3 F    = fresnelSchlick(max(dot(H, V), 0.0), F0);
-
-        vec3 numerator    = NDF * G * F;
-        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001; // + 0.0001 to prevent divide by zero
-        vec3 specular = numerator / denominator;
-
-        // kS is equal to Fresnel
-        vec3 kS = F;
-        // 为了实现节能效果，漫射光和镜面反射光的亮度都不能超过 1.0（除非表面本身会发光）；
-        // 为了保持这种关系，漫射光部分（kD）应等于 1.0 减去镜面反射光部分（kS）的值。
-        vec3 kD = vec3(1.0) - kS;
-        // 将 kD 乘以金属度的倒数，这样只有非金属材质才会具有漫反射光照效果，
-        // 如果是部分金属材质则采用线性混合效果（纯金属材质则不会有漫反射光照效果）。
-        kD *= 1.0 - metallic;
-
-        // scale light by NdotL
-        float NdotL = max(dot(N, L), 0.0);
-
-        // add to outgoing radiance Lo
-        Lo += (kD * albedo / PI + specular) * radiance * NdotL; // note that we already multiplied the BRDF by the Fresnel (kS) so we won't multiply by kS again
-    }
+    // reflectance equation：只累加当前簇内的光源
+    vec3 Lo = evaluateClusteredLights(WorldPos, N, V, albedo, metallic, roughness, F0);
 
     // ambient lighting (we now use IBL as the ambient term)
     vec3 F = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
@@ -7,6 +7,9 @@ out vec2 TexCoords;
 out vec3 WorldPos;
 out vec3 Normal;
 
+// 深度预通道与着色通道用同一份顶点着色器，invariant 保证两次算出的深度完全相同（GL_EQUAL）
+invariant gl_Position;
+
 uniform mat4 projection;
 uniform mat4 view;
 uniform mat4 model;
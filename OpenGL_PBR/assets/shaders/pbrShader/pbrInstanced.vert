@@ -0,0 +1,29 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+// 逐实例属性：xyz 为世界空间位置，w 为均匀缩放；材质在纹理数组中的层号
+layout (location = 3) in vec4 aInstancePosScale;
+layout (location = 4) in float aInstanceLayer;
+
+out vec2 TexCoords;
+out vec3 WorldPos;
+out vec3 Normal;
+flat out float Layer;
+
+// 深度预通道与着色通道用同一份顶点着色器，invariant 保证两次算出的深度完全相同（GL_EQUAL）
+invariant gl_Position;
+
+uniform mat4 projection;
+uniform mat4 view;
+
+void main()
+{
+    TexCoords = aTexCoords;
+    WorldPos = aInstancePosScale.xyz + aPos * aInstancePosScale.w;
+    // 实例只有平移和均匀缩放，法线方向不变，不需要 normalMatrix
+    Normal = aNormal;
+    Layer = aInstanceLayer;
+
+    gl_Position =  projection * view * vec4(WorldPos, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+// 独立的微基准程序：不创建窗口和 GL 上下文，只测 CPU 端的热点路径；
+// 渲染提交类的用例把 GL 调用送进 NullGL。
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+
+namespace {
+    void PrintUsage()
+    {
+        std::printf(
+            "Usage: OpenGL_PBR_Bench [options]\n"
+            "  --list                 list benchmarks and exit\n"
+            "  --filter=TEXT          run only benchmarks whose name contains TEXT\n"
+            "  --warmup=N             warm-up repetitions (default 3)\n"
+            "  --reps=N               measured repetitions (default 10)\n"
+            "  --min-time=MS          minimum duration of one repetition (default 20)\n"
+            "  --threads=N            job system worker threads (default: hardware threads - 1)\n"
+            "  --out=FILE             JSON results (default bench_results.json)\n"
+            "  --baseline=FILE        compare against a previous results file\n"
+            "  --threshold=PCT        regression threshold in percent (default 5)\n"
+            "  --check                run the behaviour checks instead of the benchmarks\n"
+            "Exit code is 1 when a benchmark regressed against the baseline or a check failed.\n");
+    }
+
+    // "--name=value" 形式的参数；匹配时写入 value 并返回 true
+    bool Option(const std::string& arg, const char* name, std::string& value)
+    {
+        const std::string prefix = std::string(name) + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0)
+            return false;
+        value = arg.substr(prefix.size());
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    std::string outPath = "bench_results.json";
+    std::string baselinePath;
+    double thresholdPct = 5.0;
+    int threads = -1;
+    bool list = false;
+    bool check = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        std::string value;
+        if (arg == "--list")                             list = true;
+        else if (arg == "--check")                       check = true;
+        else if (Option(arg, "--filter", value))         options.filter = value;
+        else if (Option(arg, "--warmup", value))         options.warmup = static_cast<unsigned int>(std::stoul(value));
+        else if (Option(arg, "--reps", value))           options.repetitions = static_cast<unsigned int>(std::stoul(value));
+        else if (Option(arg, "--min-time", value))       options.minRepMs = std::stod(value);
+        else if (Option(arg, "--threads", value))        threads = std::stoi(value);
+        else if (Option(arg, "--out", value))            outPath = value;
+        else if (Option(arg, "--baseline", value))       baselinePath = value;
+        else if (Option(arg, "--threshold", value))      thresholdPct = std::stod(value);
+        else {
+            PrintUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    bench::RegisterEngineBenchmarks();
+    bench::RegisterEngineChecks();
+    if (list) {
+        if (check) {
+            for (const bench::Check& c : bench::Checks())
+                std::printf("%s\n", c.name.c_str());
+        }
+        else {
+            for (const bench::Case& c : bench::Cases())
+                std::printf("%s\n", c.name.c_str());
+        }
+        return 0;
+    }
+
+    // 检查模式：逐项执行，不计时；任何一项失败时返回 1
+    if (check) {
+        core::JobSystem::Initialize(threads);
+        size_t failures = 0, count = 0;
+        for (const bench::Check& c : bench::Checks()) {
+            if (!options.filter.empty() && c.name.find(options.filter) == std::string::npos)
+                continue;
+            std::string message;
+            const bool ok = c.run(message);
+            std::printf("%-36s %-6s %s\n", c.name.c_str(), ok ? "ok" : "FAILED", message.c_str());
+            failures += ok ? 0 : 1;
+            ++count;
+        }
+        core::JobSystem::Shutdown();
+        std::cout << "[Benchmark] " << count - failures << " / " << count << " checks passed" << std::endl;
+        return failures > 0 ? 1 : 0;
+    }
+
+    // 先读基线，文件有问题时在跑完整套测试之前就失败
+    bench::Baseline baseline;
+    if (!baselinePath.empty() && !bench::LoadBaseline(baselinePath, baseline))
+        return 2;
+
+    core::JobSystem::Initialize(threads);
+    std::cout << "[Benchmark] " << core::JobSystem::ThreadCount() << " job threads, warmup " << options.warmup
+              << ", " << options.repetitions << " reps of >= " << options.minRepMs << " ms" << std::endl;
+
+    std::vector<bench::Result> results;
+    bench::PrintHeader();
+    for (const bench::Case& c : bench::Cases()) {
+        if (!options.filter.empty() && c.name.find(options.filter) == std::string::npos)
+            continue;
+        bench::Result result;
+        if (!bench::Run(c, options, result)) {
+            std::printf("%-32s skipped (input not available)\n", c.name.c_str());
+            continue;
+        }
+        bench::PrintResult(result);
+        results.push_back(result);
+    }
+    core::JobSystem::Shutdown();
+
+    size_t regressions = 0;
+    if (!baselinePath.empty()) {
+        regressions = bench::Compare(results, baseline, thresholdPct);
+        bench::PrintComparison(results, baseline);
+        std::cout << "[Benchmark] " << regressions << " regression(s) against " << baselinePath << std::endl;
+    }
+    if (!bench::WriteJson(outPath, options, results))
+        return 2;
+    return regressions > 0 ? 1 : 0;
+}
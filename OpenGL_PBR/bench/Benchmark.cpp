@@ -0,0 +1,439 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "utils/Simd.h"
+
+
+namespace bench {
+
+    namespace {
+
+        std::vector<Case>& Registry()
+        {
+            static std::vector<Case> cases;
+            return cases;
+        }
+
+        std::vector<Check>& CheckRegistry()
+        {
+            static std::vector<Check> checks;
+            return checks;
+        }
+
+        // Body 的返回值累加到这里，避免编译器把没有副作用的测量体优化掉
+        volatile size_t g_Sink = 0;
+
+        double RunIterations(const Body& body, uint64_t iterations, size_t& items)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (uint64_t i = 0; i < iterations; ++i)
+                items = body();
+            auto end = std::chrono::high_resolution_clock::now();
+            g_Sink = g_Sink + items;
+            return std::chrono::duration<double, std::nano>(end - start).count();
+        }
+
+        // 最近秩法：排好序的 n 个样本中第 ceil(p * n) 个（与 core::FrameStats 一致）
+        double Percentile(const std::vector<double>& sorted, double p)
+        {
+            size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+            rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+            return sorted[rank - 1];
+        }
+
+        std::string Escape(const std::string& s)
+        {
+            std::string out;
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        /// 只支持 WriteJson 用到的子集：对象、数组、字符串（\" 和 \\ 转义）、数字、true / false / null
+        class JsonReader {
+        public:
+            explicit JsonReader(const std::string& text) : m_Text(text) {}
+
+            /// 解析 "benchmarks" 数组中每个对象的 name 和数值字段
+            bool ReadBaseline(Baseline& baseline)
+            {
+                if (!Consume('{')) return false;
+                if (Consume('}')) return true;
+                do {
+                    std::string key;
+                    if (!ReadString(key) || !Consume(':')) return false;
+                    if (key == "benchmarks")
+                    {
+                        if (!ReadBenchmarks(baseline)) return false;
+                    }
+                    else if (!SkipValue())
+                        return false;
+                } while (Consume(','));
+                return Consume('}');
+            }
+
+        private:
+            const std::string& m_Text;
+            size_t m_Pos = 0;
+
+            void SkipSpace()
+            {
+                while (m_Pos < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Pos])))
+                    ++m_Pos;
+            }
+            bool Consume(char c)
+            {
+                SkipSpace();
+                if (m_Pos < m_Text.size() && m_Text[m_Pos] == c) { ++m_Pos; return true; }
+                return false;
+            }
+
+            bool ReadString(std::string& out)
+            {
+                if (!Consume('"')) return false;
+                out.clear();
+                while (m_Pos < m_Text.size() && m_Text[m_Pos] != '"')
+                {
+                    if (m_Text[m_Pos] == '\\' && m_Pos + 1 < m_Text.size()) ++m_Pos;
+                    out += m_Text[m_Pos++];
+                }
+                return m_Pos++ < m_Text.size();
+            }
+
+            bool ReadNumber(double& out)
+            {
+                SkipSpace();
+                const char* begin = m_Text.c_str() + m_Pos;
+                char* end = nullptr;
+                out = std::strtod(begin, &end);
+                if (end == begin) return false;
+                m_Pos += static_cast<size_t>(end - begin);
+                return true;
+            }
+
+            bool SkipValue()
+            {
+                SkipSpace();
+                if (m_Pos >= m_Text.size()) return false;
+                const char c = m_Text[m_Pos];
+                if (c == '"') { std::string s; return ReadString(s); }
+                if (c == '{' || c == '[')
+                {
+                    const char close = c == '{' ? '}' : ']';
+                    ++m_Pos;
+                    if (Consume(close)) return true;
+                    do {
+                        if (c == '{')
+                        {
+                            std::string key;
+                            if (!ReadString(key) || !Consume(':')) return false;
+                        }
+                        if (!SkipValue()) return false;
+                    } while (Consume(','));
+                    return Consume(close);
+                }
+                for (const char* word : { "true", "false", "null" })
+                {
+                    const size_t length = std::char_traits<char>::length(word);
+                    if (m_Text.compare(m_Pos, length, word) == 0) { m_Pos += length; return true; }
+                }
+                double number;
+                return ReadNumber(number);
+            }
+
+            bool ReadBenchmarks(Baseline& baseline)
+            {
+                if (!Consume('[')) return false;
+                if (Consume(']')) return true;
+                do {
+                    if (!Consume('{')) return false;
+                    std::string name;
+                    BaselineEntry entry;
+                    if (!Consume('}'))
+                    {
+                        do {
+                            std::string key;
+                            if (!ReadString(key) || !Consume(':')) return false;
+                            bool ok = true;
+                            if (key == "name")           ok = ReadString(name);
+                            else if (key == "median_ns") ok = ReadNumber(entry.medianNs);
+                            else if (key == "mean_ns")   ok = ReadNumber(entry.meanNs);
+                            else if (key == "stddev_ns") ok = ReadNumber(entry.stddevNs);
+                            else                         ok = SkipValue();
+                            if (!ok) return false;
+                        } while (Consume(','));
+                        if (!Consume('}')) return false;
+                    }
+                    if (!name.empty() && entry.medianNs > 0.0)
+                        baseline[name] = entry;
+                } while (Consume(','));
+                return Consume(']');
+            }
+        };
+
+        // 便于阅读的时间：自动选择 ns / us / ms
+        std::string FormatNs(double ns)
+        {
+            char buffer[32];
+            if (ns < 1e3)      std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+            else if (ns < 1e6) std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+            else               std::snprintf(buffer, sizeof(buffer), "%.3f ms", ns / 1e6);
+            return buffer;
+        }
+    }
+
+    void Register(const std::string& name, const std::string& unit, Setup setup)
+    {
+        Registry().push_back(Case{ name, unit, std::move(setup) });
+    }
+
+    const std::vector<Case>& Cases()
+    {
+        return Registry();
+    }
+
+    void RegisterCheck(const std::string& name, CheckFn check)
+    {
+        CheckRegistry().push_back(Check{ name, std::move(check) });
+    }
+
+    const std::vector<Check>& Checks()
+    {
+        return CheckRegistry();
+    }
+
+    bool Run(const Case& c, const Options& options, Result& result)
+    {
+        Body body = c.setup();
+        if (!body)
+            return false;
+
+        result = Result();
+        result.name = c.name;
+        result.unit = c.unit;
+
+        // 1. 单次耗时 -> 每次重复的迭代数
+        size_t items = 0;
+        const double singleNs = std::max(RunIterations(body, 1, items), 1.0);
+        uint64_t iterations = static_cast<uint64_t>(std::ceil(options.minRepMs * 1e6 / singleNs));
+        iterations = std::max<uint64_t>(iterations, 1);
+
+        // 2. 预热
+        for (unsigned int i = 0; i < options.warmup; ++i)
+            RunIterations(body, iterations, items);
+
+        // 3. 测量
+        const unsigned int repetitions = std::max(options.repetitions, 1u);
+        std::vector<double> samples(repetitions);
+        for (unsigned int i = 0; i < repetitions; ++i)
+            samples[i] = RunIterations(body, iterations, items) / iterations;
+
+        double sum = 0.0;
+        for (double s : samples)
+            sum += s;
+        const double mean = sum / repetitions;
+        double variance = 0.0;
+        for (double s : samples)
+            variance += (s - mean) * (s - mean);
+        variance = repetitions > 1 ? variance / (repetitions - 1) : 0.0;
+        std::sort(samples.begin(), samples.end());
+
+        result.iterations  = iterations;
+        result.repetitions = repetitions;
+        result.items       = items;
+        result.meanNs      = mean;
+        result.medianNs    = repetitions % 2 ? samples[repetitions / 2]
+                                             : 0.5 * (samples[repetitions / 2 - 1] + samples[repetitions / 2]);
+        result.stddevNs    = std::sqrt(variance);
+        result.minNs       = samples.front();
+        result.maxNs       = samples.back();
+        result.p95Ns       = Percentile(samples, 0.95);
+        result.itemsPerSec = items > 0 && result.medianNs > 0.0 ? items * 1e9 / result.medianNs : 0.0;
+        return true;
+    }
+
+    void PrintHeader()
+    {
+        std::printf("%-32s %12s %12s %12s %7s %10s  %s\n",
+                    "benchmark", "median", "mean", "min", "cv", "iters", "throughput");
+    }
+
+    void PrintResult(const Result& r)
+    {
+        char throughput[64] = "";
+        if (r.itemsPerSec > 0.0)
+            std::snprintf(throughput, sizeof(throughput), "%.3g %s/s", r.itemsPerSec, r.unit.c_str());
+        std::printf("%-32s %12s %12s %12s %6.1f%% %10llu  %s\n", r.name.c_str(),
+                    FormatNs(r.medianNs).c_str(), FormatNs(r.meanNs).c_str(), FormatNs(r.minNs).c_str(),
+                    r.Cv() * 100.0, static_cast<unsigned long long>(r.iterations), throughput);
+        std::fflush(stdout);
+    }
+
+    /*
+     * {
+     *   "format": "pbr-bench", "version": 1,
+     *   "context": { "date": ..., "build": "Release" | "Debug", "simd": "AVX" | "SSE" | "scalar", "hardware_threads": N },
+     *   "options": { "warmup": N, "repetitions": N, "min_rep_ms": X },
+     *   "benchmarks": [
+     *     { "name": ..., "unit": ..., "items": N, "iterations": N, "repetitions": N,
+     *       "mean_ns": X, "median_ns": X, "stddev_ns": X, "min_ns": X, "max_ns": X, "p95_ns": X,
+     *       "items_per_sec": X,
+     *       // 与基线比较时追加：
+     *       "baseline_median_ns": X, "change_pct": X, "noise_pct": X, "status": "unchanged" | "improved" | "regressed" | "new" }
+     *   ]
+     * }
+     */
+    bool WriteJson(const std::string& path, const Options& options, const std::vector<Result>& results)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "[Benchmark] Cannot write " << path << std::endl;
+            return false;
+        }
+
+        char date[32] = "";
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+#ifdef NDEBUG
+        const char* build = "Release";
+#else
+        const char* build = "Debug";
+#endif
+        const char* simd = PBR_SIMD_AVX ? "AVX" : (PBR_SIMD_SSE ? "SSE" : "scalar");
+
+        out.precision(10);
+        out << "{\n"
+            << "  \"format\": \"pbr-bench\",\n"
+            << "  \"version\": 1,\n"
+            << "  \"context\": { \"date\": \"" << date << "\", \"build\": \"" << build << "\", \"simd\": \"" << simd
+            << "\", \"hardware_threads\": " << std::thread::hardware_concurrency() << " },\n"
+            << "  \"options\": { \"warmup\": " << options.warmup << ", \"repetitions\": " << options.repetitions
+            << ", \"min_rep_ms\": " << options.minRepMs << " },\n"
+            << "  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            out << (i ? ",\n" : "\n")
+                << "    { \"name\": \"" << Escape(r.name) << "\", \"unit\": \"" << Escape(r.unit) << "\""
+                << ", \"items\": " << r.items << ", \"iterations\": " << r.iterations
+                << ", \"repetitions\": " << r.repetitions
+                << ", \"mean_ns\": " << r.meanNs << ", \"median_ns\": " << r.medianNs
+                << ", \"stddev_ns\": " << r.stddevNs << ", \"min_ns\": " << r.minNs << ", \"max_ns\": " << r.maxNs
+                << ", \"p95_ns\": " << r.p95Ns << ", \"items_per_sec\": " << r.itemsPerSec;
+            if (r.status != Status::None)
+            {
+                out << ", \"baseline_median_ns\": " << r.baselineNs << ", \"change_pct\": " << r.changePct
+                    << ", \"noise_pct\": " << r.noisePct << ", \"status\": \"" << StatusName(r.status) << "\"";
+            }
+            out << " }";
+        }
+        out << "\n  ]\n}\n";
+
+        std::cout << "[Benchmark] Wrote " << results.size() << " results to " << path << std::endl;
+        return static_cast<bool>(out);
+    }
+
+    bool LoadBaseline(const std::string& path, Baseline& baseline)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            std::cerr << "[Benchmark] Cannot open baseline " << path << std::endl;
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        baseline.clear();
+        if (!JsonReader(text).ReadBaseline(baseline))
+        {
+            std::cerr << "[Benchmark] " << path << " is not a benchmark result file" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    size_t Compare(std::vector<Result>& results, const Baseline& baseline, double thresholdPct)
+    {
+        size_t regressions = 0;
+        for (Result& r : results)
+        {
+            auto it = baseline.find(r.name);
+            if (it == baseline.end())
+            {
+                r.status = Status::New;
+                continue;
+            }
+            const BaselineEntry& base = it->second;
+            const double baseCv = base.meanNs > 0.0 ? base.stddevNs / base.meanNs : 0.0;
+            r.baselineNs = base.medianNs;
+            r.changePct  = (r.medianNs / base.medianNs - 1.0) * 100.0;
+            r.noisePct   = std::max(thresholdPct, 2.0 * (baseCv + r.Cv()) * 100.0);
+            if (r.changePct > r.noisePct)
+            {
+                r.status = Status::Regressed;
+                ++regressions;
+            }
+            else if (r.changePct < -r.noisePct)
+                r.status = Status::Improved;
+            else
+                r.status = Status::Unchanged;
+        }
+        return regressions;
+    }
+
+    void PrintComparison(const std::vector<Result>& results, const Baseline& baseline)
+    {
+        std::printf("\n%-32s %12s %12s %9s %8s  %s\n", "benchmark", "baseline", "current", "change", "noise", "status");
+        for (const Result& r : results)
+        {
+            if (r.status == Status::New)
+            {
+                std::printf("%-32s %12s %12s %9s %8s  %s\n", r.name.c_str(), "-", FormatNs(r.medianNs).c_str(),
+                            "-", "-", StatusName(r.status));
+                continue;
+            }
+            std::printf("%-32s %12s %12s %+8.1f%% %7.1f%%  %s%s\n", r.name.c_str(), FormatNs(r.baselineNs).c_str(),
+                        FormatNs(r.medianNs).c_str(), r.changePct, r.noisePct, StatusName(r.status),
+                        r.status == Status::Regressed ? "  <--" : "");
+        }
+        for (const auto& entry : baseline)
+        {
+            const bool ran = std::any_of(results.begin(), results.end(),
+                                         [&](const Result& r) { return r.name == entry.first; });
+            if (!ran)
+                std::printf("%-32s %12s %12s %9s %8s  %s\n", entry.first.c_str(),
+                            FormatNs(entry.second.medianNs).c_str(), "-", "-", "-", "not run");
+        }
+        std::fflush(stdout);
+    }
+
+    const char* StatusName(Status status)
+    {
+        switch (status)
+        {
+        case Status::Unchanged: return "unchanged";
+        case Status::Improved:  return "improved";
+        case Status::Regressed: return "regressed";
+        case Status::New:       return "new";
+        default:                return "";
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace bench {
+
+    /**
+     * 微基准框架
+     * ----------
+     * 每个用例由 Setup 准备输入数据并返回测量体 Body；Body 执行一次被测操作，返回本次处理的元素数
+     * （像素、物体、样本……，用于计算吞吐量，返回 0 表示不统计）。
+     *
+     * 测量过程：
+     *  1. 先单独执行一次 Body，估算每次耗时，决定每次重复内的迭代数（使一次重复至少 minRepMs 毫秒）
+     *  2. 预热 warmup 次重复（不计入结果），让缓存、分配器和作业线程进入稳态
+     *  3. 测量 repetitions 次重复，每次得到一个“每次迭代的平均耗时”样本，对这些样本做统计
+     *
+     * 结果可写成 JSON（WriteJson），也可以和之前保存的 JSON 基线比较（Compare），
+     * 中位数变慢超过阈值（且超过两次运行的噪声）时判为回退。
+     */
+
+    /// 执行一次被测操作，返回处理的元素数
+    using Body = std::function<size_t()>;
+    /// 准备输入并返回测量体；返回空 Body 表示跳过（例如资源文件不存在）
+    using Setup = std::function<Body()>;
+
+    struct Case {
+        std::string name;    // "组/用例"，如 "texture/decode_png"
+        std::string unit;    // Body 返回值的单位，如 "pixels"
+        Setup       setup;
+    };
+
+    struct Options {
+        unsigned int warmup      = 3;
+        unsigned int repetitions = 10;
+        double       minRepMs    = 20.0;
+        std::string  filter;             // 只运行名字包含该子串的用例
+    };
+
+    enum class Status { None, Unchanged, Improved, Regressed, New };
+
+    struct Result {
+        std::string  name;
+        std::string  unit;
+        uint64_t     iterations  = 0;    // 每次重复内的迭代数
+        unsigned int repetitions = 0;
+        size_t       items       = 0;    // 每次迭代处理的元素数
+
+        // 每次迭代的耗时统计（纳秒，基于各次重复的平均值）
+        double meanNs   = 0.0;
+        double medianNs = 0.0;
+        double stddevNs = 0.0;
+        double minNs    = 0.0;
+        double maxNs    = 0.0;
+        double p95Ns    = 0.0;
+        double itemsPerSec = 0.0;        // 按中位数计算
+
+        // Compare 填写
+        Status status     = Status::None;
+        double baselineNs = 0.0;         // 基线中位数
+        double changePct  = 0.0;         // (medianNs / baselineNs - 1) * 100
+        double noisePct   = 0.0;         // 判定时使用的噪声阈值
+
+        /// 变异系数（标准差 / 均值）
+        double Cv() const { return meanNs > 0.0 ? stddevNs / meanNs : 0.0; }
+    };
+
+    /// 基线中每个用例需要的数据
+    struct BaselineEntry {
+        double medianNs = 0.0;
+        double stddevNs = 0.0;
+        double meanNs   = 0.0;
+    };
+    using Baseline = std::map<std::string, BaselineEntry>;
+
+    // ---- 注册 ----
+    void Register(const std::string& name, const std::string& unit, Setup setup);
+    const std::vector<Case>& Cases();
+    /// 注册引擎热点路径的全部用例（EngineBenchmarks.cpp）
+    void RegisterEngineBenchmarks();
+
+    // ---- 行为检查（--check） ----
+    /// 一项确定性的检查：通过时返回 true，失败原因写进 message（通过时也可以写一行摘要）
+    using CheckFn = std::function<bool(std::string& message)>;
+
+    struct Check {
+        std::string name;
+        CheckFn     run;
+    };
+
+    void RegisterCheck(const std::string& name, CheckFn check);
+    const std::vector<Check>& Checks();
+    /// 注册引擎的行为检查（EngineBenchmarks.cpp）：每帧 GL 调用数、每帧堆分配等不随机器变化的量
+    void RegisterEngineChecks();
+
+    // ---- 运行 ----
+    /// 运行一个用例；Setup 返回空 Body 时返回 false
+    bool Run(const Case& c, const Options& options, Result& result);
+
+    // ---- 输出 / 基线 ----
+    void PrintHeader();
+    void PrintResult(const Result& result);
+
+    /// 写出机器可读的结果（格式见 Benchmark.cpp 中 WriteJson 的注释）
+    bool WriteJson(const std::string& path, const Options& options, const std::vector<Result>& results);
+    /// 读取 WriteJson 写出的文件
+    bool LoadBaseline(const std::string& path, Baseline& baseline);
+
+    /**
+     * 与基线比较，填写 results 中的 status / baselineNs / changePct / noisePct。
+     * 噪声阈值取 max(thresholdPct, 2 × (基线 CV + 本次 CV) × 100)，中位数变化超出它才判为回退 / 改善。
+     * @return 回退的用例数
+     */
+    size_t Compare(std::vector<Result>& results, const Baseline& baseline, double thresholdPct);
+    void   PrintComparison(const std::vector<Result>& results, const Baseline& baseline);
+
+    const char* StatusName(Status status);
+
+} // namespace bench
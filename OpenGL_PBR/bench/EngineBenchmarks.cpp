@@ -0,0 +1,630 @@
+#include "Benchmark.h"
+#include "IblKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "core/AllocationTracker.h"
+#include "core/Camera.h"
+#include "core/FrameArena.h"
+#include "utils/TextureLoader.h"
+#include "renderer/GLCallCounter.h"
+#include "renderer/GLEntryPoints.h"
+#include "renderer/GLExtensions.h"
+#include "renderer/GpuProfiler.h"
+#include "renderer/NullGL.h"
+#include "renderer/PBRRenderer.h"
+#include "renderer/Primitives.h"
+#include "scene/Model.h"
+#include "scene/TransformBatch.h"
+#include "scene/FrustumCuller.h"
+#include "scene/Bvh.h"
+#include "scene/LightClusterer.h"
+
+
+namespace bench {
+
+    namespace {
+
+        // 与应用里的资源一致（工作目录为 OpenGL_PBR/）
+        const char* kPngPath = "assets/textures/pbr/rusted_iron/roughness.png";
+        const char* kJpgPath = "assets/textures/brickwall.jpg";
+        const char* kHdrPath = "assets/textures/hdr/newport_loft.hdr";
+        const char* kMaterialDir = "assets/textures/pbr";
+
+        size_t Pixels(const utils::TextureLoader::Image& image)
+        {
+            return static_cast<size_t>(image.width) * image.height;
+        }
+
+        void RegisterDecode(const std::string& name, const char* path, bool hdr)
+        {
+            Register(name, "pixels", [path, hdr]() -> Body {
+                // 先解码一次确认文件可用，同时让文件进入系统缓存，测量的是解码而不是磁盘
+                utils::TextureLoader::Image probe = utils::TextureLoader::Decode(path, hdr);
+                if (!probe.Valid())
+                    return Body();
+                utils::TextureLoader::Free(probe);
+                return [path, hdr]() {
+                    utils::TextureLoader::Image image = utils::TextureLoader::Decode(path, hdr);
+                    const size_t pixels = Pixels(image);
+                    utils::TextureLoader::Free(image);
+                    return pixels;
+                };
+            });
+        }
+
+        /// 规则网格（side × side 个顶点，起伏的高度场），带法线 / UV / 切线，与 Assimp 导入后的数据布局相同
+        std::shared_ptr<aiMesh> MakeGridMesh(unsigned int side)
+        {
+            std::shared_ptr<aiMesh> mesh(new aiMesh());
+            const unsigned int vertexCount = side * side;
+            mesh->mNumVertices = vertexCount;
+            mesh->mVertices = new aiVector3D[vertexCount];
+            mesh->mNormals = new aiVector3D[vertexCount];
+            mesh->mTangents = new aiVector3D[vertexCount];
+            mesh->mBitangents = new aiVector3D[vertexCount];
+            mesh->mTextureCoords[0] = new aiVector3D[vertexCount];
+            for (unsigned int y = 0; y < side; ++y)
+            {
+                for (unsigned int x = 0; x < side; ++x)
+                {
+                    const unsigned int i = y * side + x;
+                    const float u = static_cast<float>(x) / (side - 1);
+                    const float v = static_cast<float>(y) / (side - 1);
+                    mesh->mVertices[i] = aiVector3D{ u * 10.0f, 0.3f * std::sin(u * 12.0f) * std::cos(v * 9.0f), v * 10.0f };
+                    mesh->mNormals[i] = aiVector3D{ 0.0f, 1.0f, 0.0f };
+                    mesh->mTangents[i] = aiVector3D{ 1.0f, 0.0f, 0.0f };
+                    mesh->mBitangents[i] = aiVector3D{ 0.0f, 0.0f, 1.0f };
+                    mesh->mTextureCoords[0][i] = aiVector3D{ u, v, 0.0f };
+                }
+            }
+
+            const unsigned int quads = (side - 1) * (side - 1);
+            mesh->mNumFaces = quads * 2;
+            mesh->mFaces = new aiFace[mesh->mNumFaces];
+            unsigned int face = 0;
+            for (unsigned int y = 0; y + 1 < side; ++y)
+            {
+                for (unsigned int x = 0; x + 1 < side; ++x)
+                {
+                    const unsigned int i = y * side + x;
+                    const unsigned int corners[2][3] = { { i, i + side, i + 1 }, { i + 1, i + side, i + side + 1 } };
+                    for (const auto& triangle : corners)
+                    {
+                        aiFace& f = mesh->mFaces[face++];
+                        f.mNumIndices = 3;
+                        f.mIndices = new unsigned int[3]{ triangle[0], triangle[1], triangle[2] };
+                    }
+                }
+            }
+            return mesh;
+        }
+
+        /// 固定种子的随机场景：物体散布在相机周围边长 2 × half 的立方体内，只有一部分落在视锥内
+        std::vector<AABB> RandomBounds(size_t count, float half, unsigned int seed)
+        {
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> pos(-half, half);
+            std::uniform_real_distribution<float> size(0.1f, 2.0f);
+            std::vector<AABB> bounds(count);
+            for (AABB& b : bounds)
+            {
+                glm::vec3 c(pos(rng), pos(rng), pos(rng));
+                glm::vec3 e(size(rng), size(rng), size(rng));
+                b.Min = c - e;
+                b.Max = c + e;
+            }
+            return bounds;
+        }
+
+        Frustum BenchFrustum()
+        {
+            glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+            glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            return Frustum::FromMatrix(projection * view);
+        }
+
+        void RegisterTransforms(const std::string& name, size_t count, bool simd)
+        {
+            Register(name, "objects", [count, simd]() -> Body {
+                // 一半等比缩放，一半非等比
+                auto batch = std::make_shared<TransformBatch>();
+                batch->useSimd = simd;
+                std::mt19937 rng(7);
+                std::uniform_real_distribution<float> pos(-50.0f, 50.0f), angle(0.0f, 6.2831853f), scale(0.5f, 2.0f);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    glm::quat rotation = glm::angleAxis(angle(rng), glm::normalize(glm::vec3(pos(rng), pos(rng), pos(rng)) + glm::vec3(0.01f)));
+                    glm::vec3 s = (i & 1) ? glm::vec3(scale(rng)) : glm::vec3(scale(rng), scale(rng), scale(rng));
+                    batch->Add(glm::vec3(pos(rng), pos(rng), pos(rng)), rotation, s);
+                }
+                return [batch, count]() {
+                    batch->MarkAllDirty();
+                    batch->Update();
+                    return count;
+                };
+            });
+        }
+
+        void RegisterClustering(const std::string& name, size_t count, bool parallel)
+        {
+            Register(name, "lights", [count, parallel]() -> Body {
+                // 与 LightClusterer::Benchmark 相同的光源分布
+                auto clusterer = std::make_shared<LightClusterer>();
+                clusterer->parallel = parallel;
+                clusterer->SetProjection(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f), 0.1f, 100.0f);
+                std::mt19937 rng(12345);
+                std::uniform_real_distribution<float> px(-30.0f, 30.0f), py(-15.0f, 15.0f), pz(-60.0f, 2.0f), pr(1.0f, 4.0f);
+                auto lights = std::make_shared<std::vector<LightClusterer::PointLight>>(count);
+                for (auto& l : *lights)
+                    l = LightClusterer::PointLight{ glm::vec3(px(rng), py(rng), pz(rng)), pr(rng), glm::vec3(1.0f) };
+                const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+                return [clusterer, lights, view, count]() {
+                    clusterer->Assign(view, *lights);
+                    return count;
+                };
+            });
+        }
+
+        /// 提交类基准共用的“上下文”：第一次用到时载入 NullGL 并装上调用计数，整个进程只载入一次
+        bool EnsureNullGL()
+        {
+            static const bool loaded = renderer::NullGL::Load();
+            if (loaded)
+            {
+                renderer::GLExtensions::Init(renderer::NullGL::GetProcAddress);
+                renderer::GLCallCounter::Install();
+            }
+            return loaded;
+        }
+
+        /// 与 Application::ScanMaterialDirectory 相同：每个子目录是一个材质
+        std::vector<std::string> MaterialNames(const char* directory)
+        {
+            std::vector<std::string> names;
+            std::error_code error;
+            for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+            {
+                if (entry.is_directory())
+                    names.push_back(entry.path().filename().string());
+            }
+            return names;
+        }
+
+        /// 与应用相同的默认场景（每个材质一个球），GL 调用送进 NullGL；spheres > 0 时换成基准球阵列。
+        /// 资源不可用时返回空指针
+        std::shared_ptr<renderer::PBRRenderer> MakeSceneRenderer(int spheres)
+        {
+            const std::vector<std::string> materials = MaterialNames(kMaterialDir);
+            if (materials.empty() || !EnsureNullGL())
+                return nullptr;
+            auto pbr = std::make_shared<renderer::PBRRenderer>(1280, 720);
+            pbr->LoadAllMaterials(materials, kMaterialDir);
+            pbr->InitPBR(std::string(kHdrPath));
+            if (spheres > 0)
+                pbr->SetBenchmarkSphereCount(spheres);
+            return pbr;
+        }
+
+        /// 与 Application 相同的场景模型：程序生成的 8 × 8 块地面
+        void AddGroundModel(renderer::PBRRenderer& pbr, bool batched)
+        {
+            pbr.SetSceneModel(Model::CreateGrid(8, 65, 10.0f),
+                              glm::translate(glm::mat4(1.0f), glm::vec3(-40.0f, -6.0f, -75.0f)));
+            pbr.batchSceneModel = batched;
+        }
+
+        /// 提交一帧，返回本帧的 GL 调用数
+        unsigned int SubmitFrame(renderer::PBRRenderer& pbr, const core::Camera& camera)
+        {
+            // 和 Application 的帧循环一样，每帧开始时作废上一帧的临时数据
+            core::FrameArena::Main().Reset();
+            renderer::GLCallCounter::BeginFrame();
+            pbr.RenderPBRScene(camera);
+            return renderer::GLCallCounter::Current().calls;
+        }
+
+        /// PBRRenderer::RenderPBRScene 的 CPU 提交开销（NullGL，GPU 不参与）
+        void RegisterSceneSubmission(const std::string& name, int spheres)
+        {
+            Register(name, "gl calls", [spheres]() -> Body {
+                std::shared_ptr<renderer::PBRRenderer> pbr = MakeSceneRenderer(spheres);
+                if (!pbr)
+                    return Body();
+                auto camera = std::make_shared<core::Camera>(glm::vec3(0.0f, 0.0f, 3.0f));
+                return [pbr, camera]() {
+                    return static_cast<size_t>(SubmitFrame(*pbr, *camera));
+                };
+            });
+        }
+
+        /// 8 × 8 块网格组成的模型，每块一个 Mesh（带 LOD 链和 meshlet）
+        std::shared_ptr<Model> MakeTileModel()
+        {
+            std::shared_ptr<aiMesh> tile = MakeGridMesh(33);
+            vector<Vertex> vertices;
+            vector<unsigned int> indices;
+            vector<MeshLod> lods;
+            Model::ConvertMesh(tile.get(), vertices, indices, lods);
+            vector<Mesh> meshes;
+            for (int z = 0; z < 8; ++z)
+            {
+                for (int x = 0; x < 8; ++x)
+                {
+                    vector<Vertex> moved = vertices;
+                    for (Vertex& v : moved)
+                        v.Position += glm::vec3(x * 10.0f, 0.0f, z * 10.0f);
+                    meshes.emplace_back(moved, indices, vector<Texture>(), lods);
+                }
+            }
+            return std::make_shared<Model>(std::move(meshes));
+        }
+
+        /// 连续提交若干帧：预热（GPU 计时结果开始回读）之后，每帧的 GL 调用数必须相同且等于 expected
+        bool CheckCallsPerFrame(const std::function<unsigned int()>& frame, unsigned int expected, std::string& message)
+        {
+            for (unsigned int i = 0; i < renderer::GpuProfiler::LATENCY + 1; ++i)
+                frame();
+            const unsigned int calls = frame();
+            for (unsigned int i = 1; i < 8; ++i)
+            {
+                const unsigned int again = frame();
+                if (again != calls)
+                {
+                    message = "calls per frame not stable: " + std::to_string(calls) + " then " + std::to_string(again);
+                    return false;
+                }
+            }
+            message = std::to_string(calls) + " calls per frame";
+            if (calls == expected)
+                return true;
+            message += ", expected " + std::to_string(expected);
+            return false;
+        }
+
+        /// 每个 draw call 发出时的固定管线状态（从 NullGL 回读）
+        struct DrawState {
+            GLint     depthFunc  = 0;
+            GLboolean depthWrite = GL_FALSE;
+            GLboolean colorWrite = GL_FALSE;
+        };
+        std::vector<DrawState> s_DrawStates;
+
+        void RecordDrawState()
+        {
+            DrawState state;
+            GLboolean color[4] = {};
+            glGetIntegerv(GL_DEPTH_FUNC, &state.depthFunc);
+            glGetBooleanv(GL_DEPTH_WRITEMASK, &state.depthWrite);
+            glGetBooleanv(GL_COLOR_WRITEMASK, color);
+            state.colorWrite = color[0] && color[1] && color[2] && color[3] ? GL_TRUE : GL_FALSE;
+            s_DrawStates.push_back(state);
+        }
+
+        // 与 GLCallCounter 相同的做法：包装 glad 的函数指针，先记录再转发（只挂在 Draw 类入口点上）
+#define PBR_BENCH_PROBE_GL(ret, name, category, params, args, bytes)   \
+        decltype(glad_##name) unprobed_##name = nullptr;               \
+        ret APIENTRY probed_##name params                              \
+        {                                                              \
+            RecordDrawState();                                         \
+            return unprobed_##name args;                               \
+        }
+        PBR_GL_ENTRY_POINTS(PBR_BENCH_PROBE_GL)
+#undef PBR_BENCH_PROBE_GL
+
+        /// 作用域内记录每个 draw call 的状态到 s_DrawStates，析构时还原函数指针
+        class DrawStateProbe {
+        public:
+            DrawStateProbe()
+            {
+                s_DrawStates.clear();
+#define PBR_BENCH_INSTALL_PROBE(ret, name, category, params, args, bytes)                            \
+                if (renderer::GLCallCounter::Category::category == renderer::GLCallCounter::Category::Draw \
+                    && glad_##name)                                                                  \
+                {                                                                                    \
+                    unprobed_##name = glad_##name;                                                   \
+                    glad_##name = probed_##name;                                                     \
+                }
+                PBR_GL_ENTRY_POINTS(PBR_BENCH_INSTALL_PROBE)
+#undef PBR_BENCH_INSTALL_PROBE
+            }
+            ~DrawStateProbe()
+            {
+#define PBR_BENCH_REMOVE_PROBE(ret, name, category, params, args, bytes) \
+                if (unprobed_##name)                                     \
+                {                                                        \
+                    glad_##name = unprobed_##name;                       \
+                    unprobed_##name = nullptr;                           \
+                }
+                PBR_GL_ENTRY_POINTS(PBR_BENCH_REMOVE_PROBE)
+#undef PBR_BENCH_REMOVE_PROBE
+            }
+            DrawStateProbe(const DrawStateProbe&) = delete;
+            DrawStateProbe& operator=(const DrawStateProbe&) = delete;
+        };
+    }
+
+    void RegisterEngineBenchmarks()
+    {
+        // ---- 贴图解码（stb_image，TextureLoader::Decode 即作业线程上执行的部分） ----
+        RegisterDecode("texture/decode_png", kPngPath, false);
+        RegisterDecode("texture/decode_jpg", kJpgPath, false);
+        RegisterDecode("texture/decode_hdr", kHdrPath, true);
+
+        // ---- 几何生成 ----
+        Register("primitives/sphere_geometry", "vertices", []() -> Body {
+            auto geometry = std::make_shared<renderer::Primitives::SphereGeometry>();
+            return [geometry]() {
+                renderer::Primitives::BuildSphereGeometry(*geometry);
+                return geometry->vertices.size() / 8;
+            };
+        });
+
+        // Assimp -> 顶点数组 + LOD 链（Model::processMesh 中不涉及贴图和 GL 的部分）
+        Register("model/convert_mesh_16k", "vertices", []() -> Body {
+            std::shared_ptr<aiMesh> mesh = MakeGridMesh(128);
+            auto vertices = std::make_shared<std::vector<Vertex>>();
+            auto indices = std::make_shared<std::vector<unsigned int>>();
+            auto lods = std::make_shared<std::vector<MeshLod>>();
+            return [mesh, vertices, indices, lods]() {
+                Model::ConvertMesh(mesh.get(), *vertices, *indices, *lods);
+                return vertices->size();
+            };
+        });
+
+        // ---- 矩阵批量更新 ----
+        RegisterTransforms("transforms/update_10k", 10000, true);
+        RegisterTransforms("transforms/update_10k_scalar", 10000, false);
+
+        // ---- 剔除 ----
+        Register("culling/frustum_100k", "objects", []() -> Body {
+            auto culler = std::make_shared<FrustumCuller>();
+            const std::vector<AABB> bounds = RandomBounds(100000, 100.0f, 1234);
+            culler->Reserve(bounds.size());
+            for (const AABB& b : bounds)
+            {
+                BoundingSphere s;
+                s.Center = (b.Min + b.Max) * 0.5f;
+                s.Radius = glm::length(b.Max - s.Center);
+                culler->Add(s, b);
+            }
+            const Frustum frustum = BenchFrustum();
+            return [culler, frustum]() {
+                culler->Cull(frustum);
+                return culler->Size();
+            };
+        });
+
+        Register("culling/bvh_frustum_100k", "objects", []() -> Body {
+            auto bvh = std::make_shared<Bvh>();
+            bvh->Build(RandomBounds(100000, 100.0f, 1234));
+            auto visible = std::make_shared<std::vector<uint32_t>>();
+            const Frustum frustum = BenchFrustum();
+            return [bvh, visible, frustum]() {
+                visible->clear();
+                bvh->QueryFrustum(frustum, *visible);
+                return bvh->ObjectCount();
+            };
+        });
+
+        Register("culling/bvh_build_10k", "objects", []() -> Body {
+            auto bounds = std::make_shared<std::vector<AABB>>(RandomBounds(10000, 50.0f, 42));
+            auto bvh = std::make_shared<Bvh>();
+            return [bvh, bounds]() {
+                bvh->Build(*bounds);
+                return bounds->size();
+            };
+        });
+
+        // ---- 分簇光照 ----
+        RegisterClustering("lights/cluster_1k", 1000, true);
+        RegisterClustering("lights/cluster_1k_serial", 1000, false);
+        RegisterClustering("lights/cluster_10k", 10000, true);
+
+        // ---- GL 提交（NullGL：只有 CPU 端的开销，每次迭代的工作量为发出的 GL 调用数） ----
+        RegisterSceneSubmission("render/pbr_scene_null", 0);
+        RegisterSceneSubmission("render/pbr_scene_1k_null", 1000);
+
+        // 8 × 8 块网格组成的模型，相机斜看过去，一部分块在视锥外
+        Register("render/model_draw_null", "gl calls", []() -> Body {
+            if (!EnsureNullGL())
+                return Body();
+            std::shared_ptr<Model> model = MakeTileModel();
+            auto shader = std::make_shared<Shader>("assets/shaders/modelShader/model.vert",
+                                                   "assets/shaders/modelShader/model.frag");
+            auto camera = std::make_shared<core::Camera>(glm::vec3(40.0f, 15.0f, 110.0f));
+            const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+            return [model, shader, camera, projection]() {
+                renderer::GLCallCounter::BeginFrame();
+                shader->use();
+                model->Draw(*shader, *camera, glm::mat4(1.0f), projection, 720.0f, LodSelector());
+                return static_cast<size_t>(renderer::GLCallCounter::Current().calls);
+            };
+        });
+
+        // ---- IBL 预计算内核（CPU 版本） ----
+        Register("ibl/brdf_lut_32", "samples", []() -> Body {
+            auto lut = std::make_shared<std::vector<glm::vec2>>();
+            return [lut]() {
+                IblKernels::IntegrateBrdfLut(32, 1024, *lut);
+                return lut->size() * 1024;
+            };
+        });
+
+        Register("ibl/irradiance_8", "texels", []() -> Body {
+            utils::TextureLoader::Image hdr = utils::TextureLoader::Decode(kHdrPath, true);
+            if (!hdr.Valid() || hdr.components != 3)
+            {
+                utils::TextureLoader::Free(hdr);
+                return Body();
+            }
+            auto pixels = std::make_shared<std::vector<float>>(static_cast<const float*>(hdr.pixels),
+                                                               static_cast<const float*>(hdr.pixels) + Pixels(hdr) * 3);
+            const int width = hdr.width, height = hdr.height;
+            utils::TextureLoader::Free(hdr);
+            auto irradiance = std::make_shared<std::vector<glm::vec3>>();
+            return [pixels, width, height, irradiance]() {
+                IblKernels::ConvolveIrradiance(pixels->data(), width, height, 8, 0.025f, *irradiance);
+                return irradiance->size();
+            };
+        });
+    }
+
+    void RegisterEngineChecks()
+    {
+        // ---- GL 提交：每帧发出的调用数是确定的，数量变化说明提交路径变了 ----
+        // 有意修改提交路径时更新这里的期望值（--check 的输出里有实际值）
+
+        // 默认场景：天空盒 + 每个材质一个球，没有场景模型
+        RegisterCheck("render/pbr_scene_gl_calls", [](std::string& message) {
+            std::shared_ptr<renderer::PBRRenderer> pbr = MakeSceneRenderer(0);
+            if (!pbr)
+            {
+                message = "scene assets not available";
+                return false;
+            }
+            const core::Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+            return CheckCallsPerFrame([&]() { return SubmitFrame(*pbr, camera); }, 95, message);
+        });
+
+        // 默认场景 + 应用里的程序生成地面，分别走合并绘制和逐 Mesh（meshlet 剔除）两条路径
+        for (bool batched : { true, false })
+        {
+            RegisterCheck(batched ? "render/scene_model_batched_gl_calls" : "render/scene_model_meshlet_gl_calls",
+                          [batched](std::string& message) {
+                std::shared_ptr<renderer::PBRRenderer> pbr = MakeSceneRenderer(0);
+                if (!pbr)
+                {
+                    message = "scene assets not available";
+                    return false;
+                }
+                AddGroundModel(*pbr, batched);
+                const core::Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+                return CheckCallsPerFrame([&]() { return SubmitFrame(*pbr, camera); }, batched ? 127 : 306, message);
+            });
+        }
+
+        // ---- 场景模型在队列执行之后绘制，不能继承天空盒的 GL_LEQUAL / 关闭深度写入 ----
+        // 同一帧先不画模型、再画模型，多出来的末尾几个 draw 就是模型的；它们必须是 GL_LESS、写深度、写颜色
+        for (bool batched : { true, false })
+        {
+            RegisterCheck(batched ? "render/model_depth_state" : "render/model_meshlet_depth_state",
+                          [batched](std::string& message) {
+                std::shared_ptr<renderer::PBRRenderer> pbr = MakeSceneRenderer(0);
+                if (!pbr)
+                {
+                    message = "scene assets not available";
+                    return false;
+                }
+                AddGroundModel(*pbr, batched);
+                const core::Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+                for (unsigned int i = 0; i < renderer::GpuProfiler::LATENCY + 1; ++i)
+                    SubmitFrame(*pbr, camera);
+
+                DrawStateProbe probe;
+                pbr->drawSceneModel = false;
+                SubmitFrame(*pbr, camera);
+                const size_t sceneDraws = s_DrawStates.size();
+                s_DrawStates.clear();
+                pbr->drawSceneModel = true;
+                SubmitFrame(*pbr, camera);
+                if (s_DrawStates.size() <= sceneDraws)
+                {
+                    message = "scene model issued no draw calls";
+                    return false;
+                }
+
+                const size_t modelDraws = s_DrawStates.size() - sceneDraws;
+                for (size_t i = sceneDraws; i < s_DrawStates.size(); ++i)
+                {
+                    const DrawState& state = s_DrawStates[i];
+                    if (state.depthFunc != GL_LESS || !state.depthWrite || !state.colorWrite)
+                    {
+                        char buffer[128];
+                        std::snprintf(buffer, sizeof(buffer),
+                                      "model draw %zu of %zu: depth func 0x%04X, depth write %s, color write %s",
+                                      i - sceneDraws, modelDraws, static_cast<unsigned int>(state.depthFunc),
+                                      state.depthWrite ? "on" : "off", state.colorWrite ? "on" : "off");
+                        message = buffer;
+                        return false;
+                    }
+                }
+                message = std::to_string(modelDraws) + " model draws with GL_LESS and depth write";
+                return true;
+            });
+        }
+
+        // ---- 每帧堆分配：预热之后，应用的默认场景（含地面，两条模型路径）每帧都不应走 operator new ----
+        for (bool batched : { true, false })
+        {
+            RegisterCheck(batched ? "render/scene_zero_alloc" : "render/scene_meshlet_zero_alloc",
+                          [batched](std::string& message) {
+                std::shared_ptr<renderer::PBRRenderer> pbr = MakeSceneRenderer(0);
+                if (!pbr)
+                {
+                    message = "scene assets not available";
+                    return false;
+                }
+                AddGroundModel(*pbr, batched);
+                const core::Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+
+                // 前几帧会建立合并缓冲、扩容各种列表、开始回读 GPU 计时，与 Application 的预热帧数相同
+                for (unsigned int i = 0; i < renderer::GpuProfiler::LATENCY + 1; ++i)
+                    SubmitFrame(*pbr, camera);
+
+                const unsigned int frames = 30;
+                uint64_t total = 0, worst = 0;
+                unsigned int dirtyFrames = 0;
+                for (unsigned int i = 0; i < frames; ++i)
+                {
+                    core::AllocationTracker::BeginFrame();
+                    SubmitFrame(*pbr, camera);
+                    core::AllocationTracker::BeginFrame();
+                    const uint64_t allocations = core::AllocationTracker::LastFrame().allocations;
+                    total += allocations;
+                    worst = std::max(worst, allocations);
+                    dirtyFrames += allocations > 0 ? 1 : 0;
+                }
+                if (total == 0)
+                {
+                    message = "no heap allocations in " + std::to_string(frames) + " frames";
+                    return true;
+                }
+                message = std::to_string(total) + " heap allocations in " + std::to_string(dirtyFrames) + " of "
+                        + std::to_string(frames) + " frames (worst frame " + std::to_string(worst) + ")";
+                return false;
+            });
+        }
+
+        // Model::Draw 单独提交（与 render/model_draw_null 相同的模型和相机）
+        RegisterCheck("render/model_draw_gl_calls", [](std::string& message) {
+            if (!EnsureNullGL())
+            {
+                message = "null GL not available";
+                return false;
+            }
+            std::shared_ptr<Model> model = MakeTileModel();
+            Shader shader("assets/shaders/modelShader/model.vert", "assets/shaders/modelShader/model.frag");
+            const core::Camera camera(glm::vec3(40.0f, 15.0f, 110.0f));
+            const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+            return CheckCallsPerFrame([&]() {
+                renderer::GLCallCounter::BeginFrame();
+                shader.use();
+                model->Draw(shader, camera, glm::mat4(1.0f), projection, 720.0f, LodSelector());
+                return renderer::GLCallCounter::Current().calls;
+            }, 249, message);
+        });
+    }
+
+} // namespace bench
@@ -0,0 +1,139 @@
+#include "IblKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+
+namespace bench {
+
+    namespace {
+        const float PI = 3.14159265359f;
+
+        float RadicalInverseVdC(uint32_t bits)
+        {
+            bits = (bits << 16u) | (bits >> 16u);
+            bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+            bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+            bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+            bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+            return float(bits) * 2.3283064365386963e-10f;
+        }
+
+        // 法线固定为 +Z，切线空间即世界空间（brdf.frag 中 N = (0, 0, 1)）
+        glm::vec3 ImportanceSampleGGX(float u, float v, float roughness)
+        {
+            const float a = roughness * roughness;
+            const float phi = 2.0f * PI * u;
+            const float cosTheta = std::sqrt((1.0f - v) / (1.0f + (a * a - 1.0f) * v));
+            const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+            return glm::vec3(std::cos(phi) * sinTheta, std::sin(phi) * sinTheta, cosTheta);
+        }
+
+        float GeometrySchlickGGX(float NdotV, float roughness)
+        {
+            const float k = (roughness * roughness) / 2.0f;
+            return NdotV / (NdotV * (1.0f - k) + k);
+        }
+
+        glm::vec2 IntegrateBRDF(float NdotV, float roughness, unsigned int sampleCount)
+        {
+            const glm::vec3 V(std::sqrt(1.0f - NdotV * NdotV), 0.0f, NdotV);
+            float A = 0.0f, B = 0.0f;
+            for (unsigned int i = 0; i < sampleCount; ++i)
+            {
+                const glm::vec3 H = ImportanceSampleGGX(float(i) / float(sampleCount), RadicalInverseVdC(i), roughness);
+                const float VdotH = glm::dot(V, H);
+                const glm::vec3 L = glm::normalize(2.0f * VdotH * H - V);
+
+                const float NdotL = std::max(L.z, 0.0f);
+                if (NdotL > 0.0f)
+                {
+                    const float NdotH = std::max(H.z, 0.0f);
+                    const float clampedVdotH = std::max(VdotH, 0.0f);
+                    const float G = GeometrySchlickGGX(std::max(NdotV, 0.0f), roughness) *
+                                    GeometrySchlickGGX(NdotL, roughness);
+                    const float G_Vis = (G * clampedVdotH) / (NdotH * NdotV);
+                    const float Fc = std::pow(1.0f - clampedVdotH, 5.0f);
+                    A += (1.0f - Fc) * G_Vis;
+                    B += Fc * G_Vis;
+                }
+            }
+            return glm::vec2(A, B) / float(sampleCount);
+        }
+
+        // equirectangularToCubemap.frag 的 SampleSphericalMap + 最近点采样
+        glm::vec3 SampleEquirect(const float* pixels, int width, int height, const glm::vec3& dir)
+        {
+            const float u = std::atan2(dir.z, dir.x) * 0.1591f + 0.5f;
+            const float v = std::asin(std::max(-1.0f, std::min(dir.y, 1.0f))) * 0.3183f + 0.5f;
+            const int x = std::min(std::max(static_cast<int>(u * width), 0), width - 1);
+            const int y = std::min(std::max(static_cast<int>(v * height), 0), height - 1);
+            const float* p = pixels + (static_cast<size_t>(y) * width + x) * 3;
+            return glm::vec3(p[0], p[1], p[2]);
+        }
+    }
+
+    void IblKernels::IntegrateBrdfLut(int size, unsigned int sampleCount, std::vector<glm::vec2>& out)
+    {
+        out.resize(static_cast<size_t>(size) * size);
+        for (int y = 0; y < size; ++y)
+        {
+            const float roughness = (y + 0.5f) / size;
+            for (int x = 0; x < size; ++x)
+                out[static_cast<size_t>(y) * size + x] = IntegrateBRDF((x + 0.5f) / size, roughness, sampleCount);
+        }
+    }
+
+    glm::vec3 IblKernels::CubeFaceDirection(int face, float u, float v)
+    {
+        // OpenGL 立方体贴图约定（与 captureViews 的六个 lookAt 对应）
+        switch (face)
+        {
+        case 0:  return glm::vec3( 1.0f,   -v,   -u);
+        case 1:  return glm::vec3(-1.0f,   -v,    u);
+        case 2:  return glm::vec3(    u, 1.0f,    v);
+        case 3:  return glm::vec3(    u, -1.0f,  -v);
+        case 4:  return glm::vec3(    u,   -v, 1.0f);
+        default: return glm::vec3(   -u,   -v, -1.0f);
+        }
+    }
+
+    void IblKernels::ConvolveIrradiance(const float* equirect, int width, int height, int faceSize,
+                                        float sampleDelta, std::vector<glm::vec3>& out)
+    {
+        out.resize(static_cast<size_t>(faceSize) * faceSize * 6);
+        for (int face = 0; face < 6; ++face)
+        {
+            for (int y = 0; y < faceSize; ++y)
+            {
+                for (int x = 0; x < faceSize; ++x)
+                {
+                    const float u = 2.0f * (x + 0.5f) / faceSize - 1.0f;
+                    const float v = 2.0f * (y + 0.5f) / faceSize - 1.0f;
+                    const glm::vec3 N = glm::normalize(CubeFaceDirection(face, u, v));
+
+                    glm::vec3 up(0.0f, 1.0f, 0.0f);
+                    const glm::vec3 right = glm::normalize(glm::cross(up, N));
+                    up = glm::normalize(glm::cross(N, right));
+
+                    glm::vec3 irradiance(0.0f);
+                    float samples = 0.0f;
+                    for (float phi = 0.0f; phi < 2.0f * PI; phi += sampleDelta)
+                    {
+                        const float cosPhi = std::cos(phi), sinPhi = std::sin(phi);
+                        for (float theta = 0.0f; theta < 0.5f * PI; theta += sampleDelta)
+                        {
+                            const float cosTheta = std::cos(theta), sinTheta = std::sin(theta);
+                            const glm::vec3 sampleVec = (sinTheta * cosPhi) * right + (sinTheta * sinPhi) * up + cosTheta * N;
+                            irradiance += SampleEquirect(equirect, width, height, sampleVec) * (cosTheta * sinTheta);
+                            samples += 1.0f;
+                        }
+                    }
+                    out[(static_cast<size_t>(face) * faceSize + y) * faceSize + x] = PI * irradiance / samples;
+                }
+            }
+        }
+    }
+
+} // namespace bench
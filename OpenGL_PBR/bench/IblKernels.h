@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+
+namespace bench {
+
+    /**
+     * IblKernels
+     * ----------
+     * IBL 预计算着色器的 CPU 版本，逐像素与 GPU 版本相同的数学，用于基准测试这些内核本身的开销
+     * （样本数、采样方式改动前后对比），也可以作为核对 GPU 烘焙结果的参考实现：
+     *  - IntegrateBrdfLut：assets/shaders/brdfShader/brdf.frag（split-sum 的 BRDF 积分表）
+     *  - ConvolveIrradiance：assets/shaders/irradianceShader（余弦加权半球卷积），
+     *    环境图直接按等距柱状投影最近点采样（GPU 版本先转换成立方体贴图）
+     */
+    class IblKernels {
+    public:
+        /// size × size 的 LUT，x 轴为 NdotV、y 轴为粗糙度（像素中心），每像素 sampleCount 个 GGX 重要性样本
+        static void IntegrateBrdfLut(int size, unsigned int sampleCount, std::vector<glm::vec2>& out);
+
+        /// 等距柱状 HDR 图（RGB float，width × height）卷积到 6 个 faceSize × faceSize 的立方体面，
+        /// 面顺序与 GL_TEXTURE_CUBE_MAP_POSITIVE_X + i 一致；sampleDelta 为着色器中的角度步长（弧度）
+        static void ConvolveIrradiance(const float* equirect, int width, int height, int faceSize,
+                                       float sampleDelta, std::vector<glm::vec3>& out);
+
+        /// 立方体第 face 面上 (u, v) ∈ [-1, 1]² 处的方向（未归一化）
+        static glm::vec3 CubeFaceDirection(int face, float u, float v);
+    };
+
+} // namespace bench
@@ -0,0 +1,219 @@
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace core {
+
+    namespace {
+
+        // 计数槽：只有所属线程写入（relaxed 的读 + 写），主线程在帧边界读取；
+        // 最后一个槽给超出数量的线程共用，用 fetch_add
+        struct Slot {
+            std::atomic<uint64_t> allocations{ 0 };
+            std::atomic<uint64_t> frees{ 0 };
+            std::atomic<uint64_t> bytes{ 0 };
+            char                  name[32] = {};
+        };
+
+        Slot                      s_Slots[AllocationTracker::MAX_THREADS];
+        std::atomic<unsigned int> s_SlotCount{ 0 };
+
+        // 以下只在主线程的 BeginFrame 里读写
+        AllocationTracker::Counts s_Previous[AllocationTracker::MAX_THREADS];
+        AllocationTracker::Counts s_LastFrame[AllocationTracker::MAX_THREADS];
+        AllocationTracker::Counts s_LastFrameTotal;
+
+        // 常量初始化，operator new 里访问不会触发线程局部变量的动态初始化
+        thread_local Slot* t_Slot = nullptr;
+
+        const unsigned int SHARED_SLOT = AllocationTracker::MAX_THREADS - 1;
+
+        Slot& ThreadSlot()
+        {
+            if (!t_Slot)
+            {
+                const unsigned int index = s_SlotCount.fetch_add(1, std::memory_order_relaxed);
+                t_Slot = &s_Slots[index < SHARED_SLOT ? index : SHARED_SLOT];
+                if (index == SHARED_SLOT)
+                    std::memcpy(t_Slot->name, "Other threads", sizeof("Other threads"));
+            }
+            return *t_Slot;
+        }
+
+        inline void Bump(std::atomic<uint64_t>& counter, uint64_t amount, bool shared)
+        {
+            if (shared)
+                counter.fetch_add(amount, std::memory_order_relaxed);
+            else
+                counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        inline void CountAllocation(size_t size)
+        {
+            Slot& slot = ThreadSlot();
+            const bool shared = &slot == &s_Slots[SHARED_SLOT];
+            Bump(slot.allocations, 1, shared);
+            Bump(slot.bytes, size, shared);
+        }
+
+        inline void CountFree(void* p)
+        {
+            if (!p) return;
+            Slot& slot = ThreadSlot();
+            Bump(slot.frees, 1, &slot == &s_Slots[SHARED_SLOT]);
+        }
+
+        void* Allocate(size_t size)
+        {
+            CountAllocation(size);
+            if (size == 0) size = 1;
+            return std::malloc(size);
+        }
+
+        void* AllocateAligned(size_t size, size_t alignment)
+        {
+            CountAllocation(size);
+            if (size == 0) size = 1;
+#ifdef _MSC_VER
+            return _aligned_malloc(size, alignment);
+#else
+            // aligned_alloc 要求大小是对齐的整数倍
+            return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+        }
+
+        void FreeAligned(void* p)
+        {
+            CountFree(p);
+#ifdef _MSC_VER
+            _aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+
+        AllocationTracker::Counts Load(const Slot& slot)
+        {
+            AllocationTracker::Counts c;
+            c.allocations = slot.allocations.load(std::memory_order_relaxed);
+            c.frees       = slot.frees.load(std::memory_order_relaxed);
+            c.bytes       = slot.bytes.load(std::memory_order_relaxed);
+            return c;
+        }
+
+    } // namespace
+
+    void AllocationTracker::BeginFrame()
+    {
+        s_LastFrameTotal = Counts();
+        const unsigned int count = ThreadCount();
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            const Counts now = Load(s_Slots[i]);
+            Counts& last = s_LastFrame[i];
+            last.allocations = now.allocations - s_Previous[i].allocations;
+            last.frees       = now.frees - s_Previous[i].frees;
+            last.bytes       = now.bytes - s_Previous[i].bytes;
+            s_Previous[i] = now;
+
+            s_LastFrameTotal.allocations += last.allocations;
+            s_LastFrameTotal.frees       += last.frees;
+            s_LastFrameTotal.bytes       += last.bytes;
+        }
+    }
+
+    const AllocationTracker::Counts& AllocationTracker::LastFrame()
+    {
+        return s_LastFrameTotal;
+    }
+
+    unsigned int AllocationTracker::ThreadCount()
+    {
+        const unsigned int count = s_SlotCount.load(std::memory_order_relaxed);
+        return count < MAX_THREADS ? count : MAX_THREADS;
+    }
+
+    const AllocationTracker::Counts& AllocationTracker::LastFrame(unsigned int thread)
+    {
+        static const Counts kEmpty;
+        return thread < ThreadCount() ? s_LastFrame[thread] : kEmpty;
+    }
+
+    const char* AllocationTracker::ThreadName(unsigned int thread)
+    {
+        if (thread >= ThreadCount()) return "?";
+        return s_Slots[thread].name[0] ? s_Slots[thread].name : "Unnamed thread";
+    }
+
+    AllocationTracker::Counts AllocationTracker::ThreadTotal()
+    {
+        return Load(ThreadSlot());
+    }
+
+    void AllocationTracker::SetThreadName(const char* name)
+    {
+        Slot& slot = ThreadSlot();
+        if (&slot == &s_Slots[SHARED_SLOT]) return;
+        const size_t length = std::min(std::strlen(name), sizeof(slot.name) - 1);
+        std::memcpy(slot.name, name, length);
+        slot.name[length] = '\0';
+    }
+
+} // namespace core
+
+// ---- 全局 operator new / delete 的替换版本（整个程序只能有一份） ----
+
+void* operator new(size_t size)
+{
+    if (void* p = core::Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    if (void* p = core::Allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return core::Allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return core::Allocate(size); }
+
+void operator delete(void* p) noexcept { core::CountFree(p); std::free(p); }
+void operator delete[](void* p) noexcept { core::CountFree(p); std::free(p); }
+void operator delete(void* p, size_t) noexcept { core::CountFree(p); std::free(p); }
+void operator delete[](void* p, size_t) noexcept { core::CountFree(p); std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { core::CountFree(p); std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { core::CountFree(p); std::free(p); }
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    if (void* p = core::AllocateAligned(size, static_cast<size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    if (void* p = core::AllocateAligned(size, static_cast<size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return core::AllocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return core::AllocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { core::FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { core::FreeAligned(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { core::FreeAligned(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { core::FreeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { core::FreeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { core::FreeAligned(p); }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+namespace core {
+
+    /**
+     * AllocationTracker
+     * -----------------
+     * 替换全局 operator new / delete（AllocationTracker.cpp），按线程统计堆分配次数、释放次数和分配的字节数，
+     * 每帧汇总一次，用来找出帧循环里的临时分配（每帧的临时数据应该放进 FrameArena）。
+     *  - 每个线程第一次分配时领取一个计数槽，之后只有本线程写入；超过 MAX_THREADS 的线程共用最后一个槽
+     *  - 只统计经 operator new 的分配；malloc（stb_image、ImGui 的默认分配器）不计入
+     *
+     * 用法：
+     *   AllocationTracker::BeginFrame();                      // 每帧开始时在主线程调用（没有作业在执行时）
+     *   AllocationTracker::LastFrame().allocations;           // 上一帧所有线程的分配次数
+     *   const uint64_t before = AllocationTracker::ThreadTotal().allocations;   // 量一段代码
+     */
+    class AllocationTracker {
+    public:
+        static const unsigned int MAX_THREADS = 64;
+
+        struct Counts {
+            uint64_t allocations = 0;
+            uint64_t frees       = 0;
+            uint64_t bytes       = 0;   // 分配的字节数（释放时不知道大小，不扣减）
+        };
+
+        /// 帧边界：把各线程自上次调用以来的增量记为“上一帧”
+        static void BeginFrame();
+
+        /// 上一帧所有线程的合计
+        static const Counts& LastFrame();
+
+        /// 领取过计数槽的线程数，以及每个线程上一帧的增量和名字
+        static unsigned int ThreadCount();
+        static const Counts& LastFrame(unsigned int thread);
+        static const char*   ThreadName(unsigned int thread);
+
+        /// 当前线程自启动以来的累计值
+        static Counts ThreadTotal();
+
+        /// 当前线程在界面上显示的名字（复制，超长截断）
+        static void SetThreadName(const char* name);
+    };
+
+} // namespace core
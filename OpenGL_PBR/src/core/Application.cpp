@@ -1,5 +1,11 @@
 #include "Application.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
 namespace fs = std::filesystem;
 
 void FramebufferSizeCallback(GLFWwindow* window, int width, int height)
@@ -8,64 +14,123 @@ void FramebufferSizeCallback(GLFWwindow* window, int width, int height)
 }
 
 
-Application::Application(int width, int height, const std::string& title)
+Application::Application(int width, int height, const std::string& title, bool headless, bool nullGL)
     : m_ScreenWidth(width),
       m_ScreenHeight(height),
-      m_WindowTitle(title)
+      m_WindowTitle(title),
+      m_Headless(headless || nullGL),
+      m_NullGL(nullGL)
 {
+    core::Profiler::SetThreadName("Main");
+    core::AllocationTracker::SetThreadName("Main");
+    PBR_PROFILE_SCOPE("Startup");
+
     // 1) 初始化窗口 + OpenGL 上下文（此时 GLFW 已经 init 并设置了 error callback）
     InitWindow();
 
-    // 2) 初始化 ImGui
-    InitImGui();
+    // 作业线程：启动阶段的贴图解码和每帧的剔除 / 变换 / 光源分簇都用它并行
+    core::JobSystem::Initialize();
+
+    // 检测 GL 版本和扩展（multi-draw indirect 等），之后各模块据此选择路径
+    if (m_NullGL)
+        renderer::GLExtensions::Init(renderer::NullGL::GetProcAddress);
+    else
+        renderer::GLExtensions::Init(m_Headless ? core::HeadlessContext::GetProcAddress : nullptr);
+    // 统计每帧的 GL 调用（纹理绑定 / draw call / uniform），在 Performance 面板显示
+    renderer::GLCallCounter::Install();
+    // 登记每个缓冲 / 贴图 / 渲染缓冲的大小和创建者，在 Performance 面板按标签汇总
+    renderer::GpuMemory::Install();
+    // --capture-frames：从这里开始录 GL 命令流（资源创建和上传都在后面，录得到）
+    renderer::GLTrace::Install(m_ScreenWidth, m_ScreenHeight);
+
+    // 2) 初始化 ImGui（无窗口模式没有界面）
+    if (!m_Headless)
+        InitImGui();
 
     // 3)扫描 HDR 贴图目录
     ScanHDRDirectory("assets/textures/hdr");
 
     // 4)创建 Camera、InputManager、PBRRenderer...
     m_Camera = std::make_unique<core::Camera>(glm::vec3(0.0f, 0.0f, 3.0f));
-    m_InputManager = std::make_unique<core::InputManager>(m_Window->GetGLFWwindow(), m_Camera.get());
     m_PBRRenderer = std::make_unique<renderer::PBRRenderer>(m_ScreenWidth, m_ScreenHeight);
-
-    // 如果有 HDR 文件，就加载第一个
-    if (!m_HDRIPaths.empty())
+    if (!m_Headless)
     {
-        m_PBRRenderer->InitPBR(m_HDRIPaths[0]);
+        m_InputManager = std::make_unique<core::InputManager>(m_Window->GetGLFWwindow(), m_Camera.get());
+
+        // 左键拾取：通过场景 BVH 做射线查询
+        m_InputManager->SetPickCallback([this](double x, double y) {
+            int picked = m_PBRRenderer->PickObject(x, y, *m_Camera);
+            std::cout << "[Application] Picked object: " << picked << std::endl;
+        });
     }
 
-    // 5) 初始化默认光源
-    if (m_PBRRenderer->lightPositions.empty())
+    // 如果有 HDR 文件，就加载第一个：先在作业线程里解码，和下面的材质贴图解码重叠
+    core::JobCounter hdrDecoded;
+    utils::TextureLoader::Image hdrImage;
+    if (!m_HDRIPaths.empty())
     {
-        m_PBRRenderer->lightPositions = {
-            {-10.0f, 10.0f, 10.0f},
-            {10.0f, 10.0f, 10.0f},
-            {-10.0f, -10.0f, 10.0f},
-            {10.0f, -10.0f, 10.0f}
-        };
-        m_PBRRenderer->lightColors = {
-            {300.0f, 300.0f, 300.0f},
-            {300.0f, 300.0f, 300.0f},
-            {300.0f, 300.0f, 300.0f},
-            {300.0f, 300.0f, 300.0f}
-        };
+        const std::string hdrPath = m_HDRIPaths[0];
+        core::JobSystem::Run([&hdrImage, hdrPath]() {
+            PBR_PROFILE_SCOPE("Decode HDR");
+            hdrImage = utils::TextureLoader::Decode(hdrPath, true);
+        }, &hdrDecoded);
     }
 
-    // 扫描 PBR 材质目录
+    // 5) 默认光源由 PBRRenderer 构造时创建
+
+    // 扫描 PBR 材质目录（LoadAllMaterials 内部并行解码，等待时主线程也会执行上面的 HDR 作业）
     ScanMaterialDirectory("assets/textures/pbr");
+    PBR_PROFILE_SCOPE("Load Assets");
     m_PBRRenderer->LoadAllMaterials(
     m_MaterialNames, 
     std::string("assets/textures/pbr")
 );
+
+    core::JobSystem::Wait(hdrDecoded);
+    if (!m_HDRIPaths.empty())
+    {
+        PBR_PROFILE_SCOPE("InitPBR");
+        m_PBRRenderer->InitPBR(hdrImage);
+    }
+
+    // 6) 场景模型：程序生成的起伏地面，8 × 8 块铺在球的下方和后方，近处的块在视锥外，远处的块降到粗糙 LOD
+    {
+        PBR_PROFILE_SCOPE("Build Ground");
+        m_PBRRenderer->SetSceneModel(Model::CreateGrid(8, 65, 10.0f),
+                                     glm::translate(glm::mat4(1.0f), glm::vec3(-40.0f, -6.0f, -75.0f)));
+    }
 }
 
 Application::~Application()
 {
+    renderer::GLTrace::Finish();
+    core::JobSystem::Shutdown();
+    renderer::GpuProfiler::Shutdown();
+    if (m_Headless)
+    {
+        // 先释放渲染器的 GL 资源，再销毁上下文
+        m_PBRRenderer.reset();
+        m_HeadlessContext.reset();
+        return;
+    }
     CleanupImGui();
     glfwTerminate();
 }
 
 void Application::InitWindow()
 {
+    if (m_NullGL)
+    {
+        if (!renderer::NullGL::Load())
+            std::exit(EXIT_FAILURE);
+        return;
+    }
+    if (m_Headless)
+    {
+        m_HeadlessContext = std::make_unique<core::HeadlessContext>(m_ScreenWidth, m_ScreenHeight);
+        return;
+    }
+
     m_Window = std::make_unique<core::Window>(m_ScreenWidth, m_ScreenHeight, m_WindowTitle);
 
     // 注册帧缓冲大小回调
@@ -117,21 +182,49 @@ void Application::Run()
 {
     while (!m_Window->ShouldClose())
     {
-        // 1) 计算 deltaTime
+        // 1) 计算 deltaTime（即上一帧的耗时）
         float currentTime = static_cast<float>(glfwGetTime());
         float dt = currentTime - m_LastFrameTime;
+        const bool firstFrame = m_LastFrameTime == 0.0f;
         m_LastFrameTime = currentTime;
 
         m_FPS = 1.0f / dt;
         m_FrameTimeMs = dt * 1000.0f;
+        // 第一帧的 dt 包含了整个启动过程，不计入统计
+        if (!firstFrame)
+            UpdateFrameStats(m_FrameTimeMs);
+
+        // 录制 trace 时每帧一个 "Frame" 事件，下面各阶段嵌套其中
+        core::Profiler::MarkFrame();
+        renderer::GLTrace::MarkFrame();
+        // 上一帧的堆分配计数，本帧的临时数据从头开始切
+        core::AllocationTracker::BeginFrame();
+        core::FrameArena::Main().Reset();
+        PBR_PROFILE_SCOPE("Frame");
 
         // 2) 先处理键盘 + “右键按下/松开”状态，让 InputManager 更新自身
-        m_InputManager->ProcessInput(dt);
+        {
+            PBR_PROFILE_SCOPE("Input");
+            m_InputManager->ProcessInput(dt);
+        }
+
+        // 相机路径：回放时上一帧的耗时记入所在的段，再覆盖相机和场景状态；录制时记下本帧将要渲染的状态
+        if (m_PathMode == PathMode::Replaying)
+        {
+            if (m_ReplayFrame > 0)
+                AddReplayFrameTime(m_FrameTimeMs);
+            AdvancePathReplay();
+        }
+        else if (m_PathMode == PathMode::Recording)
+            RecordPathFrame(dt);
 
         // 3) 启动 ImGui 一帧
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+        {
+            PBR_PROFILE_SCOPE("ImGui NewFrame");
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+        }
 
         // 4) 获取 ImGui IO，看它是否要捕获鼠标
         ImGuiIO& io = ImGui::GetIO();
@@ -159,35 +252,458 @@ void Application::Run()
             }
         }
 
-        // 6) 渲染 3D 场景
-        Render();
+        // 6) 渲染 3D 场景（GPU 计时覆盖场景和 ImGui，结果几帧后读回）
+        renderer::GpuProfiler::BeginFrame();
+        {
+            PBR_PROFILE_SCOPE("Render Submission");
+            Render();
+        }
 
         // 7) ImGui 界面
         /*ShowFrameStats();
         ShowSettings();*/
-        ShowControls();
+        {
+            PBR_PROFILE_SCOPE("UI");
+            ShowControls();
+        }
 
         // 8) ImGui 绘制到屏幕
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        {
+            PBR_PROFILE_SCOPE("ImGui Render");
+            ImGui::Render();
+            renderer::GpuScope scope("ImGui");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        renderer::GpuProfiler::EndFrame();
 
         // 9) 交换缓冲、轮询事件
-        m_Window->SwapBuffers();
-        glfwPollEvents();
+        {
+            PBR_PROFILE_SCOPE("Swap");
+            m_Window->SwapBuffers();
+        }
+        {
+            PBR_PROFILE_SCOPE("Poll Events");
+            glfwPollEvents();
+        }
+    }
+}
+
+bool Application::RunHeadless(unsigned int frames)
+{
+    // 回放相机路径时帧数由路径决定
+    const bool replay = m_PathMode == PathMode::Replaying;
+    if (replay)
+        frames = static_cast<unsigned int>(m_CameraPath.Duration() / PATH_TIMESTEP) + 1;
+    std::cout << "[Application] Headless (" << (m_NullGL ? "Null GL" : core::HeadlessContext::BackendName()) << "): rendering "
+              << frames << " frames at " << m_ScreenWidth << "x" << m_ScreenHeight
+              << (replay ? " along " + m_PathFile : std::string()) << std::endl;
+    renderer::RenderTarget target(m_ScreenWidth, m_ScreenHeight);
+
+    // 稳态帧（预热之后）的堆分配：有分配的帧数、单帧最多的次数和第一次出现的帧
+    unsigned int allocatingFrames = 0;
+    uint64_t     maxAllocations = 0;
+    int          firstAllocatingFrame = -1;
+    auto checkAllocations = [&](unsigned int finishedFrame)
+    {
+        core::AllocationTracker::BeginFrame();
+        const uint64_t allocations = core::AllocationTracker::LastFrame().allocations;
+        if (finishedFrame < ALLOCATION_WARMUP_FRAMES || allocations == 0)
+            return;
+        ++allocatingFrames;
+        maxAllocations = std::max(maxAllocations, allocations);
+        if (firstAllocatingFrame < 0)
+            firstAllocatingFrame = static_cast<int>(finishedFrame);
+    };
+
+    unsigned int frame = 0;
+    for (; frame < frames; ++frame)
+    {
+        if (replay && !AdvancePathReplay())
+            break;
+
+        const int64_t frameStart = core::Profiler::NowNs();
+        core::Profiler::MarkFrame();
+        renderer::GLTrace::MarkFrame();
+        if (frame > 0)
+            checkAllocations(frame - 1);
+        else
+            core::AllocationTracker::BeginFrame();
+        core::FrameArena::Main().Reset();
+        {
+            PBR_PROFILE_SCOPE("Frame");
+            renderer::GpuProfiler::BeginFrame();
+            target.Bind();
+            {
+                PBR_PROFILE_SCOPE("Render Submission");
+                Render();
+            }
+            renderer::GpuProfiler::EndFrame();
+
+            // 没有 SwapBuffers 限流，不等 GPU 的话 CPU 会一直往前排队，帧时间只反映提交开销
+            PBR_PROFILE_SCOPE("GPU Finish");
+            glFinish();
+        }
+        m_FrameTimeMs = static_cast<float>(core::Profiler::NowNs() - frameStart) / 1.0e6f;
+        m_FPS = 1000.0f / m_FrameTimeMs;
+        UpdateFrameStats(m_FrameTimeMs);
+        if (replay)
+            AddReplayFrameTime(m_FrameTimeMs);
+        // 第一帧会创建延迟分配的资源（实例缓冲、光源缓冲），之后的增长才算泄漏
+        if (frame == 0)
+            renderer::GpuMemory::TakeSnapshot();
+    }
+    if (frame > 0)
+        checkAllocations(frame - 1);
+    if (m_PathMode == PathMode::Replaying)
+        FinishPathReplay();
+    if (core::Profiler::IsCapturing())
+        core::Profiler::EndCapture();
+
+    const core::FrameStats::Summary stats = m_FrameStats.Compute(0);
+    std::cout << "[Application] Headless frames: " << stats.frames << ", avg " << stats.avgMs
+              << " ms, p50 " << stats.p50Ms << " ms, p95 " << stats.p95Ms << " ms, p99 " << stats.p99Ms
+              << " ms, max " << stats.maxMs << " ms" << std::endl;
+    for (const auto& section : renderer::GpuProfiler::Sections())
+        std::cout << "[Application]   GPU " << std::string(section.depth * 2, ' ') << section.name
+                  << ": " << section.avgMs << " ms" << std::endl;
+
+    PrintGLCallSummary(renderer::GLCallCounter::Current());
+    PrintGpuMemorySummary();
+    if (renderer::GpuMemory::HasSnapshot())
+        renderer::GpuMemory::ExportDiff();
+
+    m_FrameStats.ExportCsv("frame_stats.csv", { 60, 300, 1000, 0 });
+    m_FrameStats.ExportSamplesCsv("frame_times.csv");
+    // Null GL 没有像素可读
+    if (!m_NullGL)
+        target.SavePPM("headless_frame.ppm");
+
+    const unsigned int steadyFrames = frame > ALLOCATION_WARMUP_FRAMES ? frame - ALLOCATION_WARMUP_FRAMES : 0;
+    if (allocatingFrames == 0)
+        std::cout << "[Application] Heap allocations: none in " << steadyFrames << " steady-state frames (arena high water "
+                  << core::FrameArena::Main().HighWater() << " B)" << std::endl;
+    else
+        std::cout << "[Application] Heap allocations: " << allocatingFrames << " of " << steadyFrames
+                  << " steady-state frames allocated (max " << maxAllocations << " per frame, first at frame "
+                  << firstAllocatingFrame << ")" << std::endl;
+    return allocatingFrames == 0;
+}
+
+void Application::PrintGLCallSummary(const renderer::GLCallCounter::Counts& gl)
+{
+    using Category = renderer::GLCallCounter::Category;
+    std::cout << "[Application] GL calls (last frame): " << gl.calls << " total, "
+              << gl.Calls(Category::State) << " state, " << gl.drawCalls << " draws, "
+              << gl.uniforms << " uniforms (" << gl.StateChangesPerDraw() << " state changes per draw)" << std::endl;
+    std::cout << "[Application]   uploads: " << gl.bufferBytes << " B buffers, " << gl.textureBytes
+              << " B textures, " << gl.uniformBytes << " B uniforms" << std::endl;
+    unsigned int top[8];
+    const unsigned int n = renderer::GLCallCounter::TopEntries(gl, top, 8);
+    for (unsigned int i = 0; i < n; ++i)
+        std::cout << "[Application]   " << renderer::GLCallCounter::EntryName(top[i]) << ": " << gl.entries[top[i]] << std::endl;
+}
+
+void Application::PrintGpuMemorySummary()
+{
+    using GpuMemory = renderer::GpuMemory;
+    const GpuMemory::Usage& total = GpuMemory::Total();
+    std::cout << "[Application] GPU memory: " << total.Bytes() / (1024.0 * 1024.0) << " MB in "
+              << total.Count() << " resources" << std::endl;
+    for (unsigned int k = 0; k < GpuMemory::KIND_COUNT; ++k)
+        std::cout << "[Application]   " << GpuMemory::KindName(static_cast<GpuMemory::Kind>(k)) << "s: "
+                  << total.count[k] << ", " << total.bytes[k] / (1024.0 * 1024.0) << " MB" << std::endl;
+    for (const GpuMemory::TagUsage& tag : GpuMemory::ByTag())
+    {
+        if (tag.usage.Count() > 0)
+            std::cout << "[Application]   [" << tag.name << "] " << tag.usage.Count() << " resources, "
+                      << tag.usage.Bytes() / (1024.0 * 1024.0) << " MB" << std::endl;
     }
 }
 
 void Application::Render()
 {
+    renderer::GLCallCounter::BeginFrame();
+    renderer::GpuMemory::BeginFrame();
+
     // 1. 清理颜色和深度缓冲
     glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // 2. 渲染 PBR 场景（或你自己的 3D 渲染逻辑）
+    renderer::GpuScope scope("Scene");
     m_PBRRenderer->RenderPBRScene(*m_Camera);
 }
 
 
+void Application::UpdateFrameStats(float frameMs)
+{
+    m_FrameStats.Add(frameMs);
+    if (!m_SpikeCapture)
+        return;
+
+    // 超阈值的帧刚刚结束；它的 GPU 计时要再过 LATENCY 帧才读回，所以推迟写出。
+    // 倒数期间再出现的尖刺合并到同一个文件里
+    if (frameMs > m_SpikeThresholdMs)
+    {
+        ++m_SpikeCount;
+        if (m_SpikeCountdown < 0)
+        {
+            m_SpikeFrame = m_FrameStats.TotalFrames();
+            m_SpikeCountdown = renderer::GpuProfiler::LATENCY + 1;
+        }
+    }
+    if (m_SpikeCountdown >= 0 && m_SpikeCountdown-- == 0)
+    {
+        const std::string path = "spike_" + std::to_string(m_SpikeFrame) + ".json";
+        if (core::Profiler::DumpRecent(path))
+            m_LastSpikeTrace = path;
+    }
+}
+
+void Application::StartPathRecording()
+{
+    m_CameraPath.Clear();
+    m_CameraPath.AddSegment(0.0f, "Start");
+    m_PathTime = 0.0f;
+    m_PathMode = PathMode::Recording;
+    std::cout << "[Application] Recording camera path" << std::endl;
+}
+
+void Application::StopPathRecording()
+{
+    m_PathMode = PathMode::Off;
+    m_CameraPath.Save(m_PathFile);
+}
+
+void Application::RecordPathFrame(float deltaTime)
+{
+    m_CameraPath.AddCamera(m_PathTime, *m_Camera);
+    m_CameraPath.AddSettings(m_PathTime, CaptureSceneSettings());
+    CaptureSceneLights(m_PathLights);
+    m_CameraPath.AddLights(m_PathTime, m_PathLights);
+    CaptureSphereMaterials(m_PathMaterials);
+    m_CameraPath.AddMaterials(m_PathTime, m_PathMaterials);
+    m_PathTime += deltaTime;
+}
+
+bool Application::LoadSceneModel(const std::string& path)
+{
+    PBR_PROFILE_SCOPE("Load Scene Model");
+    auto model = std::make_unique<Model>(path);
+    if (model->meshes.empty())
+    {
+        std::cerr << "[Application] Failed to load scene model " << path << std::endl;
+        return false;
+    }
+    std::cout << "[Application] Scene model " << path << ": " << model->meshes.size() << " meshes" << std::endl;
+    // 放在球的后方，原点对齐；模型自身的尺度不做归一化
+    m_PBRRenderer->SetSceneModel(std::move(model), glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -2.0f, -6.0f)));
+    return true;
+}
+
+bool Application::StartPathReplay(const std::string& path)
+{
+    if (m_PathMode == PathMode::Recording)
+        StopPathRecording();
+    if (!m_CameraPath.Load(path) || m_CameraPath.Empty())
+        return false;
+
+    m_PathFile = path;
+    m_PathMode = PathMode::Replaying;
+    m_ReplayFrame = 0;
+    m_ReplaySegment = m_ReplaySettings = m_ReplayLights = m_ReplayMaterials = -1;
+    m_ReplaySegmentStats.Clear();
+    m_ReplayTotalStats.Clear();
+    m_ReplayResults.clear();
+
+    // 关闭垂直同步，否则帧时间被钉在刷新间隔上
+    if (!m_Headless)
+        glfwSwapInterval(0);
+    return true;
+}
+
+bool Application::AdvancePathReplay()
+{
+    const float t = m_ReplayFrame * PATH_TIMESTEP;
+    if (t > m_CameraPath.Duration())
+    {
+        FinishPathReplay();
+        return false;
+    }
+
+    const int segment = m_CameraPath.SegmentIndexAt(t);
+    if (segment != m_ReplaySegment)
+    {
+        FlushReplaySegment();
+        m_ReplaySegment = segment;
+    }
+
+    m_CameraPath.SampleCamera(t, *m_Camera);
+
+    // 快照只在切换到新的一条时应用（改基准球数等操作会重建场景）
+    const int settings = m_CameraPath.SettingsIndexAt(t);
+    if (settings >= 0 && settings != m_ReplaySettings)
+        ApplySceneSettings(m_CameraPath.Settings()[settings].settings);
+    const int lights = m_CameraPath.LightsIndexAt(t);
+    if (lights >= 0 && lights != m_ReplayLights)
+    {
+        const core::CameraPath::LightsKey& key = m_CameraPath.LightKeys()[lights];
+        ApplySceneLights(m_CameraPath.Lights().data() + key.first, key.count);
+    }
+    const int materials = m_CameraPath.MaterialsIndexAt(t);
+    if (materials >= 0 && materials != m_ReplayMaterials)
+    {
+        const core::CameraPath::MaterialsKey& key = m_CameraPath.MaterialKeys()[materials];
+        ApplySphereMaterials(m_CameraPath.Materials().data() + key.first, key.count);
+    }
+    m_ReplaySettings = settings;
+    m_ReplayLights = lights;
+    m_ReplayMaterials = materials;
+
+    ++m_ReplayFrame;
+    return true;
+}
+
+void Application::AddReplayFrameTime(float frameMs)
+{
+    m_ReplaySegmentStats.Add(frameMs);
+    m_ReplayTotalStats.Add(frameMs);
+}
+
+void Application::FlushReplaySegment()
+{
+    if (m_ReplaySegmentStats.Count() == 0)
+        return;
+    const auto& segments = m_CameraPath.Segments();
+    ReplaySegmentResult result;
+    result.name = m_ReplaySegment >= 0 ? segments[m_ReplaySegment].name : std::string("Path");
+    result.stats = m_ReplaySegmentStats.Compute(0);
+    m_ReplayResults.push_back(result);
+    m_ReplaySegmentStats.Clear();
+}
+
+void Application::FinishPathReplay()
+{
+    FlushReplaySegment();
+    m_PathMode = PathMode::Off;
+    if (!m_Headless)
+        glfwSwapInterval(1);
+
+    ReplaySegmentResult total;
+    total.name = "Total";
+    total.stats = m_ReplayTotalStats.Compute(0);
+
+    FILE* file = std::fopen("replay_report.csv", "w");
+    if (file)
+        std::fputs("segment,frames,avg_ms,p50_ms,p95_ms,p99_ms,max_ms\n", file);
+    std::cout << "[Application] Replay of " << m_PathFile << " finished (" << m_ReplayFrame << " frames)" << std::endl;
+    std::vector<const ReplaySegmentResult*> rows;
+    for (const ReplaySegmentResult& result : m_ReplayResults)
+        rows.push_back(&result);
+    rows.push_back(&total);
+    for (const ReplaySegmentResult* row : rows)
+    {
+        const core::FrameStats::Summary& s = row->stats;
+        std::printf("[Application]   %-16s %6zu frames  avg %7.3f  p50 %7.3f  p95 %7.3f  p99 %7.3f  max %7.3f ms\n",
+                    row->name.c_str(), s.frames, s.avgMs, s.p50Ms, s.p95Ms, s.p99Ms, s.maxMs);
+        if (file)
+            std::fprintf(file, "%s,%zu,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                         row->name.c_str(), s.frames, s.avgMs, s.p50Ms, s.p95Ms, s.p99Ms, s.maxMs);
+    }
+    if (file)
+        std::fclose(file);
+    std::fflush(stdout);
+    m_ReplayResults.push_back(total);
+}
+
+core::CameraPath::SceneSettings Application::CaptureSceneSettings() const
+{
+    using Path = core::CameraPath;
+    const renderer::PBRRenderer& r = *m_PBRRenderer;
+    Path::SceneSettings settings;
+    settings.exposure         = r.exposure;
+    settings.gamma            = r.gamma;
+    settings.benchmarkSpheres = r.GetBenchmarkSphereCount();
+    settings.benchmarkLights  = r.GetBenchmarkLightCount();
+    settings.flags = (r.useInstancing ? Path::FLAG_INSTANCING : 0u) |
+                     (r.useBindless ? Path::FLAG_BINDLESS : 0u) |
+                     (r.useDeferred ? Path::FLAG_DEFERRED : 0u) |
+                     (r.useDepthPrepass ? Path::FLAG_DEPTH_PREPASS : 0u) |
+                     (r.sortFrontToBack ? Path::FLAG_FRONT_TO_BACK : 0u) |
+                     (r.enableLod ? Path::FLAG_LOD : 0u) |
+                     (r.enableFrustumCulling ? Path::FLAG_FRUSTUM_CULLING : 0u) |
+                     (r.useBvhCulling ? Path::FLAG_BVH_CULLING : 0u);
+    return settings;
+}
+
+void Application::ApplySceneSettings(const core::CameraPath::SceneSettings& settings)
+{
+    using Path = core::CameraPath;
+    renderer::PBRRenderer& r = *m_PBRRenderer;
+    r.exposure             = settings.exposure;
+    r.gamma                = settings.gamma;
+    r.useInstancing        = (settings.flags & Path::FLAG_INSTANCING) != 0;
+    r.useBindless          = (settings.flags & Path::FLAG_BINDLESS) != 0;
+    r.useDeferred          = (settings.flags & Path::FLAG_DEFERRED) != 0;
+    r.useDepthPrepass      = (settings.flags & Path::FLAG_DEPTH_PREPASS) != 0;
+    r.sortFrontToBack      = (settings.flags & Path::FLAG_FRONT_TO_BACK) != 0;
+    r.enableLod            = (settings.flags & Path::FLAG_LOD) != 0;
+    r.enableFrustumCulling = (settings.flags & Path::FLAG_FRUSTUM_CULLING) != 0;
+    r.useBvhCulling        = (settings.flags & Path::FLAG_BVH_CULLING) != 0;
+    if (r.GetBenchmarkSphereCount() != settings.benchmarkSpheres)
+        r.SetBenchmarkSphereCount(settings.benchmarkSpheres);
+    if (r.GetBenchmarkLightCount() != settings.benchmarkLights)
+        r.SetBenchmarkLightCount(settings.benchmarkLights);
+}
+
+void Application::CaptureSceneLights(std::vector<renderer::Light>& lights) const
+{
+    lights.clear();
+    const renderer::LightManager& manager = m_PBRRenderer->GetLightManager();
+    m_PBRRenderer->ForEachSceneLight([&](Entity, renderer::LightHandle handle) {
+        lights.push_back(manager.Get(handle));
+    });
+}
+
+void Application::ApplySceneLights(const renderer::Light* lights, size_t count)
+{
+    // 数量不同时先增删光源实体，再按顺序覆盖参数
+    std::vector<Entity> entities;
+    m_PBRRenderer->ForEachSceneLight([&](Entity entity, renderer::LightHandle) { entities.push_back(entity); });
+    while (entities.size() > count)
+    {
+        m_PBRRenderer->RemoveSceneLight(entities.back());
+        entities.pop_back();
+    }
+    for (size_t i = entities.size(); i < count; ++i)
+        m_PBRRenderer->AddSceneLight(lights[i]);
+
+    renderer::LightManager& manager = m_PBRRenderer->GetLightManager();
+    size_t i = 0;
+    m_PBRRenderer->ForEachSceneLight([&](Entity, renderer::LightHandle handle) {
+        if (i < count)
+            manager.Set(handle, lights[i++]);
+    });
+}
+
+void Application::CaptureSphereMaterials(std::vector<int32_t>& materials) const
+{
+    materials.resize(static_cast<size_t>(m_PBRRenderer->GetSphereCount()));
+    for (size_t i = 0; i < materials.size(); ++i)
+        materials[i] = m_PBRRenderer->GetSphereMaterialIndex(static_cast<int>(i));
+}
+
+void Application::ApplySphereMaterials(const int32_t* materials, size_t count)
+{
+    // 球数由基准设置决定，已先于材质应用；多出或缺少的球保持原样
+    const size_t spheres = static_cast<size_t>(m_PBRRenderer->GetSphereCount());
+    for (size_t i = 0; i < count && i < spheres; ++i)
+    {
+        if (m_PBRRenderer->GetSphereMaterialIndex(static_cast<int>(i)) != materials[i])
+            m_PBRRenderer->SetSphereMaterialIndex(static_cast<int>(i), materials[i]);
+    }
+}
+
 void Application::ShowFrameStats()
 {
     // 你可以给窗口加 ImGuiWindowFlags_Resizable，以保证它可以手动调整大小
@@ -218,37 +734,8 @@ void Application::ShowSettings()
         m_PBRRenderer->gamma = g;
     }
 
-    // 2) 遍历所有光源，让用户修改位置和颜色
-    for (int i = 0; i < (int)m_PBRRenderer->lightPositions.size(); ++i)
-    {
-        std::string prefix = "Light " + std::to_string(i) + ":  ";
-
-        // 位置
-        {
-            glm::vec3& pos = m_PBRRenderer->lightPositions[i];
-            std::string label = prefix + "Position";
-            if (ImGui::DragFloat3(label.c_str(), &pos.x, 0.1f, -20.0f, 20.0f))
-            {
-                // 只要用户拖动，就会修改 pos.x/y/z，PBRRenderer::RenderPBRScene() 会自动使用新值
-            }
-        }
-
-        // 颜色（HDR 值，可以用 ColorEdit3）
-        {
-            glm::vec3& col = m_PBRRenderer->lightColors[i];
-            std::string label = prefix + "Color";
-            // ImGui 的 ColorEdit3 默认把值 clamp 到 [0,1]，如果你要 >1 的 HDR 亮度，可以先除 300 再乘回来，或者用 DragFloat3
-            float tmp[3] = {col.r / 300.0f, col.g / 300.0f, col.b / 300.0f};
-            if (ImGui::ColorEdit3(label.c_str(), tmp))
-            {
-                col.r = tmp[0] * 300.0f;
-                col.g = tmp[1] * 300.0f;
-                col.b = tmp[2] * 300.0f;
-            }
-        }
-
-        ImGui::Separator();
-    }
+    // 2) 遍历所有光源，让用户修改
+    ShowLightEditor();
 
     ImGui::End();
 
@@ -267,6 +754,74 @@ void Application::ShowSettings()
 }
 
 // 将 FPS/FrameTime + Lighting 设置 + Camera 设置，全部放到同一个 ImGui 窗口里
+void Application::ShowGpuMemory()
+{
+    using GpuMemory = renderer::GpuMemory;
+    const GpuMemory::Usage& total = GpuMemory::Total();
+    const double MB = 1024.0 * 1024.0;
+    ImGui::Text("GPU Memory: %.1f MB in %u resources (estimate)", total.Bytes() / MB, total.Count());
+    if (!ImGui::TreeNode("GPU Memory"))
+        return;
+
+    for (unsigned int k = 0; k < GpuMemory::KIND_COUNT; ++k)
+        ImGui::Text("%-14s %5u  %8.2f MB", GpuMemory::KindName(static_cast<GpuMemory::Kind>(k)),
+                    total.count[k], total.bytes[k] / MB);
+    ImGui::Separator();
+    for (const GpuMemory::TagUsage& tag : GpuMemory::ByTag())
+    {
+        if (tag.usage.Count() == 0) continue;
+        ImGui::Text("%-14s %5u  %8.2f MB  (tex %.2f, buf %.2f, rb %.2f)", tag.name, tag.usage.Count(),
+                    tag.usage.Bytes() / MB,
+                    tag.usage.bytes[static_cast<unsigned int>(GpuMemory::Kind::Texture)] / MB,
+                    tag.usage.bytes[static_cast<unsigned int>(GpuMemory::Kind::Buffer)] / MB,
+                    tag.usage.bytes[static_cast<unsigned int>(GpuMemory::Kind::Renderbuffer)] / MB);
+    }
+    // 每帧都有创建 / 释放说明有资源没有复用
+    const GpuMemory::Churn& churn = GpuMemory::LastFrameChurn();
+    ImGui::Text("Last frame: +%u / -%u resources, %.1f KB allocated, %.1f KB freed",
+                churn.created, churn.deleted, churn.allocatedBytes / 1024.0, churn.freedBytes / 1024.0);
+
+    if (ImGui::Button("Take Snapshot"))
+    {
+        GpuMemory::TakeSnapshot();
+        m_GpuMemoryDiff = GpuMemory::Diff();
+    }
+    ImGui::SameLine();
+    if (!GpuMemory::HasSnapshot())
+        ImGui::TextDisabled("Export Diff");
+    else if (ImGui::Button("Export Diff"))
+        m_GpuMemoryDiff = GpuMemory::ExportDiff();
+    if (m_GpuMemoryDiff.added + m_GpuMemoryDiff.removed + m_GpuMemoryDiff.resized > 0)
+        ImGui::Text("Diff: +%u / -%u resources, %u resized, %+.2f MB", m_GpuMemoryDiff.added,
+                    m_GpuMemoryDiff.removed, m_GpuMemoryDiff.resized, m_GpuMemoryDiff.deltaBytes / MB);
+    ImGui::TreePop();
+}
+
+void Application::ShowHeapAllocations()
+{
+    using core::AllocationTracker;
+    const AllocationTracker::Counts& total = AllocationTracker::LastFrame();
+    ImGui::Text("Heap: %llu allocs / %llu frees, %.1f KB last frame",
+                static_cast<unsigned long long>(total.allocations),
+                static_cast<unsigned long long>(total.frees), total.bytes / 1024.0);
+    if (!ImGui::TreeNode("Heap Allocations"))
+        return;
+
+    // 稳定运行时各行都应该是 0，不是 0 的线程就是还有临时分配没挪进 FrameArena 的地方
+    for (unsigned int i = 0; i < AllocationTracker::ThreadCount(); ++i)
+    {
+        const AllocationTracker::Counts& thread = AllocationTracker::LastFrame(i);
+        ImGui::Text("%-18s %6llu allocs  %6llu frees  %8.1f KB", AllocationTracker::ThreadName(i),
+                    static_cast<unsigned long long>(thread.allocations),
+                    static_cast<unsigned long long>(thread.frees), thread.bytes / 1024.0);
+    }
+    ImGui::Separator();
+    const core::FrameArena& arena = core::FrameArena::Main();
+    ImGui::Text("Frame Arena: %.1f / %.1f KB (high water %.1f KB, %u overflows)",
+                arena.Used() / 1024.0, arena.Capacity() / 1024.0, arena.HighWater() / 1024.0, arena.Overflows());
+    ImGui::TreePop();
+}
+
 void Application::ShowControls()
 {
     // 可以在第一次打开时指定一个初始大小
@@ -279,8 +834,334 @@ void Application::ShowControls()
     if (ImGui::CollapsingHeader("Performance", ImGuiTreeNodeFlags_DefaultOpen))
     {
         // “默认展开”（ImGuiTreeNodeFlags_DefaultOpen）可以去掉，改成默认收起
-        ImGui::Text("FPS: %.1f", m_FPS);
+        static const size_t FRAME_STATS_WINDOWS[] = { 60, 300, 1000, 0 };   // 0 = 全部保存的帧
+        const size_t window = FRAME_STATS_WINDOWS[m_FrameStatsWindow];
+        const core::FrameStats::Summary stats = m_FrameStats.Compute(window);
+
+        ImGui::Text("FPS: %.1f (avg %.1f)", m_FPS, stats.avgFps);
         ImGui::Text("Frame Time: %.2f ms", m_FrameTimeMs);
+        ImGui::Combo("Stats Window", &m_FrameStatsWindow, "60 frames\0" "300 frames\0" "1000 frames\0" "All\0");
+        ImGui::Text("avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms",
+                    stats.avgMs, stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs);
+
+        // 帧时间曲线（纵轴上限取 p99 的两倍，偶发的大尖刺不会把其余部分压扁）和直方图
+        const float graphMax = std::max(16.7f, static_cast<float>(stats.p99Ms) * 2.0f);
+        m_FrameStats.Recent(window ? window : m_FrameStats.Count(), m_FrameGraph);
+        if (!m_FrameGraph.empty())
+            ImGui::PlotLines("##FrameTimes", m_FrameGraph.data(), static_cast<int>(m_FrameGraph.size()), 0,
+                             nullptr, 0.0f, graphMax, ImVec2(0.0f, 60.0f));
+        m_FrameStats.Histogram(window, graphMax, m_FrameHistogram);
+        char histogramLabel[32];
+        std::snprintf(histogramLabel, sizeof(histogramLabel), "0 - %.0f ms", graphMax);
+        ImGui::PlotHistogram("##FrameHistogram", m_FrameHistogram.data(), static_cast<int>(m_FrameHistogram.size()), 0,
+                             histogramLabel, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+
+        if (ImGui::Button("Export CSV"))
+        {
+            m_FrameStats.ExportCsv("frame_stats.csv", { 60, 300, 1000, 0 });
+            m_FrameStats.ExportSamplesCsv("frame_times.csv");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset Stats"))
+            m_FrameStats.Clear();
+
+        // 尖刺捕获：保持滚动录制，超阈值的帧连同前后几帧写成 trace
+        if (ImGui::Checkbox("Spike Capture", &m_SpikeCapture))
+        {
+            core::Profiler::SetRollingWindow(m_SpikeCapture ? renderer::GpuProfiler::LATENCY + 3 : 0);
+            m_SpikeCountdown = -1;
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::SliderFloat("Threshold (ms)", &m_SpikeThresholdMs, 5.0f, 200.0f, "%.1f");
+        if (m_SpikeCapture || m_SpikeCount > 0)
+            ImGui::Text("Spikes: %u%s%s", m_SpikeCount,
+                        m_LastSpikeTrace.empty() ? "" : ", last: ", m_LastSpikeTrace.c_str());
+
+        // CPU + GPU 时间线录制，写出 Chrome trace JSON（chrome://tracing 或 Perfetto 打开）
+        if (core::Profiler::IsCapturing())
+        {
+            ImGui::Text("Capturing trace... %u frames", core::Profiler::CapturedFrames());
+            ImGui::SameLine();
+            if (ImGui::Button("Stop"))
+                core::Profiler::EndCapture();
+        }
+        else
+        {
+            ImGui::SliderInt("Trace Frames", &m_TraceFrames, 1, 1000);
+            if (ImGui::Button("Capture Trace"))
+                core::Profiler::BeginCapture(static_cast<unsigned int>(m_TraceFrames), "trace.json");
+        }
+        const core::Profiler::CaptureInfo& trace = core::Profiler::LastCapture();
+        if (trace.written)
+        {
+            ImGui::SameLine();
+            ImGui::Text("%s: %zu events, %u frames", trace.path.c_str(), trace.events, trace.frames);
+        }
+
+        // GPU 各阶段耗时（时间戳查询，延迟 GpuProfiler::LATENCY 帧读回）：平均 / 最近 / 最大
+        ImGui::Checkbox("GPU Timers", &renderer::GpuProfiler::enabled);
+        if (renderer::GpuProfiler::DroppedFrames() > 0)
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%u frames not ready)", renderer::GpuProfiler::DroppedFrames());
+        }
+        for (const auto& section : renderer::GpuProfiler::Sections())
+        {
+            const char* label = core::FrameArena::Main().Format("%*s%s", section.depth * 2, "", section.name.c_str());
+            if (section.seen)
+                ImGui::Text("%-22s %6.3f ms  (last %.3f, max %.3f)", label, section.avgMs, section.lastMs, section.maxMs);
+            else
+                ImGui::TextDisabled("%-22s %6.3f ms", label, section.avgMs);
+        }
+        if (!renderer::GpuProfiler::BakeTimings().empty() && ImGui::TreeNode("IBL Bake (GPU)"))
+        {
+            for (const auto& bake : renderer::GpuProfiler::BakeTimings())
+                ImGui::Text("%*s%-20s %8.3f ms", bake.depth * 2, "", bake.name.c_str(), bake.ms);
+            ImGui::TreePop();
+        }
+
+        // LOD 设置与提交的球体索引数
+        ImGui::Checkbox("Enable LOD", &m_PBRRenderer->enableLod);
+        ImGui::SliderFloat("LOD0 Screen Size", &m_PBRRenderer->lodSelector.lod0ScreenSize, 16.0f, 1024.0f, "%.0f px");
+        ImGui::SliderFloat("LOD Hysteresis", &m_PBRRenderer->lodSelector.hysteresis, 0.0f, 0.5f);
+        ImGui::SliderFloat("LOD Bias", &m_PBRRenderer->lodSelector.bias, -2.0f, 2.0f);
+        ImGui::Text("Sphere Indices: %u", m_PBRRenderer->GetSubmittedSphereIndices());
+
+        // 场景模型：与球共用上面的 LOD 设置；合并路径和逐 Mesh 路径各自有统计
+        if (const Model* model = m_PBRRenderer->GetSceneModel())
+        {
+            ImGui::Checkbox("Draw Scene Model", &m_PBRRenderer->drawSceneModel);
+            ImGui::Checkbox("Batch Scene Model", &m_PBRRenderer->batchSceneModel);
+            if (m_PBRRenderer->batchSceneModel)
+            {
+                const ModelBatch::Stats batch = model->GetBatchStats();
+                ImGui::Text("Model Draws: %u / %u visible in %u call(s)%s", batch.visibleDraws, batch.totalDraws,
+                            batch.apiCalls, batch.indirect ? " (indirect)" : "");
+            }
+            else
+            {
+                const Model::LodStats& lod = model->GetLodStats();
+                ImGui::Text("Model Meshes per LOD:");
+                for (unsigned int i = 0; i < MESH_LOD_COUNT; ++i)
+                {
+                    ImGui::SameLine();
+                    ImGui::Text("%u", lod.meshes[i]);
+                }
+                ImGui::Text("Model Indices: %u", lod.indices);
+
+                ImGui::Checkbox("Meshlet Culling", &m_PBRRenderer->sceneModelMeshletCulling);
+                const MeshletCuller::Stats& meshlets = model->GetMeshletStats();
+                ImGui::Text("Meshlets: %u / %u visible, %u ranges", meshlets.visibleMeshlets, meshlets.totalMeshlets,
+                            meshlets.drawRanges);
+                ImGui::Text("Meshlet Triangles: %u / %u", meshlets.visibleTriangles, meshlets.totalTriangles);
+            }
+        }
+
+        // 视锥剔除统计
+        const FrustumCuller::Stats& cull = m_PBRRenderer->GetCullStats();
+        ImGui::Checkbox("Frustum Culling", &m_PBRRenderer->enableFrustumCulling);
+        ImGui::Text("Visible Objects: %u / %u (%.3f ms)", cull.visible, cull.tested, cull.cullMs);
+        // 场景模型的逐 Mesh 剔除（在 Model::Draw 内部，始终开启；合并路径的剔除结果见上面的 Model Draws）
+        const Model* model = m_PBRRenderer->GetSceneModel();
+        if (model && !m_PBRRenderer->batchSceneModel)
+        {
+            const FrustumCuller::Stats& meshCull = model->GetCullStats();
+            ImGui::Text("Visible Model Meshes: %u / %u (%.3f ms)", meshCull.visible, meshCull.tested, meshCull.cullMs);
+        }
+
+        // 剔除微基准：在 CPU 上测试随机物体，给出每毫秒可测试的物体数
+        ImGui::SliderInt("Bench Objects", &m_CullBenchObjects, 1000, 1000000, "%d", ImGuiSliderFlags_Logarithmic);
+        if (ImGui::Button("Run Culling Benchmark"))
+        {
+            m_CullBenchResult = FrustumCuller::Benchmark(static_cast<size_t>(m_CullBenchObjects), 20);
+            std::cout << "[Application] Frustum culling: " << m_CullBenchResult << " objects/ms" << std::endl;
+        }
+        if (m_CullBenchResult > 0.0)
+        {
+            ImGui::SameLine();
+            ImGui::Text("%.0f objects/ms", m_CullBenchResult);
+        }
+
+        // 世界 / 法线矩阵：只重算变化过的物体，SIMD 批量计算
+        const TransformBatch::Stats& transforms = m_PBRRenderer->GetTransformStats();
+        ImGui::Text("Transforms: %u / %u recomputed, %u uniform-scale (%.3f ms)",
+                    transforms.updated, transforms.objects, transforms.uniform, transforms.updateMs);
+        if (ImGui::Button("Run Transform Benchmark"))
+        {
+            m_TransformBenchResults.clear();
+            for (size_t n : { size_t(10000), size_t(100000), size_t(1000000) })
+            {
+                TransformBatch::BenchmarkResult r = TransformBatch::Benchmark(n, 10);
+                std::cout << "[Application] Transforms " << r.objects << " objects: SIMD " << r.simdPerSec / 1e6
+                          << " M/s, scalar " << r.scalarPerSec / 1e6 << " M/s, glm " << r.glmPerSec / 1e6
+                          << " M/s" << std::endl;
+                m_TransformBenchResults.push_back(r);
+            }
+        }
+        for (const auto& r : m_TransformBenchResults)
+        {
+            ImGui::Text("%7zu: SIMD %.1f M/s, scalar %.1f M/s, glm %.1f M/s",
+                        r.objects, r.simdPerSec / 1e6, r.scalarPerSec / 1e6, r.glmPerSec / 1e6);
+        }
+
+        // BVH：层次化剔除 + 鼠标拾取
+        ImGui::Checkbox("BVH Culling", &m_PBRRenderer->useBvhCulling);
+        Entity picked = m_PBRRenderer->GetPickedEntity();
+        if (picked.IsNull())
+            ImGui::Text("Picked: none (left click in scene)");
+        else if (m_PBRRenderer->IsSceneLight(picked))
+            ImGui::Text("Picked: Light (entity %u)", picked.index);
+        else
+            ImGui::Text("Picked: Sphere %d (entity %u)", m_PBRRenderer->GetSphereIndex(picked), picked.index);
+
+        if (ImGui::Button("Run BVH Benchmark"))
+        {
+            m_BvhBenchResults.clear();
+            for (size_t n : { size_t(10000), size_t(100000), size_t(1000000) })
+            {
+                Bvh::BenchmarkResult r = Bvh::Benchmark(n);
+                std::cout << "[Application] BVH " << r.objects << " objects: build " << r.buildMs
+                          << " ms, refit " << r.refitMs << " ms, frustum " << r.frustumMs
+                          << " ms, ray " << r.rayMs << " ms" << std::endl;
+                m_BvhBenchResults.push_back(r);
+            }
+        }
+        for (const auto& r : m_BvhBenchResults)
+        {
+            ImGui::Text("%7zu: build %.1f ms, refit %.2f ms, frustum %.3f ms, ray %.4f ms",
+                        r.objects, r.buildMs, r.refitMs, r.frustumMs, r.rayMs);
+        }
+
+        // 实例化绘制 + 基准场景
+        ImGui::Checkbox("Instanced Spheres", &m_PBRRenderer->useInstancing);
+        if (renderer::GLExtensions::HasBindlessTexture())
+            ImGui::Checkbox("Bindless Textures", &m_PBRRenderer->useBindless);
+        else
+            ImGui::TextDisabled("Bindless Textures: not supported");
+        ImGui::Checkbox("Deferred Shading", &m_PBRRenderer->useDeferred);
+
+        // 深度预通道 + 由近到远排序：比较着色样本数（遮挡查询，延迟几帧）
+        ImGui::Checkbox("Depth Pre-pass", &m_PBRRenderer->useDepthPrepass);
+        ImGui::SameLine();
+        ImGui::Checkbox("Front-to-back", &m_PBRRenderer->sortFrontToBack);
+        const renderer::PBRRenderer::OverdrawStats& overdraw = m_PBRRenderer->GetOverdrawStats();
+        if (overdraw.depthSamples > 0 && overdraw.shadedSamples > 0)
+        {
+            const double saved = 1.0 - static_cast<double>(overdraw.shadedSamples) / overdraw.depthSamples;
+            ImGui::Text("Shaded Samples: %llu of %llu (%.1f%% saved, overdraw %.2fx)",
+                        (unsigned long long)overdraw.shadedSamples, (unsigned long long)overdraw.depthSamples,
+                        saved * 100.0, static_cast<double>(overdraw.depthSamples) / overdraw.shadedSamples);
+        }
+        else if (overdraw.shadedSamples > 0)
+            ImGui::Text("Shaded Samples: %llu", (unsigned long long)overdraw.shadedSamples);
+        static const char* kSpherePaths[] = { "per-sphere binds", "texture arrays", "bindless", "deferred" };
+        ImGui::Text("Sphere Path: %s", kSpherePaths[static_cast<int>(m_PBRRenderer->GetSpherePath())]);
+        const renderer::GLCallCounter::Counts& gl = renderer::GLCallCounter::LastFrame();
+        ImGui::Text("GL: %u binds, %u active tex, %u draws, %u uniforms, %u programs",
+                    gl.textureBinds, gl.activeTextures, gl.drawCalls, gl.uniforms, gl.programBinds);
+        ImGui::Text("GL Calls: %u (%u state, %.2f per draw)", gl.calls,
+                    gl.Calls(renderer::GLCallCounter::Category::State), gl.StateChangesPerDraw());
+        ImGui::Text("GL Uploads: %.1f KB buffers, %.1f KB textures, %.1f KB uniforms",
+                    gl.bufferBytes / 1024.0, gl.textureBytes / 1024.0, gl.uniformBytes / 1024.0);
+        if (ImGui::TreeNode("GL Entry Points"))
+        {
+            for (unsigned int c = 0; c < renderer::GLCallCounter::CATEGORY_COUNT; ++c)
+            {
+                const auto category = static_cast<renderer::GLCallCounter::Category>(c);
+                if (gl.Calls(category) > 0)
+                    ImGui::Text("%-15s %u", renderer::GLCallCounter::CategoryName(category), gl.Calls(category));
+            }
+            ImGui::Separator();
+            unsigned int top[16];
+            const unsigned int n = renderer::GLCallCounter::TopEntries(gl, top, 16);
+            for (unsigned int i = 0; i < n; ++i)
+                ImGui::Text("%-30s %u", renderer::GLCallCounter::EntryName(top[i]), gl.entries[top[i]]);
+            ImGui::TreePop();
+        }
+        ShowGpuMemory();
+        ShowHeapAllocations();
+        ImGui::Text("Sphere Draw Calls: %u (%.3f ms CPU)",
+                    m_PBRRenderer->GetSphereDrawCalls(), m_PBRRenderer->GetSphereSubmitMs());
+        // 渲染队列 + 状态缓存：排序后相邻包的重复状态调用被跳过
+        const renderer::GLStateCache::Stats& state = m_PBRRenderer->GetStateCacheStats();
+        const renderer::RenderQueue::Stats& queue = m_PBRRenderer->GetRenderQueueStats();
+        ImGui::Text("Render Queue: %u packets, %u passes (sort %.3f ms)", queue.packets, queue.passes, queue.sortMs);
+        ImGui::Text("State Changes: %u issued / %u elided", state.Issued(), state.Elided());
+        ImGui::Text("  program %u/%u  vao %u/%u  tex %u/%u  depth %u/%u",
+                    state.programs.issued, state.programs.elided, state.vaos.issued, state.vaos.elided,
+                    state.textures.issued, state.textures.elided, state.depth.issued, state.depth.elided);
+        ImGui::SliderInt("Bench Spheres", &m_BenchSphereCount, 10, 100000, "%d", ImGuiSliderFlags_Logarithmic);
+        if (ImGui::Button("Load Sphere Benchmark"))
+            m_PBRRenderer->SetBenchmarkSphereCount(m_BenchSphereCount);
+        ImGui::SameLine();
+        if (ImGui::Button("Restore Scene"))
+            m_PBRRenderer->SetBenchmarkSphereCount(0);
+        ImGui::Text("Entities: %zu (%d spheres)", m_PBRRenderer->GetEntityCount(), m_PBRRenderer->GetSphereCount());
+
+        // 分簇光照统计 + 动态光源基准
+        const LightClusterer::Stats& clusters = m_PBRRenderer->GetClusterStats();
+        ImGui::Text("Lights: %u (%u in view), %u indices, max %u / cluster",
+                    clusters.lights, clusters.lightsInView, clusters.indices, clusters.maxPerCluster);
+        ImGui::Text("Light Assign: %.3f ms on %u threads, buffers %.1f KB",
+                    clusters.assignMs, clusters.threads, m_PBRRenderer->GetClusterBufferBytes() / 1024.0);
+        ImGui::SliderInt("Bench Lights", &m_BenchLightCount, 10, 10000, "%d", ImGuiSliderFlags_Logarithmic);
+        if (ImGui::Button("Add Benchmark Lights"))
+            m_PBRRenderer->SetBenchmarkLightCount(m_BenchLightCount);
+        ImGui::SameLine();
+        if (ImGui::Button("Remove Lights"))
+            m_PBRRenderer->SetBenchmarkLightCount(0);
+        if (ImGui::Button("Run Clustering Benchmark"))
+        {
+            m_ClusterBenchMs.clear();
+            for (size_t n : { size_t(1000), size_t(2000), size_t(5000), size_t(10000) })
+            {
+                double ms = LightClusterer::Benchmark(n, 20);
+                std::cout << "[Application] Light clustering " << n << " lights: " << ms << " ms" << std::endl;
+                m_ClusterBenchMs.push_back(ms);
+            }
+        }
+        static const int kClusterBenchLights[] = { 1000, 2000, 5000, 10000 };
+        for (size_t i = 0; i < m_ClusterBenchMs.size(); ++i)
+            ImGui::Text("%5d lights: %.3f ms", kClusterBenchLights[i], m_ClusterBenchMs[i]);
+
+        // 作业系统：剔除、矩阵更新、光源分簇和贴图解码都在这些线程上并行
+        const core::JobSystem::Stats jobs = core::JobSystem::GetStats();
+        ImGui::Text("Jobs: %u threads, %llu executed, %llu stolen", core::JobSystem::ThreadCount(),
+                    (unsigned long long)jobs.executed, (unsigned long long)jobs.stolen);
+        if (ImGui::Button("Run Job Scaling Benchmark"))
+            RunJobScalingBenchmark();
+        for (const auto& r : m_JobScalingResults)
+            ImGui::Text("%2u threads: %.3f ms (x%.2f)", r.threads, r.ms, r.speedup);
+
+        // 相机路径：录制相机和界面改动，按固定步长回放并按段统计帧时间
+        if (m_PathMode == PathMode::Recording)
+        {
+            ImGui::Text("Recording: %.1f s, %zu frames", m_PathTime, m_CameraPath.Cameras().size());
+            if (ImGui::Button("Mark Segment"))
+                m_CameraPath.AddSegment(m_PathTime, "Segment " + std::to_string(m_CameraPath.Segments().size()));
+            ImGui::SameLine();
+            if (ImGui::Button("Stop Recording"))
+                StopPathRecording();
+        }
+        else if (m_PathMode == PathMode::Replaying)
+        {
+            ImGui::ProgressBar(m_ReplayFrame * PATH_TIMESTEP / std::max(m_CameraPath.Duration(), PATH_TIMESTEP),
+                               ImVec2(-1.0f, 0.0f), "Replaying");
+            if (ImGui::Button("Stop Replay"))
+                FinishPathReplay();
+        }
+        else
+        {
+            if (ImGui::Button("Record Camera Path"))
+                StartPathRecording();
+            ImGui::SameLine();
+            if (ImGui::Button("Replay"))
+                StartPathReplay(m_PathFile);
+        }
+        for (const ReplaySegmentResult& r : m_ReplayResults)
+            ImGui::Text("%-12s %5zu frames  avg %.2f  p95 %.2f  p99 %.2f ms",
+                        r.name.c_str(), r.stats.frames, r.stats.avgMs, r.stats.p95Ms, r.stats.p99Ms);
         ImGui::Spacing();
     }
 
@@ -305,30 +1186,8 @@ void Application::ShowControls()
 
         ImGui::Separator();
 
-        // 遍历光源，让用户修改位置和颜色
-        for (int i = 0; i < (int)m_PBRRenderer->lightPositions.size(); ++i)
-        {
-            std::string prefix = "Light " + std::to_string(i) + ":  ";
-            // 位置
-            {
-                glm::vec3& pos = m_PBRRenderer->lightPositions[i];
-                std::string label = prefix + "Position";
-                ImGui::DragFloat3(label.c_str(), &pos.x, 0.1f, -20.0f, 20.0f);
-            }
-            // 颜色：用 ColorEdit3，但要让颜色可以超过 [0,1]，可以先除 300，再乘回来
-            {
-                glm::vec3& col = m_PBRRenderer->lightColors[i];
-                std::string label = prefix + "Color";
-                float tmp[3] = {col.r / 300.0f, col.g / 300.0f, col.b / 300.0f};
-                if (ImGui::ColorEdit3(label.c_str(), tmp))
-                {
-                    col.r = tmp[0] * 300.0f;
-                    col.g = tmp[1] * 300.0f;
-                    col.b = tmp[2] * 300.0f;
-                }
-            }
-            ImGui::Separator(); // 每个光源分隔一条线
-        }
+        // 遍历光源，让用户修改类型、位置、颜色等
+        ShowLightEditor();
         ImGui::Spacing();
     }
 
@@ -369,22 +1228,12 @@ void Application::ShowControls()
         }
         else
         {
-            // 先把文件名提取出来供 Combo 用
-            static std::vector<std::string> names;
-            names.clear();
-            names.reserve(m_HDRIPaths.size());
-            for (auto& p : m_HDRIPaths)
-            {
-                names.push_back(std::filesystem::path(p).filename().string());
-            }
-
-            // ImGui 要一个 const char* 数组
-            std::vector<const char*> items;
-            items.reserve(names.size());
-            for (auto& s : names) items.push_back(s.c_str());
+            // ImGui 要一个 const char* 数组，每帧从帧 arena 里取
+            const char** items = core::FrameArena::Main().AllocateArray<const char*>(m_HDRINames.size());
+            for (size_t i = 0; i < m_HDRINames.size(); ++i) items[i] = m_HDRINames[i].c_str();
 
             // 下拉框
-            if (ImGui::Combo("HDRI Map", &m_CurrentHDRI, items.data(), (int)items.size()))
+            if (ImGui::Combo("HDRI Map", &m_CurrentHDRI, items, (int)m_HDRINames.size()))
             {
                 // 用户切换时，重新加载环境贴图
                 m_PBRRenderer->InitPBR(m_HDRIPaths[m_CurrentHDRI]);
@@ -401,19 +1250,31 @@ void Application::ShowControls()
         if (names.empty()) {
             ImGui::TextDisabled("No materials loaded.");
         } else {
-            // 转成 const char* 数组
-            std::vector<const char*> items;
-            items.reserve(names.size());
-            for (auto& s : names) items.push_back(s.c_str());
-
-            // 给每个球一个下拉框
-            for (int i = 0; i < 5; ++i) {
-                int idx = m_PBRRenderer->GetSphereMaterialIndex(i);
-                std::string label = "Sphere " + std::to_string(i) + " Mat";
-                if (ImGui::Combo(label.c_str(), &idx, items.data(), (int)items.size())) {
-                    // 用户切换后更新这一球材质
-                    m_PBRRenderer->SetSphereMaterialIndex(i, idx);
+            // 转成 const char* 数组（帧 arena，下一帧开始时作废）
+            core::FrameArena& arena = core::FrameArena::Main();
+            const char** items = arena.AllocateArray<const char*>(names.size());
+            for (size_t i = 0; i < names.size(); ++i) items[i] = names[i].c_str();
+
+            // 球数较少时每个球一个下拉框；基准场景下改为先选球（或左键拾取）再选材质
+            const int sphereCount = m_PBRRenderer->GetSphereCount();
+            if (sphereCount <= renderer::PBRRenderer::DEFAULT_SPHERE_COUNT) {
+                for (int i = 0; i < sphereCount; ++i) {
+                    int idx = m_PBRRenderer->GetSphereMaterialIndex(i);
+                    const char* label = arena.Format("Sphere %d Mat", i);
+                    if (ImGui::Combo(label, &idx, items, (int)names.size())) {
+                        // 用户切换后更新这一球材质
+                        m_PBRRenderer->SetSphereMaterialIndex(i, idx);
+                    }
                 }
+            } else {
+                int picked = m_PBRRenderer->GetSphereIndex(m_PBRRenderer->GetPickedEntity());
+                if (picked >= 0)
+                    m_SelectedSphere = picked;
+                m_SelectedSphere = std::min(m_SelectedSphere, sphereCount - 1);
+                ImGui::SliderInt("Sphere", &m_SelectedSphere, 0, sphereCount - 1);
+                int idx = m_PBRRenderer->GetSphereMaterialIndex(m_SelectedSphere);
+                if (ImGui::Combo("Sphere Mat", &idx, items, (int)names.size()))
+                    m_PBRRenderer->SetSphereMaterialIndex(m_SelectedSphere, idx);
             }
         }
     }
@@ -422,9 +1283,75 @@ void Application::ShowControls()
 }
 
 
+// 场景光源编辑：修改后通过 LightManager::Set 标记为脏，下一帧只上传变化的光源
+void Application::ShowLightEditor()
+{
+    renderer::LightManager& lights = m_PBRRenderer->GetLightManager();
+    static const char* kLightTypes[] = { "Point", "Spot", "Directional" };
+
+    Entity removeEntity;
+    int i = 0;
+    m_PBRRenderer->ForEachSceneLight([&](Entity entity, renderer::LightHandle handle)
+    {
+        renderer::Light light = lights.Get(handle);
+        bool changed = false;
+
+        ImGui::PushID(static_cast<int>(entity.index));
+        ImGui::Text("Light %d", i++);
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Remove"))
+            removeEntity = entity;
+
+        int type = static_cast<int>(light.Type);
+        if (ImGui::Combo("Type", &type, kLightTypes, IM_ARRAYSIZE(kLightTypes)))
+        {
+            light.Type = static_cast<renderer::LightType>(type);
+            changed = true;
+        }
+        changed |= ImGui::DragFloat3("Position", &light.Position.x, 0.1f, -20.0f, 20.0f);
+        if (light.Type != renderer::LightType::Point)
+            changed |= ImGui::DragFloat3("Direction", &light.Direction.x, 0.01f, -1.0f, 1.0f);
+        // 颜色限制在 [0,1]，亮度由 Intensity 单独调整
+        changed |= ImGui::ColorEdit3("Color", &light.Color.x);
+        changed |= ImGui::DragFloat("Intensity", &light.Intensity, 1.0f, 0.0f, 1000.0f);
+        if (light.Type != renderer::LightType::Directional)
+            changed |= ImGui::DragFloat("Range (0 = auto)", &light.Range, 0.1f, 0.0f, 200.0f);
+        if (light.Type == renderer::LightType::Spot)
+        {
+            changed |= ImGui::SliderFloat("Inner Cone", &light.InnerCone, 0.0f, 89.0f, "%.1f deg");
+            changed |= ImGui::SliderFloat("Outer Cone", &light.OuterCone, 0.0f, 89.0f, "%.1f deg");
+        }
+        if (changed)
+            lights.Set(handle, light);
+        ImGui::PopID();
+        ImGui::Separator(); // 每个光源分隔一条线
+    });
+    if (!removeEntity.IsNull())
+        m_PBRRenderer->RemoveSceneLight(removeEntity);
+
+    // 新光源放在相机前方，默认照向相机的视线方向
+    glm::vec3 spawn = m_Camera->Position + m_Camera->Front * 5.0f;
+    for (int t = 0; t < IM_ARRAYSIZE(kLightTypes); ++t)
+    {
+        if (t > 0) ImGui::SameLine();
+        if (ImGui::Button(core::FrameArena::Main().Format("Add %s", kLightTypes[t])))
+        {
+            renderer::Light light(spawn, glm::vec3(1.0f), t == 2 ? 3.0f : 100.0f);
+            light.Type = static_cast<renderer::LightType>(t);
+            light.Direction = m_Camera->Front;
+            m_PBRRenderer->AddSceneLight(light);
+        }
+    }
+
+    const renderer::LightManager::UploadStats& upload = m_PBRRenderer->GetLightUploadStats();
+    ImGui::Text("Lights: %zu / %zu, uploaded %u in %u calls",
+                lights.Count(), lights.MaxLights(), upload.lights, upload.calls);
+}
+
 void Application::ScanHDRDirectory(const std::string& directory)
 {
     m_HDRIPaths.clear();
+    m_HDRINames.clear();
     try
     {
         for (auto& entry : fs::directory_iterator(directory))
@@ -436,6 +1363,7 @@ void Application::ScanHDRDirectory(const std::string& directory)
             if (ext == ".hdr")
             {
                 m_HDRIPaths.push_back(entry.path().string());
+                m_HDRINames.push_back(entry.path().filename().string());
             }
         }
     }
@@ -475,6 +1403,49 @@ void Application::ScanMaterialDirectory(const std::string& directory)
     }
 }
 
+void Application::RunJobScalingBenchmark()
+{
+    // 合成的一帧：100k 个物体的矩阵全部重算 + 视锥剔除，10k 个光源分簇
+    const size_t objectCount = 100000;
+    const size_t lightCount  = 10000;
+
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<float> pos(-50.0f, 50.0f), scale(0.5f, 2.0f), radius(1.0f, 4.0f);
+
+    TransformBatch transforms;
+    FrustumCuller culler;
+    culler.Reserve(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        glm::vec3 p(pos(rng), pos(rng), pos(rng));
+        float s = scale(rng);
+        transforms.Add(p, glm::angleAxis(pos(rng), glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(s));
+        culler.Add(p, s);
+    }
+
+    std::vector<LightClusterer::PointLight> lights(lightCount);
+    for (auto& l : lights)
+        l = LightClusterer::PointLight{ glm::vec3(pos(rng), pos(rng), pos(rng)), radius(rng), glm::vec3(1.0f) };
+
+    const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 60.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum = Frustum::FromMatrix(projection * view);
+    LightClusterer clusterer;
+    clusterer.SetProjection(projection, 0.1f, 100.0f);
+
+    m_JobScalingResults = core::JobSystem::BenchmarkScaling([&]() {
+        transforms.MarkAllDirty();
+        transforms.Update();
+        culler.Cull(frustum);
+        clusterer.Assign(view, lights);
+    }, 10);
+
+    for (const auto& r : m_JobScalingResults)
+    {
+        std::cout << "[Application] Job scaling " << r.threads << " threads: " << r.ms
+                  << " ms (x" << r.speedup << ")" << std::endl;
+    }
+}
 
 void Application::Update(float deltaTime)
 {
@@ -10,18 +10,47 @@
 #include "core/Window.h"
 #include "core/InputManager.h"
 #include "core/Camera.h"
+#include "core/AllocationTracker.h"
+#include "core/CameraPath.h"
+#include "core/FrameArena.h"
+#include "core/FrameStats.h"
+#include "core/HeadlessContext.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
 #include "renderer/PBRRenderer.h"
+#include "renderer/GLExtensions.h"
+#include "renderer/GLCallCounter.h"
+#include "renderer/GLTrace.h"
+#include "renderer/GpuMemory.h"
+#include "renderer/GpuProfiler.h"
+#include "renderer/NullGL.h"
+#include "renderer/RenderTarget.h"
+#include "scene/Model.h"
 #include "imgui/imgui.h"
 #include "imgui/backends/imgui_impl_glfw.h"
 #include "imgui/backends/imgui_impl_opengl3.h"
 
 class Application {
 public:
-    Application(int width, int height, const std::string& title);
+    // headless 为 true 时不创建窗口、ImGui 和输入，用 HeadlessContext 建立上下文，只能调用 RunHeadless；
+    // nullGL 为 true 时（隐含 headless）不创建任何上下文，GL 调用全部进入 NullGL，只测量 CPU 提交开销
+    Application(int width, int height, const std::string& title, bool headless = false, bool nullGL = false);
     ~Application();
 
     void Run();
 
+    // 无窗口运行：把 frames 帧渲染到离屏 FBO（没有交换链，每帧 glFinish 后计时），
+    // 结束时打印帧时间统计并写出 frame_stats.csv / frame_times.csv 和最后一帧的 headless_frame.ppm；
+    // 返回预热之后的稳态帧是否都没有堆分配（--expect-zero-alloc 据此决定退出码）
+    bool RunHeadless(unsigned int frames);
+
+    // 载入相机路径并开始回放（Run / RunHeadless 之前或运行中调用）：按固定步长驱动相机和场景设置，
+    // 结束时打印每段的帧时间并写出 replay_report.csv；无窗口模式下回放完即返回
+    bool StartPathReplay(const std::string& path);
+
+    // 载入模型文件，替换默认的程序生成地面作为场景模型；失败时保留地面并返回 false
+    bool LoadSceneModel(const std::string& path);
+
 private:
     void InitWindow();
 	void InitImGui();
@@ -32,16 +61,50 @@ private:
     void Render();
 
     void ShowFrameStats();
+    // 打印一帧的 GL 调用统计（无窗口模式结束时）
+    void PrintGLCallSummary(const renderer::GLCallCounter::Counts& gl);
+    // 打印显存占用（按资源类型和创建者标签）
+    void PrintGpuMemorySummary();
+    void ShowGpuMemory();
+    // 上一帧各线程的堆分配和帧 arena 用量
+    void ShowHeapAllocations();
     void ShowSettings();
 	void ShowControls();
+	void ShowLightEditor();
 
 	void ScanHDRDirectory(const std::string& directory);
 	void ScanMaterialDirectory(const std::string& directory);
 
+    // 记录上一帧耗时；尖刺捕获打开时检测超阈值的帧，并在 GPU 计时读回后写出其 trace
+    void UpdateFrameStats(float frameMs);
+
+    // 相机路径：录制每帧的相机和场景状态；回放时按固定步长推进路径，路径走完时结束回放并返回 false
+    void StartPathRecording();
+    void StopPathRecording();
+    void RecordPathFrame(float deltaTime);
+    bool AdvancePathReplay();
+    void AddReplayFrameTime(float frameMs);
+    void FlushReplaySegment();
+    void FinishPathReplay();
+
+    // 界面可改动的场景状态（设置 / 场景光源 / 各球材质）的读取和恢复，录制和回放共用
+    core::CameraPath::SceneSettings CaptureSceneSettings() const;
+    void ApplySceneSettings(const core::CameraPath::SceneSettings& settings);
+    void CaptureSceneLights(std::vector<renderer::Light>& lights) const;
+    void ApplySceneLights(const renderer::Light* lights, size_t count);
+    void CaptureSphereMaterials(std::vector<int32_t>& materials) const;
+    void ApplySphereMaterials(const int32_t* materials, size_t count);
+
+    // 用 1..N 个线程运行一帧的 CPU 工作量（矩阵更新 + 视锥剔除 + 光源分簇），结果存入 m_JobScalingResults
+    void RunJobScalingBenchmark();
+
 private:
     int m_ScreenWidth, m_ScreenHeight;
     std::string m_WindowTitle;
 
+    bool                                m_Headless = false;
+    bool                                m_NullGL = false;
+    std::unique_ptr<core::HeadlessContext> m_HeadlessContext;
     std::unique_ptr<core::Window>       m_Window;
     std::unique_ptr<core::InputManager> m_InputManager;
     std::unique_ptr<core::Camera>       m_Camera;
@@ -53,8 +116,79 @@ private:
 	float m_FPS = 0.0f;
     float m_FrameTimeMs = 0.0f;
 
+    // 视锥剔除微基准的结果（每毫秒测试的物体数，0 表示尚未运行）
+    int    m_CullBenchObjects = 100000;
+    double m_CullBenchResult  = 0.0;
+
+    // BVH 构建 / refit / 查询基准结果（10k / 100k / 1M 物体）
+    std::vector<Bvh::BenchmarkResult> m_BvhBenchResults;
+
+    // 批量矩阵计算基准结果（10k / 100k / 1M 物体，SIMD / 标量 / 逐物体 glm）
+    std::vector<TransformBatch::BenchmarkResult> m_TransformBenchResults;
+
+    // 实例化基准场景的球数
+    int    m_BenchSphereCount = 1000;
+    // 球数超过默认数量时，材质选择面板当前编辑的球
+    int    m_SelectedSphere = 0;
+
+    // 分簇光照：基准光源数，以及 1k / 2k / 5k / 10k 光源的分簇耗时（毫秒，空表示尚未运行）
+    int                 m_BenchLightCount = 2000;
+    std::vector<double> m_ClusterBenchMs;
+
+    // 作业系统扩展性基准：每个线程数下一帧 CPU 工作量的耗时（空表示尚未运行）
+    std::vector<core::JobSystem::ScalingResult> m_JobScalingResults;
+
+    // 界面上“Capture Trace”一次录制的帧数
+    int m_TraceFrames = 120;
+
+    // 显存快照比较的最近一次结果（界面上“Export Diff”）
+    renderer::GpuMemory::Diff m_GpuMemoryDiff;
+
+    // 帧时间统计：统计窗口（FRAME_STATS_WINDOWS 的下标）、曲线和直方图的缓冲
+    core::FrameStats   m_FrameStats;
+    int                m_FrameStatsWindow = 1;
+    std::vector<float> m_FrameGraph;
+    std::vector<float> m_FrameHistogram = std::vector<float>(40, 0.0f);
+
+    // 尖刺捕获：帧时间超过阈值时把包含该帧的最近几帧 trace 写到 spike_<帧号>.json
+    bool         m_SpikeCapture     = false;
+    float        m_SpikeThresholdMs = 33.3f;
+    int          m_SpikeCountdown   = -1;      // >= 0 时每帧减一，到 0 写出（等该帧的 GPU 计时读回）
+    uint64_t     m_SpikeFrame       = 0;
+    unsigned int m_SpikeCount       = 0;
+    std::string  m_LastSpikeTrace;
+
+    // 相机路径录制 / 回放；回放固定 60 Hz 步长，与录制时的帧率无关
+    enum class PathMode { Off, Recording, Replaying };
+    static constexpr float PATH_TIMESTEP = 1.0f / 60.0f;
+    // 无窗口运行时前几帧会创建延迟分配的资源和缓冲，GpuProfiler 第一次读回结果（LATENCY 帧后）
+    // 时建立各阶段的统计表，这之后的帧才检查堆分配
+    static constexpr unsigned int ALLOCATION_WARMUP_FRAMES = renderer::GpuProfiler::LATENCY + 1;
+
+    core::CameraPath m_CameraPath;
+    PathMode         m_PathMode = PathMode::Off;
+    std::string      m_PathFile = "camera_path.campath";
+    float            m_PathTime = 0.0f;          // 录制：已录时长
+    unsigned int     m_ReplayFrame = 0;          // 回放：下一帧的编号
+    int              m_ReplaySegment = -1;
+    int              m_ReplaySettings = -1;      // 回放时已应用的设置 / 光源 / 材质快照下标
+    int              m_ReplayLights = -1;
+    int              m_ReplayMaterials = -1;
+    std::vector<renderer::Light> m_PathLights;   // 录制时的临时缓冲
+    std::vector<int32_t>         m_PathMaterials;
+
+    // 回放报告：每段和整条路径的帧时间统计（每段最多保留 FrameStats::CAPACITY 帧）
+    struct ReplaySegmentResult {
+        std::string               name;
+        core::FrameStats::Summary stats;
+    };
+    core::FrameStats                 m_ReplaySegmentStats;
+    core::FrameStats                 m_ReplayTotalStats;
+    std::vector<ReplaySegmentResult> m_ReplayResults;
+
 	// HDR 文件列表和当前选择索引
 	std::vector<std::string>  m_HDRIPaths;
+	std::vector<std::string>  m_HDRINames;    // 文件名，扫描时提取一次供下拉框显示
 	int                       m_CurrentHDRI = 0;
 
 	// PBR 材质列表 & 当前选中索引
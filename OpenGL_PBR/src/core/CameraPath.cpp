@@ -0,0 +1,234 @@
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+
+namespace core {
+
+    namespace {
+
+        const uint32_t kMagic   = 0x50524250; // "PBRP"
+        const uint32_t kVersion = 1;
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t lightSize;   // sizeof(renderer::Light)，结构变化时旧文件自动失效
+            uint32_t reserved;
+        };
+
+        static_assert(std::is_trivially_copyable<CameraPath::CameraKey>::value, "CameraKey is written as raw bytes");
+        static_assert(std::is_trivially_copyable<CameraPath::SettingsKey>::value, "SettingsKey is written as raw bytes");
+        static_assert(std::is_trivially_copyable<renderer::Light>::value, "Light is written as raw bytes");
+
+        template <typename T>
+        void WriteArray(std::ofstream& out, const std::vector<T>& v)
+        {
+            uint32_t n = static_cast<uint32_t>(v.size());
+            out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+            if (n) out.write(reinterpret_cast<const char*>(v.data()), sizeof(T) * n);
+        }
+
+        // 当前位置到文件末尾的字节数。元素个数来自文件，分配前先和它比较，损坏的文件不会触发巨大的分配
+        uint64_t Remaining(std::ifstream& in)
+        {
+            const std::streampos pos = in.tellg();
+            in.seekg(0, std::ios::end);
+            const std::streampos end = in.tellg();
+            in.seekg(pos);
+            return (pos < 0 || end < pos) ? 0 : static_cast<uint64_t>(end - pos);
+        }
+
+        template <typename T>
+        bool ReadArray(std::ifstream& in, std::vector<T>& v)
+        {
+            uint32_t n = 0;
+            if (!in.read(reinterpret_cast<char*>(&n), sizeof(n))) return false;
+            if (static_cast<uint64_t>(n) * sizeof(T) > Remaining(in)) return false;
+            v.resize(n);
+            return n == 0 || static_cast<bool>(in.read(reinterpret_cast<char*>(v.data()), sizeof(T) * n));
+        }
+
+        // 最后一个 time <= t 的下标；keys 按时间递增
+        template <typename T>
+        int LastAtOrBefore(const std::vector<T>& keys, float t)
+        {
+            auto it = std::upper_bound(keys.begin(), keys.end(), t,
+                                       [](float value, const T& key) { return value < key.time; });
+            return static_cast<int>(it - keys.begin()) - 1;
+        }
+
+        bool SameLights(const renderer::Light* a, const renderer::Light* b, size_t count)
+        {
+            return count == 0 || std::memcmp(a, b, sizeof(renderer::Light) * count) == 0;
+        }
+    }
+
+    void CameraPath::Clear()
+    {
+        m_Cameras.clear();
+        m_Settings.clear();
+        m_LightKeys.clear();
+        m_Lights.clear();
+        m_MaterialKeys.clear();
+        m_Materials.clear();
+        m_Segments.clear();
+    }
+
+    void CameraPath::AddCamera(float time, const Camera& camera)
+    {
+        m_Cameras.push_back(CameraKey{ time, camera.Position, camera.Yaw, camera.Pitch, camera.Zoom });
+    }
+
+    void CameraPath::AddSettings(float time, const SceneSettings& settings)
+    {
+        if (!m_Settings.empty() && m_Settings.back().settings == settings)
+            return;
+        m_Settings.push_back(SettingsKey{ time, settings });
+    }
+
+    void CameraPath::AddLights(float time, const std::vector<renderer::Light>& lights)
+    {
+        if (!m_LightKeys.empty())
+        {
+            const LightsKey& last = m_LightKeys.back();
+            if (last.count == lights.size() && SameLights(&m_Lights[last.first], lights.data(), lights.size()))
+                return;
+        }
+        m_LightKeys.push_back(LightsKey{ time, static_cast<uint32_t>(m_Lights.size()), static_cast<uint32_t>(lights.size()) });
+        m_Lights.insert(m_Lights.end(), lights.begin(), lights.end());
+    }
+
+    void CameraPath::AddMaterials(float time, const std::vector<int32_t>& materials)
+    {
+        if (!m_MaterialKeys.empty())
+        {
+            const MaterialsKey& last = m_MaterialKeys.back();
+            if (last.count == materials.size() &&
+                std::equal(materials.begin(), materials.end(), m_Materials.begin() + last.first))
+                return;
+        }
+        m_MaterialKeys.push_back(MaterialsKey{ time, static_cast<uint32_t>(m_Materials.size()),
+                                               static_cast<uint32_t>(materials.size()) });
+        m_Materials.insert(m_Materials.end(), materials.begin(), materials.end());
+    }
+
+    void CameraPath::AddSegment(float time, const std::string& name)
+    {
+        // 同一时刻的两个标记只保留后一个
+        if (!m_Segments.empty() && m_Segments.back().time == time)
+            m_Segments.back().name = name;
+        else
+            m_Segments.push_back(Segment{ time, name });
+    }
+
+    void CameraPath::SampleCamera(float t, Camera& camera) const
+    {
+        if (m_Cameras.empty()) return;
+
+        const int i = LastAtOrBefore(m_Cameras, t);
+        const CameraKey& a = m_Cameras[std::max(i, 0)];
+        const CameraKey& b = m_Cameras[std::min(i + 1, static_cast<int>(m_Cameras.size()) - 1)];
+        const float span = b.time - a.time;
+        const float s = (i < 0 || span <= 0.0f) ? 0.0f : std::min((t - a.time) / span, 1.0f);
+
+        camera.Position = a.position + (b.position - a.position) * s;
+        camera.Yaw      = a.yaw + (b.yaw - a.yaw) * s;
+        camera.Pitch    = a.pitch + (b.pitch - a.pitch) * s;
+        camera.Zoom     = a.zoom + (b.zoom - a.zoom) * s;
+        camera.updateCameraVectors();
+    }
+
+    int CameraPath::SettingsIndexAt(float t) const { return LastAtOrBefore(m_Settings, t); }
+    int CameraPath::LightsIndexAt(float t) const { return LastAtOrBefore(m_LightKeys, t); }
+    int CameraPath::MaterialsIndexAt(float t) const { return LastAtOrBefore(m_MaterialKeys, t); }
+    int CameraPath::SegmentIndexAt(float t) const { return LastAtOrBefore(m_Segments, t); }
+
+    bool CameraPath::Save(const std::string& path) const
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "[CameraPath] Cannot write " << path << std::endl;
+            return false;
+        }
+
+        Header h{ kMagic, kVersion, static_cast<uint32_t>(sizeof(renderer::Light)), 0 };
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        WriteArray(out, m_Cameras);
+        WriteArray(out, m_Settings);
+        WriteArray(out, m_LightKeys);
+        WriteArray(out, m_Lights);
+        WriteArray(out, m_MaterialKeys);
+        WriteArray(out, m_Materials);
+
+        uint32_t segmentCount = static_cast<uint32_t>(m_Segments.size());
+        out.write(reinterpret_cast<const char*>(&segmentCount), sizeof(segmentCount));
+        for (const Segment& segment : m_Segments)
+        {
+            uint32_t length = static_cast<uint32_t>(segment.name.size());
+            out.write(reinterpret_cast<const char*>(&segment.time), sizeof(segment.time));
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(segment.name.data(), length);
+        }
+
+        std::cout << "[CameraPath] Saved " << m_Cameras.size() << " frames (" << Duration() << " s, "
+                  << m_Segments.size() << " segments) to " << path << std::endl;
+        return static_cast<bool>(out);
+    }
+
+    bool CameraPath::Load(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            std::cerr << "[CameraPath] Cannot open " << path << std::endl;
+            return false;
+        }
+
+        Header h{};
+        if (!in.read(reinterpret_cast<char*>(&h), sizeof(h)) || h.magic != kMagic || h.version != kVersion ||
+            h.lightSize != sizeof(renderer::Light))
+        {
+            std::cerr << "[CameraPath] " << path << " is not a compatible camera path" << std::endl;
+            return false;
+        }
+
+        CameraPath loaded;
+        bool ok = ReadArray(in, loaded.m_Cameras) && ReadArray(in, loaded.m_Settings) &&
+                  ReadArray(in, loaded.m_LightKeys) && ReadArray(in, loaded.m_Lights) &&
+                  ReadArray(in, loaded.m_MaterialKeys) && ReadArray(in, loaded.m_Materials);
+        uint32_t segmentCount = 0;
+        ok = ok && static_cast<bool>(in.read(reinterpret_cast<char*>(&segmentCount), sizeof(segmentCount)));
+        for (uint32_t i = 0; ok && i < segmentCount; ++i)
+        {
+            Segment segment;
+            uint32_t length = 0;
+            ok = in.read(reinterpret_cast<char*>(&segment.time), sizeof(segment.time)) &&
+                 in.read(reinterpret_cast<char*>(&length), sizeof(length));
+            if (!ok || length > Remaining(in)) { ok = false; break; }
+            segment.name.resize(length);
+            ok = length == 0 || static_cast<bool>(in.read(&segment.name[0], length));
+            loaded.m_Segments.push_back(std::move(segment));
+        }
+        for (const LightsKey& key : loaded.m_LightKeys)
+            ok = ok && static_cast<uint64_t>(key.first) + key.count <= loaded.m_Lights.size();
+        for (const MaterialsKey& key : loaded.m_MaterialKeys)
+            ok = ok && static_cast<uint64_t>(key.first) + key.count <= loaded.m_Materials.size();
+        if (!ok)
+        {
+            std::cerr << "[CameraPath] " << path << " is truncated or corrupt" << std::endl;
+            return false;
+        }
+
+        *this = std::move(loaded);
+        std::cout << "[CameraPath] Loaded " << m_Cameras.size() << " frames (" << Duration() << " s, "
+                  << m_Segments.size() << " segments) from " << path << std::endl;
+        return true;
+    }
+
+} // namespace core
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "renderer/Renderer.h"
+
+
+namespace core {
+
+    /**
+     * CameraPath
+     * ----------
+     * 录制下来的相机路径和界面上做过的场景改动，用于可复现的性能测试：
+     *  - 相机：每帧一个关键帧（时间、位置、yaw / pitch / zoom），回放时按固定步长在相邻关键帧间插值，
+     *    不管录制时帧率如何，同一条路径总是产生相同的帧序列
+     *  - 场景设置（曝光、渲染路径开关、基准球数 / 光源数）、场景光源和各球的材质：只在发生变化时记录一条
+     *  - 段：录制时打的标记，回放时按段分别统计帧时间
+     *
+     * 文件格式（小端，<名字>.campath 或任意路径）：
+     *   Header | CameraKey[] | SettingsKey[] | LightsKey[] | Light[] | MaterialsKey[] | int32[] | 段数, (time, 名字长度, 名字)[]
+     *   （数组前都有一个 uint32 元素个数）
+     */
+    class CameraPath {
+    public:
+        struct CameraKey {
+            float     time;
+            glm::vec3 position;
+            float     yaw;
+            float     pitch;
+            float     zoom;
+        };
+
+        enum SettingsFlags : uint32_t {
+            FLAG_INSTANCING      = 1u << 0,
+            FLAG_BINDLESS        = 1u << 1,
+            FLAG_DEFERRED        = 1u << 2,
+            FLAG_DEPTH_PREPASS   = 1u << 3,
+            FLAG_FRONT_TO_BACK   = 1u << 4,
+            FLAG_LOD             = 1u << 5,
+            FLAG_FRUSTUM_CULLING = 1u << 6,
+            FLAG_BVH_CULLING     = 1u << 7,
+        };
+
+        /// 影响渲染开销、可以在界面上改动的场景设置
+        struct SceneSettings {
+            float    exposure         = 1.0f;
+            float    gamma            = 2.2f;
+            int32_t  benchmarkSpheres = 0;
+            int32_t  benchmarkLights  = 0;
+            uint32_t flags            = 0;   // SettingsFlags 的组合
+
+            bool operator==(const SceneSettings& o) const
+            {
+                return exposure == o.exposure && gamma == o.gamma && benchmarkSpheres == o.benchmarkSpheres &&
+                       benchmarkLights == o.benchmarkLights && flags == o.flags;
+            }
+            bool operator!=(const SceneSettings& o) const { return !(*this == o); }
+        };
+
+        struct SettingsKey {
+            float         time;
+            SceneSettings settings;
+        };
+
+        /// 场景光源（界面上可编辑的那些）的一次完整快照，指向 Lights() 中 [first, first + count)
+        struct LightsKey {
+            float    time;
+            uint32_t first;
+            uint32_t count;
+        };
+
+        /// 各材质球的材质下标快照，指向 Materials() 中 [first, first + count)
+        struct MaterialsKey {
+            float    time;
+            uint32_t first;
+            uint32_t count;
+        };
+
+        struct Segment {
+            float       time;
+            std::string name;
+        };
+
+        // ---- 录制 ----
+        void Clear();
+        void AddCamera(float time, const Camera& camera);
+        /// 和上一次记录的设置相同时忽略
+        void AddSettings(float time, const SceneSettings& settings);
+        /// 和上一次记录的光源快照相同时忽略
+        void AddLights(float time, const std::vector<renderer::Light>& lights);
+        /// 和上一次记录的材质快照相同时忽略
+        void AddMaterials(float time, const std::vector<int32_t>& materials);
+        void AddSegment(float time, const std::string& name);
+
+        // ---- 回放 ----
+        bool  Empty() const { return m_Cameras.empty(); }
+        float Duration() const { return m_Cameras.empty() ? 0.0f : m_Cameras.back().time; }
+
+        /// 时间 t 处的相机状态（相邻关键帧线性插值，超出范围时取两端）
+        void SampleCamera(float t, Camera& camera) const;
+        /// 时间 t 时生效的设置 / 光源快照 / 段（最后一个 time <= t 的），没有时返回 -1
+        int SettingsIndexAt(float t) const;
+        int LightsIndexAt(float t) const;
+        int MaterialsIndexAt(float t) const;
+        int SegmentIndexAt(float t) const;
+
+        const std::vector<CameraKey>&        Cameras() const { return m_Cameras; }
+        const std::vector<SettingsKey>&      Settings() const { return m_Settings; }
+        const std::vector<LightsKey>&        LightKeys() const { return m_LightKeys; }
+        const std::vector<renderer::Light>&  Lights() const { return m_Lights; }
+        const std::vector<MaterialsKey>&     MaterialKeys() const { return m_MaterialKeys; }
+        const std::vector<int32_t>&          Materials() const { return m_Materials; }
+        const std::vector<Segment>&          Segments() const { return m_Segments; }
+
+        bool Save(const std::string& path) const;
+        /// 文件不存在或格式 / 版本不符时返回 false，原有内容保持不变
+        bool Load(const std::string& path);
+
+    private:
+        std::vector<CameraKey>       m_Cameras;
+        std::vector<SettingsKey>     m_Settings;
+        std::vector<LightsKey>       m_LightKeys;
+        std::vector<renderer::Light> m_Lights;
+        std::vector<MaterialsKey>    m_MaterialKeys;
+        std::vector<int32_t>         m_Materials;
+        std::vector<Segment>         m_Segments;
+    };
+
+} // namespace core
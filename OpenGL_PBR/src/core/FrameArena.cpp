@@ -0,0 +1,75 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+namespace core {
+
+    FrameArena::FrameArena(size_t capacity)
+        : m_Block(new unsigned char[capacity]), m_Capacity(capacity)
+    {
+    }
+
+    void* FrameArena::Allocate(size_t size, size_t alignment)
+    {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(m_Block.get());
+        const uintptr_t aligned = (base + m_Used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        const size_t offset = static_cast<size_t>(aligned - base);
+        if (offset + size <= m_Capacity)
+        {
+            m_Used = offset + size;
+            return m_Block.get() + offset;
+        }
+
+        // 主块不够：单独从堆上要一块，留到 Reset 时一并释放（new[] 的结果按 max_align_t 对齐）
+        ++m_Overflows;
+        m_OverflowBytes += size + alignment;
+        m_OverflowBlocks.emplace_back(new unsigned char[size + alignment]);
+        const uintptr_t block = reinterpret_cast<uintptr_t>(m_OverflowBlocks.back().get());
+        return reinterpret_cast<void*>((block + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+    }
+
+    const char* FrameArena::Format(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        va_list measure;
+        va_copy(measure, args);
+        const int length = std::vsnprintf(nullptr, 0, format, measure);
+        va_end(measure);
+
+        char* text = static_cast<char*>(Allocate(static_cast<size_t>(std::max(length, 0)) + 1, 1));
+        if (length > 0)
+            std::vsnprintf(text, static_cast<size_t>(length) + 1, format, args);
+        else
+            text[0] = '\0';
+        va_end(args);
+        return text;
+    }
+
+    void FrameArena::Reset()
+    {
+        m_HighWater = std::max(m_HighWater, Used());
+        if (!m_OverflowBlocks.empty())
+        {
+            // 扩到本帧总用量再留一半余量，之后的帧就不用再从堆上补块。
+            // 这里在帧循环里，不打印日志（输出本身也会分配）；扩容后的容量和溢出次数在 Performance 面板显示
+            const size_t capacity = m_HighWater + m_HighWater / 2;
+            m_OverflowBlocks.clear();
+            m_OverflowBlocks.shrink_to_fit();
+            m_Block.reset(new unsigned char[capacity]);
+            m_Capacity = capacity;
+        }
+        m_Used = 0;
+        m_OverflowBytes = 0;
+    }
+
+    FrameArena& FrameArena::Main()
+    {
+        static FrameArena arena;
+        return arena;
+    }
+
+} // namespace core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+
+    /**
+     * FrameArena
+     * ----------
+     * 线性分配器：每帧的临时数据（界面上的名字数组、格式化的标签……）从一块预先分配的内存里顺序切出，
+     * 帧开始时 Reset() 整块作废，不逐个释放，也不走堆。
+     *  - 容量不够时临时从堆上再要一块，Reset() 时把主块扩到这一帧的用量，之后的帧不再分配
+     *  - 只放平凡析构的数据（不会调用析构函数）；返回的指针只在当前帧有效
+     *  - 不是线程安全的，Main() 只给主线程用
+     *
+     * 用法：
+     *   core::FrameArena& arena = core::FrameArena::Main();
+     *   const char** items = arena.AllocateArray<const char*>(names.size());
+     *   const char* label = arena.Format("Sphere %d Mat", i);
+     */
+    class FrameArena {
+    public:
+        explicit FrameArena(size_t capacity = 64 * 1024);
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T>
+        T* AllocateArray(size_t count)
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /// printf 风格格式化到 arena 里，返回以 '\0' 结尾的字符串
+        const char* Format(const char* format, ...);
+
+        /// 作废本帧的所有分配；上一帧溢出过就把主块扩大到上一帧的总用量
+        void Reset();
+
+        size_t Used() const { return m_Used + m_OverflowBytes; }
+        size_t Capacity() const { return m_Capacity; }
+        /// 单帧用量的最大值
+        size_t HighWater() const { return m_HighWater; }
+        /// 容量不够、从堆上补块的次数（累计）
+        unsigned int Overflows() const { return m_Overflows; }
+
+        /// 主线程每帧的 arena，由 Application 在帧开始时 Reset
+        static FrameArena& Main();
+
+    private:
+        std::unique_ptr<unsigned char[]>              m_Block;
+        size_t                                        m_Capacity = 0;
+        size_t                                        m_Used = 0;
+        std::vector<std::unique_ptr<unsigned char[]>> m_OverflowBlocks;
+        size_t                                        m_OverflowBytes = 0;
+        size_t                                        m_HighWater = 0;
+        unsigned int                                  m_Overflows = 0;
+    };
+
+} // namespace core
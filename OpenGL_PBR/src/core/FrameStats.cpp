@@ -0,0 +1,140 @@
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+
+namespace core {
+
+    namespace {
+        // 最近秩法：排好序的 n 个样本中第 ceil(p * n) 个
+        double Percentile(const std::vector<float>& sorted, double p)
+        {
+            if (sorted.empty()) return 0.0;
+            size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+            rank = std::min(std::max<size_t>(rank, 1), sorted.size());
+            return sorted[rank - 1];
+        }
+
+        // 写入错误（磁盘满、网络共享断开）可能在缓冲写出时才出现：既看流的错误标志，也看 fclose 的结果
+        bool CloseWritten(FILE* file, const std::string& path)
+        {
+            const bool written = std::ferror(file) == 0;
+            const bool closed = std::fclose(file) == 0;
+            if (written && closed)
+                return true;
+            std::cerr << "[FrameStats] Failed to write " << path << std::endl;
+            return false;
+        }
+    }
+
+    void FrameStats::Add(float frameMs)
+    {
+        m_Samples[m_Next] = frameMs;
+        m_Next = (m_Next + 1) % CAPACITY;
+        if (m_Count < CAPACITY) ++m_Count;
+        ++m_Total;
+    }
+
+    void FrameStats::Clear()
+    {
+        m_Next = 0;
+        m_Count = 0;
+        m_Total = 0;
+    }
+
+    void FrameStats::Recent(size_t count, std::vector<float>& out) const
+    {
+        count = std::min(count, m_Count);
+        out.resize(count);
+        const size_t first = (m_Next + CAPACITY - count) % CAPACITY;
+        for (size_t i = 0; i < count; ++i)
+            out[i] = m_Samples[(first + i) % CAPACITY];
+    }
+
+    FrameStats::Summary FrameStats::Compute(size_t window) const
+    {
+        Summary summary;
+        if (window == 0 || window > m_Count)
+            window = m_Count;
+        if (window == 0)
+            return summary;
+
+        Recent(window, m_Sorted);
+        double sum = 0.0;
+        for (float ms : m_Sorted)
+            sum += ms;
+        std::sort(m_Sorted.begin(), m_Sorted.end());
+
+        summary.frames = window;
+        summary.avgMs  = sum / window;
+        summary.minMs  = m_Sorted.front();
+        summary.p50Ms  = Percentile(m_Sorted, 0.50);
+        summary.p95Ms  = Percentile(m_Sorted, 0.95);
+        summary.p99Ms  = Percentile(m_Sorted, 0.99);
+        summary.maxMs  = m_Sorted.back();
+        summary.avgFps = summary.avgMs > 0.0 ? 1000.0 / summary.avgMs : 0.0;
+        return summary;
+    }
+
+    void FrameStats::Histogram(size_t window, float maxMs, std::vector<float>& bins) const
+    {
+        std::fill(bins.begin(), bins.end(), 0.0f);
+        if (bins.empty() || maxMs <= 0.0f) return;
+
+        if (window == 0 || window > m_Count)
+            window = m_Count;
+        const size_t first = (m_Next + CAPACITY - window) % CAPACITY;
+        const float scale = bins.size() / maxMs;
+        for (size_t i = 0; i < window; ++i)
+        {
+            const float ms = m_Samples[(first + i) % CAPACITY];
+            const size_t bin = std::min(static_cast<size_t>(std::max(ms, 0.0f) * scale), bins.size() - 1);
+            bins[bin] += 1.0f;
+        }
+    }
+
+    bool FrameStats::ExportCsv(const std::string& path, const std::vector<size_t>& windows) const
+    {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file)
+        {
+            std::cerr << "[FrameStats] Failed to open " << path << std::endl;
+            return false;
+        }
+        std::fputs("window,frames,avg_ms,min_ms,p50_ms,p95_ms,p99_ms,max_ms,avg_fps\n", file);
+        for (size_t window : windows)
+        {
+            const Summary s = Compute(window);
+            std::fprintf(file, "%zu,%zu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f\n",
+                         window, s.frames, s.avgMs, s.minMs, s.p50Ms, s.p95Ms, s.p99Ms, s.maxMs, s.avgFps);
+        }
+        if (!CloseWritten(file, path))
+            return false;
+        std::cout << "[FrameStats] Wrote " << path << std::endl;
+        return true;
+    }
+
+    bool FrameStats::ExportSamplesCsv(const std::string& path) const
+    {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file)
+        {
+            std::cerr << "[FrameStats] Failed to open " << path << std::endl;
+            return false;
+        }
+        std::fputs("frame,ms\n", file);
+        std::vector<float> samples;
+        Recent(m_Count, samples);
+        const uint64_t firstFrame = m_Total - samples.size();
+        for (size_t i = 0; i < samples.size(); ++i)
+            std::fprintf(file, "%llu,%.4f\n", static_cast<unsigned long long>(firstFrame + i), samples[i]);
+        if (!CloseWritten(file, path))
+            return false;
+        std::cout << "[FrameStats] Wrote " << samples.size() << " frames to " << path << std::endl;
+        return true;
+    }
+
+} // namespace core
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace core {
+
+    /**
+     * FrameStats
+     * ----------
+     * 帧时间记录器：环形缓冲保存最近 CAPACITY 帧的耗时（毫秒），按需在任意窗口上统计
+     * 平均值和 p50 / p95 / p99 / 最大值。单帧的 1/dt 每帧都在跳，看不出偶发卡顿，百分位数可以。
+     *
+     * 用法：
+     *   stats.Add(dtMs);                      // 每帧一次
+     *   FrameStats::Summary s = stats.Compute(300);
+     *   stats.Recent(300, graph);             // 帧时间曲线
+     *   stats.Histogram(300, 50.0f, bins);    // bins.size() 个桶，覆盖 [0, 50) ms，超出的计入最后一个桶
+     *   stats.ExportCsv("frame_stats.csv", { 60, 300, 0 });
+     */
+    class FrameStats {
+    public:
+        static const size_t CAPACITY = 8192;
+
+        struct Summary {
+            size_t frames = 0;
+            double avgMs  = 0.0;
+            double minMs  = 0.0;
+            double p50Ms  = 0.0;
+            double p95Ms  = 0.0;
+            double p99Ms  = 0.0;
+            double maxMs  = 0.0;
+            double avgFps = 0.0;   // 1000 / avgMs，而不是各帧 FPS 的平均
+        };
+
+        void Add(float frameMs);
+        void Clear();
+
+        /// 当前保存的帧数（不超过 CAPACITY）
+        size_t Count() const { return m_Count; }
+        /// 累计记录过的帧数
+        uint64_t TotalFrames() const { return m_Total; }
+
+        /// 最近 window 帧的统计；window 为 0 或超过已保存帧数时使用全部保存的帧
+        Summary Compute(size_t window) const;
+
+        /// 最近 count 帧，按时间先后写入 out
+        void Recent(size_t count, std::vector<float>& out) const;
+
+        /// 最近 window 帧的直方图：bins 的大小决定桶数，桶宽 maxMs / bins.size()
+        void Histogram(size_t window, float maxMs, std::vector<float>& bins) const;
+
+        /// 写出 CSV：每个窗口一行统计（window 为 0 表示全部保存的帧）
+        bool ExportCsv(const std::string& path, const std::vector<size_t>& windows) const;
+        /// 写出 CSV：逐帧耗时（frame, ms），frame 为累计帧号
+        bool ExportSamplesCsv(const std::string& path) const;
+
+    private:
+        std::vector<float> m_Samples = std::vector<float>(CAPACITY, 0.0f);
+        size_t             m_Next  = 0;
+        size_t             m_Count = 0;
+        uint64_t           m_Total = 0;
+
+        mutable std::vector<float> m_Sorted;   // Compute 用的临时排序缓冲
+    };
+
+} // namespace core
@@ -0,0 +1,227 @@
+#include "HeadlessContext.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <glad/glad.h>
+
+#if defined(PBR_HEADLESS_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#elif defined(PBR_HEADLESS_OSMESA)
+#include <GL/osmesa.h>
+#else
+#include <GLFW/glfw3.h>
+#endif
+
+
+namespace core {
+
+    namespace {
+        // 扩展字符串是空格分隔的列表，按整词匹配
+        bool HasToken(const char* list, const char* token)
+        {
+            if (!list) return false;
+            const size_t length = std::strlen(token);
+            for (const char* p = std::strstr(list, token); p; p = std::strstr(p + length, token))
+            {
+                const bool startOk = p == list || p[-1] == ' ';
+                const bool endOk = p[length] == '\0' || p[length] == ' ';
+                if (startOk && endOk) return true;
+            }
+            return false;
+        }
+
+        [[noreturn]] void Fail(const char* message)
+        {
+            std::cerr << "[HeadlessContext] " << message << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+#if defined(PBR_HEADLESS_EGL)
+
+    HeadlessContext::HeadlessContext(int width, int height)
+        : m_Width(width), m_Height(height)
+    {
+        // 1. 显示：surfaceless 平台不需要 X11 / Wayland，也不需要 DRM 节点以外的任何东西
+        EGLDisplay display = EGL_NO_DISPLAY;
+        const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay && HasToken(clientExtensions, "EGL_MESA_platform_surfaceless"))
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display == EGL_NO_DISPLAY)
+            display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+        EGLint major = 0, minor = 0;
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+            Fail("Failed to initialize EGL display");
+        m_Display = display;
+
+        // 2. 桌面 OpenGL 而不是 GLES
+        if (!eglBindAPI(EGL_OPENGL_API))
+            Fail("EGL implementation does not support desktop OpenGL");
+
+        const bool surfaceless = HasToken(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE,    surfaceless ? 0 : EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, 24,
+            EGL_NONE
+        };
+        EGLConfig config = nullptr;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0)
+            Fail("No suitable EGL config");
+
+        // 3. 3.3 core 上下文
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (context == EGL_NO_CONTEXT)
+            Fail("Failed to create an OpenGL 3.3 core EGL context");
+        m_Context = context;
+
+        // 4. 不支持 surfaceless 时用 pbuffer 作为默认帧缓冲
+        EGLSurface surface = EGL_NO_SURFACE;
+        if (!surfaceless)
+        {
+            const EGLint pbufferAttribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+            surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+            if (surface == EGL_NO_SURFACE)
+                Fail("Failed to create EGL pbuffer surface");
+            m_Surface = surface;
+        }
+        if (!eglMakeCurrent(display, surface, surface, context))
+            Fail("eglMakeCurrent failed");
+
+        std::cout << "[HeadlessContext] EGL " << major << "." << minor
+                  << (surfaceless ? " (surfaceless)" : " (pbuffer)") << std::endl;
+        LoadGL();
+    }
+
+    HeadlessContext::~HeadlessContext()
+    {
+        EGLDisplay display = static_cast<EGLDisplay>(m_Display);
+        if (display == EGL_NO_DISPLAY) return;
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_Surface) eglDestroySurface(display, static_cast<EGLSurface>(m_Surface));
+        if (m_Context) eglDestroyContext(display, static_cast<EGLContext>(m_Context));
+        eglTerminate(display);
+    }
+
+    const char* HeadlessContext::BackendName() { return "EGL"; }
+
+    void* HeadlessContext::GetProcAddress(const char* name)
+    {
+        return reinterpret_cast<void*>(eglGetProcAddress(name));
+    }
+
+#elif defined(PBR_HEADLESS_OSMESA)
+
+    HeadlessContext::HeadlessContext(int width, int height)
+        : m_Width(width), m_Height(height)
+    {
+        const int attribs[] = {
+            OSMESA_FORMAT,                OSMESA_RGBA,
+            OSMESA_DEPTH_BITS,            24,
+            OSMESA_STENCIL_BITS,          8,
+            OSMESA_PROFILE,               OSMESA_CORE_PROFILE,
+            OSMESA_CONTEXT_MAJOR_VERSION, 3,
+            OSMESA_CONTEXT_MINOR_VERSION, 3,
+            0
+        };
+        OSMesaContext context = OSMesaCreateContextAttribs(attribs, nullptr);
+        if (!context)
+            Fail("Failed to create an OpenGL 3.3 core OSMesa context");
+        m_Context = context;
+
+        m_ColorBuffer.resize(static_cast<size_t>(width) * height * 4);
+        if (!OSMesaMakeCurrent(context, m_ColorBuffer.data(), GL_UNSIGNED_BYTE, width, height))
+            Fail("OSMesaMakeCurrent failed");
+
+        std::cout << "[HeadlessContext] OSMesa" << std::endl;
+        LoadGL();
+    }
+
+    HeadlessContext::~HeadlessContext()
+    {
+        if (m_Context)
+            OSMesaDestroyContext(static_cast<OSMesaContext>(m_Context));
+    }
+
+    const char* HeadlessContext::BackendName() { return "OSMesa"; }
+
+    void* HeadlessContext::GetProcAddress(const char* name)
+    {
+        return reinterpret_cast<void*>(OSMesaGetProcAddress(name));
+    }
+
+#else
+
+    HeadlessContext::HeadlessContext(int width, int height)
+        : m_Width(width), m_Height(height)
+    {
+        if (!glfwInit())
+            Fail("Failed to initialize GLFW");
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        GLFWwindow* window = glfwCreateWindow(width, height, "PBR Headless", nullptr, nullptr);
+        if (!window)
+        {
+            glfwTerminate();
+            Fail("Failed to create hidden GLFW window");
+        }
+        m_Context = window;
+        glfwMakeContextCurrent(window);
+
+        std::cout << "[HeadlessContext] Hidden GLFW window (build with PBR_HEADLESS_EGL or PBR_HEADLESS_OSMESA "
+                     "for display-less hosts)" << std::endl;
+        LoadGL();
+    }
+
+    HeadlessContext::~HeadlessContext()
+    {
+        if (m_Context)
+        {
+            glfwDestroyWindow(static_cast<GLFWwindow*>(m_Context));
+            glfwTerminate();
+        }
+    }
+
+    const char* HeadlessContext::BackendName() { return "GLFW (hidden)"; }
+
+    void* HeadlessContext::GetProcAddress(const char* name)
+    {
+        return reinterpret_cast<void*>(glfwGetProcAddress(name));
+    }
+
+#endif
+
+    void HeadlessContext::LoadGL()
+    {
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(GetProcAddress)))
+            Fail("Failed to initialize GLAD");
+
+        std::cout << "[HeadlessContext] " << glGetString(GL_RENDERER) << ", " << glGetString(GL_VERSION) << std::endl;
+
+        // 和 Window 相同的初始状态
+        glViewport(0, 0, m_Width, m_Height);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+} // namespace core
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+namespace core {
+
+    /**
+     * HeadlessContext
+     * ---------------
+     * 不创建可见窗口的 OpenGL 3.3 core 上下文，用于没有显示器的构建机上跑完整渲染管线和性能测试。
+     * 后端在编译时选择：
+     *  - PBR_HEADLESS_EGL：EGL。优先 surfaceless 平台（EGL_MESA_platform_surfaceless），
+     *    驱动支持 EGL_KHR_surfaceless_context 时不创建任何表面，否则创建一个 pbuffer；
+     *    有 GPU 时走硬件驱动，没有时 Mesa 自动回落到 llvmpipe。需链接 libEGL
+     *  - PBR_HEADLESS_OSMESA：OSMesa 软件渲染（llvmpipe），默认帧缓冲是一块内存。需链接 libOSMesa
+     *  - 都未定义：隐藏的 GLFW 窗口（仍需要显示环境，用于 Windows 上的自动化测试）
+     *
+     * 构造时把上下文设为当前并载入 glad，和 Window 一样，失败时直接退出进程。
+     * 渲染不依赖默认帧缓冲：调用方绑定自己的 FBO（renderer::RenderTarget），没有交换链。
+     */
+    class HeadlessContext {
+    public:
+        HeadlessContext(int width, int height);
+        ~HeadlessContext();
+
+        HeadlessContext(const HeadlessContext&) = delete;
+        HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+        /// 编译进来的后端名（"EGL" / "OSMesa" / "GLFW (hidden)"）
+        static const char* BackendName();
+
+        /// 当前后端的 GL 函数查询，可传给 gladLoadGLLoader / GLExtensions::Init
+        static void* GetProcAddress(const char* name);
+
+    private:
+        int   m_Width;
+        int   m_Height;
+        void* m_Display = nullptr;   // EGLDisplay
+        void* m_Surface = nullptr;   // EGLSurface（surfaceless 时为空）
+        void* m_Context = nullptr;   // EGLContext / OSMesaContext / GLFWwindow*
+        std::vector<unsigned char> m_ColorBuffer;   // OSMesa 的默认帧缓冲
+
+        // 载入 glad 并设置初始状态
+        void LoadGL();
+    };
+
+} // namespace core
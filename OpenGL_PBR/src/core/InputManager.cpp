@@ -139,6 +139,14 @@ namespace core {
                 // 下次右键再按下时会重新初始化 m_FirstMouse
             }
         }
+        else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
+            // 点在 ImGui 窗口上时不拾取
+            if (m_PickCallback && !ImGui::GetIO().WantCaptureMouse) {
+                double xpos, ypos;
+                glfwGetCursorPos(m_Window, &xpos, &ypos);
+                m_PickCallback(xpos, ypos);
+            }
+        }
     }
 
     // 实例方法：在滚轮滚动时调用 Camera::ProcessMouseScroll
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <functional>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -30,11 +31,15 @@ namespace core {
         // 滚轮滚动回调（GLFW 调用）
         static void ScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
 
+        // 拾取回调：左键在场景上（非 ImGui 窗口）点击时，以光标窗口坐标调用
+        using PickCallback = std::function<void(double xpos, double ypos)>;
+        void SetPickCallback(PickCallback callback) { m_PickCallback = std::move(callback); }
+
     private:
         // 只有在鼠标右键按下时才对摄像机进行旋转
         void OnMouseMove(double xpos, double ypos);
 
-        // 只有鼠标右键按下/松开时，切换光标模式
+        // 只有鼠标右键按下/松开时，切换光标模式；左键按下时触发拾取
         void OnMouseButton(int button, int action);
 
         // 始终响应滚轮缩放
@@ -50,6 +55,8 @@ namespace core {
 
         // 记录上一次鼠标右键状态
         bool   m_RButtonPressedLastFrame;
+
+        PickCallback m_PickCallback;
     };
 
 } // namespace core
@@ -0,0 +1,310 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "AllocationTracker.h"
+#include "Profiler.h"
+
+
+namespace core {
+
+    struct JobSystem::State {
+        // 环形缓冲的双端队列：只在装满时扩容，不像 std::deque 那样随进出反复分配 / 释放块，
+        // 帧循环里提交作业因此不产生堆分配
+        struct TaskRing {
+            std::vector<JobCounter::Task> slots = std::vector<JobCounter::Task>(64);
+            size_t                        head = 0;   // 最早入队的作业
+            size_t                        size = 0;
+
+            bool empty() const { return size == 0; }
+
+            void push_back(JobCounter::Task&& task)
+            {
+                if (size == slots.size()) {
+                    std::vector<JobCounter::Task> grown(slots.size() * 2);
+                    for (size_t i = 0; i < size; ++i)
+                        grown[i] = std::move(slots[(head + i) % slots.size()]);
+                    slots.swap(grown);
+                    head = 0;
+                }
+                slots[(head + size) % slots.size()] = std::move(task);
+                ++size;
+            }
+
+            JobCounter::Task pop_back()
+            {
+                --size;
+                return std::move(slots[(head + size) % slots.size()]);
+            }
+
+            JobCounter::Task pop_front()
+            {
+                JobCounter::Task task = std::move(slots[head]);
+                head = (head + 1) % slots.size();
+                --size;
+                return task;
+            }
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            TaskRing   tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;    // 0 号给主线程等非工作线程，1..N 对应工作线程
+        std::vector<std::thread>            threads;
+
+        std::atomic<bool>     running{ true };
+        std::atomic<int>      queued{ 0 };             // 所有队列里的作业总数，工作线程据此决定是否休眠
+        std::mutex            sleepMutex;
+        std::condition_variable wake;
+
+        std::atomic<uint64_t> executed{ 0 };
+        std::atomic<uint64_t> stolen{ 0 };
+    };
+
+    JobSystem::State* JobSystem::s_State = nullptr;
+
+    namespace {
+        // 当前线程的队列编号；非工作线程都是 0
+        thread_local unsigned int t_Queue = 0;
+    }
+
+    void JobSystem::Initialize(int workerThreads)
+    {
+        if (s_State) return;
+
+        unsigned int workers = workerThreads >= 0
+            ? static_cast<unsigned int>(workerThreads)
+            : std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+        s_State = new State();
+        for (unsigned int i = 0; i <= workers; ++i)
+            s_State->queues.push_back(std::make_unique<State::Queue>());
+        for (unsigned int i = 1; i <= workers; ++i)
+            s_State->threads.emplace_back(WorkerLoop, i);
+
+        std::cout << "[JobSystem] Started " << workers << " worker thread(s)" << std::endl;
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (!s_State) return;
+
+        // 先把剩下的作业做完，挂在计数上的后续作业也会在这期间入队
+        while (TryExecute(0)) {}
+        {
+            std::lock_guard<std::mutex> lock(s_State->sleepMutex);
+            s_State->running = false;
+        }
+        s_State->wake.notify_all();
+        for (auto& t : s_State->threads)
+            t.join();
+
+        delete s_State;
+        s_State = nullptr;
+    }
+
+    unsigned int JobSystem::ThreadCount()
+    {
+        return s_State ? static_cast<unsigned int>(s_State->queues.size()) : 1u;
+    }
+
+    void JobSystem::Run(Job job, JobCounter* counter, JobCounter* dependency)
+    {
+        if (!s_State) {
+            // 未初始化：同步执行；依赖此时必然已经完成
+            job();
+            return;
+        }
+
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        JobCounter::Task task{ std::move(job), counter };
+        if (dependency) {
+            std::lock_guard<std::mutex> lock(dependency->m_Mutex);
+            if (!dependency->Done()) {
+                dependency->m_Continuations.push_back(std::move(task));
+                return;
+            }
+        }
+        Push(std::move(task));
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        while (!counter.Done()) {
+            if (!s_State || !TryExecute(t_Queue))
+                std::this_thread::yield();
+        }
+        // Finish 减到 0 时还持有计数的锁，这里等它放开，调用方之后才能安全地销毁计数
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
+    }
+
+    void JobSystem::ParallelForImpl(size_t count, size_t grain, RangeFn fn, const void* context)
+    {
+        if (count == 0) return;
+
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (count + grain - 1) / grain;
+        if (!s_State || chunks < 2) {
+            fn(context, 0, count);
+            return;
+        }
+
+        // 块数取线程数的 4 倍：块太少时一个慢块就拖住整体，太多则调度开销变大
+        chunks = std::min<size_t>(chunks, static_cast<size_t>(ThreadCount()) * 4);
+        const size_t step = (count + chunks - 1) / chunks;
+
+        // 每块的作业只捕获 range 的地址和起点（16 字节），放得进 std::function 的内部缓冲，不分配堆内存
+        struct Range { RangeFn fn; const void* context; size_t step; size_t count; };
+        const Range range{ fn, context, step, count };
+
+        JobCounter counter;
+        for (size_t begin = step; begin < count; begin += step) {
+            Run([&range, begin]() {
+                range.fn(range.context, begin, std::min(begin + range.step, range.count));
+            }, &counter);
+        }
+        fn(context, 0, std::min(step, count));
+        Wait(counter);
+    }
+
+    JobSystem::Stats JobSystem::GetStats()
+    {
+        Stats stats;
+        if (s_State) {
+            stats.executed = s_State->executed.load(std::memory_order_relaxed);
+            stats.stolen   = s_State->stolen.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    void JobSystem::Push(JobCounter::Task task)
+    {
+        State& state = *s_State;
+        {
+            State::Queue& queue = *state.queues[t_Queue];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+            state.queued.fetch_add(1, std::memory_order_release);
+        }
+        // 经过一次 sleepMutex，保证正在进入休眠的线程不会错过这次唤醒
+        { std::lock_guard<std::mutex> lock(state.sleepMutex); }
+        state.wake.notify_one();
+    }
+
+    bool JobSystem::TryExecute(unsigned int queueIndex)
+    {
+        State& state = *s_State;
+        const unsigned int queueCount = static_cast<unsigned int>(state.queues.size());
+
+        JobCounter::Task task;
+        bool found = false;
+        {
+            // 自己的队列：从尾部取，刚提交的作业数据还在缓存里
+            State::Queue& own = *state.queues[queueIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = own.tasks.pop_back();
+                state.queued.fetch_sub(1, std::memory_order_relaxed);
+                found = true;
+            }
+        }
+        for (unsigned int i = 1; !found && i < queueCount; ++i) {
+            // 偷别人的：从头部取，通常是较早提交、粒度较大的作业
+            State::Queue& victim = *state.queues[(queueIndex + i) % queueCount];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.pop_front();
+                state.queued.fetch_sub(1, std::memory_order_relaxed);
+                state.stolen.fetch_add(1, std::memory_order_relaxed);
+                found = true;
+            }
+        }
+        if (!found) return false;
+
+        {
+            PBR_PROFILE_SCOPE("Job");
+            task.fn();
+        }
+        state.executed.fetch_add(1, std::memory_order_relaxed);
+        Finish(task.counter);
+        return true;
+    }
+
+    void JobSystem::Finish(JobCounter* counter)
+    {
+        if (!counter) return;
+
+        std::vector<JobCounter::Task> ready;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_Mutex);
+            if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ready.swap(counter->m_Continuations);
+        }
+        // 放开锁之后不再访问 counter：Wait 返回后它可能已经被销毁
+        for (auto& task : ready)
+            Push(std::move(task));
+    }
+
+    void JobSystem::WorkerLoop(unsigned int queue)
+    {
+        t_Queue = queue;
+        const std::string name = "Job Worker " + std::to_string(queue);
+        Profiler::SetThreadName(name);
+        AllocationTracker::SetThreadName(name.c_str());
+        State& state = *s_State;
+        for (;;) {
+            if (TryExecute(queue))
+                continue;
+
+            std::unique_lock<std::mutex> lock(state.sleepMutex);
+            state.wake.wait(lock, [&state]() {
+                return state.queued.load(std::memory_order_acquire) > 0 || !state.running;
+            });
+            if (!state.running && state.queued.load(std::memory_order_acquire) == 0)
+                break;
+        }
+    }
+
+    std::vector<JobSystem::ScalingResult> JobSystem::BenchmarkScaling(const std::function<void()>& workload,
+                                                                      int iterations, unsigned int maxThreads)
+    {
+        const bool wasRunning = IsRunning();
+        const int previousWorkers = static_cast<int>(ThreadCount()) - 1;
+        if (maxThreads == 0)
+            maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        iterations = std::max(iterations, 1);
+
+        std::vector<ScalingResult> results;
+        for (unsigned int threads = 1; threads <= maxThreads; ++threads) {
+            Shutdown();
+            Initialize(static_cast<int>(threads) - 1);
+
+            workload();   // 预热
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < iterations; ++i)
+                workload();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            ScalingResult r;
+            r.threads = threads;
+            r.ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+            r.speedup = results.empty() ? 1.0 : results.front().ms / r.ms;
+            results.push_back(r);
+        }
+
+        Shutdown();
+        if (wasRunning)
+            Initialize(previousWorkers);
+        return results;
+    }
+
+} // namespace core
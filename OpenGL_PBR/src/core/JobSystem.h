@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+namespace core {
+
+    class JobSystem;
+
+    /// 一组作业的完成计数：Run 时加一，作业执行完减一，归零表示这组作业全部完成。
+    /// 也可以作为其他作业的依赖（见 JobSystem::Run 的 dependency 参数）
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool Done() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        struct Task {
+            std::function<void()> fn;
+            JobCounter*           counter;
+        };
+
+        std::atomic<int>      m_Pending{ 0 };
+        std::mutex            m_Mutex;
+        std::vector<Task>     m_Continuations;   // 依赖此计数的作业，归零时才提交
+    };
+
+    /**
+     * JobSystem
+     * ---------
+     * 工作窃取（work-stealing）作业系统，全局只有一个（静态接口，和 GLExtensions 一样）：
+     *  - 每个工作线程一个双端队列：自己从尾部取（后进先出，缓存更热），空闲时从其他线程队列的头部偷
+     *  - 主线程（以及其他非工作线程）共用 0 号队列；Wait 时调用线程也会执行作业，不会干等
+     *  - 作业可以依赖一个 JobCounter：依赖未完成时作业挂在该计数上，归零后再入队
+     *  - ParallelFor 把区间切块分发，块数按线程数的几倍取，负载不均时由窃取补齐
+     *
+     * 未 Initialize 时所有接口都退化为在当前线程直接执行，CPU 端算法（剔除、分簇等）因此可以无条件调用。
+     * 作业内不能调用 OpenGL（上下文只在主线程），纹理之类的工作拆成“作业解码 + 主线程上传”两步。
+     */
+    class JobSystem {
+    public:
+        using Job = std::function<void()>;
+
+        /// 启动 workerThreads 个工作线程；负数表示 hardware_concurrency - 1（主线程也参与执行）。
+        /// 0 个工作线程时作业全部由 Wait 的调用线程执行（基准测试里作为单线程的对照）
+        static void Initialize(int workerThreads = -1);
+        /// 执行完剩余作业后停止并回收所有工作线程
+        static void Shutdown();
+
+        static bool IsRunning() { return s_State != nullptr; }
+        /// 参与执行作业的线程数（工作线程 + 调用线程）；未初始化时为 1
+        static unsigned int ThreadCount();
+
+        /// 提交一个作业。counter 非空时计入该计数；dependency 非空且未归零时，等它归零后才开始执行
+        static void Run(Job job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+        /// 等到 counter 归零；等待期间当前线程执行队列里的作业（可以在作业内嵌套调用）
+        static void Wait(JobCounter& counter);
+
+        /// 把 [0, count) 切成每块至少 grain 个元素的若干块，并行调用 fn(begin, end)，返回时全部完成。
+        /// 元素不足两块或未初始化时直接在当前线程执行。
+        /// fn 按引用传给各块，不转换成 std::function，捕获再多也不会分配堆内存
+        template <typename Fn>
+        static void ParallelFor(size_t count, size_t grain, const Fn& fn)
+        {
+            ParallelForImpl(count, grain, [](const void* context, size_t begin, size_t end) {
+                (*static_cast<const Fn*>(context))(begin, end);
+            }, &fn);
+        }
+
+        struct Stats {
+            uint64_t executed = 0;   // 执行过的作业数
+            uint64_t stolen   = 0;   // 其中从其他线程队列偷来的
+        };
+        static Stats GetStats();
+
+        struct ScalingResult {
+            unsigned int threads = 0;
+            double       ms      = 0.0;   // 每次 workload 的平均耗时
+            double       speedup = 0.0;   // 相对单线程
+        };
+
+        /// 依次用 1..maxThreads 个线程（0 = hardware_concurrency）重复执行 workload iterations 次，
+        /// 结束后恢复原来的线程数。必须在主线程、没有未完成作业时调用
+        static std::vector<ScalingResult> BenchmarkScaling(const std::function<void()>& workload,
+                                                           int iterations, unsigned int maxThreads = 0);
+
+    private:
+        struct State;
+        static State* s_State;
+
+        using RangeFn = void (*)(const void* context, size_t begin, size_t end);
+        static void ParallelForImpl(size_t count, size_t grain, RangeFn fn, const void* context);
+
+        static void Push(JobCounter::Task task);
+        static bool TryExecute(unsigned int queue);
+        static void Finish(JobCounter* counter);
+        static void WorkerLoop(unsigned int queue);
+    };
+
+} // namespace core
@@ -0,0 +1,311 @@
+#include "Profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace core {
+
+    namespace {
+
+        struct Event {
+            const char* name;
+            int64_t     start;
+            int64_t     end;
+        };
+
+        // 一个线程的事件缓冲：只有所属线程写入，count 用 release 发布，导出时用 acquire 读取
+        struct ThreadBuffer {
+            static const uint32_t CAPACITY = 1u << 16;
+
+            uint32_t                 tid = 0;
+            std::string              name;
+            std::unique_ptr<Event[]> events{ new Event[CAPACITY] };
+            std::atomic<uint32_t>    count{ 0 };
+            std::atomic<uint32_t>    dropped{ 0 };
+            std::deque<uint32_t>     frameStarts;   // 滚动录制：最近几帧各自在缓冲中的起始位置
+
+            void Reset()
+            {
+                count.store(0, std::memory_order_relaxed);
+                dropped.store(0, std::memory_order_relaxed);
+                frameStarts.clear();
+            }
+
+            // 新的一帧从 count 处开始；只保留包括它在内的最近 frames 帧，更早的事件整体前移覆盖掉
+            void Trim(unsigned int frames)
+            {
+                const uint32_t n = count.load(std::memory_order_acquire);
+                frameStarts.push_back(n);
+                if (frameStarts.size() <= frames) return;
+
+                frameStarts.pop_front();
+                const uint32_t drop = frameStarts.front();
+                if (drop == 0) return;
+                std::memmove(events.get(), events.get() + drop, (n - drop) * sizeof(Event));
+                for (uint32_t& start : frameStarts)
+                    start -= drop;
+                count.store(n - drop, std::memory_order_release);
+            }
+
+            void Push(const char* eventName, int64_t start, int64_t end)
+            {
+                const uint32_t n = count.load(std::memory_order_relaxed);
+                if (n >= CAPACITY)
+                {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                events[n] = Event{ eventName, start, end };
+                count.store(n + 1, std::memory_order_release);
+            }
+        };
+
+        const uint32_t GPU_TID = 1000;
+
+        std::atomic<bool>         s_Capturing{ false };
+        std::atomic<bool>         s_Recording{ false };   // 显式录制或滚动录制
+        std::atomic<unsigned int> s_CaptureId{ 0 };
+        unsigned int              s_RollingFrames = 0;
+        unsigned int              s_FrameLimit = 0;
+        unsigned int              s_Frames = 0;
+        std::string               s_Path;
+        Profiler::CaptureInfo     s_LastCapture;
+
+        // 线程缓冲在线程命名或第一次记录时注册，之后一直保留（线程退出后其事件仍可导出）
+        std::mutex                                 s_RegistryMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> s_Buffers;
+        ThreadBuffer*                              s_GpuBuffer = nullptr;
+
+        thread_local ThreadBuffer* t_Buffer = nullptr;
+        thread_local std::string   t_Name;
+
+        const auto s_Epoch = std::chrono::steady_clock::now();
+
+        ThreadBuffer* RegisterBuffer(const std::string& name, uint32_t tid)
+        {
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->tid = tid ? tid : static_cast<uint32_t>(s_Buffers.size() + 1);
+            buffer->name = name.empty() ? "Thread " + std::to_string(buffer->tid) : name;
+            s_Buffers.push_back(std::move(buffer));
+            return s_Buffers.back().get();
+        }
+
+        void WriteEscaped(FILE* file, const char* text)
+        {
+            for (const char* c = text; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\') fputc('\\', file);
+                if (static_cast<unsigned char>(*c) >= 0x20) fputc(*c, file);
+            }
+        }
+
+        void ResetBuffers()
+        {
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            for (auto& buffer : s_Buffers)
+                buffer->Reset();
+        }
+
+        // 把所有线程缓冲中的事件写成 trace_event JSON，事件数和丢弃数累加到 info
+        bool WriteTrace(const std::string& path, Profiler::CaptureInfo& info)
+        {
+            FILE* file = std::fopen(path.c_str(), "w");
+            if (!file)
+            {
+                std::cerr << "[Profiler] Failed to open trace file: " << path << std::endl;
+                return false;
+            }
+
+            // trace_event 格式：ph "X" 为完整事件，ts / dur 单位为微秒；ph "M" 给线程命名
+            std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+            bool first = true;
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            for (const auto& buffer : s_Buffers)
+            {
+                const uint32_t count = buffer->count.load(std::memory_order_acquire);
+                info.dropped += buffer->dropped.load(std::memory_order_relaxed);
+                if (count == 0) continue;
+
+                std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                             first ? "" : ",\n", buffer->tid);
+                WriteEscaped(file, buffer->name.c_str());
+                std::fputs("\"}}", file);
+                std::fprintf(file, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}",
+                             buffer->tid, buffer->tid);
+                first = false;
+
+                const char* category = buffer.get() == s_GpuBuffer ? "gpu" : "cpu";
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const Event& e = buffer->events[i];
+                    std::fputs(",\n{\"name\":\"", file);
+                    WriteEscaped(file, e.name);
+                    std::fprintf(file, "\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                                 category, buffer->tid, e.start / 1000.0, (e.end - e.start) / 1000.0);
+                }
+                info.events += count;
+            }
+            std::fputs("\n]}\n", file);
+            info.written = std::fclose(file) == 0;
+            return info.written;
+        }
+    }
+
+    void Profiler::BeginCapture(unsigned int frames, const std::string& path)
+    {
+        ResetBuffers();
+        s_FrameLimit = frames;
+        s_Frames = 0;
+        s_Path = path;
+        s_CaptureId.fetch_add(1, std::memory_order_relaxed);
+        s_Capturing.store(true, std::memory_order_release);
+        s_Recording.store(true, std::memory_order_release);
+        std::cout << "[Profiler] Capture started"
+                  << (frames ? " for " + std::to_string(frames) + " frames" : std::string()) << std::endl;
+    }
+
+    bool Profiler::EndCapture()
+    {
+        if (!s_Capturing.exchange(false, std::memory_order_acq_rel))
+            return false;
+
+        s_LastCapture = CaptureInfo();
+        s_LastCapture.path = s_Path;
+        s_LastCapture.frames = s_Frames;
+        const bool ok = WriteTrace(s_Path, s_LastCapture);
+        if (ok)
+            std::cout << "[Profiler] Wrote " << s_LastCapture.events << " events (" << s_LastCapture.frames
+                      << " frames, " << s_LastCapture.dropped << " dropped) to " << s_Path << std::endl;
+
+        // 滚动录制仍开着时从空缓冲重新开始
+        ResetBuffers();
+        s_Recording.store(s_RollingFrames > 0, std::memory_order_release);
+        return ok;
+    }
+
+    bool Profiler::IsCapturing()
+    {
+        return s_Capturing.load(std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsRecording()
+    {
+        return s_Recording.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::SetRollingWindow(unsigned int frames)
+    {
+        if (frames == s_RollingFrames) return;
+
+        const bool wasRecording = IsRecording();
+        s_RollingFrames = frames;
+        if (IsCapturing()) return;   // 显式录制结束时再按新设置切换
+
+        ResetBuffers();
+        if (frames > 0 && !wasRecording)
+            s_CaptureId.fetch_add(1, std::memory_order_relaxed);
+        s_Recording.store(frames > 0, std::memory_order_release);
+    }
+
+    unsigned int Profiler::RollingWindow()
+    {
+        return s_RollingFrames;
+    }
+
+    bool Profiler::DumpRecent(const std::string& path)
+    {
+        if (IsCapturing() || s_RollingFrames == 0)
+            return false;
+
+        s_LastCapture = CaptureInfo();
+        s_LastCapture.path = path;
+        {
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            for (const auto& buffer : s_Buffers)
+            {
+                const unsigned int frames = static_cast<unsigned int>(buffer->frameStarts.size());
+                if (frames > s_LastCapture.frames) s_LastCapture.frames = frames;
+            }
+        }
+        const bool ok = WriteTrace(path, s_LastCapture);
+        if (ok)
+            std::cout << "[Profiler] Dumped last " << s_LastCapture.frames << " frames ("
+                      << s_LastCapture.events << " events) to " << path << std::endl;
+        return ok;
+    }
+
+    void Profiler::MarkFrame()
+    {
+        if (IsCapturing())
+        {
+            ++s_Frames;
+            if (s_FrameLimit > 0 && s_Frames >= s_FrameLimit)
+                EndCapture();
+            return;
+        }
+        if (s_RollingFrames == 0) return;
+
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        for (auto& buffer : s_Buffers)
+            buffer->Trim(s_RollingFrames);
+    }
+
+    void Profiler::SetThreadName(const std::string& name)
+    {
+        // 命名时就注册缓冲：主线程最先命名，在 trace 里排在最上面
+        t_Name = name;
+        if (!t_Buffer)
+        {
+            t_Buffer = RegisterBuffer(name, 0);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        t_Buffer->name = name;
+    }
+
+    int64_t Profiler::NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Epoch).count();
+    }
+
+    void Profiler::Record(const char* name, int64_t startNs, int64_t endNs)
+    {
+        if (!IsRecording()) return;
+        if (!t_Buffer)
+            t_Buffer = RegisterBuffer(t_Name, 0);
+        t_Buffer->Push(name, startNs, endNs);
+    }
+
+    void Profiler::RecordGpu(const char* name, int64_t startNs, int64_t endNs)
+    {
+        if (!IsRecording()) return;
+        if (!s_GpuBuffer)
+            s_GpuBuffer = RegisterBuffer("GPU", GPU_TID);
+        s_GpuBuffer->Push(name, startNs, endNs);
+    }
+
+    unsigned int Profiler::CaptureId()
+    {
+        return s_CaptureId.load(std::memory_order_relaxed);
+    }
+
+    const Profiler::CaptureInfo& Profiler::LastCapture()
+    {
+        return s_LastCapture;
+    }
+
+    unsigned int Profiler::CapturedFrames()
+    {
+        return s_Frames;
+    }
+
+} // namespace core
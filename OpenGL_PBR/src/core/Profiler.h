@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+
+namespace core {
+
+    /**
+     * Profiler
+     * --------
+     * 插桩式 CPU 分析器，录制结果导出为 Chrome trace_event JSON（chrome://tracing、Perfetto 可直接打开）。
+     *  - 作用域用 PBR_PROFILE_SCOPE("名字") 标记，析构时记一条完整事件（开始时间 + 时长）
+     *  - 每个线程一块固定容量的事件缓冲，只有本线程写入，写入无锁；缓冲写满后的事件丢弃并计数
+     *  - 不在录制时作用域只读一次原子标志，开销可以忽略
+     *  - GPU 计时（GpuProfiler）换算到 CPU 时基后写入单独的 "GPU" 轨道，和 CPU 事件在同一条时间线上
+     *
+     * 录制：
+     *   Profiler::BeginCapture(300, "trace.json");   // 300 帧后自动写文件；0 表示直到 EndCapture
+     *   每帧调用 Profiler::MarkFrame()
+     *
+     * 滚动录制：SetRollingWindow(n) 后一直记录，但每次 MarkFrame 只保留最近 n 帧的事件；
+     * 发现卡顿帧时用 DumpRecent 把这几帧写出去（帧时间的尖刺捕获用它）。显式录制优先，期间滚动录制暂停。
+     *
+     * BeginCapture / EndCapture / SetRollingWindow / DumpRecent / MarkFrame 需在主线程、没有作业在执行时调用（帧与帧之间）。
+     * 事件名必须是字符串常量（只保存指针）。
+     */
+    class Profiler {
+    public:
+        /// 开始录制；frames > 0 时录满这么多帧后自动写出到 path
+        static void BeginCapture(unsigned int frames = 0, const std::string& path = "trace.json");
+        /// 停止录制并写出 JSON；没有在录制或写文件失败时返回 false
+        static bool EndCapture();
+        /// 是否在显式录制（BeginCapture 开始的）
+        static bool IsCapturing();
+        /// 是否在记录事件：显式录制或滚动录制
+        static bool IsRecording();
+
+        /// 滚动录制保留的帧数，0 关闭
+        static void SetRollingWindow(unsigned int frames);
+        static unsigned int RollingWindow();
+        /// 把滚动录制保留的最近几帧写出到 path，不中断录制；显式录制期间或未开滚动录制时返回 false
+        static bool DumpRecent(const std::string& path);
+
+        /// 每帧开始时调用一次：累计帧数，到达 BeginCapture 指定的帧数时自动 EndCapture；
+        /// 滚动录制时丢掉超出窗口的旧帧
+        static void MarkFrame();
+
+        /// 当前线程在 trace 中显示的名字
+        static void SetThreadName(const std::string& name);
+
+        /// 单调时钟，纳秒
+        static int64_t NowNs();
+
+        /// 记录当前线程的一个事件 [startNs, endNs)
+        static void Record(const char* name, int64_t startNs, int64_t endNs);
+        /// 记录 GPU 轨道上的一个事件（时间已换算为 NowNs 的时基），只能在主线程调用
+        static void RecordGpu(const char* name, int64_t startNs, int64_t endNs);
+
+        /// 每次 BeginCapture 或开启滚动录制时加一；GPU 计时据此判断是否需要重新校准时钟偏移
+        static unsigned int CaptureId();
+
+        /// 上一次写出的录制（EndCapture 或 DumpRecent）
+        struct CaptureInfo {
+            std::string  path;
+            size_t       events  = 0;
+            unsigned int dropped = 0;   // 因缓冲写满丢弃的事件
+            unsigned int frames  = 0;
+            bool         written = false;
+        };
+        static const CaptureInfo& LastCapture();
+        /// 正在录制时已录的帧数
+        static unsigned int CapturedFrames();
+    };
+
+    /// 作用域事件：构造时取开始时间，析构时记录；不在记录时什么也不做
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name)
+            : m_Name(name), m_Start(Profiler::IsRecording() ? Profiler::NowNs() : -1) {}
+        ~ProfileScope()
+        {
+            if (m_Start >= 0)
+                Profiler::Record(m_Name, m_Start, Profiler::NowNs());
+        }
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_Name;
+        int64_t     m_Start;
+    };
+
+} // namespace core
+
+#define PBR_PROFILE_CONCAT_INNER(a, b) a##b
+#define PBR_PROFILE_CONCAT(a, b) PBR_PROFILE_CONCAT_INNER(a, b)
+/// 为当前作用域记录一个 CPU 事件
+#define PBR_PROFILE_SCOPE(name) ::core::ProfileScope PBR_PROFILE_CONCAT(pbrProfileScope_, __LINE__)(name)
+#define PBR_PROFILE_FUNCTION() PBR_PROFILE_SCOPE(__FUNCTION__)
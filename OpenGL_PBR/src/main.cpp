@@ -1,7 +1,125 @@
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+
 #include "core/Application.h"
+#include "core/HeadlessContext.h"
+#include "core/Profiler.h"
+#include "renderer/GLTrace.h"
+#include "renderer/GLTracePlayer.h"
+#include "renderer/NullGL.h"
+
+// 重放 .pbrtrace：不构造 Application、不读任何资源，只创建和录制时同样大小的无窗口上下文（或 Null GL）
+static int PlayTrace(const std::string& path, renderer::GLTracePlayer::Options options, bool nullGL) {
+    renderer::GLTracePlayer player;
+    if (!player.Load(path))
+        return 1;
+
+    std::unique_ptr<core::HeadlessContext> context;
+    if (nullGL) {
+        if (!renderer::NullGL::Load())
+            return 1;
+        // 没有 GPU 时间，也没有像素可读
+        options.gpuTiming = false;
+        options.imagePath.clear();
+    } else {
+        context = std::make_unique<core::HeadlessContext>(player.Width(), player.Height());
+    }
+    return player.Run(options) ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    int width = 1280, height = 720;
+    bool headless = false;
+    bool nullGL = false;
+    bool expectZeroAlloc = false;
+    unsigned int headlessFrames = 300;
+    std::string replayPath;
+    std::string modelPath;
+    std::string tracePath;
+    renderer::GLTracePlayer::Options traceOptions;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        // --trace[=帧数]：从启动开始录制 CPU / GPU 时间线（包含资源加载），录满后写出 trace.json
+        if (arg == "--trace" || arg.rfind("--trace=", 0) == 0) {
+            unsigned int frames = 300;
+            if (arg.size() > 8)
+                frames = static_cast<unsigned int>(std::stoul(arg.substr(8)));
+            core::Profiler::BeginCapture(frames, "trace.json");
+        }
+        // --headless[=帧数]：不创建窗口，渲染到离屏 FBO，结束后写出帧时间统计（给没有显示器的性能测试机用）
+        else if (arg == "--headless" || arg.rfind("--headless=", 0) == 0) {
+            headless = true;
+            if (arg.size() > 11)
+                headlessFrames = static_cast<unsigned int>(std::stoul(arg.substr(11)));
+        }
+        // --null-gl：无窗口运行且不创建 GL 上下文，所有 GL 调用进入空实现，帧时间只包含 CPU 提交开销
+        else if (arg == "--null-gl") {
+            nullGL = true;
+        }
+        // --expect-zero-alloc：无窗口运行时预热之后的任何一帧有堆分配就以退出码 1 结束（CI 回归检查）
+        else if (arg == "--expect-zero-alloc") {
+            expectZeroAlloc = true;
+        }
+        // --model=文件：用 Assimp 能读的模型文件替换默认的程序生成地面
+        else if (arg.rfind("--model=", 0) == 0) {
+            modelPath = arg.substr(8);
+        }
+        // --replay[=文件]：启动后回放录制的相机路径并写出 replay_report.csv；和 --headless 一起用时回放完即退出
+        else if (arg == "--replay" || arg.rfind("--replay=", 0) == 0) {
+            replayPath = arg.size() > 9 ? arg.substr(9) : std::string("camera_path.campath");
+        }
+        // --capture-frames=N[,跳过帧数]：把 GL 命令流和引用的数据录成 frame_capture.pbrtrace（从启动开始录，资源都包含在内）
+        else if (arg.rfind("--capture-frames=", 0) == 0) {
+            unsigned int frames = 0, skip = 0;
+            if (std::sscanf(arg.c_str() + 17, "%u,%u", &frames, &skip) < 1 || frames == 0) {
+                std::fprintf(stderr, "Invalid --capture-frames, expected N[,SKIP]: %s\n", arg.c_str());
+                return 1;
+            }
+            renderer::GLTrace::RequestCapture("frame_capture.pbrtrace", frames, skip);
+        }
+        // --play-trace=文件：离线重放录下的帧并逐个 draw / pass 计时，写出 trace_replay.csv 和 trace_frame.ppm
+        else if (arg.rfind("--play-trace=", 0) == 0) {
+            tracePath = arg.substr(13);
+        }
+        // --loops=N：重放时录下的帧重复执行的次数
+        else if (arg.rfind("--loops=", 0) == 0) {
+            traceOptions.loops = static_cast<unsigned int>(std::stoul(arg.substr(8)));
+        }
+        // --skip-draw=i,j,...：重放时跳过每帧中这些序号的 draw call
+        else if (arg.rfind("--skip-draw=", 0) == 0) {
+            std::stringstream list(arg.substr(12));
+            std::string item;
+            while (std::getline(list, item, ','))
+                traceOptions.skipDraws.push_back(static_cast<unsigned int>(std::stoul(item)));
+        }
+        // --skip-pass=名字：重放时跳过该 pass（GPU 计时区间）内的 draw / 清屏 / blit，可重复
+        else if (arg.rfind("--skip-pass=", 0) == 0) {
+            traceOptions.skipPasses.push_back(arg.substr(12));
+        }
+        // --size=宽x高：窗口或离屏渲染目标的尺寸
+        else if (arg.rfind("--size=", 0) == 0) {
+            if (std::sscanf(arg.c_str() + 7, "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+                std::fprintf(stderr, "Invalid --size, expected WIDTHxHEIGHT: %s\n", arg.c_str());
+                return 1;
+            }
+        }
+    }
+
+    if (!tracePath.empty())
+        return PlayTrace(tracePath, traceOptions, nullGL);
 
-int main() {
-    Application app(1280, 720, "PBR Demo");
-    app.Run();
+    Application app(width, height, "PBR Demo", headless, nullGL);
+    if (!modelPath.empty() && !app.LoadSceneModel(modelPath))
+        return 1;
+    if (!replayPath.empty() && !app.StartPathReplay(replayPath))
+        return 1;
+    if (headless || nullGL) {
+        if (!app.RunHeadless(headlessFrames) && expectZeroAlloc)
+            return 1;
+    } else
+        app.Run();
     return 0;
 }
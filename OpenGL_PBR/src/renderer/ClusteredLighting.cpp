@@ -0,0 +1,114 @@
+#include "ClusteredLighting.h"
+#include "GpuMemory.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace renderer {
+
+    ClusteredLighting::~ClusteredLighting()
+    {
+        glDeleteTextures(2, m_Textures);
+        glDeleteBuffers(2, m_Buffers);
+    }
+
+    void ClusteredLighting::CreateBuffers()
+    {
+        GpuMemory::Scope memoryTag("Lights");
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &m_MaxTexels);
+        glGenBuffers(2, m_Buffers);
+        glGenTextures(2, m_Textures);
+    }
+
+    void ClusteredLighting::Upload(unsigned int index, GLenum format, const void* data, size_t bytes)
+    {
+        // 空缓冲纹理在部分驱动上会报错，至少保留 16 字节；每帧整体重新分配（孤立旧存储，避免等待 GPU）
+        static const uint32_t empty[4] = {};
+        if (bytes == 0)
+        {
+            data = empty;
+            bytes = sizeof(empty);
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, m_Buffers[index]);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(bytes), data, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_Textures[index]);
+        glTexBuffer(GL_TEXTURE_BUFFER, format, m_Buffers[index]);
+        m_BufferBytes += bytes;
+    }
+
+    void ClusteredLighting::Update(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane,
+                                   int screenWidth, int screenHeight, const LightManager& lights)
+    {
+        if (m_Buffers[0] == 0)
+            CreateBuffers();
+
+        m_View = view;
+        m_ScreenWidth = std::max(1, screenWidth);
+        m_ScreenHeight = std::max(1, screenHeight);
+        m_LightTexture = lights.Texture();
+
+        // 方向光照亮所有像素，不参与分簇（半径为 0），下标放在索引缓冲最前面
+        m_Indices.clear();
+        const std::vector<LightType>& types = lights.Types();
+        for (size_t i = 0; i < types.size(); ++i)
+        {
+            if (types[i] == LightType::Directional)
+                m_Indices.push_back(static_cast<uint32_t>(i));
+        }
+        m_DirectionalCount = static_cast<int>(m_Indices.size());
+
+        m_Clusterer.SetProjection(projection, nearPlane, farPlane);
+        m_Clusterer.Assign(view, lights.Positions().data(), lights.Ranges().data(), lights.Count());
+
+        const std::vector<uint32_t>& clustered = m_Clusterer.LightIndices();
+        m_Indices.insert(m_Indices.end(), clustered.begin(), clustered.end());
+
+        // 索引列表超出 GL_MAX_TEXTURE_BUFFER_SIZE 时，把越界部分的簇数量截掉
+        const size_t maxTexels = static_cast<size_t>(std::max(m_MaxTexels, 65536));
+        const size_t indexCount = std::min(m_Indices.size(), maxTexels);
+        m_Table = m_Clusterer.ClusterTable();
+        if (indexCount < m_Indices.size())
+        {
+            if (!m_Truncated)
+            {
+                std::cerr << "[ClusteredLighting] " << m_Indices.size() << " light indices exceed texture buffer limit" << std::endl;
+                m_Truncated = true;
+            }
+            const size_t available = indexCount - std::min<size_t>(indexCount, m_DirectionalCount);
+            for (size_t c = 0; c < m_Table.size(); c += 2)
+            {
+                const size_t offset = m_Table[c];
+                m_Table[c + 1] = offset >= available ? 0
+                               : static_cast<uint32_t>(std::min<size_t>(m_Table[c + 1], available - offset));
+            }
+        }
+
+        m_BufferBytes = 0;
+        Upload(0, GL_RG32UI, m_Table.data(), m_Table.size() * sizeof(uint32_t));
+        Upload(1, GL_R32UI, m_Indices.data(), indexCount * sizeof(uint32_t));
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+
+    void ClusteredLighting::Apply(const Shader& shader, unsigned int firstUnit) const
+    {
+        static const char* samplers[3] = { "clusterLightData", "clusterTable", "clusterLightIndices" };
+        const GLuint textures[3] = { m_LightTexture, m_Textures[0], m_Textures[1] };
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+            glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+            shader.setInt(samplers[i], static_cast<int>(firstUnit + i));
+        }
+        glActiveTexture(GL_TEXTURE0);
+
+        shader.setMat4("clusterView", m_View);
+        glUniform3i(glGetUniformLocation(shader.ID, "clusterDims"),
+                    LightClusterer::TILES_X, LightClusterer::TILES_Y, LightClusterer::SLICES);
+        shader.setVec2("clusterScreenSize", glm::vec2(static_cast<float>(m_ScreenWidth), static_cast<float>(m_ScreenHeight)));
+        shader.setFloat("clusterSliceScale", m_Clusterer.SliceScale());
+        shader.setFloat("clusterSliceBias", m_Clusterer.SliceBias());
+        shader.setInt("clusterDirectionalCount", m_DirectionalCount);
+    }
+
+} // namespace renderer
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "LightManager.h"
+#include "scene/LightClusterer.h"
+
+namespace renderer {
+
+    /**
+     * ClusteredLighting
+     * -----------------
+     * 分簇前向光照的 GPU 部分：每帧用 LightClusterer 为 LightManager 中的光源分簇，
+     * 再把结果上传到缓冲纹理（GL_TEXTURE_BUFFER，3.3 core 即可使用）：
+     *  - clusterLightData    RGBA32F：LightManager 维护的光源缓冲（布局见 LightManager）
+     *  - clusterTable        RG32UI ：每簇（起点，数量）
+     *  - clusterLightIndices R32UI  ：先是所有方向光的下标（clusterDirectionalCount 个），其后为各簇的光源下标
+     * 着色器端见 assets/shaders/common/clusteredLights.glsl，片段只遍历自己所在簇的光源，
+     * 因此光源数量可以到数千而不必为每个光源做一次全屏计算。
+     */
+    class ClusteredLighting {
+    public:
+        static const unsigned int FIRST_UNIT = 8;   // 默认占用 8~10 号纹理单元（0~7 为 IBL 和材质）
+
+        ClusteredLighting() = default;
+        ~ClusteredLighting();
+        ClusteredLighting(const ClusteredLighting&) = delete;
+        ClusteredLighting& operator=(const ClusteredLighting&) = delete;
+
+        /// 分簇并上传簇表（lights 需已 Upload；需要有效的 GL 上下文，首次调用时创建缓冲）
+        void Update(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane,
+                    int screenWidth, int screenHeight, const LightManager& lights);
+
+        /// 绑定缓冲纹理到 firstUnit 起的 3 个纹理单元并设置 uniform（shader 需已 use()）
+        void Apply(const Shader& shader, unsigned int firstUnit = FIRST_UNIT) const;
+
+        LightClusterer&              Clusterer() { return m_Clusterer; }
+        const LightClusterer::Stats& GetStats() const { return m_Clusterer.GetStats(); }
+        /// 簇表和索引缓冲当前占用的显存（字节，不含 LightManager 的光源缓冲）
+        size_t GetBufferBytes() const { return m_BufferBytes; }
+
+    private:
+        LightClusterer m_Clusterer;
+
+        GLuint m_Buffers[2]  = {};   // table / indices
+        GLuint m_Textures[2] = {};
+        GLuint m_LightTexture = 0;   // LightManager::Texture()
+        GLint  m_MaxTexels = 0;      // GL_MAX_TEXTURE_BUFFER_SIZE
+        bool   m_Truncated = false;  // 已经因超出上限截断过（只提示一次）
+        size_t m_BufferBytes = 0;
+
+        int m_ScreenWidth = 1, m_ScreenHeight = 1;
+        glm::mat4 m_View = glm::mat4(1.0f);
+        int       m_DirectionalCount = 0;
+
+        std::vector<uint32_t> m_Table;
+        std::vector<uint32_t> m_Indices;
+
+        void CreateBuffers();
+        void Upload(unsigned int index, GLenum format, const void* data, size_t bytes);
+    };
+
+} // namespace renderer
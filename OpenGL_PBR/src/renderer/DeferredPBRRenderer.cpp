@@ -0,0 +1,164 @@
+#include "DeferredPBRRenderer.h"
+
+#include <iostream>
+#include <algorithm>
+
+#include "Primitives.h"
+#include "GpuMemory.h"
+
+namespace renderer {
+
+    DeferredPBRRenderer::DeferredPBRRenderer(int width, int height)
+        : Renderer(width, height),
+          m_GeometryShader(LoadShader("assets/shaders/pbrShader/pbrInstanced.vert",
+                                      "assets/shaders/deferredShader/gbuffer.frag")),
+          m_LightingShader(LoadShader("assets/shaders/deferredShader/lighting.vert",
+                                      "assets/shaders/deferredShader/lighting.frag"))
+    {
+        m_GeometryShader.use();
+        m_GeometryShader.setInt("albedoMap", 3);
+        m_GeometryShader.setInt("normalMap", 4);
+        m_GeometryShader.setInt("metallicMap", 5);
+        m_GeometryShader.setInt("roughnessMap", 6);
+        m_GeometryShader.setInt("aoMap", 7);
+
+        m_LightingShader.use();
+        m_LightingShader.setInt("irradianceMap", 0);
+        m_LightingShader.setInt("prefilterMap", 1);
+        m_LightingShader.setInt("brdfLUT", 2);
+        m_LightingShader.setInt("gAlbedoAo", 3);
+        m_LightingShader.setInt("gNormalMetalRough", 4);
+        m_LightingShader.setInt("gDepth", 5);
+
+        CreateGBuffer();
+    }
+
+    DeferredPBRRenderer::~DeferredPBRRenderer()
+    {
+        DestroyGBuffer();
+        glDeleteProgram(m_GeometryShader.ID);
+        glDeleteProgram(m_LightingShader.ID);
+    }
+
+    void DeferredPBRRenderer::CreateGBuffer()
+    {
+        GpuMemory::Scope memoryTag("G-Buffer");
+        const GLsizei w = std::max(1, m_ScreenWidth);
+        const GLsizei h = std::max(1, m_ScreenHeight);
+
+        auto createTarget = [w, h](GLenum internalFormat, GLenum format, GLenum type)
+        {
+            GLuint tex = 0;
+            glGenTextures(1, &tex);
+            glBindTexture(GL_TEXTURE_2D, tex);
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, w, h, 0, format, type, nullptr);
+            // 光照阶段按像素 1:1 读取，用最近邻避免深度 / 编码法线被插值
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            return tex;
+        };
+
+        m_AlbedoAo         = createTarget(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE);
+        m_NormalMetalRough = createTarget(GL_RGBA16, GL_RGBA, GL_UNSIGNED_SHORT);
+        m_Depth            = createTarget(GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT);
+
+        GLint previousFBO = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+        glGenFramebuffers(1, &m_GBuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_GBuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_AlbedoAo, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_NormalMetalRough, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_Depth, 0);
+        const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, drawBuffers);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cerr << "[DeferredPBRRenderer] G-Buffer framebuffer is not complete" << std::endl;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFBO));
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void DeferredPBRRenderer::DestroyGBuffer()
+    {
+        glDeleteFramebuffers(1, &m_GBuffer);
+        glDeleteTextures(1, &m_AlbedoAo);
+        glDeleteTextures(1, &m_NormalMetalRough);
+        glDeleteTextures(1, &m_Depth);
+        m_GBuffer = m_AlbedoAo = m_NormalMetalRough = m_Depth = 0;
+    }
+
+    void DeferredPBRRenderer::Resize(int width, int height)
+    {
+        if (width == m_ScreenWidth && height == m_ScreenHeight) return;
+        m_ScreenWidth = width;
+        m_ScreenHeight = height;
+        DestroyGBuffer();
+        CreateGBuffer();
+    }
+
+    void DeferredPBRRenderer::SetEnvironment(unsigned int irradianceMap, unsigned int prefilterMap, unsigned int brdfLUT)
+    {
+        m_IrradianceMap = irradianceMap;
+        m_PrefilterMap = prefilterMap;
+        m_BrdfLUT = brdfLUT;
+    }
+
+    size_t DeferredPBRRenderer::GetGBufferBytes() const
+    {
+        // RGBA8 + RGBA16 + DEPTH24（按 4 字节对齐计）
+        return static_cast<size_t>(m_ScreenWidth) * m_ScreenHeight * (4 + 8 + 4);
+    }
+
+    void DeferredPBRRenderer::GeometryPass(const core::Camera& camera)
+    {
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_TargetFBO);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_GBuffer);
+        glViewport(0, 0, m_ScreenWidth, m_ScreenHeight);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        m_GeometryShader.use();
+        m_GeometryShader.setMat4("view", camera.GetViewMatrix());
+        m_GeometryShader.setMat4("projection", m_Projection);
+        if (m_GeometryCallback)
+            m_GeometryCallback(m_GeometryShader, camera);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(m_TargetFBO));
+    }
+
+    void DeferredPBRRenderer::LightingPass(const core::Camera& camera)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(m_TargetFBO));
+        glViewport(0, 0, m_ScreenWidth, m_ScreenHeight);
+
+        m_LightingShader.use();
+        m_LightingShader.setVec3("camPos", camera.Position);
+        m_LightingShader.setMat4("invViewProjection", glm::inverse(m_Projection * camera.GetViewMatrix()));
+        if (m_ClusteredLighting)
+            m_ClusteredLighting->Apply(m_LightingShader);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_IrradianceMap);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, m_PrefilterMap);
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, m_BrdfLUT);
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, m_AlbedoAo);
+        glActiveTexture(GL_TEXTURE4);
+        glBindTexture(GL_TEXTURE_2D, m_NormalMetalRough);
+        glActiveTexture(GL_TEXTURE5);
+        glBindTexture(GL_TEXTURE_2D, m_Depth);
+
+        // 全屏四边形：深度测试总是通过，由 gl_FragDepth 写回几何深度
+        glDepthFunc(GL_ALWAYS);
+        Primitives::RenderQuad();
+        glDepthFunc(GL_LESS);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+} // namespace renderer
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "ClusteredLighting.h"
+#include "core/Camera.h"
+
+namespace renderer {
+
+    /**
+     * DeferredPBRRenderer
+     * -------------------
+     * Renderer 接口的延迟渲染实现，与 PBRRenderer 的前向路径使用同一套材质和 IBL：
+     *  - GeometryPass：把场景写入紧凑的 G-Buffer（16 字节/像素）
+     *      RT0 RGBA8  : albedo.rgb + ao
+     *      RT1 RGBA16 : 八面体编码法线 + metallic + roughness
+     *      Depth 24   : 光照阶段由深度重建世界空间位置，不单独存位置
+     *  - LightingPass：全屏四边形逐像素累加所在簇的光源（ClusteredLighting）再加 IBL，开销与场景 overdraw 无关，
+     *    结果和几何深度写回进入 GeometryPass 时绑定的帧缓冲，之后可以继续前向绘制天空盒
+     *
+     * 场景几何由外部通过 SetGeometryCallback 提交：回调拿到已 use() 的 G-Buffer 着色器
+     * （顶点输入与 pbrInstanced.vert 相同，材质为纹理数组，纹理单元 3~7），负责绑定材质并绘制。
+     */
+    class DeferredPBRRenderer : public Renderer {
+    public:
+        using GeometryCallback = std::function<void(Shader&, const core::Camera&)>;
+
+        DeferredPBRRenderer(int width, int height);
+        ~DeferredPBRRenderer() override;
+
+        DeferredPBRRenderer(const DeferredPBRRenderer&) = delete;
+        DeferredPBRRenderer& operator=(const DeferredPBRRenderer&) = delete;
+
+        void GeometryPass(const core::Camera& camera) override;
+        void LightingPass(const core::Camera& camera) override;
+
+        /// 窗口大小变化时重建 G-Buffer
+        void Resize(int width, int height);
+
+        /// IBL 预计算结果（由 PBRRenderer::InitPBR 生成）
+        void SetEnvironment(unsigned int irradianceMap, unsigned int prefilterMap, unsigned int brdfLUT);
+        /// 本帧已分簇的光源（由 PBRRenderer 每帧 Update，与前向路径共用）
+        void SetClusteredLighting(const ClusteredLighting* lighting) { m_ClusteredLighting = lighting; }
+        /// 与前向路径一致的投影矩阵
+        void SetProjection(const glm::mat4& projection) { m_Projection = projection; }
+        void SetGeometryCallback(GeometryCallback callback) { m_GeometryCallback = std::move(callback); }
+
+        /// G-Buffer 显存占用（字节）
+        size_t GetGBufferBytes() const;
+
+    private:
+        Shader m_GeometryShader;
+        Shader m_LightingShader;
+
+        GLuint m_GBuffer = 0;
+        GLuint m_AlbedoAo = 0;
+        GLuint m_NormalMetalRough = 0;
+        GLuint m_Depth = 0;
+        GLint  m_TargetFBO = 0;   // GeometryPass 开始时绑定的帧缓冲，LightingPass 输出到这里
+
+        GLuint m_IrradianceMap = 0, m_PrefilterMap = 0, m_BrdfLUT = 0;
+        const ClusteredLighting* m_ClusteredLighting = nullptr;
+        glm::mat4        m_Projection = glm::mat4(1.0f);
+        GeometryCallback m_GeometryCallback;
+
+        void CreateGBuffer();
+        void DestroyGBuffer();
+    };
+
+} // namespace renderer
@@ -0,0 +1,150 @@
+#include "GLCallCounter.h"
+#include "GLEntryPoints.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace renderer {
+
+    bool                  GLCallCounter::s_Installed = false;
+    GLCallCounter::Counts GLCallCounter::s_Current;
+    GLCallCounter::Counts GLCallCounter::s_LastFrame;
+
+    namespace {
+
+        using Category = GLCallCounter::Category;
+
+        static_assert(GLEntryCount <= GLCallCounter::MAX_ENTRIES, "raise GLCallCounter::MAX_ENTRIES");
+
+#define PBR_GL_ENTRY_NAME(ret, name, category, params, args, bytes) #name,
+        const char* const kEntryNames[] = { PBR_GL_ENTRY_POINTS(PBR_GL_ENTRY_NAME) };
+#undef PBR_GL_ENTRY_NAME
+
+#define PBR_GL_ENTRY_CATEGORY(ret, name, category, params, args, bytes) Category::category,
+        const Category kEntryCategories[] = { PBR_GL_ENTRY_POINTS(PBR_GL_ENTRY_CATEGORY) };
+#undef PBR_GL_ENTRY_CATEGORY
+
+        // GLEntryPoints.h 的字节数表达式里不带类名
+        inline uint64_t TexelBytes(GLenum format, GLenum type) { return GLCallCounter::TexelBytes(format, type); }
+
+        /// 记一次调用；entry / category 在每个包装函数里都是常量，分支会被编译器折叠掉
+        inline void Record(GLEntry entry, Category category, uint64_t bytes)
+        {
+            GLCallCounter::Counts& c = GLCallCounter::Current();
+            ++c.calls;
+            ++c.categories[static_cast<unsigned int>(category)];
+            ++c.entries[entry];
+
+            switch (category)
+            {
+            case Category::Draw:          ++c.drawCalls; break;
+            case Category::Uniform:       ++c.uniforms;      c.uniformBytes += bytes; break;
+            case Category::BufferUpload:  ++c.bufferUploads; c.bufferBytes += bytes;  break;
+            case Category::TextureUpload: c.textureBytes += bytes; break;
+            default: break;
+            }
+            if (entry == GLEntry_glBindTexture)   ++c.textureBinds;
+            if (entry == GLEntry_glActiveTexture) ++c.activeTextures;
+            if (entry == GLEntry_glUseProgram)    ++c.programBinds;
+        }
+
+        // 为每个入口点生成“原始指针 + 计数包装”；params / args 分别是带类型的参数表和转发用的实参表
+#define PBR_COUNTED_GL(ret, name, category, params, args, bytes)                         \
+        decltype(glad_##name) original_##name = nullptr;                                 \
+        ret APIENTRY counted_##name params                                               \
+        {                                                                                \
+            Record(GLEntry_##name, Category::category, static_cast<uint64_t>(bytes));      \
+            return original_##name args;                                                 \
+        }
+
+        PBR_GL_ENTRY_POINTS(PBR_COUNTED_GL)
+
+#undef PBR_COUNTED_GL
+
+    } // namespace
+
+    void GLCallCounter::Install()
+    {
+        if (s_Installed) return;
+        s_Installed = true;
+
+        // glad 的 glXxx 宏展开为 glad_glXxx 函数指针变量，直接替换即可；
+        // 当前上下文不提供的函数保持为空，调用方原本就会检查
+#define PBR_HOOK_GL(ret, name, category, params, args, bytes)   \
+        original_##name = glad_##name;                          \
+        if (original_##name) glad_##name = counted_##name;
+
+        PBR_GL_ENTRY_POINTS(PBR_HOOK_GL)
+
+#undef PBR_HOOK_GL
+
+        std::cout << "[GLCallCounter] Installed counters on " << EntryCount() << " GL entry points" << std::endl;
+    }
+
+    void GLCallCounter::BeginFrame()
+    {
+        s_LastFrame = s_Current;
+        s_Current = Counts();
+    }
+
+    unsigned int GLCallCounter::EntryCount()
+    {
+        return GLEntryCount;
+    }
+
+    const char* GLCallCounter::EntryName(unsigned int entry)
+    {
+        return entry < GLEntryCount ? kEntryNames[entry] : "?";
+    }
+
+    GLCallCounter::Category GLCallCounter::EntryCategory(unsigned int entry)
+    {
+        return entry < GLEntryCount ? kEntryCategories[entry] : Category::Other;
+    }
+
+    const char* GLCallCounter::CategoryName(Category category)
+    {
+        static const char* kNames[] = { "state", "draw", "uniform", "buffer upload", "texture upload",
+                                        "resource", "query", "other" };
+        const unsigned int i = static_cast<unsigned int>(category);
+        return i < CATEGORY_COUNT ? kNames[i] : "?";
+    }
+
+    uint64_t GLCallCounter::TexelBytes(GLenum format, GLenum type)
+    {
+        if (type == GL_UNSIGNED_INT_24_8)
+            return 4;
+        uint64_t components = 4;
+        switch (format)
+        {
+        case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: components = 1; break;
+        case GL_RG:  case GL_RG_INTEGER:                            components = 2; break;
+        case GL_RGB: case GL_BGR: case GL_RGB_INTEGER:             components = 3; break;
+        default: break;
+        }
+        switch (type)
+        {
+        case GL_UNSIGNED_BYTE: case GL_BYTE:                     return components;
+        case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+        default:                                                 return components * 4;
+        }
+    }
+
+    unsigned int GLCallCounter::TopEntries(const Counts& counts, unsigned int* out, unsigned int maxCount)
+    {
+        unsigned int order[MAX_ENTRIES];
+        unsigned int used = 0;
+        for (unsigned int i = 0; i < GLEntryCount; ++i)
+        {
+            if (counts.entries[i] > 0)
+                order[used++] = i;
+        }
+        const unsigned int n = std::min(used, maxCount);
+        std::partial_sort(order, order + n, order + used, [&counts](unsigned int a, unsigned int b) {
+            return counts.entries[a] != counts.entries[b] ? counts.entries[a] > counts.entries[b] : a < b;
+        });
+        std::copy(order, order + n, out);
+        return n;
+    }
+
+} // namespace renderer
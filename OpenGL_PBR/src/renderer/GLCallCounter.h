@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * GLCallCounter
+     * -------------
+     * 统计每帧发出的 GL 调用（按入口点逐个计数），用于对比不同渲染路径的 CPU 提交开销：
+     *  - 每个入口点的调用次数，以及按分类（状态切换 / draw / uniform / 上传 / 资源 / 查询）的汇总；
+     *  - 状态切换与 draw call 的比值；
+     *  - 经 glBufferData / glBufferSubData、glTexImage* 和 glUniform* 上传的字节数。
+     * Install() 把 glad 的函数指针替换成先计数再转发的包装函数，因此对调用方完全透明；
+     * 入口点清单在 GLEntryPoints.h。ImGui 后端使用自己的加载器，不会被计入。
+     * 与 NullGL 搭配时可以在没有 GL 驱动的机器上测量 / 校验渲染器发出的调用序列。
+     *
+     * 用法：
+     *   GLCallCounter::Install();          // gladLoadGLLoader 之后调用一次
+     *   GLCallCounter::BeginFrame();       // 每帧开始时调用
+     *   GLCallCounter::LastFrame().textureBinds;
+     */
+    class GLCallCounter {
+    public:
+        enum class Category : uint8_t {
+            State,          // 绑定、开关、顶点格式、FBO 附件等
+            Draw,           // glDraw* / glMultiDraw*
+            Uniform,        // glUniform*
+            BufferUpload,   // glBufferData / glBufferSubData
+            TextureUpload,  // glTexImage* / glTexSubImage*
+            Resource,       // 对象创建 / 删除、着色器编译链接
+            Query,          // glGet*、查询对象、回读和同步
+            Other,          // 清屏、blit、mipmap 生成
+            Count
+        };
+        static const unsigned int CATEGORY_COUNT = static_cast<unsigned int>(Category::Count);
+        /// 入口点数量的上限（实际数量见 EntryCount()）
+        static const unsigned int MAX_ENTRIES = 128;
+
+        struct Counts {
+            unsigned int textureBinds   = 0;   // glBindTexture
+            unsigned int activeTextures = 0;   // glActiveTexture
+            unsigned int drawCalls      = 0;   // glDraw* / glMultiDraw*
+            unsigned int uniforms       = 0;   // glUniform*
+            unsigned int programBinds   = 0;   // glUseProgram
+            unsigned int bufferUploads  = 0;   // glBufferData / glBufferSubData
+
+            unsigned int calls = 0;                           // 所有被统计的调用
+            unsigned int categories[CATEGORY_COUNT] = {};
+            unsigned int entries[MAX_ENTRIES] = {};           // 下标为入口点编号，见 EntryName()
+
+            uint64_t bufferBytes  = 0;
+            uint64_t textureBytes = 0;
+            uint64_t uniformBytes = 0;
+
+            unsigned int Calls(Category c) const { return categories[static_cast<unsigned int>(c)]; }
+            /// 每个 draw call 平均伴随的状态切换次数（没有 draw 时为 0）
+            float StateChangesPerDraw() const
+            {
+                return drawCalls > 0 ? static_cast<float>(Calls(Category::State)) / drawCalls : 0.0f;
+            }
+        };
+
+        /// 替换 glad 函数指针（重复调用无效）
+        static void Install();
+        static bool Installed() { return s_Installed; }
+
+        /// 保存当前计数为“上一帧”，并清零
+        static void BeginFrame();
+
+        static const Counts& LastFrame() { return s_LastFrame; }
+        static Counts&       Current()   { return s_Current; }
+
+        static unsigned int EntryCount();
+        static const char*  EntryName(unsigned int entry);
+        static Category     EntryCategory(unsigned int entry);
+        static const char*  CategoryName(Category category);
+
+        /// 把 counts 中调用次数最多的入口点编号写入 out（最多 maxCount 个，按次数降序），返回写入个数
+        static unsigned int TopEntries(const Counts& counts, unsigned int* out, unsigned int maxCount);
+
+        /// 客户端像素数据中每个纹素的字节数（format × type），未知组合按 4 字节估计
+        static uint64_t TexelBytes(GLenum format, GLenum type);
+
+    private:
+        static bool   s_Installed;
+        static Counts s_Current;
+        static Counts s_LastFrame;
+    };
+
+} // namespace renderer
@@ -0,0 +1,178 @@
+#pragma once
+
+// 渲染器用到的全部 GL 入口点（X-macro 清单），供 GLCallCounter / GLTrace 等包装层逐个生成包装函数。
+//
+//   X(返回类型, 函数名, 分类, 带类型的参数表, 转发用的实参表, 本次调用上传的字节数)
+//
+// 分类对应 GLCallCounter::Category；字节数表达式可以引用参数名（TexelBytes 在包装层中定义）。
+// 代码里新用到一个 GL 函数时在这里补一行，否则它不会被计数。
+
+#define PBR_GL_ENTRY_POINTS(X)                                                                                   \
+    /* ---- 状态切换 ---- */                                                                                     \
+    X(void, glBindTexture, State, (GLenum target, GLuint texture), (target, texture), 0)                         \
+    X(void, glActiveTexture, State, (GLenum texture), (texture), 0)                                              \
+    X(void, glUseProgram, State, (GLuint program), (program), 0)                                                 \
+    X(void, glBindVertexArray, State, (GLuint array), (array), 0)                                                \
+    X(void, glBindBuffer, State, (GLenum target, GLuint buffer), (target, buffer), 0)                            \
+    X(void, glBindBufferBase, State, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer), 0)   \
+    X(void, glBindFramebuffer, State, (GLenum target, GLuint framebuffer), (target, framebuffer), 0)             \
+    X(void, glBindRenderbuffer, State, (GLenum target, GLuint renderbuffer), (target, renderbuffer), 0)          \
+    X(void, glEnable, State, (GLenum cap), (cap), 0)                                                             \
+    X(void, glDisable, State, (GLenum cap), (cap), 0)                                                            \
+    X(void, glDepthFunc, State, (GLenum func), (func), 0)                                                        \
+    X(void, glDepthMask, State, (GLboolean flag), (flag), 0)                                                     \
+    X(void, glColorMask, State, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha),               \
+      (red, green, blue, alpha), 0)                                                                              \
+    X(void, glViewport, State, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height), 0)      \
+    X(void, glClearColor, State, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha),                      \
+      (red, green, blue, alpha), 0)                                                                              \
+    X(void, glPixelStorei, State, (GLenum pname, GLint param), (pname, param), 0)                                \
+    X(void, glTexParameteri, State, (GLenum target, GLenum pname, GLint param), (target, pname, param), 0)       \
+    X(void, glDrawBuffers, State, (GLsizei n, const GLenum* bufs), (n, bufs), 0)                                 \
+    X(void, glEnableVertexAttribArray, State, (GLuint index), (index), 0)                                        \
+    X(void, glVertexAttribPointer, State,                                                                        \
+      (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer),        \
+      (index, size, type, normalized, stride, pointer), 0)                                                       \
+    X(void, glVertexAttribIPointer, State,                                                                       \
+      (GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer),                              \
+      (index, size, type, stride, pointer), 0)                                                                   \
+    X(void, glVertexAttribDivisor, State, (GLuint index, GLuint divisor), (index, divisor), 0)                   \
+    X(void, glFramebufferTexture2D, State,                                                                       \
+      (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level),                         \
+      (target, attachment, textarget, texture, level), 0)                                                        \
+    X(void, glFramebufferTextureLayer, State,                                                                    \
+      (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer),                              \
+      (target, attachment, texture, level, layer), 0)                                                            \
+    X(void, glFramebufferRenderbuffer, State,                                                                    \
+      (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer),                        \
+      (target, attachment, renderbuffertarget, renderbuffer), 0)                                                 \
+    X(void, glTexBuffer, State, (GLenum target, GLenum internalformat, GLuint buffer),                           \
+      (target, internalformat, buffer), 0)                                                                       \
+    /* ---- draw call ---- */                                                                                    \
+    X(void, glDrawArrays, Draw, (GLenum mode, GLint first, GLsizei count), (mode, first, count), 0)              \
+    X(void, glDrawElements, Draw, (GLenum mode, GLsizei count, GLenum type, const void* indices),                \
+      (mode, count, type, indices), 0)                                                                           \
+    X(void, glDrawArraysInstanced, Draw, (GLenum mode, GLint first, GLsizei count, GLsizei instances),           \
+      (mode, first, count, instances), 0)                                                                        \
+    X(void, glDrawElementsInstanced, Draw,                                                                       \
+      (GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances),                         \
+      (mode, count, type, indices, instances), 0)                                                                \
+    X(void, glDrawElementsBaseVertex, Draw,                                                                      \
+      (GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex),                          \
+      (mode, count, type, indices, baseVertex), 0)                                                               \
+    X(void, glMultiDrawElements, Draw,                                                                           \
+      (GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount),           \
+      (mode, count, type, indices, drawcount), 0)                                                                \
+    X(void, glMultiDrawElementsBaseVertex, Draw,                                                                 \
+      (GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount,            \
+       const GLint* baseVertex),                                                                                 \
+      (mode, count, type, indices, drawcount, baseVertex), 0)                                                    \
+    /* ---- uniform ---- */                                                                                      \
+    X(void, glUniform1i, Uniform, (GLint location, GLint v0), (location, v0), 4)                                 \
+    X(void, glUniform1f, Uniform, (GLint location, GLfloat v0), (location, v0), 4)                               \
+    X(void, glUniform2f, Uniform, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1), 8)               \
+    X(void, glUniform3f, Uniform, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2),                          \
+      (location, v0, v1, v2), 12)                                                                                \
+    X(void, glUniform3i, Uniform, (GLint location, GLint v0, GLint v1, GLint v2), (location, v0, v1, v2), 12)    \
+    X(void, glUniform4f, Uniform, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3),              \
+      (location, v0, v1, v2, v3), 16)                                                                            \
+    X(void, glUniform2fv, Uniform, (GLint location, GLsizei count, const GLfloat* value),                        \
+      (location, count, value), count * 8)                                                                       \
+    X(void, glUniform3fv, Uniform, (GLint location, GLsizei count, const GLfloat* value),                        \
+      (location, count, value), count * 12)                                                                      \
+    X(void, glUniform4fv, Uniform, (GLint location, GLsizei count, const GLfloat* value),                        \
+      (location, count, value), count * 16)                                                                      \
+    X(void, glUniform4iv, Uniform, (GLint location, GLsizei count, const GLint* value),                          \
+      (location, count, value), count * 16)                                                                      \
+    X(void, glUniformMatrix2fv, Uniform, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), \
+      (location, count, transpose, value), count * 16)                                                           \
+    X(void, glUniformMatrix3fv, Uniform, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), \
+      (location, count, transpose, value), count * 36)                                                           \
+    X(void, glUniformMatrix4fv, Uniform, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), \
+      (location, count, transpose, value), count * 64)                                                           \
+    /* ---- 缓冲上传（data 为空的 glBufferData 只分配存储，不计字节） ---- */                                   \
+    X(void, glBufferData, BufferUpload, (GLenum target, GLsizeiptr size, const void* data, GLenum usage),        \
+      (target, size, data, usage), data ? size : 0)                                                              \
+    X(void, glBufferSubData, BufferUpload, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data),  \
+      (target, offset, size, data), size)                                                                        \
+    /* ---- 贴图上传 ---- */                                                                                     \
+    X(void, glTexImage2D, TextureUpload,                                                                         \
+      (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border,            \
+       GLenum format, GLenum type, const void* pixels),                                                          \
+      (target, level, internalformat, width, height, border, format, type, pixels),                              \
+      pixels ? TexelBytes(format, type) * width * height : 0)                                                    \
+    X(void, glTexSubImage2D, TextureUpload,                                                                      \
+      (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,                  \
+       GLenum format, GLenum type, const void* pixels),                                                          \
+      (target, level, xoffset, yoffset, width, height, format, type, pixels),                                    \
+      pixels ? TexelBytes(format, type) * width * height : 0)                                                    \
+    X(void, glTexImage3D, TextureUpload,                                                                         \
+      (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth,           \
+       GLint border, GLenum format, GLenum type, const void* pixels),                                            \
+      (target, level, internalformat, width, height, depth, border, format, type, pixels),                       \
+      pixels ? TexelBytes(format, type) * width * height * depth : 0)                                            \
+    /* ---- 资源创建 / 销毁 ---- */                                                                              \
+    X(void, glGenBuffers, Resource, (GLsizei n, GLuint* buffers), (n, buffers), 0)                               \
+    X(void, glGenTextures, Resource, (GLsizei n, GLuint* textures), (n, textures), 0)                            \
+    X(void, glGenVertexArrays, Resource, (GLsizei n, GLuint* arrays), (n, arrays), 0)                            \
+    X(void, glGenFramebuffers, Resource, (GLsizei n, GLuint* framebuffers), (n, framebuffers), 0)                \
+    X(void, glGenRenderbuffers, Resource, (GLsizei n, GLuint* renderbuffers), (n, renderbuffers), 0)             \
+    X(void, glGenQueries, Resource, (GLsizei n, GLuint* ids), (n, ids), 0)                                       \
+    X(void, glDeleteBuffers, Resource, (GLsizei n, const GLuint* buffers), (n, buffers), 0)                      \
+    X(void, glDeleteTextures, Resource, (GLsizei n, const GLuint* textures), (n, textures), 0)                   \
+    X(void, glDeleteVertexArrays, Resource, (GLsizei n, const GLuint* arrays), (n, arrays), 0)                   \
+    X(void, glDeleteFramebuffers, Resource, (GLsizei n, const GLuint* framebuffers), (n, framebuffers), 0)       \
+    X(void, glDeleteRenderbuffers, Resource, (GLsizei n, const GLuint* renderbuffers), (n, renderbuffers), 0)    \
+    X(void, glDeleteQueries, Resource, (GLsizei n, const GLuint* ids), (n, ids), 0)                              \
+    X(void, glRenderbufferStorage, Resource, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), \
+      (target, internalformat, width, height), 0)                                                                \
+    X(GLuint, glCreateShader, Resource, (GLenum type), (type), 0)                                                \
+    X(GLuint, glCreateProgram, Resource, (), (), 0)                                                              \
+    X(void, glDeleteShader, Resource, (GLuint shader), (shader), 0)                                              \
+    X(void, glDeleteProgram, Resource, (GLuint program), (program), 0)                                           \
+    X(void, glShaderSource, Resource,                                                                            \
+      (GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length),                          \
+      (shader, count, string, length), 0)                                                                        \
+    X(void, glCompileShader, Resource, (GLuint shader), (shader), 0)                                             \
+    X(void, glAttachShader, Resource, (GLuint program, GLuint shader), (program, shader), 0)                     \
+    X(void, glLinkProgram, Resource, (GLuint program), (program), 0)                                             \
+    /* ---- 查询 / 回读 / 同步 ---- */                                                                           \
+    X(GLint, glGetUniformLocation, Query, (GLuint program, const GLchar* name), (program, name), 0)              \
+    X(void, glGetIntegerv, Query, (GLenum pname, GLint* data), (pname, data), 0)                                 \
+    X(void, glGetInteger64v, Query, (GLenum pname, GLint64* data), (pname, data), 0)                             \
+    X(const GLubyte*, glGetString, Query, (GLenum name), (name), 0)                                              \
+    X(const GLubyte*, glGetStringi, Query, (GLenum name, GLuint index), (name, index), 0)                        \
+    X(void, glGetShaderiv, Query, (GLuint shader, GLenum pname, GLint* params), (shader, pname, params), 0)      \
+    X(void, glGetShaderInfoLog, Query, (GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog),       \
+      (shader, bufSize, length, infoLog), 0)                                                                     \
+    X(void, glGetProgramiv, Query, (GLuint program, GLenum pname, GLint* params), (program, pname, params), 0)   \
+    X(void, glGetProgramInfoLog, Query, (GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog),     \
+      (program, bufSize, length, infoLog), 0)                                                                    \
+    X(void, glGetTexLevelParameteriv, Query, (GLenum target, GLint level, GLenum pname, GLint* params),          \
+      (target, level, pname, params), 0)                                                                         \
+    X(void, glGetQueryObjectuiv, Query, (GLuint id, GLenum pname, GLuint* params), (id, pname, params), 0)       \
+    X(void, glGetQueryObjectui64v, Query, (GLuint id, GLenum pname, GLuint64* params), (id, pname, params), 0)   \
+    X(GLenum, glCheckFramebufferStatus, Query, (GLenum target), (target), 0)                                     \
+    X(void, glReadPixels, Query,                                                                                 \
+      (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels),               \
+      (x, y, width, height, format, type, pixels), 0)                                                            \
+    X(void, glBeginQuery, Query, (GLenum target, GLuint id), (target, id), 0)                                    \
+    X(void, glEndQuery, Query, (GLenum target), (target), 0)                                                     \
+    X(void, glQueryCounter, Query, (GLuint id, GLenum target), (id, target), 0)                                  \
+    X(void, glFinish, Query, (), (), 0)                                                                          \
+    /* ---- 其他（清屏、拷贝、mipmap 生成等 GPU 端操作） ---- */                                                \
+    X(void, glClear, Other, (GLbitfield mask), (mask), 0)                                                        \
+    X(void, glBlitFramebuffer, Other,                                                                            \
+      (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1,   \
+       GLbitfield mask, GLenum filter),                                                                          \
+      (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter), 0)                                 \
+    X(void, glGenerateMipmap, Other, (GLenum target), (target), 0)
+
+namespace renderer {
+
+#define PBR_GL_ENTRY_ID(ret, name, category, params, args, bytes) GLEntry_##name,
+    /// 入口点编号：GLCallCounter 的计数下标，GLTrace 文件中按名字表对应
+    enum GLEntry : unsigned int { PBR_GL_ENTRY_POINTS(PBR_GL_ENTRY_ID) GLEntryCount };
+#undef PBR_GL_ENTRY_ID
+
+} // namespace renderer
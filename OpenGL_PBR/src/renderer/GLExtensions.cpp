@@ -0,0 +1,110 @@
+#include "GLExtensions.h"
+
+#include <iostream>
+#include <cstring>
+
+#include <GLFW/glfw3.h>
+
+namespace renderer {
+
+    bool GLExtensions::s_Initialized = false;
+    int  GLExtensions::s_Major = 3;
+    int  GLExtensions::s_Minor = 3;
+    PFN_glMultiDrawElementsIndirect GLExtensions::s_MultiDrawElementsIndirect = nullptr;
+
+    bool GLExtensions::s_BindlessTexture = false;
+    PFN_glGetTextureHandleARB            GLExtensions::s_GetTextureHandle = nullptr;
+    PFN_glMakeTextureHandleResidentARB    GLExtensions::s_MakeResident = nullptr;
+    PFN_glMakeTextureHandleNonResidentARB GLExtensions::s_MakeNonResident = nullptr;
+    PFN_glUniformHandleui64ARB            GLExtensions::s_UniformHandle = nullptr;
+    std::unordered_map<GLuint, GLuint64>  GLExtensions::s_ResidentHandles;
+
+    void GLExtensions::Init(GLADloadproc loadProc)
+    {
+        if (s_Initialized) return;
+        s_Initialized = true;
+        if (!loadProc)
+            loadProc = reinterpret_cast<GLADloadproc>(glfwGetProcAddress);
+
+        glGetIntegerv(GL_MAJOR_VERSION, &s_Major);
+        glGetIntegerv(GL_MINOR_VERSION, &s_Minor);
+        const bool gl43 = s_Major > 4 || (s_Major == 4 && s_Minor >= 3);
+
+        if (gl43 || HasExtension("GL_ARB_multi_draw_indirect"))
+        {
+            s_MultiDrawElementsIndirect = reinterpret_cast<PFN_glMultiDrawElementsIndirect>(
+                loadProc("glMultiDrawElementsIndirect"));
+        }
+
+        // bindless 材质路径还需要 SSBO 存放句柄表
+        if (HasExtension("GL_ARB_bindless_texture") && (gl43 || HasExtension("GL_ARB_shader_storage_buffer_object")))
+        {
+            s_GetTextureHandle = reinterpret_cast<PFN_glGetTextureHandleARB>(
+                loadProc("glGetTextureHandleARB"));
+            s_MakeResident = reinterpret_cast<PFN_glMakeTextureHandleResidentARB>(
+                loadProc("glMakeTextureHandleResidentARB"));
+            s_MakeNonResident = reinterpret_cast<PFN_glMakeTextureHandleNonResidentARB>(
+                loadProc("glMakeTextureHandleNonResidentARB"));
+            s_UniformHandle = reinterpret_cast<PFN_glUniformHandleui64ARB>(
+                loadProc("glUniformHandleui64ARB"));
+            s_BindlessTexture = s_GetTextureHandle && s_MakeResident && s_MakeNonResident && s_UniformHandle;
+        }
+
+        std::cout << "[GLExtensions] OpenGL " << s_Major << "." << s_Minor
+                  << ", multi-draw indirect: " << (HasMultiDrawIndirect() ? "yes" : "no (glMultiDrawElements fallback)")
+                  << ", bindless textures: " << (HasBindlessTexture() ? "yes" : "no (texture array fallback)")
+                  << std::endl;
+    }
+
+    bool GLExtensions::HasExtension(const std::string& name)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (ext && name == ext)
+                return true;
+        }
+        return false;
+    }
+
+    void GLExtensions::DisableExtensionPaths()
+    {
+        if (!s_MultiDrawElementsIndirect && !s_BindlessTexture) return;
+        s_MultiDrawElementsIndirect = nullptr;
+        s_BindlessTexture = false;
+        std::cout << "[GLExtensions] Multi-draw indirect and bindless paths disabled" << std::endl;
+    }
+
+    GLuint64 GLExtensions::GetResidentHandle(GLuint texture)
+    {
+        if (!s_BindlessTexture || texture == 0) return 0;
+
+        auto it = s_ResidentHandles.find(texture);
+        if (it != s_ResidentHandles.end())
+            return it->second;
+
+        GLuint64 handle = s_GetTextureHandle(texture);
+        if (handle != 0)
+            s_MakeResident(handle);
+        s_ResidentHandles[texture] = handle;
+        return handle;
+    }
+
+    void GLExtensions::ReleaseResidentHandle(GLuint texture)
+    {
+        auto it = s_ResidentHandles.find(texture);
+        if (it == s_ResidentHandles.end()) return;
+        if (it->second != 0)
+            s_MakeNonResident(it->second);
+        s_ResidentHandles.erase(it);
+    }
+
+    void GLExtensions::UniformHandle(GLint location, GLuint64 handle)
+    {
+        if (s_UniformHandle && location >= 0)
+            s_UniformHandle(location, handle);
+    }
+
+} // namespace renderer
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+// 上下文为 GL 3.3 core，glad 只生成了 3.3 的入口；更高版本 / 扩展的枚举和函数指针在这里补齐
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#endif
+
+namespace renderer {
+
+    /// glDrawElementsIndirect 使用的命令结构（与 GL 规范中的布局一致）
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint  baseVertex;
+        GLuint baseInstance;
+    };
+
+    typedef void (APIENTRYP PFN_glMultiDrawElementsIndirect)(GLenum mode, GLenum type, const void* indirect,
+                                                              GLsizei drawcount, GLsizei stride);
+
+    // GL_ARB_bindless_texture
+    typedef GLuint64 (APIENTRYP PFN_glGetTextureHandleARB)(GLuint texture);
+    typedef void (APIENTRYP PFN_glMakeTextureHandleResidentARB)(GLuint64 handle);
+    typedef void (APIENTRYP PFN_glMakeTextureHandleNonResidentARB)(GLuint64 handle);
+    typedef void (APIENTRYP PFN_glUniformHandleui64ARB)(GLint location, GLuint64 value);
+
+    /**
+     * GLExtensions
+     * ------------
+     * 运行时检测 GL 版本和扩展，并加载 glad 未包含的函数。
+     * 必须在 gladLoadGLLoader 之后、上下文为当前时调用 Init()。
+     */
+    class GLExtensions {
+    public:
+        /// loadProc 为空时用 glfwGetProcAddress；无窗口上下文传入对应后端的查询函数
+        static void Init(GLADloadproc loadProc = nullptr);
+
+        static int  MajorVersion() { return s_Major; }
+        static int  MinorVersion() { return s_Minor; }
+        static bool HasExtension(const std::string& name);
+
+        /// 关闭 multi-draw indirect 和 bindless 路径，之后各模块只用 glad 的 3.3 入口（GLTrace 录制时调用）。
+        /// 必须在各模块根据 Has*() 选择路径之前调用
+        static void DisableExtensionPaths();
+
+        /// GL 4.3 或 GL_ARB_multi_draw_indirect
+        static bool HasMultiDrawIndirect() { return s_MultiDrawElementsIndirect != nullptr; }
+        static PFN_glMultiDrawElementsIndirect MultiDrawElementsIndirect() { return s_MultiDrawElementsIndirect; }
+
+        /// GL_ARB_bindless_texture，且支持 SSBO（GL 4.3 或 GL_ARB_shader_storage_buffer_object）
+        static bool HasBindlessTexture() { return s_BindlessTexture; }
+
+        /// 取纹理的 64 位 bindless 句柄并常驻（同一纹理只创建一次）；不支持时返回 0。
+        /// 取句柄后纹理参数不能再修改
+        static GLuint64 GetResidentHandle(GLuint texture);
+        /// 取消常驻并忘记该纹理的句柄（删除纹理前调用）
+        static void ReleaseResidentHandle(GLuint texture);
+
+        /// 把 bindless 句柄写入 sampler uniform（着色器需启用 GL_ARB_bindless_texture）
+        static void UniformHandle(GLint location, GLuint64 handle);
+
+    private:
+        static bool s_Initialized;
+        static int  s_Major;
+        static int  s_Minor;
+        static PFN_glMultiDrawElementsIndirect s_MultiDrawElementsIndirect;
+
+        static bool s_BindlessTexture;
+        static PFN_glGetTextureHandleARB            s_GetTextureHandle;
+        static PFN_glMakeTextureHandleResidentARB    s_MakeResident;
+        static PFN_glMakeTextureHandleNonResidentARB s_MakeNonResident;
+        static PFN_glUniformHandleui64ARB            s_UniformHandle;
+        static std::unordered_map<GLuint, GLuint64>  s_ResidentHandles;
+    };
+
+} // namespace renderer
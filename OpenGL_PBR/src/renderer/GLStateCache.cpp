@@ -0,0 +1,132 @@
+#include "GLStateCache.h"
+
+namespace renderer {
+
+    void GLStateCache::BeginFrame()
+    {
+        m_LastFrame = m_Current;
+        m_Current = Stats();
+        Invalidate();
+    }
+
+    void GLStateCache::Invalidate()
+    {
+        m_Program = UNKNOWN;
+        m_Vao = UNKNOWN;
+        m_DepthFunc = 0;
+        m_DepthMask = -1;
+        m_ColorMask = -1;
+        InvalidateTextures();
+    }
+
+    void GLStateCache::InvalidateTextures()
+    {
+        m_ActiveUnit = UNKNOWN;
+        for (auto& unit : m_Textures)
+            for (auto& texture : unit)
+                texture = UNKNOWN;
+    }
+
+    int GLStateCache::TargetSlot(GLenum target)
+    {
+        switch (target)
+        {
+        case GL_TEXTURE_2D:       return 0;
+        case GL_TEXTURE_CUBE_MAP: return 1;
+        case GL_TEXTURE_2D_ARRAY: return 2;
+        case GL_TEXTURE_BUFFER:   return 3;
+        default:                  return -1;
+        }
+    }
+
+    void GLStateCache::UseProgram(GLuint program)
+    {
+        if (program == m_Program)
+        {
+            ++m_Current.programs.elided;
+            return;
+        }
+        glUseProgram(program);
+        m_Program = program;
+        ++m_Current.programs.issued;
+    }
+
+    void GLStateCache::BindVertexArray(GLuint vao)
+    {
+        if (vao == m_Vao)
+        {
+            ++m_Current.vaos.elided;
+            return;
+        }
+        glBindVertexArray(vao);
+        m_Vao = vao;
+        ++m_Current.vaos.issued;
+    }
+
+    void GLStateCache::ActivateUnit(unsigned int unit)
+    {
+        if (unit == m_ActiveUnit) return;
+        glActiveTexture(GL_TEXTURE0 + unit);
+        m_ActiveUnit = unit;
+    }
+
+    void GLStateCache::BindTexture(unsigned int unit, GLenum target, GLuint texture)
+    {
+        const int slot = TargetSlot(target);
+        if (unit >= MAX_TEXTURE_UNITS || slot < 0)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(target, texture);
+            m_ActiveUnit = unit < MAX_TEXTURE_UNITS ? unit : UNKNOWN;
+            ++m_Current.textures.issued;
+            return;
+        }
+        if (m_Textures[unit][slot] == texture)
+        {
+            ++m_Current.textures.elided;
+            return;
+        }
+        ActivateUnit(unit);
+        glBindTexture(target, texture);
+        m_Textures[unit][slot] = texture;
+        ++m_Current.textures.issued;
+    }
+
+    void GLStateCache::DepthFunc(GLenum func)
+    {
+        if (func == m_DepthFunc)
+        {
+            ++m_Current.depth.elided;
+            return;
+        }
+        glDepthFunc(func);
+        m_DepthFunc = func;
+        ++m_Current.depth.issued;
+    }
+
+    void GLStateCache::DepthMask(bool write)
+    {
+        if (m_DepthMask == static_cast<int>(write))
+        {
+            ++m_Current.depth.elided;
+            return;
+        }
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+        m_DepthMask = write ? 1 : 0;
+        ++m_Current.depth.issued;
+    }
+
+    void GLStateCache::ColorMask(bool write)
+    {
+        if (m_ColorMask == static_cast<int>(write))
+        {
+            ++m_Current.depth.elided;
+            return;
+        }
+        const GLboolean value = write ? GL_TRUE : GL_FALSE;
+        glColorMask(value, value, value, value);
+        m_ColorMask = write ? 1 : 0;
+        ++m_Current.depth.issued;
+    }
+
+} // namespace renderer
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * GLStateCache
+     * ------------
+     * 记住最近一次设置的程序、VAO、各纹理单元的绑定和深度 / 颜色写入状态，
+     * 与当前值相同的设置直接跳过，不发出 GL 调用。
+     * 缓存只知道经过它设置的状态：其它代码（ImGui、DeferredPBRRenderer 等）直接改了 GL 状态后，
+     * 需要调用 Invalidate() / InvalidateTextures()，下一次设置一定会真正发出。
+     */
+    class GLStateCache {
+    public:
+        static const unsigned int MAX_TEXTURE_UNITS = 16;
+
+        /// 某类状态本帧真正发出的和被跳过的调用数
+        struct Counter {
+            unsigned int issued = 0;
+            unsigned int elided = 0;
+        };
+        struct Stats {
+            Counter programs;   // glUseProgram
+            Counter vaos;       // glBindVertexArray
+            Counter textures;   // glBindTexture（含所需的 glActiveTexture）
+            Counter depth;      // glDepthFunc / glDepthMask / glColorMask
+
+            unsigned int Issued() const { return programs.issued + vaos.issued + textures.issued + depth.issued; }
+            unsigned int Elided() const { return programs.elided + vaos.elided + textures.elided + depth.elided; }
+        };
+
+        GLStateCache() { Invalidate(); }
+
+        /// 保存上一帧统计并清零，同时 Invalidate()（每帧开始时调用）
+        void BeginFrame();
+        const Stats& LastFrame() const { return m_LastFrame; }
+
+        void Invalidate();
+        void InvalidateTextures();
+
+        void UseProgram(GLuint program);
+        void BindVertexArray(GLuint vao);
+        /// 绑定到指定纹理单元；unit 超出 MAX_TEXTURE_UNITS 时不缓存
+        void BindTexture(unsigned int unit, GLenum target, GLuint texture);
+        void DepthFunc(GLenum func);
+        void DepthMask(bool write);
+        void ColorMask(bool write);
+
+        GLuint CurrentProgram() const { return m_Program; }
+
+    private:
+        static const GLuint UNKNOWN = 0xFFFFFFFFu;
+        static const int    TARGET_COUNT = 4;   // 2D / CUBE_MAP / 2D_ARRAY / BUFFER
+
+        GLuint m_Program = UNKNOWN;
+        GLuint m_Vao = UNKNOWN;
+        GLuint m_ActiveUnit = UNKNOWN;
+        GLuint m_Textures[MAX_TEXTURE_UNITS][TARGET_COUNT];
+        GLenum m_DepthFunc = 0;
+        int    m_DepthMask = -1;   // -1 表示未知
+        int    m_ColorMask = -1;
+
+        Stats m_Current;
+        Stats m_LastFrame;
+
+        static int TargetSlot(GLenum target);
+        void       ActivateUnit(unsigned int unit);
+    };
+
+} // namespace renderer
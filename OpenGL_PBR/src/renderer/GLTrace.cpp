@@ -0,0 +1,439 @@
+#include "GLTrace.h"
+#include "GLCallCounter.h"
+#include "GLEntryPoints.h"
+#include "GLExtensions.h"
+#include "GLTraceFormat.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <unordered_map>
+
+namespace renderer {
+
+    std::string  GLTrace::s_Path;
+    unsigned int GLTrace::s_Frames = 0;
+    unsigned int GLTrace::s_SkipFrames = 0;
+    unsigned int GLTrace::s_FrameIndex = 0;
+    bool         GLTrace::s_Recording = false;
+
+    namespace {
+
+        using trace::RecordType;
+        using trace::ToSlot;
+
+        FILE*        s_File = nullptr;
+        uint64_t     s_FileBytes = 0;
+        uint64_t     s_BlobBytes = 0;
+        uint64_t     s_CallsWritten = 0;
+        unsigned int s_FramesWritten = 0;
+
+        std::unordered_map<uint64_t, uint32_t> s_BlobIds;   // 内容哈希 → 数据块编号
+        uint32_t     s_PendingBlobs[trace::MAX_BLOBS];      // 当前调用引用的数据块
+        unsigned int s_PendingCount = 0;
+
+        // 录制期间跟踪的少量状态，用来确定 glTexImage* 从客户端内存读多少字节
+        GLint  s_UnpackAlignment = 4;
+        GLuint s_UnpackBuffer = 0;
+
+        void Write(const void* data, size_t size)
+        {
+            std::fwrite(data, 1, size, s_File);
+            s_FileBytes += size;
+        }
+
+        template <typename T>
+        void WriteValue(const T& value)
+        {
+            Write(&value, sizeof(value));
+        }
+
+        /// 64 位内容哈希（按 8 字节一组混合），用于数据块去重
+        uint64_t Hash(const unsigned char* data, uint64_t size)
+        {
+            uint64_t h = 0xcbf29ce484222325ull ^ (size * 0x9E3779B97F4A7C15ull);
+            uint64_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                h = (h ^ word) * 0x100000001b3ull;
+                h ^= h >> 29;
+            }
+            for (; i < size; ++i)
+                h = (h ^ data[i]) * 0x100000001b3ull;
+            return h ^ (h >> 32);
+        }
+
+        /// 把一段客户端内存作为当前调用的数据块；内容相同的只写一次，之后按编号引用
+        void AddBlob(const void* data, uint64_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            const uint64_t key = Hash(bytes, size);
+
+            uint32_t id;
+            auto it = s_BlobIds.find(key);
+            if (it != s_BlobIds.end())
+                id = it->second;
+            else
+            {
+                id = static_cast<uint32_t>(s_BlobIds.size());
+                s_BlobIds.emplace(key, id);
+                WriteValue(RecordType::Blob);
+                WriteValue(id);
+                WriteValue(size);
+                // 数据按 8 字节对齐，回放时整个文件读进内存后可以直接交给 GL
+                const uint8_t padding = static_cast<uint8_t>((8 - (s_FileBytes + 1) % 8) % 8);
+                const uint64_t zero = 0;
+                WriteValue(padding);
+                Write(&zero, padding);
+                Write(bytes, static_cast<size_t>(size));
+                s_BlobBytes += size;
+            }
+            s_PendingBlobs[s_PendingCount++] = id;
+        }
+
+        template <typename... A>
+        void WriteCall(GLEntry entry, bool hasResult, uint64_t result, A... args)
+        {
+            const uint64_t slots[] = { ToSlot(args)..., 0 };
+            const uint8_t argCount = static_cast<uint8_t>(sizeof...(A));
+            static_assert(sizeof...(A) <= trace::MAX_ARGS, "raise trace::MAX_ARGS");
+
+            WriteValue(RecordType::Call);
+            WriteValue(static_cast<uint16_t>(entry));
+            WriteValue(argCount);
+            WriteValue(static_cast<uint8_t>(s_PendingCount));
+            WriteValue(static_cast<uint8_t>(hasResult ? 1 : 0));
+            if (hasResult)
+                WriteValue(result);
+            Write(slots, sizeof(uint64_t) * argCount);
+            Write(s_PendingBlobs, sizeof(uint32_t) * s_PendingCount);
+            s_PendingCount = 0;
+            ++s_CallsWritten;
+        }
+
+        /// 纯查询 / 回读不影响渲染结果，不录
+        constexpr bool IsRecorded(GLEntry entry)
+        {
+            switch (entry)
+            {
+            case GLEntry_glGetIntegerv:      case GLEntry_glGetInteger64v:
+            case GLEntry_glGetString:        case GLEntry_glGetStringi:
+            case GLEntry_glGetShaderiv:      case GLEntry_glGetShaderInfoLog:
+            case GLEntry_glGetProgramiv:     case GLEntry_glGetProgramInfoLog:
+            case GLEntry_glGetTexLevelParameteriv:
+            case GLEntry_glGetQueryObjectuiv: case GLEntry_glGetQueryObjectui64v:
+            case GLEntry_glCheckFramebufferStatus:
+            case GLEntry_glReadPixels:       case GLEntry_glFinish:
+                return false;
+            default:
+                return true;
+            }
+        }
+
+        // ---- 每个入口点引用的客户端数据（在调用之后执行，Gen* 的输出名字此时已写好） ----
+
+        template <GLEntry E>
+        struct Payload {
+            template <typename... A>
+            static void Capture(A...) {}
+        };
+
+        template <> struct Payload<GLEntry_glBindBuffer> {
+            static void Capture(GLenum target, GLuint buffer)
+            {
+                if (target == GL_PIXEL_UNPACK_BUFFER) s_UnpackBuffer = buffer;
+            }
+        };
+        template <> struct Payload<GLEntry_glPixelStorei> {
+            static void Capture(GLenum pname, GLint param)
+            {
+                if (pname == GL_UNPACK_ALIGNMENT) s_UnpackAlignment = param;
+            }
+        };
+        template <> struct Payload<GLEntry_glDrawBuffers> {
+            static void Capture(GLsizei n, const GLenum* bufs) { AddBlob(bufs, sizeof(GLenum) * n); }
+        };
+        template <> struct Payload<GLEntry_glMultiDrawElements> {
+            static void Capture(GLenum, const GLsizei* count, GLenum, const void* const* indices, GLsizei drawcount)
+            {
+                AddBlob(count, sizeof(GLsizei) * drawcount);
+                AddBlob(indices, sizeof(void*) * drawcount);
+            }
+        };
+        template <> struct Payload<GLEntry_glMultiDrawElementsBaseVertex> {
+            static void Capture(GLenum, const GLsizei* count, GLenum, const void* const* indices, GLsizei drawcount,
+                                const GLint* baseVertex)
+            {
+                AddBlob(count, sizeof(GLsizei) * drawcount);
+                AddBlob(indices, sizeof(void*) * drawcount);
+                AddBlob(baseVertex, sizeof(GLint) * drawcount);
+            }
+        };
+
+        /// glUniform*v：count 个元素，每个 N 个分量
+        template <unsigned int N, typename T>
+        struct UniformArray {
+            static void Capture(GLint, GLsizei count, const T* value) { AddBlob(value, sizeof(T) * N * count); }
+            static void Capture(GLint, GLsizei count, GLboolean, const T* value) { AddBlob(value, sizeof(T) * N * count); }
+        };
+        template <> struct Payload<GLEntry_glUniform2fv> : UniformArray<2, GLfloat> {};
+        template <> struct Payload<GLEntry_glUniform3fv> : UniformArray<3, GLfloat> {};
+        template <> struct Payload<GLEntry_glUniform4fv> : UniformArray<4, GLfloat> {};
+        template <> struct Payload<GLEntry_glUniform4iv> : UniformArray<4, GLint> {};
+        template <> struct Payload<GLEntry_glUniformMatrix2fv> : UniformArray<4, GLfloat> {};
+        template <> struct Payload<GLEntry_glUniformMatrix3fv> : UniformArray<9, GLfloat> {};
+        template <> struct Payload<GLEntry_glUniformMatrix4fv> : UniformArray<16, GLfloat> {};
+
+        template <> struct Payload<GLEntry_glBufferData> {
+            static void Capture(GLenum, GLsizeiptr size, const void* data, GLenum)
+            {
+                if (data) AddBlob(data, static_cast<uint64_t>(size));
+            }
+        };
+        template <> struct Payload<GLEntry_glBufferSubData> {
+            static void Capture(GLenum, GLintptr, GLsizeiptr size, const void* data)
+            {
+                AddBlob(data, static_cast<uint64_t>(size));
+            }
+        };
+
+        /// 贴图数据来自客户端内存时才存；绑定了 PBO 时 pixels 是缓冲内偏移，原样回放
+        void AddPixels(const void* pixels, GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth)
+        {
+            if (!pixels || s_UnpackBuffer != 0) return;
+            AddBlob(pixels, trace::PixelBytes(GLCallCounter::TexelBytes(format, type), width, height, depth,
+                                              s_UnpackAlignment));
+        }
+        template <> struct Payload<GLEntry_glTexImage2D> {
+            static void Capture(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint,
+                                GLenum format, GLenum type, const void* pixels)
+            {
+                AddPixels(pixels, format, type, width, height, 1);
+            }
+        };
+        template <> struct Payload<GLEntry_glTexSubImage2D> {
+            static void Capture(GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height,
+                                GLenum format, GLenum type, const void* pixels)
+            {
+                AddPixels(pixels, format, type, width, height, 1);
+            }
+        };
+        template <> struct Payload<GLEntry_glTexImage3D> {
+            static void Capture(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLsizei depth,
+                                GLint, GLenum format, GLenum type, const void* pixels)
+            {
+                AddPixels(pixels, format, type, width, height, depth);
+            }
+        };
+
+        /// glGen* 的输出 / glDelete* 的输入：n 个对象名
+        struct Names {
+            static void Capture(GLsizei n, const GLuint* names) { AddBlob(names, sizeof(GLuint) * n); }
+        };
+        template <> struct Payload<GLEntry_glGenBuffers> : Names {};
+        template <> struct Payload<GLEntry_glGenTextures> : Names {};
+        template <> struct Payload<GLEntry_glGenVertexArrays> : Names {};
+        template <> struct Payload<GLEntry_glGenFramebuffers> : Names {};
+        template <> struct Payload<GLEntry_glGenRenderbuffers> : Names {};
+        template <> struct Payload<GLEntry_glGenQueries> : Names {};
+        template <> struct Payload<GLEntry_glDeleteBuffers> : Names {};
+        template <> struct Payload<GLEntry_glDeleteTextures> : Names {};
+        template <> struct Payload<GLEntry_glDeleteVertexArrays> : Names {};
+        template <> struct Payload<GLEntry_glDeleteFramebuffers> : Names {};
+        template <> struct Payload<GLEntry_glDeleteRenderbuffers> : Names {};
+        template <> struct Payload<GLEntry_glDeleteQueries> : Names {};
+
+        /// 源码拼成一个以 '\0' 结尾的字符串，回放时 count 按 1 处理
+        template <> struct Payload<GLEntry_glShaderSource> {
+            static void Capture(GLuint, GLsizei count, const GLchar* const* string, const GLint* length)
+            {
+                std::string source;
+                for (GLsizei i = 0; i < count; ++i)
+                {
+                    if (length && length[i] >= 0) source.append(string[i], static_cast<size_t>(length[i]));
+                    else                          source.append(string[i]);
+                }
+                AddBlob(source.c_str(), source.size() + 1);
+            }
+        };
+        template <> struct Payload<GLEntry_glGetUniformLocation> {
+            static void Capture(GLuint, const GLchar* name) { AddBlob(name, std::strlen(name) + 1); }
+        };
+
+        // ---- 包装函数 ----
+
+        template <GLEntry E, typename R, typename... A>
+        struct Traced {
+            R (APIENTRYP original)(A...);
+
+            R operator()(A... args) const
+            {
+                if constexpr (!IsRecorded(E))
+                    return original(args...);
+                else
+                {
+                    if (!GLTrace::Capturing())
+                        return original(args...);
+                    if constexpr (std::is_void<R>::value)
+                    {
+                        original(args...);
+                        Payload<E>::Capture(args...);
+                        WriteCall(E, false, 0, args...);
+                    }
+                    else
+                    {
+                        const R result = original(args...);
+                        Payload<E>::Capture(args...);
+                        WriteCall(E, true, ToSlot(result), args...);
+                        return result;
+                    }
+                }
+            }
+        };
+
+        template <GLEntry E, typename R, typename... A>
+        Traced<E, R, A...> MakeTraced(R (APIENTRYP original)(A...))
+        {
+            return Traced<E, R, A...>{ original };
+        }
+
+#define PBR_TRACED_GL(ret, name, category, params, args, bytes)     \
+        decltype(glad_##name) original_##name = nullptr;             \
+        ret APIENTRY traced_##name params                            \
+        {                                                            \
+            return MakeTraced<GLEntry_##name>(original_##name) args; \
+        }
+
+        PBR_GL_ENTRY_POINTS(PBR_TRACED_GL)
+
+#undef PBR_TRACED_GL
+
+        /// 上下文创建时（替换指针之前）设置的全局状态，按等价的调用补录到准备阶段开头
+        void WriteInitialState()
+        {
+            GLint viewport[4] = { 0, 0, 0, 0 };
+            glGetIntegerv(GL_VIEWPORT, viewport);
+            WriteCall(GLEntry_glViewport, false, 0, viewport[0], viewport[1],
+                      static_cast<GLsizei>(viewport[2]), static_cast<GLsizei>(viewport[3]));
+
+            const GLenum caps[] = { GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_STENCIL_TEST,
+                                    GL_FRAMEBUFFER_SRGB, GL_TEXTURE_CUBE_MAP_SEAMLESS };
+            for (GLenum cap : caps)
+            {
+                if (glIsEnabled(cap))
+                    WriteCall(GLEntry_glEnable, false, 0, cap);
+            }
+            GLint depthFunc = GL_LESS;
+            glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+            if (depthFunc != 0)
+                WriteCall(GLEntry_glDepthFunc, false, 0, static_cast<GLenum>(depthFunc));
+        }
+
+    } // namespace
+
+    void GLTrace::RequestCapture(const std::string& path, unsigned int frames, unsigned int skipFrames)
+    {
+        s_Path = path;
+        s_Frames = frames;
+        s_SkipFrames = skipFrames;
+    }
+
+    void GLTrace::Install(int width, int height)
+    {
+        if (s_Path.empty() || s_File) return;
+        s_File = std::fopen(s_Path.c_str(), "wb");
+        if (!s_File)
+        {
+            std::cerr << "[GLTrace] Failed to open " << s_Path << std::endl;
+            return;
+        }
+        std::setvbuf(s_File, nullptr, _IOFBF, 1 << 20);
+
+        // 扩展入口不经过 glad，录不到
+        GLExtensions::DisableExtensionPaths();
+
+        trace::FileHeader header = {};
+        std::memcpy(header.magic, trace::MAGIC, sizeof(header.magic));
+        header.version    = trace::VERSION;
+        header.width      = static_cast<uint32_t>(width);
+        header.height     = static_cast<uint32_t>(height);
+        header.frames     = 0;
+        header.entryCount = GLEntryCount;
+        WriteValue(header);
+        for (unsigned int i = 0; i < GLEntryCount; ++i)
+        {
+            const char* name = GLCallCounter::EntryName(i);
+            const uint8_t length = static_cast<uint8_t>(std::strlen(name));
+            WriteValue(length);
+            Write(name, length);
+        }
+
+        // 与 GLCallCounter 相同：替换 glad 的函数指针变量；在它之后安装时包在计数器外层
+#define PBR_HOOK_GL(ret, name, category, params, args, bytes)   \
+        original_##name = glad_##name;                          \
+        if (original_##name) glad_##name = traced_##name;
+
+        PBR_GL_ENTRY_POINTS(PBR_HOOK_GL)
+
+#undef PBR_HOOK_GL
+
+        s_Recording = true;
+        WriteInitialState();
+        std::cout << "[GLTrace] Capturing " << s_Frames << " frames (after " << s_SkipFrames
+                  << " skipped) to " << s_Path << std::endl;
+    }
+
+    void GLTrace::MarkFrame()
+    {
+        if (!s_Recording) return;
+        if (s_FrameIndex++ < s_SkipFrames) return;
+        if (s_FramesWritten == s_Frames)
+        {
+            Finish();
+            return;
+        }
+        WriteValue(RecordType::Frame);
+        WriteValue(static_cast<uint32_t>(s_FramesWritten));
+        ++s_FramesWritten;
+    }
+
+    void GLTrace::Finish()
+    {
+        if (!s_Recording) return;
+        s_Recording = false;
+
+        WriteValue(RecordType::End);
+        const uint32_t frames = s_FramesWritten;
+        std::fseek(s_File, static_cast<long>(offsetof(trace::FileHeader, frames)), SEEK_SET);
+        std::fwrite(&frames, sizeof(frames), 1, s_File);
+        const bool ok = std::fclose(s_File) == 0;
+        s_File = nullptr;
+        s_BlobIds.clear();
+
+        if (!ok)
+        {
+            std::cerr << "[GLTrace] Failed to write " << s_Path << std::endl;
+            return;
+        }
+        std::cout << "[GLTrace] Wrote " << s_Path << ": " << frames << " frames, " << s_CallsWritten << " calls, "
+                  << s_FileBytes / (1024 * 1024) << " MB (" << s_BlobBytes / (1024 * 1024) << " MB data)" << std::endl;
+    }
+
+    void GLTrace::PushMarker(const char* name)
+    {
+        if (!s_Recording) return;
+        const uint16_t length = static_cast<uint16_t>(std::strlen(name));
+        WriteValue(RecordType::PushMarker);
+        WriteValue(length);
+        Write(name, length);
+    }
+
+    void GLTrace::PopMarker()
+    {
+        if (!s_Recording) return;
+        WriteValue(RecordType::PopMarker);
+    }
+
+} // namespace renderer
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+
+namespace renderer {
+
+    /**
+     * GLTrace
+     * -------
+     * 把 GL 命令流连同引用的缓冲 / 贴图 / 着色器数据录成二进制 trace 文件（.pbrtrace），
+     * 由 GLTracePlayer 在没有应用和资源文件的情况下离线重放，用来复现现场的性能问题。
+     *
+     * 录制从 GL 上下文创建后立即开始：之前的所有调用（资源创建、上传、烘焙）构成“准备阶段”，
+     * 之后按帧切分，录满 frames 帧后写完文件并停止。这样不需要在录制时从 GPU 回读任何对象，
+     * 代价是文件包含全部资源数据；内容相同的数据块只存一次（每帧重复上传的实例数据、相同的贴图）。
+     * 包装方式与 GLCallCounter 相同（替换 glad 函数指针，清单在 GLEntryPoints.h），
+     * 纯查询 / 回读类的调用不录。GpuProfiler 的计时区间作为标记写入，回放时据此按 pass 汇总和跳过。
+     *
+     * 扩展入口（multi-draw indirect、bindless）不经过 glad，录不到；录制时关闭这些路径，
+     * 所有 draw 都走 3.3 基础路径。
+     *
+     * 用法：
+     *   GLTrace::RequestCapture("frame_capture.pbrtrace", 2, 10);   // 创建上下文之前：跳过 10 帧后录 2 帧
+     *   GLTrace::Install(width, height);   // gladLoadGLLoader 之后（GLCallCounter::Install 之后）调用一次
+     *   GLTrace::MarkFrame();              // 每帧开始时调用
+     *   GLTrace::Finish();                 // 提前退出时写完已录的帧
+     */
+    class GLTrace {
+    public:
+        /// 登记一次录制；之后的 Install() 才会真正替换函数指针
+        static void RequestCapture(const std::string& path, unsigned int frames, unsigned int skipFrames = 0);
+        static bool Requested() { return !s_Path.empty(); }
+
+        /// 替换 glad 函数指针并写入文件头和初始状态；没有登记录制或打开文件失败时什么也不做
+        static void Install(int width, int height);
+
+        /// 正在写文件（准备阶段或录制中的帧）
+        static bool Capturing() { return s_Recording; }
+
+        /// 帧边界：跳过的帧算作准备阶段，之后每次调用开始新的一帧，录满后自动 Finish()
+        static void MarkFrame();
+
+        /// 写入结束记录并关闭文件（重复调用无效）
+        static void Finish();
+
+        /// 计时区间标记，由 GpuProfiler::Begin / End 调用
+        static void PushMarker(const char* name);
+        static void PopMarker();
+
+    private:
+        static std::string  s_Path;
+        static unsigned int s_Frames;
+        static unsigned int s_SkipFrames;
+        static unsigned int s_FrameIndex;
+        static bool         s_Recording;
+    };
+
+} // namespace renderer
@@ -0,0 +1,120 @@
+#pragma once
+
+// GLTrace 文件格式与参数编码，只在 GLTrace.cpp / GLTracePlayer.cpp 之间共享。
+//
+//   文件头 FileHeader
+//   入口点名字表：entryCount 个 (u8 长度 + 字符)，回放端按名字找到自己的入口点编号
+//   记录流：每条以 u8 RecordType 开头
+//     Call        u16 入口点, u8 参数个数, u8 数据块个数, u8 是否有返回值,
+//                 [u64 返回值], u64 参数 × n, u32 数据块编号 × m
+//     Blob        u32 编号, u64 字节数, u8 填充字节数, 填充, 数据
+//                 （数据从 8 字节对齐的文件偏移开始；内容相同的数据块只写一次，之后按编号引用）
+//     Frame       u32 帧序号                         （之前的记录是准备阶段：资源创建、上传、初始状态）
+//     PushMarker  u16 长度, 名字                     （GpuProfiler::Begin）
+//     PopMarker
+//     End
+//
+// 参数统一编码为 64 位：整数按值（有符号数符号扩展），float 取位模式，指针按地址——
+// 在 core profile 下 draw / 顶点属性的指针参数都是缓冲内偏移，可以原样回放；
+// 指向客户端内存的参数（上传的数据、名字数组、字符串）另存为数据块。
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <glad/glad.h>
+
+namespace renderer {
+namespace trace {
+
+    const char     MAGIC[4] = { 'P', 'B', 'R', 'T' };
+    const uint32_t VERSION  = 1;
+
+    enum class RecordType : uint8_t {
+        Call = 1,
+        Blob,
+        Frame,
+        PushMarker,
+        PopMarker,
+        End
+    };
+
+    struct FileHeader {
+        char     magic[4];
+        uint32_t version;
+        uint32_t width;        // 录制时默认帧缓冲的尺寸，回放用同样大小的离屏目标代替 FBO 0
+        uint32_t height;
+        uint32_t frames;       // 录下的帧数（结束时回填）
+        uint32_t entryCount;
+    };
+
+    /// 单条调用最多的参数个数（glBlitFramebuffer 有 10 个）
+    const unsigned int MAX_ARGS  = 12;
+    const unsigned int MAX_BLOBS = 4;
+
+    template <typename T>
+    inline uint64_t ToSlot(T value)
+    {
+        if constexpr (std::is_pointer<T>::value)
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+            static_assert(sizeof(T) == sizeof(uint32_t), "GL only passes 32-bit floats here");
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+        else
+            return static_cast<uint64_t>(value);
+    }
+
+    template <typename T>
+    inline T FromSlot(uint64_t slot)
+    {
+        if constexpr (std::is_pointer<T>::value)
+            return reinterpret_cast<T>(static_cast<uintptr_t>(slot));
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+            const uint32_t bits = static_cast<uint32_t>(slot);
+            T value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        else
+            return static_cast<T>(slot);
+    }
+
+    template <typename R, typename... A, size_t... I>
+    inline uint64_t CallWithSlots(R (APIENTRYP fn)(A...), const uint64_t* slots, std::index_sequence<I...>)
+    {
+        (void)slots;
+        if constexpr (std::is_void<R>::value)
+        {
+            fn(FromSlot<A>(slots[I])...);
+            return 0;
+        }
+        else
+            return ToSlot(fn(FromSlot<A>(slots[I])...));
+    }
+
+    /// 用解码后的参数调用 GL 函数，返回值编码为 64 位（void 返回 0）
+    template <typename R, typename... A>
+    inline uint64_t CallWithSlots(R (APIENTRYP fn)(A...), const uint64_t* slots)
+    {
+        return CallWithSlots(fn, slots, std::index_sequence_for<A...>());
+    }
+
+    /// glTexImage* 从客户端内存读取的字节数：每行按 GL_UNPACK_ALIGNMENT 对齐，最后一行不补齐
+    inline uint64_t PixelBytes(uint64_t texelBytes, GLsizei width, GLsizei height, GLsizei depth, GLint alignment)
+    {
+        if (width <= 0 || height <= 0 || depth <= 0)
+            return 0;
+        const uint64_t row = texelBytes * static_cast<uint64_t>(width);
+        const uint64_t align = alignment > 0 ? static_cast<uint64_t>(alignment) : 1;
+        const uint64_t stride = (row + align - 1) / align * align;
+        return stride * (static_cast<uint64_t>(height) * static_cast<uint64_t>(depth) - 1) + row;
+    }
+
+} // namespace trace
+} // namespace renderer
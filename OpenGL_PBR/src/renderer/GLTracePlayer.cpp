@@ -0,0 +1,761 @@
+#include "GLTracePlayer.h"
+#include "GLCallCounter.h"
+#include "GLEntryPoints.h"
+#include "GLTraceFormat.h"
+#include "RenderTarget.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace renderer {
+
+    namespace {
+
+        using trace::ToSlot;
+        using Clock = std::chrono::steady_clock;
+
+        // 每个入口点一个“用 64 位参数调用 glad 函数”的函数，按入口点编号查表
+#define PBR_REPLAY_INVOKER(ret, name, category, params, args, bytes) \
+        uint64_t Invoke_##name(const uint64_t* slots) { return trace::CallWithSlots(glad_##name, slots); }
+
+        PBR_GL_ENTRY_POINTS(PBR_REPLAY_INVOKER)
+
+#undef PBR_REPLAY_INVOKER
+
+        using Invoker = uint64_t (*)(const uint64_t*);
+#define PBR_REPLAY_INVOKER_PTR(ret, name, category, params, args, bytes) &Invoke_##name,
+        const Invoker kInvokers[] = { PBR_GL_ENTRY_POINTS(PBR_REPLAY_INVOKER_PTR) };
+#undef PBR_REPLAY_INVOKER_PTR
+
+        /// 按顺序读取内存中的文件，越界时返回 false / 空指针
+        class Reader {
+        public:
+            Reader(const unsigned char* data, size_t size) : m_Data(data), m_Size(size) {}
+
+            template <typename T>
+            bool Read(T& value)
+            {
+                const unsigned char* bytes = Take(sizeof(T));
+                if (!bytes) return false;
+                std::memcpy(&value, bytes, sizeof(T));
+                return true;
+            }
+
+            const unsigned char* Take(uint64_t size)
+            {
+                if (size > m_Size - m_Pos) return nullptr;
+                const unsigned char* bytes = m_Data + m_Pos;
+                m_Pos += static_cast<size_t>(size);
+                return bytes;
+            }
+
+        private:
+            const unsigned char* m_Data;
+            size_t               m_Size;
+            size_t               m_Pos = 0;
+        };
+
+        const uint32_t NO_PASS = ~0u;
+
+        struct DrawStat {
+            uint32_t pass      = NO_PASS;   // 所在的最内层 pass
+            uint16_t entry     = 0;
+            uint64_t count     = 0;         // 顶点 / 索引数（multi-draw 为总和）
+            uint64_t instances = 1;
+            bool     skipped   = false;
+            double   cpuNs     = 0.0;       // 所有循环的总和
+            double   gpuNs     = 0.0;
+        };
+
+        struct PassStat {
+            uint64_t calls = 0;
+            uint64_t draws = 0;
+            double   cpuNs = 0.0;
+            double   gpuNs = 0.0;
+        };
+
+        /// 等待中的 GPU 时间戳区间：结束后加到 *target 上
+        struct PendingTiming {
+            uint32_t begin;
+            uint32_t end;
+            double*  target;
+        };
+
+        double ElapsedNs(Clock::time_point start, Clock::time_point end)
+        {
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+
+        bool IsSkippable(uint16_t entry)
+        {
+            return GLCallCounter::EntryCategory(entry) == GLCallCounter::Category::Draw
+                || entry == GLEntry_glClear || entry == GLEntry_glBlitFramebuffer;
+        }
+
+    } // namespace
+
+    bool GLTracePlayer::Load(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            std::cerr << "[GLTracePlayer] Failed to open " << path << std::endl;
+            return false;
+        }
+        m_File.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(m_File.data()), static_cast<std::streamsize>(m_File.size()));
+
+        m_Commands.clear();
+        m_Args.clear();
+        m_BlobRefs.clear();
+        m_Blobs.clear();
+        m_FrameStarts.clear();
+        m_PassNames.clear();
+        m_PassDepths.clear();
+
+        Reader in(m_File.data(), m_File.size());
+        auto corrupt = [&path](const char* what) {
+            std::cerr << "[GLTracePlayer] " << path << ": " << what << std::endl;
+            return false;
+        };
+
+        trace::FileHeader header;
+        if (!in.Read(header) || std::memcmp(header.magic, trace::MAGIC, sizeof(header.magic)) != 0)
+            return corrupt("not a GL trace");
+        if (header.version != trace::VERSION)
+            return corrupt("unsupported trace version");
+        m_Width = header.width;
+        m_Height = header.height;
+
+        // 文件里的入口点编号 → 本程序的编号（按名字对应，清单顺序变了也能读）
+        std::vector<int>         entries(header.entryCount, -1);
+        std::vector<std::string> entryNames(header.entryCount);
+        for (uint32_t i = 0; i < header.entryCount; ++i)
+        {
+            uint8_t length = 0;
+            const unsigned char* name = nullptr;
+            if (!in.Read(length) || !(name = in.Take(length)))
+                return corrupt("truncated entry table");
+            entryNames[i].assign(reinterpret_cast<const char*>(name), length);
+            for (unsigned int e = 0; e < GLEntryCount; ++e)
+            {
+                if (entryNames[i] == GLCallCounter::EntryName(e))
+                {
+                    entries[i] = static_cast<int>(e);
+                    break;
+                }
+            }
+        }
+
+        int  depth = 0;
+        bool ended = false;
+        while (!ended)
+        {
+            trace::RecordType type;
+            if (!in.Read(type))
+                break;
+
+            switch (type)
+            {
+            case trace::RecordType::Call:
+            {
+                uint16_t entry = 0;
+                uint8_t  argCount = 0, blobCount = 0, hasResult = 0;
+                if (!in.Read(entry) || !in.Read(argCount) || !in.Read(blobCount) || !in.Read(hasResult))
+                    return corrupt("truncated call");
+                if (entry >= entries.size())
+                    return corrupt("call to an unknown entry point");
+                if (entries[entry] < 0)
+                {
+                    std::cerr << "[GLTracePlayer] " << path << " uses " << entryNames[entry]
+                              << ", which this build does not wrap" << std::endl;
+                    return false;
+                }
+                if (argCount > trace::MAX_ARGS || blobCount > trace::MAX_BLOBS)
+                    return corrupt("corrupt call record");
+
+                Command command;
+                command.type      = CommandType::Call;
+                command.entry     = static_cast<uint16_t>(entries[entry]);
+                command.argCount  = argCount;
+                command.blobCount = blobCount;
+                command.hasResult = hasResult != 0;
+                command.first     = static_cast<uint32_t>(m_Args.size());
+                command.blobFirst = static_cast<uint32_t>(m_BlobRefs.size());
+                if (command.hasResult && !in.Read(command.result))
+                    return corrupt("truncated call");
+                for (uint8_t i = 0; i < argCount; ++i)
+                {
+                    uint64_t arg = 0;
+                    if (!in.Read(arg)) return corrupt("truncated call");
+                    m_Args.push_back(arg);
+                }
+                for (uint8_t i = 0; i < blobCount; ++i)
+                {
+                    uint32_t id = 0;
+                    if (!in.Read(id) || id >= m_Blobs.size()) return corrupt("bad blob reference");
+                    m_BlobRefs.push_back(id);
+                }
+                m_Commands.push_back(command);
+                break;
+            }
+            case trace::RecordType::Blob:
+            {
+                uint32_t id = 0;
+                uint64_t size = 0;
+                uint8_t  padding = 0;
+                Blob blob;
+                if (!in.Read(id) || !in.Read(size) || !in.Read(padding) || !in.Take(padding)
+                    || !(blob.data = in.Take(size)))
+                    return corrupt("truncated blob");
+                if (id != m_Blobs.size())
+                    return corrupt("blobs out of order");
+                blob.size = size;
+                m_Blobs.push_back(blob);
+                break;
+            }
+            case trace::RecordType::Frame:
+            {
+                uint32_t index = 0;
+                if (!in.Read(index)) return corrupt("truncated frame record");
+                m_FrameStarts.push_back(m_Commands.size());
+                depth = 0;
+                break;
+            }
+            case trace::RecordType::PushMarker:
+            {
+                uint16_t length = 0;
+                const unsigned char* chars = nullptr;
+                if (!in.Read(length) || !(chars = in.Take(length)))
+                    return corrupt("truncated marker");
+                const std::string name(reinterpret_cast<const char*>(chars), length);
+                auto it = std::find(m_PassNames.begin(), m_PassNames.end(), name);
+                if (it == m_PassNames.end())
+                {
+                    m_PassNames.push_back(name);
+                    m_PassDepths.push_back(depth);
+                    it = m_PassNames.end() - 1;
+                }
+                Command command;
+                command.type  = CommandType::PushMarker;
+                command.first = static_cast<uint32_t>(it - m_PassNames.begin());
+                m_Commands.push_back(command);
+                ++depth;
+                break;
+            }
+            case trace::RecordType::PopMarker:
+            {
+                Command command;
+                command.type = CommandType::PopMarker;
+                m_Commands.push_back(command);
+                depth = std::max(0, depth - 1);
+                break;
+            }
+            case trace::RecordType::End:
+                ended = true;
+                break;
+            default:
+                return corrupt("corrupt record");
+            }
+        }
+
+        // 录制被中断（进程崩溃）时没有结束记录，最后一帧可能不完整
+        if (!ended)
+            std::cerr << "[GLTracePlayer] " << path << " has no end record; the last frame may be incomplete" << std::endl;
+        if (m_FrameStarts.empty())
+            return corrupt("no frames recorded");
+
+        uint64_t blobBytes = 0;
+        for (const Blob& blob : m_Blobs)
+            blobBytes += blob.size;
+        std::cout << "[GLTracePlayer] Loaded " << path << ": " << m_Width << "x" << m_Height << ", "
+                  << m_FrameStarts.size() << " frames, " << m_Commands.size() << " commands ("
+                  << m_FrameStarts[0] << " setup), " << m_Blobs.size() << " blobs, "
+                  << blobBytes / (1024 * 1024) << " MB data" << std::endl;
+        return true;
+    }
+
+    GLuint GLTracePlayer::Map(NameKind kind, uint64_t name) const
+    {
+        if (name == 0)
+            return kind == Framebuffers ? m_DefaultFramebuffer : 0;
+        // 不认识的名字（录制范围之外创建的对象）按 0 处理
+        auto it = m_Names[kind].find(static_cast<GLuint>(name));
+        return it != m_Names[kind].end() ? it->second : 0;
+    }
+
+    GLint GLTracePlayer::MapLocation(uint64_t location) const
+    {
+        const GLint captured = static_cast<GLint>(location);
+        if (captured < 0)
+            return captured;
+        // 没有经 glGetUniformLocation 查到的 location（着色器里显式指定的）原样使用
+        auto it = m_Locations.find((static_cast<uint64_t>(m_Program) << 32) | static_cast<uint32_t>(captured));
+        return it != m_Locations.end() ? it->second : captured;
+    }
+
+    void GLTracePlayer::GenNames(NameKind kind, const Command& command)
+    {
+        const GLsizei n = static_cast<GLsizei>(Arg(command, 0));
+        std::vector<GLuint> names(static_cast<size_t>(std::max(n, 0)));
+        const uint64_t args[2] = { static_cast<uint64_t>(n), ToSlot(names.data()) };
+        kInvokers[command.entry](args);
+
+        if (command.blobCount == 0) return;
+        const Blob& captured = BlobOf(command, 0);
+        for (size_t i = 0; i < names.size() && (i + 1) * sizeof(GLuint) <= captured.size; ++i)
+        {
+            GLuint name;
+            std::memcpy(&name, captured.data + i * sizeof(GLuint), sizeof(name));
+            m_Names[kind][name] = names[i];
+        }
+    }
+
+    void GLTracePlayer::DeleteNames(NameKind kind, const Command& command)
+    {
+        if (command.blobCount == 0) return;
+        const Blob& captured = BlobOf(command, 0);
+        std::vector<GLuint> names;
+        for (size_t i = 0; (i + 1) * sizeof(GLuint) <= captured.size; ++i)
+        {
+            GLuint name;
+            std::memcpy(&name, captured.data + i * sizeof(GLuint), sizeof(name));
+            auto it = m_Names[kind].find(name);
+            if (it == m_Names[kind].end()) continue;
+            names.push_back(it->second);
+            m_Names[kind].erase(it);
+        }
+        const uint64_t args[2] = { static_cast<uint64_t>(names.size()), ToSlot(names.data()) };
+        kInvokers[command.entry](args);
+    }
+
+    void GLTracePlayer::Execute(const Command& command)
+    {
+        uint64_t a[trace::MAX_ARGS] = {};
+        std::copy(m_Args.begin() + command.first, m_Args.begin() + command.first + command.argCount, a);
+
+        // 指向客户端内存的参数换成文件里的数据块；没有数据块时保留原值（空指针或缓冲内偏移）
+        auto pointer = [&](unsigned int arg, unsigned int blob) {
+            if (blob < command.blobCount)
+                a[arg] = ToSlot(BlobOf(command, blob).data);
+        };
+        const GLchar* source = nullptr;
+
+        switch (command.entry)
+        {
+        case GLEntry_glBindTexture:             a[1] = Map(Textures, a[1]); break;
+        case GLEntry_glBindVertexArray:         a[0] = Map(VertexArrays, a[0]); break;
+        case GLEntry_glBindBuffer:              a[1] = Map(Buffers, a[1]); break;
+        case GLEntry_glBindBufferBase:          a[2] = Map(Buffers, a[2]); break;
+        case GLEntry_glBindRenderbuffer:        a[1] = Map(Renderbuffers, a[1]); break;
+        case GLEntry_glFramebufferTexture2D:    a[3] = Map(Textures, a[3]); break;
+        case GLEntry_glFramebufferTextureLayer: a[2] = Map(Textures, a[2]); break;
+        case GLEntry_glFramebufferRenderbuffer: a[3] = Map(Renderbuffers, a[3]); break;
+        case GLEntry_glTexBuffer:               a[2] = Map(Buffers, a[2]); break;
+        case GLEntry_glBeginQuery:              a[1] = Map(Queries, a[1]); break;
+        case GLEntry_glQueryCounter:            a[0] = Map(Queries, a[0]); break;
+        case GLEntry_glUseProgram:
+            m_Program = static_cast<GLuint>(a[0]);
+            a[0] = Map(Objects, a[0]);
+            break;
+        case GLEntry_glBindFramebuffer:
+            a[1] = Map(Framebuffers, a[1]);
+            if (a[0] != GL_READ_FRAMEBUFFER)
+                m_DrawFramebuffer = static_cast<GLuint>(a[1]);
+            break;
+        case GLEntry_glDrawBuffers:
+            pointer(1, 0);
+            break;
+        case GLEntry_glMultiDrawElementsBaseVertex:
+            pointer(5, 2);
+            pointer(1, 0);
+            pointer(3, 1);
+            break;
+        case GLEntry_glMultiDrawElements:
+            pointer(1, 0);
+            pointer(3, 1);
+            break;
+
+        case GLEntry_glUniform1i: case GLEntry_glUniform1f: case GLEntry_glUniform2f:
+        case GLEntry_glUniform3f: case GLEntry_glUniform3i: case GLEntry_glUniform4f:
+            a[0] = ToSlot(MapLocation(a[0]));
+            break;
+        case GLEntry_glUniform2fv: case GLEntry_glUniform3fv: case GLEntry_glUniform4fv: case GLEntry_glUniform4iv:
+            a[0] = ToSlot(MapLocation(a[0]));
+            pointer(2, 0);
+            break;
+        case GLEntry_glUniformMatrix2fv: case GLEntry_glUniformMatrix3fv: case GLEntry_glUniformMatrix4fv:
+            a[0] = ToSlot(MapLocation(a[0]));
+            pointer(3, 0);
+            break;
+
+        case GLEntry_glBufferData:    pointer(2, 0); break;
+        case GLEntry_glBufferSubData: pointer(3, 0); break;
+        case GLEntry_glTexImage2D:    pointer(8, 0); break;
+        case GLEntry_glTexSubImage2D: pointer(8, 0); break;
+        case GLEntry_glTexImage3D:    pointer(9, 0); break;
+
+        case GLEntry_glGenBuffers:          GenNames(Buffers, command); return;
+        case GLEntry_glGenTextures:         GenNames(Textures, command); return;
+        case GLEntry_glGenVertexArrays:     GenNames(VertexArrays, command); return;
+        case GLEntry_glGenFramebuffers:     GenNames(Framebuffers, command); return;
+        case GLEntry_glGenRenderbuffers:    GenNames(Renderbuffers, command); return;
+        case GLEntry_glGenQueries:          GenNames(Queries, command); return;
+        case GLEntry_glDeleteBuffers:       DeleteNames(Buffers, command); return;
+        case GLEntry_glDeleteTextures:      DeleteNames(Textures, command); return;
+        case GLEntry_glDeleteVertexArrays:  DeleteNames(VertexArrays, command); return;
+        case GLEntry_glDeleteFramebuffers:  DeleteNames(Framebuffers, command); return;
+        case GLEntry_glDeleteRenderbuffers: DeleteNames(Renderbuffers, command); return;
+        case GLEntry_glDeleteQueries:       DeleteNames(Queries, command); return;
+
+        case GLEntry_glCreateShader:
+        case GLEntry_glCreateProgram:
+            m_Names[Objects][static_cast<GLuint>(command.result)] = static_cast<GLuint>(kInvokers[command.entry](a));
+            return;
+        case GLEntry_glDeleteShader:
+        case GLEntry_glDeleteProgram:
+        {
+            const GLuint captured = static_cast<GLuint>(a[0]);
+            a[0] = Map(Objects, a[0]);
+            kInvokers[command.entry](a);
+            m_Names[Objects].erase(captured);
+            return;
+        }
+        case GLEntry_glShaderSource:
+            a[0] = Map(Objects, a[0]);
+            a[1] = 1;
+            source = command.blobCount > 0 ? reinterpret_cast<const GLchar*>(BlobOf(command, 0).data) : "";
+            a[2] = ToSlot(&source);
+            a[3] = 0;
+            break;
+        case GLEntry_glCompileShader:
+        case GLEntry_glLinkProgram:
+        {
+            const GLuint name = Map(Objects, a[0]);
+            a[0] = name;
+            kInvokers[command.entry](a);
+            GLint ok = GL_TRUE;
+            char log[512] = "";
+            if (command.entry == GLEntry_glCompileShader)
+            {
+                glGetShaderiv(name, GL_COMPILE_STATUS, &ok);
+                if (!ok) glGetShaderInfoLog(name, sizeof(log), nullptr, log);
+            }
+            else
+            {
+                glGetProgramiv(name, GL_LINK_STATUS, &ok);
+                if (!ok) glGetProgramInfoLog(name, sizeof(log), nullptr, log);
+            }
+            if (!ok)
+                std::cerr << "[GLTracePlayer] " << GLCallCounter::EntryName(command.entry) << " failed: " << log << std::endl;
+            return;
+        }
+        case GLEntry_glAttachShader:
+            a[0] = Map(Objects, a[0]);
+            a[1] = Map(Objects, a[1]);
+            break;
+        case GLEntry_glGetUniformLocation:
+        {
+            const GLuint program = static_cast<GLuint>(a[0]);
+            a[0] = Map(Objects, a[0]);
+            pointer(1, 0);
+            const GLint location = static_cast<GLint>(kInvokers[command.entry](a));
+            const GLint captured = static_cast<GLint>(command.result);
+            if (captured >= 0)
+                m_Locations[(static_cast<uint64_t>(program) << 32) | static_cast<uint32_t>(captured)] = location;
+            return;
+        }
+        default:
+            break;
+        }
+        kInvokers[command.entry](a);
+    }
+
+    bool GLTracePlayer::Run(const Options& options)
+    {
+        if (m_FrameStarts.empty())
+            return false;
+
+        for (auto& names : m_Names) names.clear();
+        m_Locations.clear();
+        m_Program = 0;
+
+        // 录制时的默认帧缓冲
+        RenderTarget target(static_cast<int>(m_Width), static_cast<int>(m_Height));
+        m_DefaultFramebuffer = target.GetFramebuffer();
+        m_DrawFramebuffer = m_DefaultFramebuffer;
+        target.Bind();
+
+        // 1. 准备阶段只执行一次，不计入统计
+        const Clock::time_point setupStart = Clock::now();
+        for (size_t i = 0; i < m_FrameStarts[0]; ++i)
+        {
+            if (m_Commands[i].type == CommandType::Call)
+                Execute(m_Commands[i]);
+        }
+        glFinish();
+        std::cout << "[GLTracePlayer] Setup: " << m_FrameStarts[0] << " commands in "
+                  << ElapsedNs(setupStart, Clock::now()) / 1.0e6 << " ms" << std::endl;
+
+        std::vector<bool> skipPass(m_PassNames.size(), false);
+        for (const std::string& name : options.skipPasses)
+        {
+            auto it = std::find(m_PassNames.begin(), m_PassNames.end(), name);
+            if (it == m_PassNames.end())
+                std::cerr << "[GLTracePlayer] No pass named \"" << name << "\" in the trace" << std::endl;
+            else
+                skipPass[it - m_PassNames.begin()] = true;
+        }
+
+        // 2. 录下的帧重复执行 loops 遍
+        const size_t frameCount = m_FrameStarts.size();
+        const unsigned int loops = std::max(options.loops, 1u);
+        std::vector<std::vector<DrawStat>> draws(frameCount);
+        std::vector<PassStat> passes(m_PassNames.size());
+        std::vector<bool>     passInFrames(m_PassNames.size(), false);   // 只在准备阶段出现的（烘焙）不输出
+        std::vector<uint64_t> entryCalls(GLEntryCount, 0);
+        std::vector<double>   entryNs(GLEntryCount, 0.0);
+        double frameCpuNs = 0.0, frameGpuNs = 0.0;
+        uint64_t frameCalls = 0;
+
+        std::vector<GLuint> queries;
+        std::vector<PendingTiming> pending;
+        std::vector<uint32_t> passStack, passBegin;
+
+        for (unsigned int loop = 0; loop < loops; ++loop)
+        {
+            for (size_t frame = 0; frame < frameCount; ++frame)
+            {
+                const size_t begin = m_FrameStarts[frame];
+                const size_t end = frame + 1 < frameCount ? m_FrameStarts[frame + 1] : m_Commands.size();
+
+                uint32_t usedQueries = 0;
+                auto timestamp = [&]() -> uint32_t {
+                    if (usedQueries == queries.size())
+                    {
+                        GLuint query = 0;
+                        glGenQueries(1, &query);
+                        queries.push_back(query);
+                    }
+                    glQueryCounter(queries[usedQueries], GL_TIMESTAMP);
+                    return usedQueries++;
+                };
+                pending.clear();
+                passStack.clear();
+                passBegin.clear();
+                unsigned int skipDepth = 0;
+                size_t drawIndex = 0;
+
+                const uint32_t frameBegin = options.gpuTiming ? timestamp() : 0;
+                const Clock::time_point frameStart = Clock::now();
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const Command& command = m_Commands[i];
+                    if (command.type == CommandType::PushMarker)
+                    {
+                        passStack.push_back(command.first);
+                        passInFrames[command.first] = true;
+                        passBegin.push_back(options.gpuTiming ? timestamp() : 0);
+                        if (skipPass[command.first]) ++skipDepth;
+                        continue;
+                    }
+                    if (command.type == CommandType::PopMarker)
+                    {
+                        if (passStack.empty()) continue;
+                        const uint32_t pass = passStack.back();
+                        if (options.gpuTiming)
+                            pending.push_back({ passBegin.back(), timestamp(), &passes[pass].gpuNs });
+                        if (skipPass[pass]) --skipDepth;
+                        passStack.pop_back();
+                        passBegin.pop_back();
+                        continue;
+                    }
+
+                    const bool isDraw = GLCallCounter::EntryCategory(command.entry) == GLCallCounter::Category::Draw;
+                    bool skip = IsSkippable(command.entry) && skipDepth > 0;
+                    DrawStat* stat = nullptr;
+                    if (isDraw)
+                    {
+                        const size_t index = drawIndex++;
+                        if (std::find(options.skipDraws.begin(), options.skipDraws.end(), index) != options.skipDraws.end())
+                            skip = true;
+                        if (loop == 0)
+                        {
+                            DrawStat s;
+                            s.pass    = passStack.empty() ? NO_PASS : passStack.back();
+                            s.entry   = command.entry;
+                            s.skipped = skip;
+                            switch (command.entry)
+                            {
+                            case GLEntry_glDrawArrays:             s.count = Arg(command, 2); break;
+                            case GLEntry_glDrawArraysInstanced:    s.count = Arg(command, 2); s.instances = Arg(command, 3); break;
+                            case GLEntry_glDrawElementsInstanced:  s.count = Arg(command, 1); s.instances = Arg(command, 4); break;
+                            case GLEntry_glMultiDrawElements:
+                            case GLEntry_glMultiDrawElementsBaseVertex:
+                                if (command.blobCount > 0)
+                                {
+                                    const Blob& counts = BlobOf(command, 0);
+                                    for (uint64_t j = 0; (j + 1) * sizeof(GLsizei) <= counts.size; ++j)
+                                    {
+                                        GLsizei n;
+                                        std::memcpy(&n, counts.data + j * sizeof(GLsizei), sizeof(n));
+                                        s.count += static_cast<uint64_t>(n);
+                                    }
+                                }
+                                break;
+                            default:                               s.count = Arg(command, 1); break;
+                            }
+                            draws[frame].push_back(s);
+                        }
+                        stat = &draws[frame][index];
+                    }
+                    if (skip)
+                        continue;
+
+                    const uint32_t drawBegin = (isDraw && options.gpuTiming) ? timestamp() : 0;
+                    const Clock::time_point callStart = Clock::now();
+                    Execute(command);
+                    const double ns = ElapsedNs(callStart, Clock::now());
+                    if (stat)
+                    {
+                        stat->cpuNs += ns;
+                        if (options.gpuTiming)
+                            pending.push_back({ drawBegin, timestamp(), &stat->gpuNs });
+                    }
+
+                    ++frameCalls;
+                    ++entryCalls[command.entry];
+                    entryNs[command.entry] += ns;
+                    for (uint32_t pass : passStack)
+                    {
+                        ++passes[pass].calls;
+                        passes[pass].cpuNs += ns;
+                        if (isDraw) ++passes[pass].draws;
+                    }
+                }
+                frameCpuNs += ElapsedNs(frameStart, Clock::now());
+                if (options.gpuTiming)
+                    pending.push_back({ frameBegin, timestamp(), &frameGpuNs });
+
+                // 等这一帧在 GPU 上执行完，读回时间戳
+                glFinish();
+                for (const PendingTiming& timing : pending)
+                {
+                    GLuint64 t0 = 0, t1 = 0;
+                    glGetQueryObjectui64v(queries[timing.begin], GL_QUERY_RESULT, &t0);
+                    glGetQueryObjectui64v(queries[timing.end], GL_QUERY_RESULT, &t1);
+                    if (t1 > t0)
+                        *timing.target += static_cast<double>(t1 - t0);
+                }
+            }
+        }
+        if (!queries.empty())
+            glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+
+        // 3. 报告：统计值都换算成每帧（或每次）平均
+        const double perFrame = 1.0 / (static_cast<double>(loops) * frameCount);
+        size_t drawsPerFrame = 0, skippedPerFrame = 0;
+        for (const auto& frameDraws : draws)
+        {
+            drawsPerFrame += frameDraws.size();
+            for (const DrawStat& s : frameDraws)
+                skippedPerFrame += s.skipped ? 1 : 0;
+        }
+
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "[GLTracePlayer] Replayed " << frameCount << " frames x " << loops << " loops: CPU "
+                  << frameCpuNs * perFrame / 1.0e6 << " ms/frame";
+        if (options.gpuTiming)
+            std::cout << ", GPU " << frameGpuNs * perFrame / 1.0e6 << " ms/frame";
+        std::cout << ", " << static_cast<uint64_t>(frameCalls * perFrame) << " calls and "
+                  << drawsPerFrame / frameCount << " draws per frame";
+        if (skippedPerFrame > 0)
+            std::cout << " (" << skippedPerFrame / frameCount << " draws skipped)";
+        std::cout << std::endl;
+
+        std::cout << "[GLTracePlayer]   " << std::left << std::setw(32) << "pass" << std::right << std::setw(8) << "calls"
+                  << std::setw(8) << "draws" << std::setw(10) << "CPU ms" << std::setw(10) << "GPU ms" << std::endl;
+        for (size_t p = 0; p < m_PassNames.size(); ++p)
+        {
+            if (!passInFrames[p]) continue;
+            const std::string label = std::string(m_PassDepths[p] * 2, ' ') + m_PassNames[p] + (skipPass[p] ? " (skipped)" : "");
+            std::cout << "[GLTracePlayer]   " << std::left << std::setw(32) << label << std::right
+                      << std::setw(8) << static_cast<uint64_t>(passes[p].calls * perFrame)
+                      << std::setw(8) << static_cast<uint64_t>(passes[p].draws * perFrame)
+                      << std::setw(10) << passes[p].cpuNs * perFrame / 1.0e6
+                      << std::setw(10) << passes[p].gpuNs * perFrame / 1.0e6 << std::endl;
+        }
+
+        std::vector<unsigned int> order;
+        for (unsigned int e = 0; e < GLEntryCount; ++e)
+        {
+            if (entryCalls[e] > 0) order.push_back(e);
+        }
+        std::sort(order.begin(), order.end(), [&entryNs](unsigned int a, unsigned int b) { return entryNs[a] > entryNs[b]; });
+        std::cout << "[GLTracePlayer] Entry points by CPU time (per frame):" << std::endl;
+        for (size_t i = 0; i < order.size() && i < 8; ++i)
+            std::cout << "[GLTracePlayer]   " << std::left << std::setw(32) << GLCallCounter::EntryName(order[i]) << std::right
+                      << std::setw(8) << static_cast<uint64_t>(entryCalls[order[i]] * perFrame)
+                      << std::setw(10) << entryNs[order[i]] * perFrame / 1.0e6 << " ms" << std::endl;
+
+        if (options.gpuTiming)
+        {
+            std::vector<std::pair<size_t, size_t>> ranked;
+            for (size_t f = 0; f < frameCount; ++f)
+                for (size_t d = 0; d < draws[f].size(); ++d)
+                    if (!draws[f][d].skipped) ranked.emplace_back(f, d);
+            std::sort(ranked.begin(), ranked.end(), [&draws](const auto& a, const auto& b) {
+                return draws[a.first][a.second].gpuNs > draws[b.first][b.second].gpuNs;
+            });
+            std::cout << "[GLTracePlayer] Most expensive draws (GPU):" << std::endl;
+            for (size_t i = 0; i < ranked.size() && i < 8; ++i)
+            {
+                const DrawStat& s = draws[ranked[i].first][ranked[i].second];
+                std::cout << "[GLTracePlayer]   frame " << ranked[i].first << " draw " << ranked[i].second << " ["
+                          << (s.pass == NO_PASS ? std::string("-") : m_PassNames[s.pass]) << "] "
+                          << GLCallCounter::EntryName(s.entry) << " " << s.count << " x" << s.instances << ": "
+                          << s.gpuNs / loops / 1.0e6 << " ms" << std::endl;
+            }
+        }
+        std::cout << std::defaultfloat << std::setprecision(6);
+
+        if (!options.csvPath.empty())
+        {
+            std::ofstream csv(options.csvPath);
+            if (!csv)
+                std::cerr << "[GLTracePlayer] Failed to open " << options.csvPath << std::endl;
+            else
+            {
+                csv << "frame,draw,pass,entry,count,instances,skipped,cpu_us,gpu_us\n";
+                for (size_t f = 0; f < frameCount; ++f)
+                {
+                    for (size_t d = 0; d < draws[f].size(); ++d)
+                    {
+                        const DrawStat& s = draws[f][d];
+                        csv << f << "," << d << "," << (s.pass == NO_PASS ? std::string() : m_PassNames[s.pass]) << ","
+                            << GLCallCounter::EntryName(s.entry) << "," << s.count << "," << s.instances << ","
+                            << (s.skipped ? 1 : 0) << "," << s.cpuNs / loops / 1.0e3 << "," << s.gpuNs / loops / 1.0e3 << "\n";
+                    }
+                }
+                std::cout << "[GLTracePlayer] Wrote " << options.csvPath << std::endl;
+            }
+        }
+
+        // 最后一帧结束时绑定的绘制目标，一般就是录制时的默认帧缓冲
+        if (!options.imagePath.empty())
+        {
+            std::vector<unsigned char> rgba(static_cast<size_t>(m_Width) * m_Height * 4);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, m_DrawFramebuffer);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glReadPixels(0, 0, static_cast<GLsizei>(m_Width), static_cast<GLsizei>(m_Height), GL_RGBA, GL_UNSIGNED_BYTE,
+                         rgba.data());
+            RenderTarget::WritePPM(options.imagePath, rgba, static_cast<int>(m_Width), static_cast<int>(m_Height));
+        }
+        return true;
+    }
+
+} // namespace renderer
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * GLTracePlayer
+     * -------------
+     * 重放 GLTrace 录下的 .pbrtrace 文件，不需要应用本身和任何资源文件。
+     * 准备阶段（资源创建、上传、烘焙）只执行一次，之后把录下的帧重复执行 loops 遍并计时：
+     *  - 每个调用的 CPU 提交时间（按入口点、按 pass 汇总）；
+     *  - 每个 draw call 和每个 pass（GpuProfiler 的计时区间）的 GPU 时间，用时间戳查询测量；
+     *  - 可以跳过指定序号的 draw，或跳过整个 pass 内的 draw / 清屏 / blit（状态设置照常执行），
+     *    用来二分定位 RenderPBRScene 里的开销。
+     * 对象名（缓冲、贴图、程序……）和 uniform location 在回放时重新映射；录制时的默认帧缓冲
+     * 由一个同样大小的离屏 RenderTarget 代替。结果写到 stdout、每个 draw 一行的 CSV，以及最后一帧的 PPM。
+     *
+     * 用法：
+     *   GLTracePlayer player;
+     *   player.Load("frame_capture.pbrtrace");
+     *   core::HeadlessContext context(player.Width(), player.Height());   // 或 NullGL::Load()
+     *   player.Run(options);
+     */
+    class GLTracePlayer {
+    public:
+        struct Options {
+            unsigned int              loops = 1;      // 录下的帧整体重复执行的次数
+            std::vector<unsigned int> skipDraws;      // 每帧中要跳过的 draw 序号（从 0 开始）
+            std::vector<std::string>  skipPasses;     // 要跳过的 pass 名（任意嵌套层级）
+            bool                      gpuTiming = true;   // Null GL 下没有意义，关闭
+            std::string               csvPath   = "trace_replay.csv";
+            std::string               imagePath = "trace_frame.ppm";   // 为空时不读回
+        };
+
+        /// 读入整个文件并解析，失败时打印原因并返回 false
+        bool Load(const std::string& path);
+
+        int          Width() const { return static_cast<int>(m_Width); }
+        int          Height() const { return static_cast<int>(m_Height); }
+        unsigned int Frames() const { return static_cast<unsigned int>(m_FrameStarts.size()); }
+
+        /// 在当前 GL 上下文中重放（glad 已载入）
+        bool Run(const Options& options);
+
+    private:
+        enum class CommandType : uint8_t { Call, PushMarker, PopMarker };
+
+        struct Command {
+            CommandType type;
+            uint8_t     argCount  = 0;
+            uint8_t     blobCount = 0;
+            bool        hasResult = false;
+            uint16_t    entry     = 0;   // 本程序的入口点编号（GLEntry）
+            uint32_t    first     = 0;   // 参数在 m_Args 中的起点；PushMarker 为 pass 编号
+            uint32_t    blobFirst = 0;   // 数据块编号在 m_BlobRefs 中的起点
+            uint64_t    result    = 0;
+        };
+
+        struct Blob {
+            const unsigned char* data = nullptr;
+            uint64_t             size = 0;
+        };
+
+        std::vector<unsigned char> m_File;
+        uint32_t                   m_Width = 0;
+        uint32_t                   m_Height = 0;
+        std::vector<Command>       m_Commands;
+        std::vector<uint64_t>      m_Args;
+        std::vector<uint32_t>      m_BlobRefs;
+        std::vector<Blob>          m_Blobs;
+        std::vector<size_t>        m_FrameStarts;   // 每帧第一条命令的下标，之前的是准备阶段
+        std::vector<std::string>   m_PassNames;     // 标记名去重后的 pass 表（按首次出现的顺序）
+        std::vector<int>           m_PassDepths;    // 首次出现时的嵌套层级，只用于缩进输出
+
+        // ---- 回放状态：录制时的对象名 → 本次回放中的对象名 ----
+        enum NameKind { Buffers, Textures, VertexArrays, Framebuffers, Renderbuffers, Queries, Objects, NAME_KIND_COUNT };
+
+        std::unordered_map<GLuint, GLuint>   m_Names[NAME_KIND_COUNT];   // Objects：着色器和程序共用一个名字空间
+        std::unordered_map<uint64_t, GLint>  m_Locations;   // (录制时的程序, location) → 回放时的 location
+        GLuint m_Program = 0;              // 录制时的名字
+        GLuint m_DefaultFramebuffer = 0;   // 代替 FBO 0 的离屏目标
+        GLuint m_DrawFramebuffer = 0;      // 回放时的名字，最后一帧从这里读回
+
+        GLuint   Map(NameKind kind, uint64_t name) const;
+        GLint    MapLocation(uint64_t location) const;
+        uint64_t Arg(const Command& command, unsigned int index) const { return m_Args[command.first + index]; }
+        const Blob& BlobOf(const Command& command, unsigned int index) const
+        {
+            return m_Blobs[m_BlobRefs[command.blobFirst + index]];
+        }
+
+        /// 重新映射对象名 / location / 客户端指针后执行一条调用
+        void Execute(const Command& command);
+        void GenNames(NameKind kind, const Command& command);
+        void DeleteNames(NameKind kind, const Command& command);
+    };
+
+} // namespace renderer
@@ -0,0 +1,762 @@
+#include "GpuMemory.h"
+#include "GLCallCounter.h"
+#include "GLEntryPoints.h"
+#include "GLExtensions.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace renderer {
+
+    bool GpuMemory::s_Installed = false;
+
+    namespace {
+
+        using Kind = GpuMemory::Kind;
+
+        const unsigned int MAX_FACES     = 6;
+        const unsigned int MAX_TAG_DEPTH = 16;
+
+        struct Resource {
+            uint64_t serial = 0;          // 创建序号：对象名会被复用，快照比较按它区分
+            GLuint   name = 0;
+            GLenum   target = 0;          // 首次绑定的目标；立方体的面记为 GL_TEXTURE_CUBE_MAP
+            GLenum   format = 0;          // 贴图 / 渲染缓冲的内部格式，缓冲为 usage
+            int      width = 0;           // 第 0 层的尺寸（缓冲不用）
+            int      height = 0;
+            int      depth = 0;           // 3D 贴图的深度或数组贴图的层数
+            uint64_t texelBytes = 0;
+            uint16_t levels[MAX_FACES] = {};   // 每个面已分配存储的 mip 层（位掩码）
+            uint64_t bytes = 0;
+            uint16_t tag = 0;
+            uint64_t createdFrame = 0;
+        };
+
+        uint64_t s_Frame = 0;
+        uint64_t s_NextSerial = 1;
+        std::unordered_map<GLuint, Resource> s_Resources[GpuMemory::KIND_COUNT];
+
+        GpuMemory::Usage              s_Total;
+        std::vector<GpuMemory::TagUsage> s_Tags = { { "Untagged", {} } };
+        uint16_t     s_TagStack[MAX_TAG_DEPTH];
+        unsigned int s_TagDepth = 0;
+
+        GpuMemory::Churn s_Churn;
+        GpuMemory::Churn s_LastChurn;
+
+        // 快照：基线时的资源和按标签的汇总；基线之后释放的资源记下释放帧，之后创建又释放的只计数
+        bool                                   s_HasSnapshot = false;
+        uint64_t                               s_SnapshotFrame = 0;
+        uint64_t                               s_SnapshotSerial = 0;   // 序号小于它的资源属于基线
+        std::vector<std::pair<Kind, Resource>> s_Baseline;
+        std::vector<GpuMemory::TagUsage>       s_BaselineTags;
+        std::unordered_map<uint64_t, uint64_t> s_DeletedFrames;   // 基线资源的序号 → 释放帧
+        unsigned int                           s_TransientCount = 0;
+        uint64_t                               s_TransientBytes = 0;
+
+        // ---- 绑定状态（在包装函数里跟踪，不调用 glGet*） ----
+
+        const GLenum kBufferTargets[] = {
+            GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_UNIFORM_BUFFER, GL_TEXTURE_BUFFER,
+            GL_PIXEL_PACK_BUFFER, GL_PIXEL_UNPACK_BUFFER, GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+            GL_DRAW_INDIRECT_BUFFER, GL_SHADER_STORAGE_BUFFER,
+        };
+        const unsigned int BUFFER_TARGET_COUNT = sizeof(kBufferTargets) / sizeof(kBufferTargets[0]);
+
+        const GLenum kTextureTargets[] = {
+            GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D,
+            GL_TEXTURE_BUFFER, GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_1D, GL_TEXTURE_RECTANGLE,
+        };
+        const unsigned int TEXTURE_TARGET_COUNT = sizeof(kTextureTargets) / sizeof(kTextureTargets[0]);
+
+        GLuint s_Buffers[BUFFER_TARGET_COUNT] = {};
+        GLuint s_VertexArray = 0;
+        std::unordered_map<GLuint, GLuint> s_ElementBuffers;   // 元素缓冲的绑定属于 VAO
+        std::vector<std::array<GLuint, TEXTURE_TARGET_COUNT>> s_Textures;   // [纹理单元][目标]
+        unsigned int s_ActiveUnit = 0;
+        GLuint s_Renderbuffer = 0;
+
+        int BufferSlot(GLenum target)
+        {
+            for (unsigned int i = 0; i < BUFFER_TARGET_COUNT; ++i)
+                if (kBufferTargets[i] == target) return static_cast<int>(i);
+            return -1;
+        }
+
+        /// 立方体的六个面都对应 GL_TEXTURE_CUBE_MAP 的绑定
+        GLenum BindingTarget(GLenum target)
+        {
+            if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+                return GL_TEXTURE_CUBE_MAP;
+            return target;
+        }
+
+        int TextureSlot(GLenum target)
+        {
+            target = BindingTarget(target);
+            for (unsigned int i = 0; i < TEXTURE_TARGET_COUNT; ++i)
+                if (kTextureTargets[i] == target) return static_cast<int>(i);
+            return -1;
+        }
+
+        GLuint BoundBuffer(GLenum target)
+        {
+            if (target == GL_ELEMENT_ARRAY_BUFFER)
+            {
+                auto it = s_ElementBuffers.find(s_VertexArray);
+                return it != s_ElementBuffers.end() ? it->second : 0;
+            }
+            const int slot = BufferSlot(target);
+            return slot >= 0 ? s_Buffers[slot] : 0;
+        }
+
+        GLuint BoundTexture(GLenum target)
+        {
+            const int slot = TextureSlot(target);
+            if (slot < 0 || s_ActiveUnit >= s_Textures.size()) return 0;
+            return s_Textures[s_ActiveUnit][slot];
+        }
+
+        Resource* Find(Kind kind, GLuint name)
+        {
+            if (name == 0) return nullptr;
+            auto& resources = s_Resources[static_cast<unsigned int>(kind)];
+            auto it = resources.find(name);
+            return it != resources.end() ? &it->second : nullptr;
+        }
+
+        // ---- 登记表 ----
+
+        uint16_t CurrentTag()
+        {
+            // 超过最大嵌套深度时沿用最深一层的标签
+            return s_TagDepth > 0 ? s_TagStack[std::min(s_TagDepth, MAX_TAG_DEPTH) - 1] : 0;
+        }
+
+        uint16_t InternTag(const char* name)
+        {
+            for (size_t i = 0; i < s_Tags.size(); ++i)
+            {
+                if (s_Tags[i].name == name || std::strcmp(s_Tags[i].name, name) == 0)
+                    return static_cast<uint16_t>(i);
+            }
+            s_Tags.push_back({ name, {} });
+            return static_cast<uint16_t>(s_Tags.size() - 1);
+        }
+
+        void AddUsage(Kind kind, uint16_t tag, int64_t bytes, int count)
+        {
+            const unsigned int k = static_cast<unsigned int>(kind);
+            // 负数按补码回绕，等价于减法
+            s_Total.bytes[k] += static_cast<uint64_t>(bytes);
+            s_Total.count[k] += static_cast<unsigned int>(count);
+            s_Tags[tag].usage.bytes[k] += static_cast<uint64_t>(bytes);
+            s_Tags[tag].usage.count[k] += static_cast<unsigned int>(count);
+        }
+
+        void SetBytes(Kind kind, Resource& r, uint64_t bytes)
+        {
+            AddUsage(kind, r.tag, static_cast<int64_t>(bytes) - static_cast<int64_t>(r.bytes), 0);
+            r.bytes = bytes;
+        }
+
+        void Create(Kind kind, GLsizei n, const GLuint* names)
+        {
+            for (GLsizei i = 0; i < n; ++i)
+            {
+                Resource r;
+                r.serial = s_NextSerial++;
+                r.name = names[i];
+                r.tag = CurrentTag();
+                r.createdFrame = s_Frame;
+                s_Resources[static_cast<unsigned int>(kind)][names[i]] = r;
+                AddUsage(kind, r.tag, 0, 1);
+                ++s_Churn.created;
+            }
+        }
+
+        void Unbind(Kind kind, GLuint name)
+        {
+            switch (kind)
+            {
+            case Kind::Buffer:
+                for (GLuint& b : s_Buffers)
+                    if (b == name) b = 0;
+                for (auto& binding : s_ElementBuffers)
+                    if (binding.second == name) binding.second = 0;
+                break;
+            case Kind::Texture:
+                for (auto& unit : s_Textures)
+                    for (GLuint& t : unit)
+                        if (t == name) t = 0;
+                break;
+            case Kind::Renderbuffer:
+                if (s_Renderbuffer == name) s_Renderbuffer = 0;
+                break;
+            default:
+                break;
+            }
+        }
+
+        void Delete(Kind kind, GLsizei n, const GLuint* names)
+        {
+            auto& resources = s_Resources[static_cast<unsigned int>(kind)];
+            for (GLsizei i = 0; i < n; ++i)
+            {
+                auto it = resources.find(names[i]);
+                if (it == resources.end()) continue;
+                const Resource& r = it->second;
+                AddUsage(kind, r.tag, -static_cast<int64_t>(r.bytes), -1);
+                ++s_Churn.deleted;
+                s_Churn.freedBytes += r.bytes;
+                if (s_HasSnapshot)
+                {
+                    if (r.serial < s_SnapshotSerial)
+                        s_DeletedFrames[r.serial] = s_Frame;
+                    else
+                    {
+                        ++s_TransientCount;
+                        s_TransientBytes += r.bytes;
+                    }
+                }
+                resources.erase(it);
+                Unbind(kind, names[i]);
+            }
+        }
+
+        /// 内部格式每个纹素的字节数；不带大小的格式按上传数据的 format / type 估计
+        uint64_t InternalFormatBytes(GLenum internalFormat, GLenum format, GLenum type)
+        {
+            switch (internalFormat)
+            {
+            case GL_R8: case GL_R8UI: case GL_R8I:                          return 1;
+            case GL_RG8: case GL_R16: case GL_R16F: case GL_R16UI: case GL_R16I:
+            case GL_DEPTH_COMPONENT16:                                      return 2;
+            case GL_RGB8: case GL_SRGB8:                                    return 3;
+            case GL_RGBA8: case GL_SRGB8_ALPHA8: case GL_RG16: case GL_RG16F:
+            case GL_R32F: case GL_R32UI: case GL_R32I: case GL_RGB10_A2: case GL_R11F_G11F_B10F:
+            case GL_DEPTH_COMPONENT24: case GL_DEPTH_COMPONENT32F: case GL_DEPTH24_STENCIL8:
+                                                                            return 4;   // 24 位深度按 4 字节存
+            case GL_RGB16: case GL_RGB16F:                                  return 6;
+            case GL_RGBA16: case GL_RGBA16F: case GL_RG32F: case GL_RG32UI: case GL_RG32I:
+            case GL_DEPTH32F_STENCIL8:                                      return 8;
+            case GL_RGB32F: case GL_RGB32UI: case GL_RGB32I:                return 12;
+            case GL_RGBA32F: case GL_RGBA32UI: case GL_RGBA32I:             return 16;
+            case GL_SRGB:       return GLCallCounter::TexelBytes(GL_RGB, type);
+            case GL_SRGB_ALPHA: return GLCallCounter::TexelBytes(GL_RGBA, type);
+            default:            return GLCallCounter::TexelBytes(format != 0 ? format : internalFormat, type);
+            }
+        }
+
+        uint64_t TextureBytes(const Resource& r)
+        {
+            uint64_t total = 0;
+            for (unsigned int face = 0; face < MAX_FACES; ++face)
+            {
+                for (unsigned int level = 0; level < 16; ++level)
+                {
+                    if (!(r.levels[face] & (1u << level))) continue;
+                    const uint64_t w = std::max(1, r.width >> level);
+                    const uint64_t h = std::max(1, r.height >> level);
+                    // 数组贴图的层数不随 mip 减半
+                    const uint64_t d = r.target == GL_TEXTURE_3D ? std::max(1, r.depth >> level) : std::max(1, r.depth);
+                    total += r.texelBytes * w * h * d;
+                }
+            }
+            return total;
+        }
+
+        unsigned int MipCount(const Resource& r)
+        {
+            unsigned int mips = 0;
+            for (unsigned int face = 0; face < MAX_FACES; ++face)
+            {
+                unsigned int count = 0;
+                for (uint16_t bits = r.levels[face]; bits; bits &= bits - 1) ++count;
+                mips = std::max(mips, count);
+            }
+            return mips;
+        }
+
+        void TexImage(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                      GLsizei depth, GLenum format, GLenum type)
+        {
+            Resource* r = Find(Kind::Texture, BoundTexture(target));
+            if (!r || level < 0 || level >= 16) return;
+
+            // 尺寸换算到第 0 层；第 0 层的尺寸或格式变了就是重新分配，之前的 mip 层作废
+            const int baseWidth  = width << level;
+            const int baseHeight = height << level;
+            const int baseDepth  = BindingTarget(target) == GL_TEXTURE_3D ? depth << level : depth;
+            if (r->width != baseWidth || r->height != baseHeight || r->depth != baseDepth ||
+                r->format != static_cast<GLenum>(internalFormat))
+            {
+                std::fill(std::begin(r->levels), std::end(r->levels), uint16_t(0));
+                r->width = baseWidth;
+                r->height = baseHeight;
+                r->depth = baseDepth;
+                r->format = static_cast<GLenum>(internalFormat);
+            }
+            r->target = BindingTarget(target);
+            r->texelBytes = InternalFormatBytes(static_cast<GLenum>(internalFormat), format, type);
+            const unsigned int face = r->target == GL_TEXTURE_CUBE_MAP ? target - GL_TEXTURE_CUBE_MAP_POSITIVE_X : 0;
+            r->levels[face] |= static_cast<uint16_t>(1u << level);
+            s_Churn.allocatedBytes += r->texelBytes * static_cast<uint64_t>(width) * height * std::max(1, depth);
+            SetBytes(Kind::Texture, *r, TextureBytes(*r));
+        }
+
+        // ---- 每个入口点的记录（在原调用之后执行，Gen* 的输出名字此时已写好） ----
+
+        template <GLEntry E>
+        struct Track {
+            static constexpr bool enabled = false;
+            template <typename... A>
+            static void After(A...) {}
+        };
+
+        template <> struct Track<GLEntry_glGenBuffers> {
+            static constexpr bool enabled = true;
+            static void After(GLsizei n, GLuint* names) { Create(Kind::Buffer, n, names); }
+        };
+        template <> struct Track<GLEntry_glGenTextures> {
+            static constexpr bool enabled = true;
+            static void After(GLsizei n, GLuint* names) { Create(Kind::Texture, n, names); }
+        };
+        template <> struct Track<GLEntry_glGenRenderbuffers> {
+            static constexpr bool enabled = true;
+            static void After(GLsizei n, GLuint* names) { Create(Kind::Renderbuffer, n, names); }
+        };
+        template <> struct Track<GLEntry_glDeleteBuffers> {
+            static constexpr bool enabled = true;
+            static void After(GLsizei n, const GLuint* names) { Delete(Kind::Buffer, n, names); }
+        };
+        template <> struct Track<GLEntry_glDeleteTextures> {
+            static constexpr bool enabled = true;
+            static void After(GLsizei n, const GLuint* names) { Delete(Kind::Texture, n, names); }
+        };
+        template <> struct Track<GLEntry_glDeleteRenderbuffers> {
+            static constexpr bool enabled = true;
+            static void After(GLsizei n, const GLuint* names) { Delete(Kind::Renderbuffer, n, names); }
+        };
+        template <> struct Track<GLEntry_glDeleteVertexArrays> {
+            static constexpr bool enabled = true;
+            static void After(GLsizei n, const GLuint* arrays)
+            {
+                for (GLsizei i = 0; i < n; ++i)
+                {
+                    s_ElementBuffers.erase(arrays[i]);
+                    if (s_VertexArray == arrays[i]) s_VertexArray = 0;
+                }
+            }
+        };
+
+        template <> struct Track<GLEntry_glBindVertexArray> {
+            static constexpr bool enabled = true;
+            static void After(GLuint array) { s_VertexArray = array; }
+        };
+        template <> struct Track<GLEntry_glBindBuffer> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLuint buffer)
+            {
+                if (target == GL_ELEMENT_ARRAY_BUFFER)
+                    s_ElementBuffers[s_VertexArray] = buffer;
+                else if (BufferSlot(target) >= 0)
+                    s_Buffers[BufferSlot(target)] = buffer;
+                Resource* r = Find(Kind::Buffer, buffer);
+                if (r && r->target == 0) r->target = target;
+            }
+        };
+        // glBindBufferBase 同时改变通用绑定点
+        template <> struct Track<GLEntry_glBindBufferBase> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLuint, GLuint buffer) { Track<GLEntry_glBindBuffer>::After(target, buffer); }
+        };
+        template <> struct Track<GLEntry_glActiveTexture> {
+            static constexpr bool enabled = true;
+            static void After(GLenum texture) { s_ActiveUnit = texture - GL_TEXTURE0; }
+        };
+        template <> struct Track<GLEntry_glBindTexture> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLuint texture)
+            {
+                const int slot = TextureSlot(target);
+                if (slot >= 0 && s_ActiveUnit < s_Textures.size())
+                    s_Textures[s_ActiveUnit][slot] = texture;
+                Resource* r = Find(Kind::Texture, texture);
+                if (r && r->target == 0) r->target = target;
+            }
+        };
+        template <> struct Track<GLEntry_glBindRenderbuffer> {
+            static constexpr bool enabled = true;
+            static void After(GLenum, GLuint renderbuffer) { s_Renderbuffer = renderbuffer; }
+        };
+
+        template <> struct Track<GLEntry_glBufferData> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLsizeiptr size, const void*, GLenum usage)
+            {
+                Resource* r = Find(Kind::Buffer, BoundBuffer(target));
+                if (!r) return;
+                if (r->target == 0) r->target = target;
+                r->format = usage;
+                s_Churn.allocatedBytes += static_cast<uint64_t>(size);
+                SetBytes(Kind::Buffer, *r, static_cast<uint64_t>(size));
+            }
+        };
+        template <> struct Track<GLEntry_glTexImage2D> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                              GLint, GLenum format, GLenum type, const void*)
+            {
+                TexImage(target, level, internalFormat, width, height, 1, format, type);
+            }
+        };
+        template <> struct Track<GLEntry_glTexImage3D> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                              GLsizei depth, GLint, GLenum format, GLenum type, const void*)
+            {
+                TexImage(target, level, internalFormat, width, height, depth, format, type);
+            }
+        };
+        // 按第 0 层的尺寸补齐整条 mip 链
+        template <> struct Track<GLEntry_glGenerateMipmap> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target)
+            {
+                Resource* r = Find(Kind::Texture, BoundTexture(target));
+                if (!r) return;
+                int size = std::max(r->width, r->height);
+                if (r->target == GL_TEXTURE_3D) size = std::max(size, r->depth);
+                unsigned int levels = 1;
+                while ((size >>= 1) > 0 && levels < 16) ++levels;
+                const uint16_t mask = static_cast<uint16_t>((1u << levels) - 1);
+                const uint64_t before = r->bytes;
+                for (uint16_t& face : r->levels)
+                    if (face & 1u) face = mask;
+                SetBytes(Kind::Texture, *r, TextureBytes(*r));
+                if (r->bytes > before) s_Churn.allocatedBytes += r->bytes - before;
+            }
+        };
+        // 缓冲贴图没有自己的存储，只记格式（字节数算在缓冲上）
+        template <> struct Track<GLEntry_glTexBuffer> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLenum internalFormat, GLuint)
+            {
+                Resource* r = Find(Kind::Texture, BoundTexture(target));
+                if (r) r->format = internalFormat;
+            }
+        };
+        template <> struct Track<GLEntry_glRenderbufferStorage> {
+            static constexpr bool enabled = true;
+            static void After(GLenum target, GLenum internalFormat, GLsizei width, GLsizei height)
+            {
+                Resource* r = Find(Kind::Renderbuffer, s_Renderbuffer);
+                if (!r) return;
+                r->target = target;
+                r->format = internalFormat;
+                r->width = width;
+                r->height = height;
+                r->depth = 1;
+                r->levels[0] = 1;
+                r->texelBytes = InternalFormatBytes(internalFormat, 0, GL_UNSIGNED_BYTE);
+                const uint64_t bytes = r->texelBytes * static_cast<uint64_t>(width) * height;
+                s_Churn.allocatedBytes += bytes;
+                SetBytes(Kind::Renderbuffer, *r, bytes);
+            }
+        };
+
+        // ---- 包装函数 ----
+
+        template <GLEntry E, typename R, typename... A>
+        struct Tracked {
+            R (APIENTRYP original)(A...);
+
+            R operator()(A... args) const
+            {
+                if constexpr (std::is_void<R>::value)
+                {
+                    original(args...);
+                    Track<E>::After(args...);
+                }
+                else
+                    return original(args...);
+            }
+        };
+
+        template <GLEntry E, typename R, typename... A>
+        Tracked<E, R, A...> MakeTracked(R (APIENTRYP original)(A...))
+        {
+            return Tracked<E, R, A...>{ original };
+        }
+
+#define PBR_TRACKED_GL(ret, name, category, params, args, bytes)     \
+        decltype(glad_##name) original_##name = nullptr;              \
+        ret APIENTRY tracked_##name params                            \
+        {                                                             \
+            return MakeTracked<GLEntry_##name>(original_##name) args; \
+        }
+
+        PBR_GL_ENTRY_POINTS(PBR_TRACKED_GL)
+
+#undef PBR_TRACKED_GL
+
+        // ---- CSV ----
+
+        const char* EnumName(GLenum value)
+        {
+            switch (value)
+            {
+            case 0:                           return "";
+            case GL_ARRAY_BUFFER:             return "ARRAY_BUFFER";
+            case GL_ELEMENT_ARRAY_BUFFER:     return "ELEMENT_ARRAY_BUFFER";
+            case GL_UNIFORM_BUFFER:           return "UNIFORM_BUFFER";
+            case GL_TEXTURE_BUFFER:           return "TEXTURE_BUFFER";
+            case GL_DRAW_INDIRECT_BUFFER:     return "DRAW_INDIRECT_BUFFER";
+            case GL_PIXEL_PACK_BUFFER:        return "PIXEL_PACK_BUFFER";
+            case GL_PIXEL_UNPACK_BUFFER:      return "PIXEL_UNPACK_BUFFER";
+            case GL_STATIC_DRAW:              return "STATIC_DRAW";
+            case GL_DYNAMIC_DRAW:             return "DYNAMIC_DRAW";
+            case GL_STREAM_DRAW:              return "STREAM_DRAW";
+            case GL_STREAM_READ:              return "STREAM_READ";
+            case GL_TEXTURE_2D:               return "TEXTURE_2D";
+            case GL_TEXTURE_CUBE_MAP:         return "TEXTURE_CUBE_MAP";
+            case GL_TEXTURE_2D_ARRAY:         return "TEXTURE_2D_ARRAY";
+            case GL_TEXTURE_3D:               return "TEXTURE_3D";
+            case GL_RENDERBUFFER:             return "RENDERBUFFER";
+            case GL_RED:                      return "RED";
+            case GL_RG:                       return "RG";
+            case GL_RGB:                      return "RGB";
+            case GL_RGBA:                     return "RGBA";
+            case GL_SRGB:                     return "SRGB";
+            case GL_SRGB_ALPHA:               return "SRGB_ALPHA";
+            case GL_R8:                       return "R8";
+            case GL_RGBA8:                    return "RGBA8";
+            case GL_SRGB8_ALPHA8:             return "SRGB8_ALPHA8";
+            case GL_RGBA16:                   return "RGBA16";
+            case GL_R16F:                     return "R16F";
+            case GL_RG16F:                    return "RG16F";
+            case GL_RGB16F:                   return "RGB16F";
+            case GL_RGBA16F:                  return "RGBA16F";
+            case GL_R32F:                     return "R32F";
+            case GL_RGBA32F:                  return "RGBA32F";
+            case GL_R32UI:                    return "R32UI";
+            case GL_RG32UI:                   return "RG32UI";
+            case GL_DEPTH_COMPONENT:          return "DEPTH_COMPONENT";
+            case GL_DEPTH_COMPONENT24:        return "DEPTH_COMPONENT24";
+            case GL_DEPTH24_STENCIL8:         return "DEPTH24_STENCIL8";
+            default:
+            {
+                static char hex[16];
+                std::snprintf(hex, sizeof(hex), "0x%04X", value);
+                return hex;
+            }
+            }
+        }
+
+        void WriteResource(FILE* file, Kind kind, const Resource& r)
+        {
+            std::fprintf(file, "%s,%u,%s,", GpuMemory::KindName(kind), r.name, s_Tags[r.tag].name);
+            std::fprintf(file, "%s,", EnumName(r.target));
+            std::fprintf(file, "%s,%d,%d,%d,%u,%llu,%llu", EnumName(r.format), r.width, r.height, r.depth,
+                         kind == Kind::Buffer ? 0u : MipCount(r), static_cast<unsigned long long>(r.bytes),
+                         static_cast<unsigned long long>(r.createdFrame));
+        }
+
+        /// 所有存活资源按创建顺序排列
+        std::vector<std::pair<Kind, Resource>> LiveResources()
+        {
+            std::vector<std::pair<Kind, Resource>> live;
+            for (unsigned int k = 0; k < GpuMemory::KIND_COUNT; ++k)
+                for (const auto& entry : s_Resources[k])
+                    live.emplace_back(static_cast<Kind>(k), entry.second);
+            std::sort(live.begin(), live.end(),
+                      [](const auto& a, const auto& b) { return a.second.serial < b.second.serial; });
+            return live;
+        }
+
+        double ToMB(int64_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); }
+
+    } // namespace
+
+    GpuMemory::Scope::Scope(const char* tag)
+    {
+        if (s_TagDepth < MAX_TAG_DEPTH)
+            s_TagStack[s_TagDepth] = InternTag(tag);
+        ++s_TagDepth;
+    }
+
+    GpuMemory::Scope::~Scope()
+    {
+        --s_TagDepth;
+    }
+
+    void GpuMemory::Install()
+    {
+        if (s_Installed) return;
+        s_Installed = true;
+
+        GLint units = 0;
+        glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+        s_Textures.assign(static_cast<size_t>(std::max(units, 16)), {});
+
+        // 与 GLCallCounter 相同：替换 glad 的函数指针变量，只挂需要跟踪的入口点
+#define PBR_HOOK_GL(ret, name, category, params, args, bytes)                    \
+        original_##name = glad_##name;                                           \
+        if (Track<GLEntry_##name>::enabled && original_##name) glad_##name = tracked_##name;
+
+        PBR_GL_ENTRY_POINTS(PBR_HOOK_GL)
+
+#undef PBR_HOOK_GL
+
+        std::cout << "[GpuMemory] Tracking buffers, textures and renderbuffers" << std::endl;
+    }
+
+    void GpuMemory::BeginFrame()
+    {
+        ++s_Frame;
+        s_LastChurn = s_Churn;
+        s_Churn = Churn();
+    }
+
+    const GpuMemory::Usage& GpuMemory::Total()
+    {
+        return s_Total;
+    }
+
+    const std::vector<GpuMemory::TagUsage>& GpuMemory::ByTag()
+    {
+        return s_Tags;
+    }
+
+    const GpuMemory::Churn& GpuMemory::LastFrameChurn()
+    {
+        return s_LastChurn;
+    }
+
+    const char* GpuMemory::KindName(Kind kind)
+    {
+        static const char* kNames[] = { "buffer", "texture", "renderbuffer" };
+        const unsigned int i = static_cast<unsigned int>(kind);
+        return i < KIND_COUNT ? kNames[i] : "?";
+    }
+
+    void GpuMemory::TakeSnapshot(const std::string& path)
+    {
+        s_Baseline = LiveResources();
+        s_BaselineTags = s_Tags;
+        s_SnapshotFrame = s_Frame;
+        s_SnapshotSerial = s_NextSerial;
+        s_HasSnapshot = true;
+        s_DeletedFrames.clear();
+        s_TransientCount = 0;
+        s_TransientBytes = 0;
+        std::cout << "[GpuMemory] Snapshot at frame " << s_Frame << ": " << s_Total.Count() << " resources, "
+                  << ToMB(s_Total.Bytes()) << " MB" << std::endl;
+
+        if (path.empty()) return;
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file)
+        {
+            std::cerr << "[GpuMemory] Failed to open " << path << std::endl;
+            return;
+        }
+        std::fputs("kind,name,tag,target,format,width,height,depth,mips,bytes,created_frame,age_frames\n", file);
+        for (const auto& entry : s_Baseline)
+        {
+            WriteResource(file, entry.first, entry.second);
+            std::fprintf(file, ",%llu\n", static_cast<unsigned long long>(s_Frame - entry.second.createdFrame));
+        }
+        std::fclose(file);
+        std::cout << "[GpuMemory] Wrote " << path << std::endl;
+    }
+
+    bool GpuMemory::HasSnapshot()
+    {
+        return s_HasSnapshot;
+    }
+
+    GpuMemory::Diff GpuMemory::ExportDiff(const std::string& path)
+    {
+        Diff diff;
+        if (!s_HasSnapshot)
+        {
+            std::cerr << "[GpuMemory] No snapshot to compare against" << std::endl;
+            return diff;
+        }
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file)
+        {
+            std::cerr << "[GpuMemory] Failed to open " << path << std::endl;
+            return diff;
+        }
+        std::fputs("status,kind,name,tag,target,format,width,height,depth,mips,bytes,created_frame,delta_bytes,deleted_frame\n", file);
+
+        // 两边都按创建序号排好，归并比较
+        const std::vector<std::pair<Kind, Resource>> live = LiveResources();
+        size_t a = 0, b = 0;
+        while (a < s_Baseline.size() || b < live.size())
+        {
+            const bool takeOld = b == live.size() ||
+                                 (a < s_Baseline.size() && s_Baseline[a].second.serial < live[b].second.serial);
+            const bool takeNew = a == s_Baseline.size() ||
+                                 (b < live.size() && live[b].second.serial < s_Baseline[a].second.serial);
+            if (takeOld)
+            {
+                const auto& old = s_Baseline[a++];
+                auto it = s_DeletedFrames.find(old.second.serial);
+                std::fputs("removed,", file);
+                WriteResource(file, old.first, old.second);
+                std::fprintf(file, ",%lld,", -static_cast<long long>(old.second.bytes));
+                if (it != s_DeletedFrames.end())
+                    std::fprintf(file, "%llu", static_cast<unsigned long long>(it->second));
+                std::fputc('\n', file);
+                ++diff.removed;
+                diff.deltaBytes -= static_cast<int64_t>(old.second.bytes);
+            }
+            else if (takeNew)
+            {
+                const auto& added = live[b++];
+                std::fputs("added,", file);
+                WriteResource(file, added.first, added.second);
+                std::fprintf(file, ",%llu,\n", static_cast<unsigned long long>(added.second.bytes));
+                ++diff.added;
+                diff.deltaBytes += static_cast<int64_t>(added.second.bytes);
+            }
+            else
+            {
+                const auto& old = s_Baseline[a++];
+                const auto& now = live[b++];
+                if (old.second.bytes == now.second.bytes) continue;
+                const int64_t delta = static_cast<int64_t>(now.second.bytes) - static_cast<int64_t>(old.second.bytes);
+                std::fputs("resized,", file);
+                WriteResource(file, now.first, now.second);
+                std::fprintf(file, ",%lld,\n", static_cast<long long>(delta));
+                ++diff.resized;
+                diff.deltaBytes += delta;
+            }
+        }
+        std::fclose(file);
+
+        std::cout << "[GpuMemory] Since frame " << s_SnapshotFrame << ": +" << diff.added << " / -" << diff.removed
+                  << " resources, " << diff.resized << " resized, " << ToMB(diff.deltaBytes) << " MB; "
+                  << s_TransientCount << " created and freed in between (" << ToMB(s_TransientBytes) << " MB)" << std::endl;
+        for (size_t i = 0; i < s_Tags.size(); ++i)
+        {
+            const Usage before = i < s_BaselineTags.size() ? s_BaselineTags[i].usage : Usage();
+            const int64_t delta = static_cast<int64_t>(s_Tags[i].usage.Bytes()) - static_cast<int64_t>(before.Bytes());
+            const int count = static_cast<int>(s_Tags[i].usage.Count()) - static_cast<int>(before.Count());
+            if (delta != 0 || count != 0)
+                std::cout << "[GpuMemory]   " << s_Tags[i].name << ": " << (count >= 0 ? "+" : "") << count
+                          << " resources, " << ToMB(delta) << " MB" << std::endl;
+        }
+        std::cout << "[GpuMemory] Wrote " << path << std::endl;
+        return diff;
+    }
+
+} // namespace renderer
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * GpuMemory
+     * ---------
+     * 显存占用登记表：记录每个缓冲、贴图和渲染缓冲的大小、格式、mip 层数、创建者标签和生命周期。
+     * 包装方式与 GLCallCounter 相同（替换 glad 函数指针，清单在 GLEntryPoints.h），只挂创建 / 删除、
+     * 绑定和分配存储的入口点；绑定状态在包装函数里自己跟踪，不调用 glGet*。
+     * 大小按内部格式的名义字节数估算（mip 链、立方体六个面都计入），不含驱动的对齐和填充，
+     * RGB8 这类格式实际可能按 4 字节存储。
+     *
+     * 创建者标签用 GpuMemory::Scope 在创建资源的代码外面声明，嵌套时最内层生效（InitPBR 里顺带
+     * 创建的 G-Buffer 和立方体网格仍记在各自名下）。TextureLoader、Mesh 这类通用加载函数不声明标签，
+     * 资源记在调用方名下：
+     *   GpuMemory::Scope tag("IBL");
+     *   glGenTextures(1, &envCubemap);       // 记在 "IBL" 名下
+     *
+     * 用法：
+     *   GpuMemory::Install();                // GLCallCounter::Install 之后调用一次
+     *   GpuMemory::BeginFrame();             // 每帧开始时调用
+     *   GpuMemory::TakeSnapshot();           // 记下当前的全部资源作为基线
+     *   GpuMemory::ExportDiff("gpu_memory_diff.csv");   // 与基线比较：新增 / 释放 / 变大的资源
+     */
+    class GpuMemory {
+    public:
+        enum class Kind : uint8_t { Buffer, Texture, Renderbuffer, Count };
+        static const unsigned int KIND_COUNT = static_cast<unsigned int>(Kind::Count);
+
+        struct Usage {
+            uint64_t     bytes[KIND_COUNT] = {};
+            unsigned int count[KIND_COUNT] = {};
+
+            uint64_t     Bytes() const { return bytes[0] + bytes[1] + bytes[2]; }
+            unsigned int Count() const { return count[0] + count[1] + count[2]; }
+        };
+
+        struct TagUsage {
+            const char* name;
+            Usage       usage;
+        };
+
+        /// 本帧的创建 / 释放（BeginFrame 清零），每帧都在创建的资源通常是泄漏或没有复用
+        struct Churn {
+            unsigned int created = 0;
+            unsigned int deleted = 0;
+            uint64_t     allocatedBytes = 0;   // 本帧分配或重新分配存储的字节数
+            uint64_t     freedBytes = 0;
+        };
+
+        /// 与基线比较的结果
+        struct Diff {
+            unsigned int added = 0;
+            unsigned int removed = 0;
+            unsigned int resized = 0;
+            int64_t      deltaBytes = 0;
+        };
+
+        /// 创建者标签，作用域内创建的资源记在 tag 名下；tag 须是字符串常量
+        class Scope {
+        public:
+            explicit Scope(const char* tag);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        /// 替换 glad 函数指针（重复调用无效）
+        static void Install();
+        static bool Installed() { return s_Installed; }
+
+        /// 帧边界：帧序号加一，本帧的创建 / 释放计数移到 LastFrameChurn()
+        static void BeginFrame();
+
+        static const Usage&                 Total();
+        /// 按标签汇总（按首次出现的顺序；没有标签的资源记在 "Untagged"）
+        static const std::vector<TagUsage>& ByTag();
+        static const Churn&                 LastFrameChurn();
+        static const char*                  KindName(Kind kind);
+
+        /// 记下当前的全部资源作为基线，并写出一份完整清单（path 为空时不写）
+        static void TakeSnapshot(const std::string& path = "gpu_memory_snapshot.csv");
+        static bool HasSnapshot();
+        /// 与基线比较，把新增 / 释放 / 大小变化的资源写到 CSV，按标签的增减打印到 stdout
+        static Diff ExportDiff(const std::string& path = "gpu_memory_diff.csv");
+
+    private:
+        static bool s_Installed;
+    };
+
+} // namespace renderer
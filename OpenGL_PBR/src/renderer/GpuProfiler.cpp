@@ -0,0 +1,248 @@
+#include "GpuProfiler.h"
+#include "GLTrace.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "core/Profiler.h"
+
+namespace renderer {
+
+    bool GpuProfiler::enabled = true;
+
+    GpuProfiler::FrameQueries GpuProfiler::s_Frames[GpuProfiler::LATENCY];
+    GpuProfiler::FrameQueries GpuProfiler::s_BakeQueries;
+    int                       GpuProfiler::s_Current = 0;
+    bool                      GpuProfiler::s_InFrame = false;
+    bool                      GpuProfiler::s_Baking = false;
+    size_t                    GpuProfiler::s_BakeBase = 0;
+    std::vector<size_t>       GpuProfiler::s_Open;
+
+    std::vector<GpuProfiler::Section>    GpuProfiler::s_Sections;
+    std::vector<GpuProfiler::Timing>     GpuProfiler::s_Resolved;
+    std::vector<GpuProfiler::BakeTiming> GpuProfiler::s_Bake;
+    GLuint64                             GpuProfiler::s_ResolvedStart = 0;
+    unsigned int                         GpuProfiler::s_Dropped = 0;
+    unsigned int                         GpuProfiler::s_TraceCaptureId = 0;
+    int64_t                              GpuProfiler::s_GpuToCpuNs = 0;
+
+    namespace {
+        // 被禁用时 Begin 压入的占位，End 弹出后什么也不做
+        const size_t NO_RECORD = static_cast<size_t>(-1);
+
+        double ToMs(GLuint64 begin, GLuint64 end)
+        {
+            return end > begin ? static_cast<double>(end - begin) * 1e-6 : 0.0;
+        }
+    }
+
+    GpuProfiler::FrameQueries* GpuProfiler::Active()
+    {
+        if (s_Baking) return &s_BakeQueries;
+        if (s_InFrame) return &s_Frames[s_Current];
+        return nullptr;
+    }
+
+    GLuint GpuProfiler::Timestamp(FrameQueries& frame)
+    {
+        if (frame.used == frame.queries.size())
+        {
+            GLuint query = 0;
+            glGenQueries(1, &query);
+            frame.queries.push_back(query);
+        }
+        const GLuint query = frame.queries[frame.used++];
+        glQueryCounter(query, GL_TIMESTAMP);
+        return query;
+    }
+
+    void GpuProfiler::SyncTraceClock()
+    {
+        // 录制 CPU trace 时，GPU 时间戳要换算到 Profiler 的时基：每次录制开始时对一次两边的“当前时间”
+        if (!core::Profiler::IsRecording() || s_TraceCaptureId == core::Profiler::CaptureId())
+            return;
+        GLint64 gpuNow = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+        s_GpuToCpuNs = core::Profiler::NowNs() - static_cast<int64_t>(gpuNow);
+        s_TraceCaptureId = core::Profiler::CaptureId();
+    }
+
+    void GpuProfiler::BeginFrame()
+    {
+        SyncTraceClock();
+        s_Current = (s_Current + 1) % LATENCY;
+        FrameQueries& frame = s_Frames[s_Current];
+
+        // 这组查询是 LATENCY 帧之前发出的；GPU 按顺序执行，最后一个时间戳可用说明整帧都可用
+        if (frame.pending)
+        {
+            GLuint available = 0;
+            glGetQueryObjectuiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available)
+                Resolve(frame);
+            else
+                ++s_Dropped;
+        }
+        frame.used = 0;
+        frame.records.clear();
+        frame.pending = false;
+
+        s_Open.clear();
+        s_InFrame = true;
+        Begin("Frame");
+    }
+
+    void GpuProfiler::EndFrame()
+    {
+        if (!s_InFrame) return;
+        while (!s_Open.empty())
+            End();
+        FrameQueries& frame = s_Frames[s_Current];
+        frame.pending = frame.used > 0;
+        s_InFrame = false;
+    }
+
+    void GpuProfiler::Begin(const char* name)
+    {
+        GLTrace::PushMarker(name);
+        FrameQueries* frame = Active();
+        if (!frame || !enabled)
+        {
+            s_Open.push_back(NO_RECORD);
+            return;
+        }
+
+        Record record;
+        record.name  = name;
+        record.depth = static_cast<int>(s_Open.size() - (s_Baking ? s_BakeBase : 0));
+        record.begin = Timestamp(*frame);
+        record.end   = 0;
+        s_Open.push_back(frame->records.size());
+        frame->records.push_back(record);
+    }
+
+    void GpuProfiler::End()
+    {
+        if (s_Open.empty()) return;
+        GLTrace::PopMarker();
+        const size_t index = s_Open.back();
+        s_Open.pop_back();
+
+        FrameQueries* frame = Active();
+        if (index == NO_RECORD || !frame) return;
+        frame->records[index].end = Timestamp(*frame);
+    }
+
+    void GpuProfiler::Resolve(FrameQueries& frame)
+    {
+        for (auto& section : s_Sections)
+        {
+            section.seen = false;
+            section.lastMs = 0.0;
+        }
+        s_Resolved.clear();
+
+        // 新出现的阶段插在本帧上一个阶段之后，保持和执行顺序一致的层级显示
+        size_t previous = 0;
+        GLuint64 frameStart = 0;
+        for (size_t i = 0; i < frame.records.size(); ++i)
+        {
+            const Record& record = frame.records[i];
+            if (record.end == 0) continue;
+
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(record.begin, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(record.end, GL_QUERY_RESULT, &end);
+            if (i == 0) frameStart = begin;
+
+            const double ms = ToMs(begin, end);
+            core::Profiler::RecordGpu(record.name, static_cast<int64_t>(begin) + s_GpuToCpuNs,
+                                      static_cast<int64_t>(end) + s_GpuToCpuNs);
+            s_Resolved.push_back({ record.name, record.depth, ToMs(frameStart, begin), ms });
+
+            auto it = std::find_if(s_Sections.begin(), s_Sections.end(),
+                                   [&](const Section& s) { return s.name == record.name; });
+            if (it == s_Sections.end())
+            {
+                Section section;
+                section.name = record.name;
+                const size_t at = s_Sections.empty() ? 0 : std::min(previous + 1, s_Sections.size());
+                it = s_Sections.insert(s_Sections.begin() + at, section);
+            }
+            // 同名阶段一帧内出现多次时累加
+            it->depth = record.depth;
+            it->lastMs += ms;
+            it->seen = true;
+            previous = static_cast<size_t>(it - s_Sections.begin());
+        }
+        s_ResolvedStart = frameStart;
+
+        // 本帧没出现的阶段记为 0，关掉某条路径后平均值会逐渐降下来
+        for (auto& section : s_Sections)
+        {
+            section.history[section.cursor] = section.lastMs;
+            section.cursor = (section.cursor + 1) % HISTORY;
+            if (section.samples < HISTORY) ++section.samples;
+
+            double sum = 0.0, peak = 0.0;
+            for (int i = 0; i < section.samples; ++i)
+            {
+                sum += section.history[i];
+                peak = std::max(peak, section.history[i]);
+            }
+            section.avgMs = sum / section.samples;
+            section.maxMs = peak;
+        }
+    }
+
+    void GpuProfiler::BeginBake()
+    {
+        SyncTraceClock();
+        s_Baking = true;
+        s_BakeBase = s_Open.size();
+        s_BakeQueries.used = 0;
+        s_BakeQueries.records.clear();
+        s_Bake.clear();
+    }
+
+    void GpuProfiler::EndBake()
+    {
+        if (!s_Baking) return;
+        while (s_Open.size() > s_BakeBase)
+            End();
+        s_Baking = false;
+
+        // 烘焙只做一次，这里直接等 GPU 完成
+        for (const Record& record : s_BakeQueries.records)
+        {
+            if (record.end == 0) continue;
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(record.begin, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(record.end, GL_QUERY_RESULT, &end);
+            s_Bake.push_back({ record.name, record.depth, ToMs(begin, end) });
+            core::Profiler::RecordGpu(record.name, static_cast<int64_t>(begin) + s_GpuToCpuNs,
+                                      static_cast<int64_t>(end) + s_GpuToCpuNs);
+            std::cout << "[GpuProfiler] " << std::string(record.depth * 2, ' ') << record.name
+                      << ": " << ToMs(begin, end) << " ms" << std::endl;
+        }
+        s_BakeQueries.records.clear();
+        s_BakeQueries.used = 0;
+    }
+
+    void GpuProfiler::Shutdown()
+    {
+        for (auto& frame : s_Frames)
+        {
+            if (!frame.queries.empty())
+                glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+            frame = FrameQueries();
+        }
+        if (!s_BakeQueries.queries.empty())
+            glDeleteQueries(static_cast<GLsizei>(s_BakeQueries.queries.size()), s_BakeQueries.queries.data());
+        s_BakeQueries = FrameQueries();
+        s_InFrame = false;
+        s_Baking = false;
+        s_Open.clear();
+    }
+
+} // namespace renderer
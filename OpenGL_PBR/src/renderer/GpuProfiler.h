@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * GpuProfiler
+     * -----------
+     * 用 glQueryCounter(GL_TIMESTAMP) 测量各渲染阶段在 GPU 上的耗时。
+     *  - 每个作用域在开始和结束处各写一个时间戳；时间戳可以嵌套，GL_TIME_ELAPSED 查询则不行
+     *  - 查询对象按帧分成 LATENCY 组轮流使用，某一帧的结果在 LATENCY 帧后才读取，
+     *    到时还没完成就丢弃这一帧（计入 DroppedFrames），从不让 CPU 等待 GPU
+     *  - 每个阶段保留最近 HISTORY 帧的耗时，界面显示滑动平均、最近值和最大值
+     *  - InitPBR 的烘焙阶段只执行一次，用 BeginBake / EndBake 单独收集，结束时同步读取
+     *  - core::Profiler 录制期间，读回的计时同时写入 trace 的 GPU 轨道
+     *
+     * 用法（作用域名需为字符串常量）：
+     *   GpuProfiler::BeginFrame();
+     *   { GpuScope scope("Skybox"); ...绘制... }
+     *   GpuProfiler::EndFrame();
+     *   for (auto& s : GpuProfiler::Sections()) ...
+     */
+    class GpuProfiler {
+    public:
+        static const int LATENCY = 3;
+        static const int HISTORY = 64;
+
+        /// 一个阶段的统计（按名字合并，顺序与执行顺序一致）
+        struct Section {
+            std::string name;
+            int         depth   = 0;      // 嵌套层级，0 为整帧
+            double      lastMs  = 0.0;
+            double      avgMs   = 0.0;    // 最近 HISTORY 帧的平均
+            double      maxMs   = 0.0;    // 最近 HISTORY 帧的最大值
+            double      history[HISTORY] = {};
+            int         samples = 0;
+            int         cursor  = 0;
+            bool        seen    = false;  // 最近读回的一帧里是否出现
+        };
+
+        /// 最近读回的一帧里的一次计时（时间相对该帧开始）
+        struct Timing {
+            const char* name;
+            int         depth;
+            double      startMs;
+            double      ms;
+        };
+
+        /// 一次性烘焙阶段的耗时
+        struct BakeTiming {
+            std::string name;
+            int         depth;
+            double      ms;
+        };
+
+        /// false 时不再发出查询（已发出的照常读取）
+        static bool enabled;
+
+        static void BeginFrame();
+        static void EndFrame();
+
+        static void Begin(const char* name);
+        static void End();
+
+        /// 烘焙期间的作用域不计入帧统计，EndBake 时等待 GPU 完成并读取结果
+        static void BeginBake();
+        static void EndBake();
+
+        static const std::vector<Section>&    Sections() { return s_Sections; }
+        static const std::vector<Timing>&     LastResolvedFrame() { return s_Resolved; }
+        static const std::vector<BakeTiming>& BakeTimings() { return s_Bake; }
+        /// 最近读回的一帧开始时的 GPU 时间戳（纳秒，与 GL_TIMESTAMP 同一时基）
+        static GLuint64 LastResolvedFrameStart() { return s_ResolvedStart; }
+        static unsigned int DroppedFrames() { return s_Dropped; }
+
+        /// 删除所有查询对象（GL 上下文销毁前调用）
+        static void Shutdown();
+
+    private:
+        struct Record {
+            const char* name;
+            int         depth;
+            GLuint      begin;
+            GLuint      end;
+        };
+
+        // 一帧（或一次烘焙）用到的查询：queries 只增不减，used 为本次已用的数量
+        struct FrameQueries {
+            std::vector<GLuint> queries;
+            size_t              used = 0;
+            std::vector<Record> records;
+            bool                pending = false;
+        };
+
+        static FrameQueries s_Frames[LATENCY];
+        static FrameQueries s_BakeQueries;
+        static int          s_Current;
+        static bool         s_InFrame;
+        static bool         s_Baking;
+        static size_t       s_BakeBase;      // BeginBake 时已打开的帧作用域数，烘焙阶段的层级从这里算起
+        static std::vector<size_t> s_Open;   // 当前打开的作用域在 records 中的下标（嵌套栈）
+
+        static std::vector<Section>    s_Sections;
+        static std::vector<Timing>     s_Resolved;
+        static std::vector<BakeTiming> s_Bake;
+        static GLuint64                s_ResolvedStart;
+        static unsigned int            s_Dropped;
+        static unsigned int            s_TraceCaptureId;   // 上次校准时钟偏移时的录制编号
+        static int64_t                 s_GpuToCpuNs;       // GPU 时间戳 + 偏移 = core::Profiler::NowNs 时基
+
+        static FrameQueries* Active();
+        static GLuint        Timestamp(FrameQueries& frame);
+        static void          Resolve(FrameQueries& frame);
+        static void          SyncTraceClock();
+    };
+
+    /// 作用域计时：构造时 Begin，析构时 End
+    class GpuScope {
+    public:
+        explicit GpuScope(const char* name) { GpuProfiler::Begin(name); }
+        ~GpuScope() { GpuProfiler::End(); }
+        GpuScope(const GpuScope&) = delete;
+        GpuScope& operator=(const GpuScope&) = delete;
+    };
+
+} // namespace renderer
@@ -0,0 +1,277 @@
+#include "LightManager.h"
+#include "GpuMemory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace renderer {
+
+    LightManager::~LightManager()
+    {
+        glDeleteTextures(1, &m_Texture);
+        glDeleteBuffers(1, &m_Buffer);
+    }
+
+    void LightManager::QueryLimits()
+    {
+        if (m_MaxLights != 0) return;
+        GLint maxTexels = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+        // GL 3.3 保证至少 65536 个 texel
+        m_MaxLights = static_cast<size_t>(std::max(maxTexels, 65536)) / TEXELS_PER_LIGHT;
+    }
+
+    LightHandle LightManager::Create(const Light& light)
+    {
+        QueryLimits();
+        if (m_Positions.size() >= m_MaxLights)
+        {
+            std::cerr << "[LightManager] Light buffer is full (" << m_MaxLights << " lights)" << std::endl;
+            return LightHandle();
+        }
+
+        uint32_t slot;
+        if (!m_FreeSlots.empty())
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.push_back(Slot());
+        }
+
+        const uint32_t index = static_cast<uint32_t>(m_Positions.size());
+        m_Slots[slot].index = index;
+        m_Slots[slot].alive = true;
+
+        m_Positions.emplace_back();
+        m_Directions.emplace_back();
+        m_Colors.emplace_back();
+        m_Intensities.emplace_back();
+        m_Ranges.emplace_back();
+        m_UserRanges.emplace_back();
+        m_InnerCones.emplace_back();
+        m_OuterCones.emplace_back();
+        m_Types.emplace_back();
+        m_SlotOf.push_back(slot);
+        m_Dirty.push_back(0);
+        Write(index, light);
+
+        return LightHandle{ slot, m_Slots[slot].generation };
+    }
+
+    void LightManager::Destroy(LightHandle handle)
+    {
+        if (!IsValid(handle)) return;
+
+        // 用最后一个光源填洞，保持数组紧密
+        const uint32_t index = m_Slots[handle.slot].index;
+        const uint32_t last = static_cast<uint32_t>(m_Positions.size() - 1);
+        if (index != last)
+        {
+            m_Positions[index]   = m_Positions[last];
+            m_Directions[index]  = m_Directions[last];
+            m_Colors[index]      = m_Colors[last];
+            m_Intensities[index] = m_Intensities[last];
+            m_Ranges[index]      = m_Ranges[last];
+            m_UserRanges[index]  = m_UserRanges[last];
+            m_InnerCones[index]  = m_InnerCones[last];
+            m_OuterCones[index]  = m_OuterCones[last];
+            m_Types[index]       = m_Types[last];
+            m_SlotOf[index]      = m_SlotOf[last];
+            m_Slots[m_SlotOf[index]].index = index;
+            MarkDirty(index);
+        }
+
+        m_Positions.pop_back();
+        m_Directions.pop_back();
+        m_Colors.pop_back();
+        m_Intensities.pop_back();
+        m_Ranges.pop_back();
+        m_UserRanges.pop_back();
+        m_InnerCones.pop_back();
+        m_OuterCones.pop_back();
+        m_Types.pop_back();
+        m_SlotOf.pop_back();
+        m_Dirty.pop_back();
+
+        Slot& slot = m_Slots[handle.slot];
+        slot.alive = false;
+        ++slot.generation;
+        m_FreeSlots.push_back(handle.slot);
+    }
+
+    void LightManager::Clear()
+    {
+        for (size_t i = m_Positions.size(); i > 0; --i)
+            Destroy(HandleAt(i - 1));
+    }
+
+    bool LightManager::IsValid(LightHandle handle) const
+    {
+        return handle.slot < m_Slots.size() && m_Slots[handle.slot].alive
+            && m_Slots[handle.slot].generation == handle.generation;
+    }
+
+    LightHandle LightManager::HandleAt(size_t index) const
+    {
+        if (index >= m_SlotOf.size()) return LightHandle();
+        const uint32_t slot = m_SlotOf[index];
+        return LightHandle{ slot, m_Slots[slot].generation };
+    }
+
+    Light LightManager::Get(LightHandle handle) const
+    {
+        if (!IsValid(handle)) return Light();
+        const uint32_t i = m_Slots[handle.slot].index;
+        Light light(m_Positions[i], m_Colors[i], m_Intensities[i]);
+        light.Type = m_Types[i];
+        light.Direction = m_Directions[i];
+        light.Range = m_UserRanges[i];
+        light.InnerCone = m_InnerCones[i];
+        light.OuterCone = m_OuterCones[i];
+        return light;
+    }
+
+    void LightManager::Set(LightHandle handle, const Light& light)
+    {
+        if (!IsValid(handle)) return;
+        Write(m_Slots[handle.slot].index, light);
+    }
+
+    void LightManager::SetPosition(LightHandle handle, const glm::vec3& position)
+    {
+        if (!IsValid(handle)) return;
+        const uint32_t i = m_Slots[handle.slot].index;
+        if (m_Positions[i] == position) return;
+        m_Positions[i] = position;
+        MarkDirty(i);
+    }
+
+    void LightManager::SetRangeCutoff(float cutoff)
+    {
+        if (cutoff == m_RangeCutoff) return;
+        m_RangeCutoff = cutoff;
+        for (uint32_t i = 0; i < m_Positions.size(); ++i)
+        {
+            if (m_UserRanges[i] <= 0.0f)
+            {
+                ResolveRange(i);
+                MarkDirty(i);
+            }
+        }
+    }
+
+    void LightManager::Write(uint32_t i, const Light& light)
+    {
+        m_Positions[i]   = light.Position;
+        m_Directions[i]  = glm::length(light.Direction) > 0.0f ? glm::normalize(light.Direction) : glm::vec3(0.0f, -1.0f, 0.0f);
+        m_Colors[i]      = light.Color;
+        m_Intensities[i] = light.Intensity;
+        m_UserRanges[i]  = light.Range;
+        m_InnerCones[i]  = light.InnerCone;
+        m_OuterCones[i]  = light.OuterCone;
+        m_Types[i]       = light.Type;
+        ResolveRange(i);
+        MarkDirty(i);
+    }
+
+    void LightManager::ResolveRange(uint32_t i)
+    {
+        if (m_Types[i] == LightType::Directional)
+        {
+            m_Ranges[i] = 0.0f;
+            return;
+        }
+        if (m_UserRanges[i] > 0.0f)
+        {
+            m_Ranges[i] = m_UserRanges[i];
+            return;
+        }
+        const glm::vec3 radiance = m_Colors[i] * m_Intensities[i];
+        const float peak = std::max(radiance.r, std::max(radiance.g, radiance.b));
+        m_Ranges[i] = std::sqrt(std::max(peak, 0.0f) / std::max(m_RangeCutoff, 1e-6f));
+    }
+
+    void LightManager::MarkDirty(uint32_t index)
+    {
+        m_Dirty[index] = 1;
+        m_AnyDirty = true;
+    }
+
+    void LightManager::Pack(uint32_t i, glm::vec4* out) const
+    {
+        float scale = 0.0f, offset = 1.0f;
+        if (m_Types[i] == LightType::Spot)
+        {
+            const float cosOuter = std::cos(glm::radians(m_OuterCones[i]));
+            const float cosInner = std::cos(glm::radians(std::min(m_InnerCones[i], m_OuterCones[i])));
+            scale = 1.0f / std::max(cosInner - cosOuter, 1e-4f);
+            offset = -cosOuter * scale;
+        }
+        out[0] = glm::vec4(m_Positions[i], m_Ranges[i]);
+        out[1] = glm::vec4(m_Colors[i] * m_Intensities[i], offset);
+        out[2] = glm::vec4(m_Directions[i], scale);
+    }
+
+    const LightManager::UploadStats& LightManager::Upload()
+    {
+        m_UploadStats = UploadStats();
+        if (m_Buffer == 0)
+        {
+            GpuMemory::Scope memoryTag("Lights");
+            glGenBuffers(1, &m_Buffer);
+            glGenTextures(1, &m_Texture);
+        }
+
+        const size_t count = m_Positions.size();
+        glBindBuffer(GL_TEXTURE_BUFFER, m_Buffer);
+
+        // 容量不够时按 2 倍扩容并整体上传（至少 64 个光源，空缓冲纹理在部分驱动上会报错）
+        if (count > m_Capacity || m_Capacity == 0)
+        {
+            m_Capacity = std::min(std::max<size_t>(64, std::max(count, m_Capacity * 2)), std::max<size_t>(m_MaxLights, 64));
+            m_Staging.assign(m_Capacity * TEXELS_PER_LIGHT, glm::vec4(0.0f));
+            for (uint32_t i = 0; i < count; ++i)
+                Pack(i, &m_Staging[i * TEXELS_PER_LIGHT]);
+            glBufferData(GL_TEXTURE_BUFFER, m_Staging.size() * sizeof(glm::vec4), m_Staging.data(), GL_DYNAMIC_DRAW);
+            glBindTexture(GL_TEXTURE_BUFFER, m_Texture);
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_Buffer);
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+            std::fill(m_Dirty.begin(), m_Dirty.end(), 0);
+            m_AnyDirty = false;
+            m_UploadStats.lights = static_cast<unsigned int>(count);
+            m_UploadStats.calls = 1;
+        }
+        else if (m_AnyDirty)
+        {
+            // 连续的脏光源合并为一次 glBufferSubData
+            m_Staging.resize(count * TEXELS_PER_LIGHT);
+            size_t i = 0;
+            while (i < count)
+            {
+                if (!m_Dirty[i]) { ++i; continue; }
+                const size_t first = i;
+                for (; i < count && m_Dirty[i]; ++i)
+                {
+                    Pack(static_cast<uint32_t>(i), &m_Staging[i * TEXELS_PER_LIGHT]);
+                    m_Dirty[i] = 0;
+                }
+                const size_t texelSize = TEXELS_PER_LIGHT * sizeof(glm::vec4);
+                glBufferSubData(GL_TEXTURE_BUFFER, first * texelSize, (i - first) * texelSize,
+                                &m_Staging[first * TEXELS_PER_LIGHT]);
+                m_UploadStats.lights += static_cast<unsigned int>(i - first);
+                ++m_UploadStats.calls;
+            }
+            m_AnyDirty = false;
+        }
+
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        return m_UploadStats;
+    }
+
+} // namespace renderer
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Renderer.h"
+
+namespace renderer {
+
+    /// 光源句柄：槽位 + 代数，光源被删除后旧句柄自动失效
+    struct LightHandle {
+        uint32_t slot       = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool operator==(const LightHandle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const LightHandle& other) const { return !(*this == other); }
+    };
+
+    /**
+     * LightManager
+     * ------------
+     * 场景中所有动态光源（点光 / 聚光 / 方向光）的集中存储：
+     *  - 光源在数组中紧密排列（SoA），删除时用最后一个光源填洞；句柄经槽位表间接寻址，不受移动影响
+     *  - 修改过的光源打上脏标记，Upload() 只把连续的脏区间用 glBufferSubData 传到 GPU
+     *  - GPU 端是一个 RGBA32F 缓冲纹理，每个光源 TEXELS_PER_LIGHT 个 texel：
+     *      0: 位置.xyz, 影响半径（方向光为 0）
+     *      1: 辐射度.rgb（Color * Intensity）, 聚光锥 offset
+     *      2: 方向.xyz, 聚光锥 scale  —— 锥形衰减 = saturate(cosθ * scale + offset)²，点光为 scale 0 / offset 1
+     *    光源上限由 GL_MAX_TEXTURE_BUFFER_SIZE 决定，不再是着色器里的常量
+     * 着色器端读取方式见 assets/shaders/common/clusteredLights.glsl。
+     */
+    class LightManager {
+    public:
+        static const unsigned int TEXELS_PER_LIGHT = 3;
+
+        struct UploadStats {
+            unsigned int lights = 0;   // 本次上传的光源数
+            unsigned int calls  = 0;   // glBufferData / glBufferSubData 次数
+        };
+
+        LightManager() = default;
+        ~LightManager();
+        LightManager(const LightManager&) = delete;
+        LightManager& operator=(const LightManager&) = delete;
+
+        /// 添加光源；超出缓冲容量时返回无效句柄
+        LightHandle Create(const Light& light);
+        void        Destroy(LightHandle handle);
+        void        Clear();
+        bool        IsValid(LightHandle handle) const;
+
+        Light Get(LightHandle handle) const;
+        void  Set(LightHandle handle, const Light& light);
+        void  SetPosition(LightHandle handle, const glm::vec3& position);
+
+        /// 自动半径：平方反比衰减降到 cutoff 时的距离（修改后所有自动半径的光源都会重新上传）
+        void  SetRangeCutoff(float cutoff);
+        float GetRangeCutoff() const { return m_RangeCutoff; }
+
+        size_t Count() const { return m_Positions.size(); }
+        /// 需要 GL 上下文；第一次调用前返回 0
+        size_t MaxLights() const { return m_MaxLights; }
+
+        // 紧密数组（下标与 GPU 缓冲中的光源下标一致）
+        const std::vector<glm::vec3>& Positions() const { return m_Positions; }
+        /// 实际影响半径（已解析自动半径），方向光为 0
+        const std::vector<float>&     Ranges() const { return m_Ranges; }
+        const std::vector<LightType>& Types() const { return m_Types; }
+        LightHandle HandleAt(size_t index) const;
+
+        /// 把脏光源同步到 GPU（需要 GL 上下文）
+        const UploadStats& Upload();
+        const UploadStats& GetUploadStats() const { return m_UploadStats; }
+        GLuint Texture() const { return m_Texture; }
+        size_t GetBufferBytes() const { return m_Capacity * TEXELS_PER_LIGHT * sizeof(glm::vec4); }
+
+    private:
+        struct Slot {
+            uint32_t index      = 0;   // 在紧密数组中的下标
+            uint32_t generation = 0;
+            bool     alive      = false;
+        };
+
+        // SoA
+        std::vector<glm::vec3> m_Positions;
+        std::vector<glm::vec3> m_Directions;
+        std::vector<glm::vec3> m_Colors;
+        std::vector<float>     m_Intensities;
+        std::vector<float>     m_Ranges;       // 解析后的半径
+        std::vector<float>     m_UserRanges;   // Light::Range 原值（<= 0 为自动）
+        std::vector<float>     m_InnerCones;
+        std::vector<float>     m_OuterCones;
+        std::vector<LightType> m_Types;
+        std::vector<uint32_t>  m_SlotOf;       // 紧密下标 → 槽位
+        std::vector<uint8_t>   m_Dirty;
+
+        std::vector<Slot>     m_Slots;
+        std::vector<uint32_t> m_FreeSlots;
+
+        float  m_RangeCutoff = 0.05f;
+        size_t m_MaxLights = 0;
+        size_t m_Capacity  = 0;   // GPU 缓冲当前可容纳的光源数
+        bool   m_AnyDirty  = false;
+
+        GLuint m_Buffer  = 0;
+        GLuint m_Texture = 0;
+        std::vector<glm::vec4> m_Staging;
+        UploadStats            m_UploadStats;
+
+        void QueryLimits();
+        void Write(uint32_t index, const Light& light);
+        void ResolveRange(uint32_t index);
+        void MarkDirty(uint32_t index);
+        void Pack(uint32_t index, glm::vec4* out) const;
+    };
+
+} // namespace renderer
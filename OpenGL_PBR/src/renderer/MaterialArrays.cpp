@@ -0,0 +1,90 @@
+#include "MaterialArrays.h"
+
+#include <iostream>
+#include <algorithm>
+
+#include "utils/TextureLoader.h"
+
+namespace renderer {
+
+    MaterialArrays::~MaterialArrays()
+    {
+        Release();
+    }
+
+    void MaterialArrays::Release()
+    {
+        for (auto& group : m_Groups)
+            glDeleteTextures(MAP_COUNT, group.arrays);
+        m_Groups.clear();
+        m_Slots.clear();
+    }
+
+    void MaterialArrays::Build(const std::vector<Source>& materials)
+    {
+        Release();
+        m_Slots.resize(materials.size());
+
+        // 1. 按 albedo 分辨率分组，记录每个材质的组号和层号
+        for (size_t i = 0; i < materials.size(); ++i)
+        {
+            GLint w = 1, h = 1;
+            if (materials[i].maps[0] != 0)
+            {
+                glBindTexture(GL_TEXTURE_2D, materials[i].maps[0]);
+                glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+                glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+            }
+            w = std::max(1, std::min(w, static_cast<GLint>(MAX_LAYER_SIZE)));
+            h = std::max(1, std::min(h, static_cast<GLint>(MAX_LAYER_SIZE)));
+
+            auto it = std::find_if(m_Groups.begin(), m_Groups.end(),
+                                   [w, h](const Group& g) { return g.width == w && g.height == h; });
+            if (it == m_Groups.end())
+            {
+                Group group;
+                group.width = w;
+                group.height = h;
+                m_Groups.push_back(group);
+                it = m_Groups.end() - 1;
+            }
+            m_Slots[i].group = static_cast<int>(it - m_Groups.begin());
+            m_Slots[i].layer = it->layers++;
+        }
+
+        // 2. 每组每类贴图建立一个数组
+        for (size_t g = 0; g < m_Groups.size(); ++g)
+        {
+            Group& group = m_Groups[g];
+            for (int map = 0; map < MAP_COUNT; ++map)
+            {
+                std::vector<unsigned int> textures(group.layers, 0);
+                for (size_t i = 0; i < materials.size(); ++i)
+                {
+                    if (m_Slots[i].group == static_cast<int>(g))
+                        textures[m_Slots[i].layer] = materials[i].maps[map];
+                }
+                GLenum format = (map < 2) ? GL_RGBA8 : GL_R8;
+                group.arrays[map] = utils::TextureLoader::BuildArray(textures, group.width, group.height, format);
+            }
+            std::cout << "[MaterialArrays] Group " << g << ": " << group.width << "x" << group.height
+                      << ", " << group.layers << " materials" << std::endl;
+        }
+    }
+
+    MaterialArrays::Slot MaterialArrays::GetSlot(size_t material) const
+    {
+        return material < m_Slots.size() ? m_Slots[material] : Slot();
+    }
+
+    void MaterialArrays::Bind(int group, unsigned int firstUnit) const
+    {
+        if (group < 0 || group >= static_cast<int>(m_Groups.size())) return;
+        for (int map = 0; map < MAP_COUNT; ++map)
+        {
+            glActiveTexture(GL_TEXTURE0 + firstUnit + map);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, m_Groups[group].arrays[map]);
+        }
+    }
+
+} // namespace renderer
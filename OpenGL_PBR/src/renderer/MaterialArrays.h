@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * MaterialArrays
+     * --------------
+     * 把 PBR 材质的五张贴图（albedo / normal / metallic / roughness / ao）按分辨率分组，
+     * 每组的同类贴图放进一个 GL_TEXTURE_2D_ARRAY，每个材质占一层：
+     *  - 材质分辨率以 albedo 为准（最大 MAX_LAYER_SIZE），同组内其余贴图缩放到该分辨率
+     *  - albedo / normal 使用 RGBA8，metallic / roughness / ao 只需红色通道，使用 R8
+     *  - 绘制时只需按组绑定一次 5 个数组，材质本身由逐实例的层号选择
+     *
+     * 配合 assets/shaders/pbrShader/pbrInstanced 使用。
+     */
+    class MaterialArrays {
+    public:
+        static const int MAP_COUNT      = 5;     // albedo / normal / metallic / roughness / ao
+        static const int MAX_LAYER_SIZE = 2048;  // 单层最大边长，更大的贴图会被缩小
+
+        /// 一个材质的五张 2D 贴图（顺序与 MAP_COUNT 注释一致）
+        struct Source {
+            unsigned int maps[MAP_COUNT];
+        };
+
+        /// 材质在数组中的位置
+        struct Slot {
+            int group = -1;
+            int layer = 0;
+        };
+
+        MaterialArrays() = default;
+        ~MaterialArrays();
+        MaterialArrays(const MaterialArrays&) = delete;
+        MaterialArrays& operator=(const MaterialArrays&) = delete;
+
+        /// 由材质列表建立纹理数组（需要有效的 GL 上下文），会先释放旧的数组
+        void Build(const std::vector<Source>& materials);
+        void Release();
+
+        bool   Empty() const { return m_Groups.empty(); }
+        size_t GroupCount() const { return m_Groups.size(); }
+
+        /// 第 material 个材质（Build 时的下标）所在的组和层；越界时返回 group = -1
+        Slot GetSlot(size_t material) const;
+
+        /// 把第 group 组的五个数组依次绑定到 firstUnit 起的连续纹理单元
+        void Bind(int group, unsigned int firstUnit) const;
+        /// 第 group 组的五个数组纹理名（顺序同 MAP_COUNT 注释），供渲染队列按纹理单元记录绑定
+        const GLuint* GetArrays(int group) const { return m_Groups[group].arrays; }
+
+    private:
+        struct Group {
+            int    width  = 0;
+            int    height = 0;
+            int    layers = 0;
+            GLuint arrays[MAP_COUNT] = {};
+        };
+
+        std::vector<Group> m_Groups;
+        std::vector<Slot>  m_Slots;
+    };
+
+} // namespace renderer
@@ -0,0 +1,276 @@
+#include "NullGL.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "GLEntryPoints.h"
+
+namespace renderer {
+
+    bool NullGL::s_Loaded = false;
+
+    namespace {
+
+        GLuint s_NextName = 1;            // 所有对象共用一个名字计数器，保证不重复
+        GLint  s_Framebuffer = 0;         // GL_FRAMEBUFFER_BINDING 的回读
+        GLint  s_Viewport[4] = { 0, 0, 0, 0 };
+        GLint     s_DepthFunc = GL_LESS;       // 深度测试 / 颜色写入状态的回读，初值与 GL 默认值相同
+        GLboolean s_DepthMask = GL_TRUE;
+        GLboolean s_ColorMask[4] = { GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
+        std::vector<unsigned char> s_MapScratch;   // glMapBufferRange 返回的临时内存
+
+        // 渲染器用到的每个入口点（GLEntryPoints.h 清单）都有一个签名正确的空函数：忽略参数，返回 0
+#define PBR_NULL_GL_STUB(ret, name, category, params, args, bytes) \
+        ret APIENTRY Stub_##name params { return static_cast<ret>(0); }
+        PBR_GL_ENTRY_POINTS(PBR_NULL_GL_STUB)
+#undef PBR_NULL_GL_STUB
+
+        // 清单之外、glad 仍会载入的函数：忽略参数，返回 0（GL_NO_ERROR / GL_FALSE / 空指针）。
+        // 签名与实际不符，只有引擎从不调用的函数才会落到这里；万一被调用，
+        // 也只有调用方清理栈的 x64 约定能让参数个数不符的调用安全返回
+        static_assert(sizeof(void*) == 8,
+                      "NullGL's untyped Noop fallback (GL functions outside GLEntryPoints.h, never called by the "
+                      "engine) relies on the caller-cleanup x64 calling convention");
+        GLuint64 APIENTRY Noop() { return 0; }
+
+        const GLubyte* APIENTRY GetString(GLenum name)
+        {
+            const char* value = "";
+            switch (name)
+            {
+            case GL_VENDOR:                   value = "OpenGL_PBR"; break;
+            case GL_RENDERER:                 value = "Null GL"; break;
+            case GL_VERSION:                  value = "3.3.0 NullGL"; break;
+            case GL_SHADING_LANGUAGE_VERSION: value = "3.30 NullGL"; break;
+            default: break;
+            }
+            return reinterpret_cast<const GLubyte*>(value);
+        }
+
+        const GLubyte* APIENTRY GetStringi(GLenum, GLuint)
+        {
+            return reinterpret_cast<const GLubyte*>("");
+        }
+
+        void APIENTRY GetIntegerv(GLenum pname, GLint* data)
+        {
+            switch (pname)
+            {
+            case GL_MAJOR_VERSION:            data[0] = 3; break;
+            case GL_MINOR_VERSION:            data[0] = 3; break;
+            case GL_NUM_EXTENSIONS:           data[0] = 0; break;   // 不声明任何扩展，各模块走 3.3 基础路径
+            case GL_FRAMEBUFFER_BINDING:      data[0] = s_Framebuffer; break;
+            case GL_VIEWPORT:                 std::memcpy(data, s_Viewport, sizeof(s_Viewport)); break;
+            case GL_MAX_TEXTURE_SIZE:         data[0] = 16384; break;
+            case GL_MAX_ARRAY_TEXTURE_LAYERS: data[0] = 2048; break;
+            case GL_MAX_TEXTURE_BUFFER_SIZE:  data[0] = 1 << 27; break;
+            case GL_MAX_TEXTURE_IMAGE_UNITS:  data[0] = 32; break;
+            case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS: data[0] = 192; break;
+            case GL_MAX_DRAW_BUFFERS:         data[0] = 8; break;
+            case GL_MAX_COLOR_ATTACHMENTS:    data[0] = 8; break;
+            case GL_MAX_UNIFORM_BLOCK_SIZE:   data[0] = 65536; break;
+            case GL_DEPTH_FUNC:               data[0] = s_DepthFunc; break;
+            default:                          data[0] = 0; break;
+            }
+        }
+
+        void APIENTRY GetInteger64v(GLenum, GLint64* data) { data[0] = 0; }
+        void APIENTRY GetFloatv(GLenum, GLfloat* data) { data[0] = 0.0f; }
+        void APIENTRY GetBooleanv(GLenum pname, GLboolean* data)
+        {
+            switch (pname)
+            {
+            case GL_DEPTH_WRITEMASK: data[0] = s_DepthMask; break;
+            case GL_COLOR_WRITEMASK: std::memcpy(data, s_ColorMask, sizeof(s_ColorMask)); break;
+            default:                 data[0] = GL_FALSE; break;
+            }
+        }
+
+        void APIENTRY GenNames(GLsizei n, GLuint* names)
+        {
+            for (GLsizei i = 0; i < n; ++i)
+                names[i] = s_NextName++;
+        }
+
+        GLuint APIENTRY CreateShader(GLenum) { return s_NextName++; }
+        GLuint APIENTRY CreateProgram() { return s_NextName++; }
+
+        void APIENTRY BindFramebuffer(GLenum target, GLuint framebuffer)
+        {
+            if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER)
+                s_Framebuffer = static_cast<GLint>(framebuffer);
+        }
+
+        void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+        {
+            s_Viewport[0] = x; s_Viewport[1] = y; s_Viewport[2] = width; s_Viewport[3] = height;
+        }
+
+        void APIENTRY DepthFunc(GLenum func) { s_DepthFunc = static_cast<GLint>(func); }
+        void APIENTRY DepthMask(GLboolean flag) { s_DepthMask = flag; }
+        void APIENTRY ColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+        {
+            s_ColorMask[0] = red; s_ColorMask[1] = green; s_ColorMask[2] = blue; s_ColorMask[3] = alpha;
+        }
+
+        // 着色器 / 程序：编译、链接、校验都成功，没有日志
+        void APIENTRY GetObjectiv(GLuint, GLenum pname, GLint* params)
+        {
+            params[0] = (pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS)
+                      ? GL_TRUE : 0;
+        }
+
+        void APIENTRY GetInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+        {
+            if (length) *length = 0;
+            if (infoLog && bufSize > 0) infoLog[0] = '\0';
+        }
+
+        GLint  APIENTRY GetUniformLocation(GLuint, const GLchar*) { return 0; }
+        GLint  APIENTRY GetAttribLocation(GLuint, const GLchar*) { return -1; }
+        GLboolean APIENTRY IsEnabled(GLenum) { return GL_FALSE; }
+
+        // 程序里没有活动的 uniform：输出参数全部写成空
+        void APIENTRY GetActiveUniform(GLuint, GLuint, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type,
+                                       GLchar* name)
+        {
+            if (length) *length = 0;
+            if (size) *size = 0;
+            if (type) *type = 0;
+            if (name && bufSize > 0) name[0] = '\0';
+        }
+        GLuint APIENTRY GetUniformBlockIndex(GLuint, const GLchar*) { return 0; }
+        GLenum APIENTRY CheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+
+        // 查询对象：结果立即可用，值为 0（GPU 计时、遮挡样本数都读到 0）
+        void APIENTRY GetQueryObjectuiv(GLuint, GLenum pname, GLuint* params)
+        {
+            params[0] = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+        }
+        void APIENTRY GetQueryObjectiv(GLuint, GLenum pname, GLint* params)
+        {
+            params[0] = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+        }
+        void APIENTRY GetQueryObjectui64v(GLuint, GLenum pname, GLuint64* params)
+        {
+            params[0] = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+        }
+        void APIENTRY GetQueryObjecti64v(GLuint, GLenum pname, GLint64* params)
+        {
+            params[0] = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+        }
+        void APIENTRY GetQueryiv(GLenum, GLenum pname, GLint* params)
+        {
+            params[0] = pname == GL_QUERY_COUNTER_BITS ? 64 : 0;
+        }
+
+        // 贴图尺寸回读：统一报告 1 × 1 × 1，调用方据此分配的内存最小
+        void APIENTRY GetTexLevelParameteriv(GLenum, GLint, GLenum pname, GLint* params)
+        {
+            params[0] = (pname == GL_TEXTURE_WIDTH || pname == GL_TEXTURE_HEIGHT || pname == GL_TEXTURE_DEPTH) ? 1 : 0;
+        }
+
+        // 映射得到的是一块每次复用的临时内存，写入的内容被丢弃；glMapBuffer 不知道缓冲大小，按映射失败处理
+        void* APIENTRY MapBufferRange(GLenum, GLintptr, GLsizeiptr length, GLbitfield)
+        {
+            if (s_MapScratch.size() < static_cast<size_t>(length))
+                s_MapScratch.resize(static_cast<size_t>(length));
+            return s_MapScratch.data();
+        }
+        GLboolean APIENTRY UnmapBuffer(GLenum) { return GL_TRUE; }
+
+        GLsync APIENTRY FenceSync(GLenum, GLbitfield) { return reinterpret_cast<GLsync>(static_cast<uintptr_t>(1)); }
+        GLenum APIENTRY ClientWaitSync(GLsync, GLbitfield, GLuint64) { return GL_ALREADY_SIGNALED; }
+
+        struct Override {
+            const char* name;
+            void*       proc;
+        };
+
+#define PBR_NULL_GL(name, proc) { name, reinterpret_cast<void*>(&proc) }
+        const Override kOverrides[] = {
+            PBR_NULL_GL("glGetString", GetString),
+            PBR_NULL_GL("glGetStringi", GetStringi),
+            PBR_NULL_GL("glGetIntegerv", GetIntegerv),
+            PBR_NULL_GL("glGetInteger64v", GetInteger64v),
+            PBR_NULL_GL("glGetFloatv", GetFloatv),
+            PBR_NULL_GL("glGetBooleanv", GetBooleanv),
+            PBR_NULL_GL("glGenBuffers", GenNames),
+            PBR_NULL_GL("glGenTextures", GenNames),
+            PBR_NULL_GL("glGenVertexArrays", GenNames),
+            PBR_NULL_GL("glGenFramebuffers", GenNames),
+            PBR_NULL_GL("glGenRenderbuffers", GenNames),
+            PBR_NULL_GL("glGenQueries", GenNames),
+            PBR_NULL_GL("glGenSamplers", GenNames),
+            PBR_NULL_GL("glCreateShader", CreateShader),
+            PBR_NULL_GL("glCreateProgram", CreateProgram),
+            PBR_NULL_GL("glBindFramebuffer", BindFramebuffer),
+            PBR_NULL_GL("glViewport", Viewport),
+            PBR_NULL_GL("glDepthFunc", DepthFunc),
+            PBR_NULL_GL("glDepthMask", DepthMask),
+            PBR_NULL_GL("glColorMask", ColorMask),
+            PBR_NULL_GL("glGetShaderiv", GetObjectiv),
+            PBR_NULL_GL("glGetProgramiv", GetObjectiv),
+            PBR_NULL_GL("glGetShaderInfoLog", GetInfoLog),
+            PBR_NULL_GL("glGetProgramInfoLog", GetInfoLog),
+            PBR_NULL_GL("glGetUniformLocation", GetUniformLocation),
+            PBR_NULL_GL("glGetAttribLocation", GetAttribLocation),
+            PBR_NULL_GL("glGetActiveUniform", GetActiveUniform),
+            PBR_NULL_GL("glIsEnabled", IsEnabled),
+            PBR_NULL_GL("glGetUniformBlockIndex", GetUniformBlockIndex),
+            PBR_NULL_GL("glCheckFramebufferStatus", CheckFramebufferStatus),
+            PBR_NULL_GL("glGetQueryObjectuiv", GetQueryObjectuiv),
+            PBR_NULL_GL("glGetQueryObjectiv", GetQueryObjectiv),
+            PBR_NULL_GL("glGetQueryObjectui64v", GetQueryObjectui64v),
+            PBR_NULL_GL("glGetQueryObjecti64v", GetQueryObjecti64v),
+            PBR_NULL_GL("glGetQueryiv", GetQueryiv),
+            PBR_NULL_GL("glGetTexLevelParameteriv", GetTexLevelParameteriv),
+            PBR_NULL_GL("glMapBufferRange", MapBufferRange),
+            PBR_NULL_GL("glUnmapBuffer", UnmapBuffer),
+            PBR_NULL_GL("glFenceSync", FenceSync),
+            PBR_NULL_GL("glClientWaitSync", ClientWaitSync),
+        };
+#define PBR_NULL_GL_ENTRY(ret, name, category, params, args, bytes) PBR_NULL_GL(#name, Stub_##name),
+        const Override kStubs[] = {
+            PBR_GL_ENTRY_POINTS(PBR_NULL_GL_ENTRY)
+        };
+#undef PBR_NULL_GL_ENTRY
+#undef PBR_NULL_GL
+
+    } // namespace
+
+    void* NullGL::GetProcAddress(const char* name)
+    {
+        // 有专门行为的优先，其次是清单里的空函数
+        for (const Override& o : kOverrides)
+        {
+            if (std::strcmp(o.name, name) == 0)
+                return o.proc;
+        }
+        for (const Override& o : kStubs)
+        {
+            if (std::strcmp(o.name, name) == 0)
+                return o.proc;
+        }
+        return reinterpret_cast<void*>(&Noop);
+    }
+
+    bool NullGL::Load()
+    {
+        if (s_Loaded) return true;
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(GetProcAddress)))
+        {
+            std::cerr << "[NullGL] gladLoadGLLoader failed" << std::endl;
+            return false;
+        }
+        s_Loaded = true;
+        std::cout << "[NullGL] Loaded null GL " << GLVersion.major << "." << GLVersion.minor
+                  << " (no rendering, CPU submission only)" << std::endl;
+        return true;
+    }
+
+} // namespace renderer
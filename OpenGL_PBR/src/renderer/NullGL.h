@@ -0,0 +1,34 @@
+#pragma once
+
+namespace renderer {
+
+    /**
+     * NullGL
+     * ------
+     * 不需要任何 GL 驱动的空实现：所有函数都立即返回，只模拟调用方依赖的那一小部分行为
+     * （版本号 3.3、对象名递增分配、着色器编译 / 链接成功、FBO 完整、查询结果立即可用、
+     * 当前 FBO / 视口 / 深度函数 / 深度与颜色写入开关的回读）。用来在构建机上单独测量渲染器的 CPU 提交开销，
+     * 或配合 GLCallCounter 校验某条路径发出的调用序列；画面当然是空的。
+     *
+     * GLEntryPoints.h 清单里的函数没有专门实现时，指向按清单签名生成的空函数（返回 0）；
+     * 清单之外的函数统一指向一个返回 0 的无参空函数，只是为了让 glad 的指针非空，
+     * 引擎不应调用它们（这依赖 x64 调用约定，因此只在 64 位构建中可用）。
+     *
+     * 用法：
+     *   NullGL::Load();                                   // 代替 gladLoadGLLoader
+     *   GLExtensions::Init(NullGL::GetProcAddress);
+     */
+    class NullGL {
+    public:
+        /// 把 glad 的函数指针全部载入为空实现，失败时返回 false
+        static bool Load();
+        static bool Loaded() { return s_Loaded; }
+
+        /// 可传给 gladLoadGLLoader / GLExtensions::Init 的查询函数；不会返回空指针
+        static void* GetProcAddress(const char* name);
+
+    private:
+        static bool s_Loaded;
+    };
+
+} // namespace renderer
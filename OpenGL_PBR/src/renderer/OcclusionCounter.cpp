@@ -0,0 +1,58 @@
+#include "OcclusionCounter.h"
+
+namespace renderer {
+
+    OcclusionCounter::~OcclusionCounter()
+    {
+        if (m_Queries[0] != 0)
+            glDeleteQueries(LATENCY, m_Queries);
+    }
+
+    void OcclusionCounter::Resolve(int index)
+    {
+        // 环形缓冲转了一圈才回到这里，结果基本都已可用；不可用时才会等待
+        GLuint64 samples = 0;
+        glGetQueryObjectui64v(m_Queries[index], GL_QUERY_RESULT, &samples);
+        m_Latest = samples;
+        m_Pending[index] = false;
+    }
+
+    void OcclusionCounter::Begin()
+    {
+        if (m_Queries[0] == 0)
+            glGenQueries(LATENCY, m_Queries);
+
+        if (m_Pending[m_Next])
+            Resolve(m_Next);
+        glBeginQuery(GL_SAMPLES_PASSED, m_Queries[m_Next]);
+        m_Active = true;
+    }
+
+    void OcclusionCounter::End()
+    {
+        if (!m_Active) return;
+        glEndQuery(GL_SAMPLES_PASSED);
+        m_Pending[m_Next] = true;
+        m_Active = false;
+        m_Next = (m_Next + 1) % LATENCY;
+
+        // 顺带读取已经完成的更早的查询（从最旧的开始），尽量缩短显示延迟
+        for (int i = 1; i < LATENCY; ++i)
+        {
+            const int index = (m_Next + i - 1) % LATENCY;
+            if (!m_Pending[index]) continue;
+            GLuint available = 0;
+            glGetQueryObjectuiv(m_Queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) break;
+            Resolve(index);
+        }
+    }
+
+    void OcclusionCounter::Reset()
+    {
+        for (int i = 0; i < LATENCY; ++i)
+            m_Pending[i] = false;
+        m_Latest = 0;
+    }
+
+} // namespace renderer
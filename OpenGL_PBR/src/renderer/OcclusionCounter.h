@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * OcclusionCounter
+     * ----------------
+     * 用 GL_SAMPLES_PASSED 遮挡查询统计一段绘制中通过深度测试的样本数。
+     * 查询对象组成环形缓冲，结果在 LATENCY - 1 帧后读取，不会让 CPU 等待 GPU。
+     *
+     * 用法（每帧）：
+     *   counter.Begin();  ...绘制...  counter.End();
+     *   counter.Latest();   // 最近一次已完成查询的样本数
+     */
+    class OcclusionCounter {
+    public:
+        static const int LATENCY = 4;
+
+        OcclusionCounter() = default;
+        ~OcclusionCounter();
+        OcclusionCounter(const OcclusionCounter&) = delete;
+        OcclusionCounter& operator=(const OcclusionCounter&) = delete;
+
+        void Begin();
+        void End();
+        /// 丢弃尚未读取的查询和旧结果（统计条件改变时调用）
+        void Reset();
+
+        uint64_t Latest() const { return m_Latest; }
+
+    private:
+        GLuint   m_Queries[LATENCY] = {};
+        bool     m_Pending[LATENCY] = {};
+        int      m_Next = 0;
+        bool     m_Active = false;
+        uint64_t m_Latest = 0;
+
+        void Resolve(int index);
+    };
+
+} // namespace renderer
@@ -1,4 +1,13 @@
 #include "PBRRenderer.h"
+#include "GpuMemory.h"
+#include "core/FrameArena.h"
+#include "scene/Model.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cmath>
+#include <random>
+#include <algorithm>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
@@ -11,6 +20,11 @@ namespace renderer
     PBRRenderer::PBRRenderer(unsigned int width, unsigned int height)
         : SCR_WIDTH(width), SCR_HEIGHT(height),
           pbrShader("assets/shaders/pbrShader/pbr.vert", "assets/shaders/pbrShader/pbr.frag"),
+          pbrInstancedShader("assets/shaders/pbrShader/pbrInstanced.vert",
+                             "assets/shaders/pbrShader/pbrInstanced.frag"),
+          depthDirectShader("assets/shaders/pbrShader/pbr.vert", "assets/shaders/depthShader/depthOnly.frag"),
+          depthInstancedShader("assets/shaders/pbrShader/pbrInstanced.vert",
+                               "assets/shaders/depthShader/depthOnly.frag"),
           equirectangularToCubemapShader(
               "assets/shaders/equirectangularToCubemapShader/equirectangularToCubemap.vert",
               "assets/shaders/equirectangularToCubemapShader/equirectangularToCubemap.frag"
@@ -22,6 +36,8 @@ namespace renderer
           brdfShader("assets/shaders/brdfShader/brdf.vert", "assets/shaders/brdfShader/brdf.frag"),
           backgroundShader("assets/shaders/backgroundShader/background.vert",
                            "assets/shaders/backgroundShader/background.frag"),
+          modelShader("assets/shaders/modelShader/model.vert", "assets/shaders/modelShader/model.frag"),
+          modelMaterialLayersLocation(glGetUniformLocation(modelShader.ID, "materialLayers")),
           hdrTexture(0),
           envCubemap(0),
           irradianceMap(0),
@@ -30,27 +46,49 @@ namespace renderer
           captureFBO(0),
           captureRBO(0)
     {
-        // 在构造里只做简单的成员初始化，不开显存
+        // 在构造里只做简单的成员初始化，不开显存（光源缓冲在第一帧 Upload 时创建）
+        // 默认光源：四个角各一个白色点光源
+        const glm::vec3 defaultPositions[4] = {
+            {-10.0f, 10.0f, 10.0f},
+            {10.0f, 10.0f, 10.0f},
+            {-10.0f, -10.0f, 10.0f},
+            {10.0f, -10.0f, 10.0f}
+        };
+        for (const auto& position : defaultPositions)
+            AddSceneLight(Light(position, glm::vec3(1.0f), 300.0f));
     }
 
     PBRRenderer::~PBRRenderer()
     {
         // 释放所有 OpenGL 资源
-        glDeleteFramebuffers(1, &captureFBO);
-        glDeleteRenderbuffers(1, &captureRBO);
-        glDeleteTextures(1, &hdrTexture);
-        glDeleteTextures(1, &envCubemap);
-        glDeleteTextures(1, &irradianceMap);
-        glDeleteTextures(1, &prefilterMap);
-        glDeleteTextures(1, &brdfLUTTexture);
+        ReleaseEnvironment();
+        glDeleteBuffers(1, &instanceVBO);
+        glDeleteBuffers(1, &materialHandleBuffer);
+        ReleaseMaterialTextures();
+        GLExtensions::ReleaseResidentHandle(missingMapTexture);
+        glDeleteTextures(1, &missingMapTexture);
     }
 
     /// 在 Application 初始化时调用，完成一次性预计算
     void PBRRenderer::InitPBR(const std::string& hdrPath)
     {
+        utils::TextureLoader::Image hdrImage = utils::TextureLoader::Decode(hdrPath, true);
+        InitPBR(hdrImage);
+    }
+
+    void PBRRenderer::InitPBR(utils::TextureLoader::Image& hdrImage)
+    {
+        // 环境立方体贴图、辐照度图、预过滤图、BRDF LUT 和烘焙用的 FBO 附件
+        GpuMemory::Scope memoryTag("IBL");
+        // 各烘焙阶段的 GPU 耗时，结束时输出并在 Performance 面板显示
+        GpuProfiler::BeginBake();
+        GpuProfiler::Begin("IBL Bake");
+
         // ------------------------------------------------------------------------
         //  1. 创建 captureFBO、captureRBO，用于后续各次 render 到立方体贴图
+        //     （更换环境图时先释放上一张环境图的全部结果）
         // ------------------------------------------------------------------------
+        ReleaseEnvironment();
         glGenFramebuffers(1, &captureFBO);
         glGenRenderbuffers(1, &captureRBO);
 
@@ -62,24 +100,23 @@ namespace renderer
         // ------------------------------------------------------------------------
         //  2. 加载 HDR 环境图到 2D 纹理
         // ------------------------------------------------------------------------
-        stbi_set_flip_vertically_on_load(true);
-        int width, height, nrComponents;
-        float* data = stbi_loadf(hdrPath.c_str(), &width, &height, &nrComponents, 0);
-        if (data)
+        GpuProfiler::Begin("HDR Upload");
+        if (hdrImage.Valid() && hdrImage.hdr)
         {
             glGenTextures(1, &hdrTexture);
             glBindTexture(GL_TEXTURE_2D, hdrTexture);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, data);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, hdrImage.width, hdrImage.height, 0, GL_RGB, GL_FLOAT, hdrImage.pixels);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            stbi_image_free(data);
         }
         else
         {
-            std::cout << "[PBRRenderer] Failed to load HDR image: " << hdrPath << std::endl;
+            std::cout << "[PBRRenderer] Failed to load HDR image" << std::endl;
         }
+        utils::TextureLoader::Free(hdrImage);
+        GpuProfiler::End();
 
         // ------------------------------------------------------------------------
         //  3. 创建一个空的立方体贴图 envCubemap，用于存放从 HDRMap 转换来的 cubemap
@@ -104,6 +141,7 @@ namespace renderer
         // ------------------------------------------------------------------------
         //  4. 用 equirectangularToCubemapShader 把 HDR 2D 图渲染到 6 个面上
         // ------------------------------------------------------------------------
+        GpuProfiler::Begin("Equirect To Cubemap");
         glm::mat4 captureProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
         glm::mat4 captureViews[] = {
             glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f)),
@@ -140,10 +178,12 @@ namespace renderer
         // 生成 mipmap
         glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
         glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+        GpuProfiler::End();
 
         // ------------------------------------------------------------------------
         //  5. 生成 32×32 的 irradianceMap
         // ------------------------------------------------------------------------
+        GpuProfiler::Begin("Irradiance");
         glGenTextures(1, &irradianceMap);
         glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
         for (unsigned int i = 0; i < 6; ++i)
@@ -186,10 +226,12 @@ namespace renderer
             Primitives::RenderCube();
         }
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GpuProfiler::End();
 
         // ------------------------------------------------------------------------
         //  6. 生成 128×128~ 的 prefilterMap，并逐层渲染
         // ------------------------------------------------------------------------
+        GpuProfiler::Begin("Prefilter");
         glGenTextures(1, &prefilterMap);
         glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
         for (unsigned int i = 0; i < 6; ++i)
@@ -240,10 +282,12 @@ namespace renderer
             }
         }
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GpuProfiler::End();
 
         // ------------------------------------------------------------------------
         //  7. 生成 512×512 BRDF LUT
         // ------------------------------------------------------------------------
+        GpuProfiler::Begin("BRDF LUT");
         glGenTextures(1, &brdfLUTTexture);
         glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
         glTexImage2D(
@@ -271,6 +315,7 @@ namespace renderer
         brdfShader.use();
         Primitives::RenderQuad();
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GpuProfiler::End();
 
         // ------------------------------------------------------------------------
         //  8. 配置 pbrShader 和 backgroundShader 中的常量
@@ -285,62 +330,84 @@ namespace renderer
         pbrShader.setInt("roughnessMap", 6);
         pbrShader.setInt("aoMap", 7);
 
+        pbrInstancedShader.use();
+        pbrInstancedShader.setInt("irradianceMap", 0);
+        pbrInstancedShader.setInt("prefilterMap", 1);
+        pbrInstancedShader.setInt("brdfLUT", 2);
+        pbrInstancedShader.setInt("albedoMap", 3);
+        pbrInstancedShader.setInt("normalMap", 4);
+        pbrInstancedShader.setInt("metallicMap", 5);
+        pbrInstancedShader.setInt("roughnessMap", 6);
+        pbrInstancedShader.setInt("aoMap", 7);
+
+        // 延迟渲染路径：共享 IBL 结果，几何由 RenderSpheresInstanced 提交。
+        // G-Buffer 和着色器只在第一次调用时创建，更换环境图时只换 IBL 贴图
+        if (!deferredRenderer)
+        {
+            deferredRenderer = std::make_unique<DeferredPBRRenderer>(static_cast<int>(SCR_WIDTH), static_cast<int>(SCR_HEIGHT));
+            deferredRenderer->SetClusteredLighting(&clusteredLighting);
+            deferredRenderer->SetGeometryCallback([this](Shader& geometryShader, const core::Camera& camera)
+            {
+                RenderSpheresInstanced(camera, geometryShader, false);
+            });
+        }
+        deferredRenderer->SetEnvironment(irradianceMap, prefilterMap, brdfLUTTexture);
+
+        // bindless 着色器需要 GLSL 4.30 + GL_ARB_bindless_texture，只在驱动支持时编译（同样只编译一次）
+        if (GLExtensions::HasBindlessTexture() && !pbrBindlessShader)
+        {
+            pbrBindlessShader = std::make_unique<Shader>("assets/shaders/pbrShader/pbrInstanced.vert",
+                                                         "assets/shaders/pbrShader/pbrBindless.frag");
+            pbrBindlessShader->use();
+            pbrBindlessShader->setInt("irradianceMap", 0);
+            pbrBindlessShader->setInt("prefilterMap", 1);
+            pbrBindlessShader->setInt("brdfLUT", 2);
+        }
+
         backgroundShader.use();
         backgroundShader.setInt("environmentMap", 0);
 
         // ------------------------------------------------------------------------
-        //  9. 初始化几种材料贴图和光源
+        //  9. 场景内容
         // ------------------------------------------------------------------------
-        // 假设你有几种 PBR 材质放在 assets/textures/pbr/<name>/ 里
-        // 先预载它们：
-        std::string baseDir = "assets/textures/pbr/";
-        std::vector<std::string> names = {"rusted_iron", "gold", "grass", "plastic", "wall"};
-        for (const auto& n : names)
-        {
-            MaterialTextures mat;
-            mat.albedo = utils::TextureLoader::Load2D((baseDir + n + "/albedo.png").c_str());
-            mat.normal = utils::TextureLoader::Load2D((baseDir + n + "/normal.png").c_str());
-            mat.metallic = utils::TextureLoader::Load2D((baseDir + n + "/metallic.png").c_str());
-            mat.roughness = utils::TextureLoader::Load2D((baseDir + n + "/roughness.png").c_str());
-            mat.ao = utils::TextureLoader::Load2D((baseDir + n + "/ao.png").c_str());
-            materials.push_back(mat);
-        }
-        // 对应的球体位置
-        materialPositions = {
-            {-5.0f, 0.0f, 2.0f},
-            {-3.0f, 0.0f, 2.0f},
-            {-1.0f, 0.0f, 2.0f},
-            {1.0f, 0.0f, 2.0f},
-            {3.0f, 0.0f, 2.0f}
-        };
-
-        // 光源
-        lightPositions = {
-            {-10.0f, 10.0f, 10.0f},
-            {10.0f, 10.0f, 10.0f},
-            {-10.0f, -10.0f, 10.0f},
-            {10.0f, -10.0f, 10.0f}
-        };
-        lightColors = {
-            {300.0f, 300.0f, 300.0f},
-            {300.0f, 300.0f, 300.0f},
-            {300.0f, 300.0f, 300.0f},
-            {300.0f, 300.0f, 300.0f}
-        };
+        // 材质库和材质球实体由 LoadAllMaterials 创建，光源实体在构造时创建；
+        // 这里只做与 HDR 环境图相关的预计算，更换环境图时可以重复调用
 
         // 进入最后阶段之前，切换视口回原始尺寸
+        //（用渲染器自己的尺寸，不查询 GLFW 窗口：无窗口模式下没有 GLFW 上下文）
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        int scrW, scrH;
-        glfwGetFramebufferSize(glfwGetCurrentContext(), &scrW, &scrH);
-        glViewport(0, 0, scrW, scrH);
+        glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+        // 旧环境贴图被删除后纹理名可能被新贴图复用，状态缓存里记录的绑定不再可信
+        stateCache.Invalidate();
+
+        GpuProfiler::End();
+        GpuProfiler::EndBake();
+    }
+
+    void PBRRenderer::ReleaseEnvironment()
+    {
+        glDeleteFramebuffers(1, &captureFBO);
+        glDeleteRenderbuffers(1, &captureRBO);
+        glDeleteTextures(1, &hdrTexture);
+        glDeleteTextures(1, &envCubemap);
+        glDeleteTextures(1, &irradianceMap);
+        glDeleteTextures(1, &prefilterMap);
+        glDeleteTextures(1, &brdfLUTTexture);
+        captureFBO = captureRBO = 0;
+        hdrTexture = envCubemap = irradianceMap = prefilterMap = brdfLUTTexture = 0;
     }
 
     /// 每帧调用此函数，使用当前相机渲染一次完整的 PBR 场景
     void PBRRenderer::RenderPBRScene(const core::Camera& camera)
     {
+        PBR_PROFILE_FUNCTION();
+
         // 1. 先清屏
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        {
+            GpuScope scope("Clear");
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        }
 
         // 2. 计算 view、projection 矩阵
         glm::mat4 view = camera.GetViewMatrix();
@@ -350,87 +417,566 @@ namespace renderer
             0.1f, 100.0f
         );
 
+        // 光源小球跟随光源位置
+        for (size_t i = 0; i < lightRefs.Size(); ++i)
+        {
+            if (TransformComponent* transform = transforms.TryGet(lightRefs.EntityAt(i)))
+                transform->position = lightManager.Get(lightRefs.At(i)).Position;
+        }
+
+        // 分簇光照：只上传变化过的光源，前向和延迟路径共用同一份簇表
+        {
+            GpuScope scope("Light Upload");
+            lightManager.Upload();
+            clusteredLighting.Update(view, projection, 0.1f, 100.0f,
+                                     static_cast<int>(SCR_WIDTH), static_cast<int>(SCR_HEIGHT), lightManager);
+        }
+
         // 3. 绘制 PBR 球体（及光源小球），保持默认深度设置
         //    深度测试已在 Window 初始化时 glEnable(GL_DEPTH_TEST) 并设为 GL_LEQUAL/GL_LESS
-        pbrShader.use();
-        pbrShader.setMat4("view", view);
-        pbrShader.setMat4("projection", projection);
-        pbrShader.setVec3("camPos", camera.Position);
+        //    所有可绘制实体都带 allMaterials 中的材质下标，材质库加载后即可走实例化路径
+        //    bindless 优先，其次纹理数组，最后逐球绑定
+        //    延迟路径的几何阶段同样使用纹理数组
+        const bool materialsReady = !allMaterials.empty();
+        const bool deferred = useDeferred && deferredRenderer && !materialArrays.Empty() && materialsReady;
+        const bool bindless = !deferred && useBindless && pbrBindlessShader && materialHandleBuffer != 0 && materialsReady;
+        const bool instanced = bindless || (useInstancing && !materialArrays.Empty() && materialsReady);
+        // 延迟路径本来就每像素只着色一次，不需要深度预通道
+        const bool prepass = useDepthPrepass && !deferred;
+        Shader& shader = bindless ? *pbrBindlessShader : (instanced ? pbrInstancedShader : pbrShader);
+        activeSpherePath = deferred ? SpherePath::Deferred
+                         : bindless ? SpherePath::Bindless
+                         : (instanced ? SpherePath::TextureArray : SpherePath::Direct);
 
-        // 绑定预计算的 IBL 数据
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, irradianceMap);
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, prefilterMap);
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, brdfLUTTexture);
+        submittedSphereIndices = 0;
+        sphereDrawCalls = 0;
 
-        // 依次绘制每个 PBR 球体，绑定它对应材质贴图
-        for (size_t i = 0; i < materials.size(); ++i)
-        {
-            auto &mat = materials[i];
-            glActiveTexture(GL_TEXTURE3);
-            glBindTexture(GL_TEXTURE_2D, mat.albedo);
-            glActiveTexture(GL_TEXTURE4);
-            glBindTexture(GL_TEXTURE_2D, mat.normal);
-            glActiveTexture(GL_TEXTURE5);
-            glBindTexture(GL_TEXTURE_2D, mat.metallic);
-            glActiveTexture(GL_TEXTURE6);
-            glBindTexture(GL_TEXTURE_2D, mat.roughness);
-            glActiveTexture(GL_TEXTURE7);
-            glBindTexture(GL_TEXTURE_2D, mat.ao);
-
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, materialPositions[i]);
-            pbrShader.setMat4("model", model);
-            pbrShader.setMat3(
-                "normalMatrix",
-                glm::transpose(glm::inverse(glm::mat3(model)))
-            );
-            Primitives::RenderSphere();
+        // 视锥剔除：先更新所有球的世界空间包围体，再一次性测试；可见物体按观察深度由近到远排序
+        {
+            PBR_PROFILE_SCOPE("Scene Update");
+            UpdateSceneBounds();
+            CullScene(Frustum::FromMatrix(projection * view));
+            BuildDrawOrder(view);
         }
 
-        // 4. 渲染“光源”小球
-        for (size_t i = 0; i < lightPositions.size(); ++i)
+        // 预通道开关切换后，旧的查询结果不再可比
+        if (prepass != lastFramePrepass)
         {
-            glm::vec3 newPos = lightPositions[i];
-            pbrShader.setVec3("lightPositions[" + std::to_string(i) + "]", newPos);
-            pbrShader.setVec3("lightColors[" + std::to_string(i) + "]", lightColors[i]);
+            prepassCounter.Reset();
+            shadingCounter.Reset();
+            lastFramePrepass = prepass;
+        }
 
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, newPos);
-            model = glm::scale(model, glm::vec3(0.5f));
-            pbrShader.setMat4("model", model);
-            pbrShader.setMat3(
-                "normalMatrix",
-                glm::transpose(glm::inverse(glm::mat3(model)))
-            );
-            Primitives::RenderSphere();
+        // 状态缓存每帧从未知状态开始（ImGui 等会直接修改 GL 状态）
+        stateCache.BeginFrame();
+
+        // 4. 材质球和光源小球
+        auto submitStart = std::chrono::high_resolution_clock::now();
+        if (deferred)
+        {
+            // 几何阶段通过回调调用 RenderSpheresInstanced，光照阶段为一次全屏绘制
+            deferredRenderer->SetProjection(projection);
+            {
+                GpuScope scope("Deferred Geometry");
+                deferredRenderer->GeometryPass(camera);
+            }
+            {
+                GpuScope scope("Deferred Lighting");
+                deferredRenderer->LightingPass(camera);
+            }
+            stateCache.Invalidate();
+        }
+
+        // 前向路径的所有绘制（以及两条路径共用的天空盒）收集成绘制包，排序后经状态缓存统一提交
+        renderQueue.Clear();
+        if (!deferred)
+        {
+            if (instanced)
+                PrepareSphereInstances(camera, bindless);
+
+            // 4.1 深度预通道：只写深度，片段着色器为空
+            if (prepass)
+            {
+                Shader& depthShader = instanced ? depthInstancedShader : depthDirectShader;
+                stateCache.UseProgram(depthShader.ID);
+                depthShader.setMat4("view", view);
+                depthShader.setMat4("projection", projection);
+
+                RenderQueue::PassState state;
+                state.depthFunc = GL_LESS;
+                state.depthWrite = true;
+                state.colorWrite = false;
+                state.onBegin = [this]() { GpuProfiler::Begin("Depth Pre-pass"); prepassCounter.Begin(); };
+                state.onEnd = [this]() { prepassCounter.End(); GpuProfiler::End(); };
+                renderQueue.SetPassState(PASS_DEPTH_PREPASS, state);
+
+                if (instanced)
+                    SubmitSphereInstances(PASS_DEPTH_PREPASS, depthShader, bindless, false);
+                else
+                    SubmitSpheresDirect(camera, PASS_DEPTH_PREPASS, depthShader, false);
+            }
+
+            // 4.2 着色通道：开了预通道时只着色深度与预通道完全相等的片段（即最终可见的那一层），不再写深度
+            stateCache.UseProgram(shader.ID);
+            shader.setMat4("view", view);
+            shader.setMat4("projection", projection);
+            shader.setVec3("camPos", camera.Position);
+            clusteredLighting.Apply(shader);
+            stateCache.InvalidateTextures();
+
+            // 绑定预计算的 IBL 数据（材质包只占用 3~7 号单元，不会覆盖）
+            stateCache.BindTexture(0, GL_TEXTURE_CUBE_MAP, irradianceMap);
+            stateCache.BindTexture(1, GL_TEXTURE_CUBE_MAP, prefilterMap);
+            stateCache.BindTexture(2, GL_TEXTURE_2D, brdfLUTTexture);
+
+            RenderQueue::PassState state;
+            state.depthFunc = prepass ? GL_EQUAL : GL_LESS;
+            state.depthWrite = !prepass;
+            state.onBegin = [this]() { GpuProfiler::Begin("Opaque"); shadingCounter.Begin(); };
+            state.onEnd = [this]() { shadingCounter.End(); GpuProfiler::End(); };
+            renderQueue.SetPassState(PASS_OPAQUE, state);
+
+            if (instanced)
+                SubmitSphereInstances(PASS_OPAQUE, shader, bindless, true);
+            else
+                SubmitSpheresDirect(camera, PASS_OPAQUE, shader, true);
         }
 
         // 5. 渲染天空盒（背景立方体贴图）
-        //    a) 关闭深度写入，让天空盒永远绘制在最远处；
+        //    a) 关闭深度写入，深度函数为“小于或等于”，让天空盒永远绘制在最远处；
         //    b) 使用去掉平移分量的 view 矩阵。
+        {
+            stateCache.UseProgram(backgroundShader.ID);
+            // 去掉 view 中的平移成分：只保留旋转部分
+            glm::mat4 viewNoTranslate = glm::mat4(glm::mat3(view));
+            backgroundShader.setMat4("view", viewNoTranslate);
+            backgroundShader.setMat4("projection", projection);
 
-        // 5.1 关闭深度写入
-        glDepthMask(GL_FALSE);
-        // 可选：确保深度函数为 “小于或等于”。
-        // 如果之前设置的是 GL_LESS，也可以在此改为 GL_LEQUAL：
-        glDepthFunc(GL_LEQUAL);
+            RenderQueue::PassState state;
+            state.depthFunc = GL_LEQUAL;
+            state.depthWrite = false;
+            state.onBegin = []() { GpuProfiler::Begin("Skybox"); };
+            state.onEnd = []() { GpuProfiler::End(); };
+            renderQueue.SetPassState(PASS_SKYBOX, state);
 
-        backgroundShader.use();
-        // 去掉 view 中的平移成分：只保留旋转部分
-        glm::mat4 viewNoTranslate = glm::mat4(glm::mat3(view));
-        backgroundShader.setMat4("view", viewNoTranslate);
-        backgroundShader.setMat4("projection", projection);
+            RenderQueue::DrawPacket packet;
+            packet.key = renderQueue.MakeKey(PASS_SKYBOX, backgroundShader, 0, 0);
+            packet.shader = &backgroundShader;
+            packet.vao = Primitives::GetCubeVAO();
+            packet.mode = GL_TRIANGLES;
+            packet.count = 36;
+            packet.firstTexture = renderQueue.AddTextures({ { 0, GL_TEXTURE_CUBE_MAP, envCubemap } });
+            packet.textureCount = 1;
+            renderQueue.Submit(packet);
+        }
+
+        {
+            PBR_PROFILE_SCOPE("Queue Execute");
+            renderQueue.Sort();
+            renderQueue.Execute(stateCache);
+        }
+
+        // 6. 场景模型：不经渲染队列，Model 自己绑定 VAO / 贴图，画完后状态缓存里的记录作废。
+        //    队列不恢复各 pass 的状态，最后执行的天空盒留下了 GL_LEQUAL 和关闭的深度写入，先改回不透明物体的状态
+        if (sceneModel && drawSceneModel)
+        {
+            GpuScope scope("Scene Model");
+            stateCache.DepthFunc(GL_LESS);
+            stateCache.DepthMask(true);
+            stateCache.ColorMask(true);
+            RenderSceneModel(camera, view, projection);
+            stateCache.Invalidate();
+        }
 
+        // 恢复默认状态：深度写入、GL_LESS、颜色写入，不留下绑定的 VAO
+        stateCache.DepthFunc(GL_LESS);
+        stateCache.DepthMask(true);
+        stateCache.ColorMask(true);
+        stateCache.BindVertexArray(0);
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, envCubemap);
-        Primitives::RenderCube();
 
-        // 5.2 恢复深度写入和深度函数
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
+        auto submitEnd = std::chrono::high_resolution_clock::now();
+        sphereSubmitMs = std::chrono::duration<double, std::milli>(submitEnd - submitStart).count();
+
+        overdrawStats.depthSamples = prepass ? prepassCounter.Latest() : 0;
+        overdrawStats.shadedSamples = deferred ? 0 : shadingCounter.Latest();
+    }
+
+    void PBRRenderer::SetSceneModel(std::unique_ptr<Model> model, const glm::mat4& transform)
+    {
+        sceneModel = std::move(model);
+        sceneModelMatrix = transform;
+    }
+
+    void PBRRenderer::RenderSceneModel(const core::Camera& camera, const glm::mat4& view, const glm::mat4& projection)
+    {
+        PBR_PROFILE_FUNCTION();
+        modelShader.use();
+        modelShader.setMat4("view", view);
+        modelShader.setMat4("projection", projection);
+        modelShader.setMat4("model", sceneModelMatrix);
+        modelShader.setMat3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(sceneModelMatrix))));
+        modelShader.setVec3("camPos", camera.Position);
+        modelShader.setVec3("lightDir", glm::vec3(0.4f, 1.0f, 0.3f));
+        modelShader.setVec3("lightColor", glm::vec3(1.0f));
+
+        // 关闭 LOD 时阈值取 0，可见的 Mesh 都用 LOD0
+        LodSelector selector = lodSelector;
+        if (!enableLod)
+            selector.lod0ScreenSize = 0.0f;
+
+        // 合并路径自己上传材质表并绑定纹理数组（首次调用时建立合并缓冲）
+        if (batchSceneModel)
+        {
+            sceneModel->DrawBatched(modelShader, camera, sceneModelMatrix, projection, static_cast<float>(SCR_HEIGHT),
+                                    selector);
+            return;
+        }
+
+        // 逐 Mesh 绘制不绑定纹理数组，材质 0 的三个层号都是 -1（按无贴图着色）
+        const GLint noLayers[4] = { -1, -1, -1, 0 };
+        glUniform4iv(modelMaterialLayersLocation, 1, noLayers);
+        sceneModel->Draw(modelShader, camera, sceneModelMatrix, projection, static_cast<float>(SCR_HEIGHT),
+                         selector, sceneModelMeshletCulling);
+    }
+
+    void PBRRenderer::BuildDrawOrder(const glm::mat4& view)
+    {
+        // 只需要观察空间深度：view 矩阵第三行与位置的点积
+        const glm::vec4 depthRow(-view[0][2], -view[1][2], -view[2][2], -view[3][2]);
+        const size_t count = objectPositions.size();
+
+        drawOrder.clear();
+        sortKeys.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (enableFrustumCulling && !objectVisible[i])
+                continue;
+            if (!sortFrontToBack)
+            {
+                drawOrder.push_back(static_cast<uint32_t>(i));
+                continue;
+            }
+            sortKeys.emplace_back(glm::dot(depthRow, glm::vec4(objectPositions[i], 1.0f)), static_cast<uint32_t>(i));
+        }
+
+        if (sortFrontToBack)
+        {
+            std::sort(sortKeys.begin(), sortKeys.end());
+            drawOrder.reserve(sortKeys.size());
+            for (const auto& key : sortKeys)
+                drawOrder.push_back(key.second);
+        }
+    }
+
+    void PBRRenderer::SubmitSpheresDirect(const core::Camera& camera, unsigned int pass, Shader& shader, bool bindMaterials)
+    {
+        if (allMaterials.empty())
+            return;
+        const glm::mat4 view = camera.GetViewMatrix();
+        const glm::vec4 depthRow(-view[0][2], -view[1][2], -view[2][2], -view[3][2]);
+
+        // 每个物体一个绘制包。
+        // 键中的材质取 albedo 纹理名：同一材质的球排在一起，状态缓存跳过重复的纹理绑定
+        for (uint32_t object : drawOrder)
+        {
+            const glm::vec3& position = objectPositions[object];
+            unsigned int lod = SelectSphereLod(position, objectScales[object], camera, renderables.At(object).lod);
+
+            RenderQueue::DrawPacket packet;
+            packet.shader = &shader;
+            packet.vao = Primitives::GetSphereVAO();
+            packet.mode = GL_TRIANGLE_STRIP;
+            packet.count = static_cast<GLsizei>(Primitives::GetSphereIndexCount(lod));
+            packet.indexType = GL_UNSIGNED_INT;
+            packet.indexOffset = Primitives::GetSphereIndexByteOffset(lod);
+            packet.transform = renderQueue.AddTransform(sceneTransforms.World(object), sceneTransforms.Normal(object));
+
+            uint32_t material = 0;
+            if (bindMaterials)
+            {
+                const MaterialTextures& mat = allMaterials[objectMaterials[object]];
+                packet.firstTexture = renderQueue.AddTextures({
+                    { 3, GL_TEXTURE_2D, mat.albedo },
+                    { 4, GL_TEXTURE_2D, mat.normal },
+                    { 5, GL_TEXTURE_2D, mat.metallic },
+                    { 6, GL_TEXTURE_2D, mat.roughness },
+                    { 7, GL_TEXTURE_2D, mat.ao } });
+                packet.textureCount = 5;
+                material = mat.albedo;
+                submittedSphereIndices += Primitives::GetSphereIndexCount(lod);
+            }
+            const float depth = glm::dot(depthRow, glm::vec4(position, 1.0f));
+            packet.key = renderQueue.MakeKey(pass, shader, material, RenderQueue::DepthOrder(depth));
+            renderQueue.Submit(packet);
+            ++sphereDrawCalls;
+        }
+    }
+
+    void PBRRenderer::RenderSpheresInstanced(const core::Camera& camera, Shader& shader, bool bindless)
+    {
+        // 延迟路径的几何阶段：G-Buffer 着色器已由 DeferredPBRRenderer 直接 use()
+        stateCache.Invalidate();
+        stateCache.UseProgram(shader.ID);
+        PrepareSphereInstances(camera, bindless);
+
+        renderQueue.Clear();
+        renderQueue.SetPassState(PASS_OPAQUE, RenderQueue::PassState());
+        SubmitSphereInstances(PASS_OPAQUE, shader, bindless, true);
+        renderQueue.Sort();
+        renderQueue.Execute(stateCache);
+        stateCache.BindVertexArray(0);
+    }
+
+    void PBRRenderer::PrepareSphereInstances(const core::Camera& camera, bool bindless)
+    {
+        const unsigned int lodCount = Primitives::SPHERE_LOD_COUNT;
+
+        // 1. 按 drawOrder 为每个可见球生成实例数据并记下所在的桶：
+        //    纹理数组路径按 (分辨率组, LOD) 分桶；bindless 路径按 (材质, LOD) 分桶，
+        //    材质下标作为 uniform 传入，保证句柄在一次 draw 内是 dynamically uniform 的
+        const size_t bucketGroups = bindless ? allMaterials.size() : materialArrays.GroupCount();
+        unsortedInstances.clear();
+        instanceBuckets.clear();
+        bucketCounts.assign(bucketGroups * lodCount, 0);
+
+        auto addInstance = [&](const glm::vec3& position, float scale, int materialIndex, unsigned int lod)
+        {
+            MaterialArrays::Slot slot = materialArrays.GetSlot(static_cast<size_t>(materialIndex));
+            if (bindless)
+                slot = MaterialArrays::Slot{ materialIndex, 0 };
+            if (slot.group < 0 || static_cast<size_t>(slot.group) >= bucketGroups) return;
+            unsigned int bucket = static_cast<unsigned int>(slot.group) * lodCount + lod;
+            unsortedInstances.push_back({ glm::vec4(position, scale), static_cast<float>(slot.layer) });
+            instanceBuckets.push_back(bucket);
+            ++bucketCounts[bucket];
+            submittedSphereIndices += Primitives::GetSphereIndexCount(lod);
+        };
+
+        for (uint32_t object : drawOrder)
+        {
+            const glm::vec3& position = objectPositions[object];
+            const float scale = objectScales[object];
+            unsigned int lod = SelectSphereLod(position, scale, camera, renderables.At(object).lod);
+            addInstance(position, scale, objectMaterials[object], lod);
+        }
+        if (unsortedInstances.empty())
+            return;
+
+        // 2. 计数排序：同一桶的实例在缓冲中连续；排序是稳定的，桶内保持 drawOrder 的前后顺序
+        bucketStarts.assign(bucketCounts.size(), 0);
+        for (size_t b = 1; b < bucketCounts.size(); ++b)
+            bucketStarts[b] = bucketStarts[b - 1] + bucketCounts[b - 1];
+        bucketCursors = bucketStarts;
+        sphereInstances.resize(unsortedInstances.size());
+        for (size_t i = 0; i < unsortedInstances.size(); ++i)
+            sphereInstances[bucketCursors[instanceBuckets[i]]++] = unsortedInstances[i];
+
+        // 3. 上传实例缓冲（首次使用时把逐实例属性挂到球体 VAO 上）
+        if (instanceVBO == 0)
+        {
+            GpuMemory::Scope memoryTag("Instances");
+            glGenBuffers(1, &instanceVBO);
+            glBindVertexArray(Primitives::GetSphereVAO());
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            glEnableVertexAttribArray(3);
+            glVertexAttribDivisor(3, 1);
+            glEnableVertexAttribArray(4);
+            glVertexAttribDivisor(4, 1);
+            glBindVertexArray(0);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, sphereInstances.size() * sizeof(SphereInstance),
+                     sphereInstances.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void PBRRenderer::SubmitSphereInstances(unsigned int pass, Shader& shader, bool bindless, bool bindMaterials)
+    {
+        if (unsortedInstances.empty())
+            return;
+
+        const unsigned int lodCount = Primitives::SPHERE_LOD_COUNT;
+        const GLsizei stride = sizeof(SphereInstance);
+        renderQueue.SetInstanceLayout(instanceVBO, {
+            { 3, 4, stride, offsetof(SphereInstance, positionScale) },
+            { 4, 1, stride, offsetof(SphereInstance, layer) } });
+        if (bindless && bindMaterials)
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, materialHandleBuffer);
+
+        // 每个非空桶一个实例化绘制包；桶号（组 * LOD 数 + LOD）作为键的低位，LOD 0 的近处球先画
+        for (size_t b = 0; b < bucketCounts.size(); ++b)
+        {
+            if (bucketCounts[b] == 0) continue;
+
+            const unsigned int group = static_cast<unsigned int>(b / lodCount);
+            const unsigned int lod = static_cast<unsigned int>(b % lodCount);
+
+            RenderQueue::DrawPacket packet;
+            packet.shader = &shader;
+            packet.vao = Primitives::GetSphereVAO();
+            packet.mode = GL_TRIANGLE_STRIP;
+            packet.count = static_cast<GLsizei>(Primitives::GetSphereIndexCount(lod));
+            packet.indexType = GL_UNSIGNED_INT;
+            packet.indexOffset = Primitives::GetSphereIndexByteOffset(lod);
+            packet.instanceCount = static_cast<GLsizei>(bucketCounts[b]);
+            packet.instanceOffset = static_cast<size_t>(bucketStarts[b]) * sizeof(SphereInstance);
+
+            uint32_t material = 0;
+            if (bindMaterials)
+            {
+                material = group;
+                if (bindless)
+                    packet.materialIndex = static_cast<int32_t>(group);
+                else
+                {
+                    const GLuint* arrays = materialArrays.GetArrays(static_cast<int>(group));
+                    packet.firstTexture = renderQueue.AddTextures({
+                        { 3, GL_TEXTURE_2D_ARRAY, arrays[0] },
+                        { 4, GL_TEXTURE_2D_ARRAY, arrays[1] },
+                        { 5, GL_TEXTURE_2D_ARRAY, arrays[2] },
+                        { 6, GL_TEXTURE_2D_ARRAY, arrays[3] },
+                        { 7, GL_TEXTURE_2D_ARRAY, arrays[4] } });
+                    packet.textureCount = MaterialArrays::MAP_COUNT;
+                }
+            }
+            packet.key = renderQueue.MakeKey(pass, shader, material, static_cast<uint32_t>(b));
+            renderQueue.Submit(packet);
+            ++sphereDrawCalls;
+        }
+    }
+
+    void PBRRenderer::UpdateSceneBounds()
+    {
+        const BoundingSphere& unitSphere = Primitives::GetSphereBounds();
+        const AABB& unitBox = Primitives::GetSphereAABB();
+        const size_t count = renderables.Size();
+
+        // 按 renderables 的稠密顺序收集一次物体数据（组件查找都是数组下标访问）
+        objectPositions.resize(count);
+        objectScales.resize(count);
+        objectMaterials.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Entity entity = renderables.EntityAt(i);
+            const TransformComponent& transform = transforms.Get(entity);
+            objectPositions[i] = transform.position;
+            objectScales[i] = transform.scale;
+            objectMaterials[i] = materialRefs.Get(entity).material;
+        }
+
+        // 世界矩阵 / 法线矩阵：只有位置或缩放变化过的物体会被批量重算
+        sceneTransforms.Resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            sceneTransforms.SetPosition(i, objectPositions[i]);
+            sceneTransforms.SetScale(i, objectScales[i]);
+        }
+        sceneTransforms.Update();
+
+        // 本帧的包围盒只用来和上一帧比较，放在帧 arena 里，不每帧分配 vector
+        sceneSpheres.resize(count);
+        AABB* boxes = core::FrameArena::Main().AllocateArray<AABB>(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            sceneSpheres[i] = BoundingSphere{ objectPositions[i] + unitSphere.Center * objectScales[i],
+                                              unitSphere.Radius * objectScales[i] };
+            boxes[i] = unitBox.Transformed(sceneTransforms.World(i));
+        }
+
+        // 物体数量变化时重建 BVH，否则只对移动过的物体做增量 refit
+        if (count != sceneBoxes.size())
+        {
+            sceneBoxes.assign(boxes, boxes + count);
+            sceneBvh.Build(sceneBoxes);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (boxes[i].Min != sceneBoxes[i].Min || boxes[i].Max != sceneBoxes[i].Max)
+            {
+                sceneBoxes[i] = boxes[i];
+                sceneBvh.UpdateObject(static_cast<uint32_t>(i), boxes[i]);
+            }
+        }
+    }
+
+    void PBRRenderer::CullScene(const Frustum& frustum)
+    {
+        const size_t count = sceneBoxes.size();
+        objectVisible.assign(count, 0);
+
+        if (useBvhCulling)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            unsigned int visited = sceneBvh.QueryFrustum(frustum, bvhVisible);
+            for (uint32_t obj : bvhVisible)
+                objectVisible[obj] = 1;
+            auto end = std::chrono::high_resolution_clock::now();
+
+            cullStats.tested  = visited;  // BVH 路径下为访问的节点数
+            cullStats.visible = static_cast<unsigned int>(bvhVisible.size());
+            cullStats.cullMs  = std::chrono::duration<double, std::milli>(end - start).count();
+            return;
+        }
+
+        sceneCuller.Clear();
+        sceneCuller.Reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            sceneCuller.Add(sceneSpheres[i], sceneBoxes[i]);
+        cullStats = sceneCuller.Cull(frustum);
+        for (size_t i = 0; i < count; ++i)
+            objectVisible[i] = sceneCuller.IsVisible(i) ? 1 : 0;
+    }
+
+    int PBRRenderer::PickObject(double cursorX, double cursorY, const core::Camera& camera)
+    {
+        pickedEntity = Entity();
+        if (sceneBvh.Empty() || SCR_WIDTH == 0 || SCR_HEIGHT == 0)
+            return -1;
+
+        // 光标 → NDC → 世界空间射线（与 RenderPBRScene 使用同一投影）
+        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom),
+                                                (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+        glm::mat4 invViewProj = glm::inverse(projection * camera.GetViewMatrix());
+        float ndcX = static_cast<float>(2.0 * cursorX / SCR_WIDTH - 1.0);
+        float ndcY = static_cast<float>(1.0 - 2.0 * cursorY / SCR_HEIGHT);
+        glm::vec4 nearPoint = invViewProj * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+        glm::vec4 farPoint  = invViewProj * glm::vec4(ndcX, ndcY,  1.0f, 1.0f);
+        glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+        glm::vec3 dir = glm::normalize(glm::vec3(farPoint) / farPoint.w - origin);
+
+        // 叶子里用精确的射线-球求交
+        Bvh::RayHit hit = sceneBvh.Raycast(origin, dir, 1e30f,
+            [this](uint32_t obj, const glm::vec3& o, const glm::vec3& d, float& t)
+            {
+                const BoundingSphere& s = sceneSpheres[obj];
+                glm::vec3 oc = o - s.Center;
+                float b = glm::dot(oc, d);
+                float c = glm::dot(oc, oc) - s.Radius * s.Radius;
+                float disc = b * b - c;
+                if (disc < 0.0f) return false;
+                float sq = std::sqrt(disc);
+                t = (-b - sq >= 0.0f) ? -b - sq : -b + sq;
+                return t >= 0.0f;
+            });
+
+        if (hit.object >= 0 && static_cast<size_t>(hit.object) < renderables.Size())
+            pickedEntity = renderables.EntityAt(static_cast<size_t>(hit.object));
+        return hit.object;
+    }
+
+    unsigned int PBRRenderer::SelectSphereLod(const glm::vec3& center, float radius,
+                                              const core::Camera& camera, int& currentLod) const
+    {
+        if (!enableLod)
+        {
+            currentLod = 0;
+            return 0;
+        }
+        float size = LodSelector::ProjectedSize(center, radius, camera, static_cast<float>(SCR_HEIGHT));
+        currentLod = lodSelector.Select(size, currentLod, static_cast<int>(Primitives::SPHERE_LOD_COUNT));
+        return static_cast<unsigned int>(currentLod);
     }
 
     /// 处理窗口大小变化
@@ -439,14 +985,13 @@ namespace renderer
         SCR_WIDTH = width;
         SCR_HEIGHT = height;
         glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+        if (deferredRenderer)
+            deferredRenderer->Resize(static_cast<int>(width), static_cast<int>(height));
     }
 
 
     void PBRRenderer::LoadMaterialsFromDirectory(const std::string& parentDirectory)
     {
-        materials.clear();
-        materialPositions.clear();
-
         // 1) 遍历 parentDirectory 下的每个子目录
         if (!fs::exists(parentDirectory) || !fs::is_directory(parentDirectory))
         {
@@ -459,7 +1004,7 @@ namespace renderer
         {
             if (entry.is_directory())
             {
-                subdirs.push_back(entry.path().string());
+                subdirs.push_back(entry.path().filename().string());
             }
         }
         if (subdirs.empty())
@@ -468,68 +1013,266 @@ namespace renderer
             return;
         }
 
-        // 2) 对每个子目录依次加载贴图，存入 materials
-        for (auto& folderPath : subdirs)
-        {
-            MaterialTextures mat;
-            std::string base = folderPath + "/";
-
-            mat.albedo = utils::TextureLoader::Load2D((base + "albedo.png").c_str());
-            mat.normal = utils::TextureLoader::Load2D((base + "normal.png").c_str());
-            mat.metallic = utils::TextureLoader::Load2D((base + "metallic.png").c_str());
-            mat.roughness = utils::TextureLoader::Load2D((base + "roughness.png").c_str());
-            mat.ao = utils::TextureLoader::Load2D((base + "ao.png").c_str());
-
-            materials.push_back(mat);
-        }
-
-        // 3) 自动生成 materialPositions，使球体水平排列
-        size_t N = materials.size();
-        float spacing = 2.5f;
-        // 从 -(N-1)/2 到 +(N-1)/2
-        for (size_t i = 0; i < N; ++i)
-        {
-            float x = (float(i) - float(N - 1) * 0.5f) * spacing;
-            materialPositions.push_back(glm::vec3(x, 0.0f, 2.0f));
-        }
+        // 2) 每个子目录一个材质，每个材质一个球
+        LoadAllMaterials(subdirs, parentDirectory, static_cast<int>(subdirs.size()));
+        for (size_t i = 0; i < sphereEntities.size(); ++i)
+            materialRefs.Get(sphereEntities[i]).material = static_cast<int>(i);
 
-        std::cout << "[PBRRenderer] Loaded " << N << " materials from " << parentDirectory << std::endl;
+        std::cout << "[PBRRenderer] Loaded " << subdirs.size() << " materials from " << parentDirectory << std::endl;
     }
 
     // 初始化时调用一次：把所有子文件夹的贴图 Load 进 allMaterials
     void PBRRenderer::LoadAllMaterials(
         const std::vector<std::string>& names,
-        const std::string& baseDir
+        const std::string& baseDir,
+        int sphereCount
     )
     {
+        PBR_PROFILE_FUNCTION();
+        // 单张贴图、合并后的贴图数组和 bindless 句柄缓冲都记在材质名下
+        GpuMemory::Scope memoryTag("Materials");
+
         materialNames = names;
-        allMaterials.clear();
+        ReleaseMaterialTextures();
 
+        // 所有材质的 5 张贴图一起交给作业系统并行解码，上传仍在主线程
+        static const char* MAP_FILES[MaterialArrays::MAP_COUNT] = {
+            "albedo.png", "normal.png", "metallic.png", "roughness.png", "ao.png"
+        };
+        std::vector<std::string> paths;
+        paths.reserve(names.size() * MaterialArrays::MAP_COUNT);
         for (auto& n : names)
         {
-            MaterialTextures mat;
             std::string folder = baseDir + "/" + n + "/";
-            mat.albedo = utils::TextureLoader::Load2D((folder + "albedo.png").c_str());
-            mat.normal = utils::TextureLoader::Load2D((folder + "normal.png").c_str());
-            mat.metallic = utils::TextureLoader::Load2D((folder + "metallic.png").c_str());
-            mat.roughness = utils::TextureLoader::Load2D((folder + "roughness.png").c_str());
-            mat.ao = utils::TextureLoader::Load2D((folder + "ao.png").c_str());
+            for (const char* file : MAP_FILES)
+                paths.push_back(folder + file);
+        }
+        std::vector<unsigned int> textures = utils::TextureLoader::LoadMany(paths);
+
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            const unsigned int* maps = &textures[i * MaterialArrays::MAP_COUNT];
+            MaterialTextures mat;
+            mat.albedo = maps[0];
+            mat.normal = maps[1];
+            mat.metallic = maps[2];
+            mat.roughness = maps[3];
+            mat.ao = maps[4];
             allMaterials.push_back(mat);
         }
 
-        // 为五个球准备位置（水平排列）和初始材质索引 0
-        int N = 5;
-        float spacing = 2.5f;
-        materials.resize(N);
-        materialPositions.resize(N);
-        sphereMaterialIdx.assign(N, 0);
+        // 重建 sphereCount 个水平排列的球，初始材质索引 0
+        DestroySpheres();
+        benchmarkSphereCount = 0;
+        if (allMaterials.empty())
+        {
+            std::cerr << "[PBRRenderer] LoadAllMaterials: no materials, spheres not created" << std::endl;
+            return;
+        }
+        const int N = std::max(0, sphereCount);
+        const float spacing = 2.5f;
         for (int i = 0; i < N; ++i)
+            CreateSphere(glm::vec3((i - (N - 1) / 2.0f) * spacing, 0.0f, 2.0f), 0);
+
+        // 实例化路径使用的纹理数组
+        std::vector<MaterialArrays::Source> sources;
+        sources.reserve(allMaterials.size());
+        for (const auto& m : allMaterials)
+            sources.push_back({ { m.albedo, m.normal, m.metallic, m.roughness, m.ao } });
+        materialArrays.Build(sources);
+
+        // bindless 路径：每个材质 5 个常驻句柄，按 std430 的 uvec2 数组布局写入 SSBO。
+        // 加载失败的贴图（纹理 0）没有句柄，着色器对 0 句柄采样是未定义行为，改用常驻的 1x1 替身
+        if (GLExtensions::HasBindlessTexture())
+        {
+            if (missingMapTexture == 0)
+            {
+                const unsigned char black[4] = { 0, 0, 0, 255 };
+                glGenTextures(1, &missingMapTexture);
+                glBindTexture(GL_TEXTURE_2D, missingMapTexture);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, black);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                glBindTexture(GL_TEXTURE_2D, 0);
+            }
+
+            std::vector<GLuint64> handles;
+            handles.reserve(allMaterials.size() * MaterialArrays::MAP_COUNT);
+            for (const auto& src : sources)
+            {
+                for (unsigned int tex : src.maps)
+                    handles.push_back(GLExtensions::GetResidentHandle(tex != 0 ? tex : missingMapTexture));
+            }
+            if (materialHandleBuffer == 0)
+                glGenBuffers(1, &materialHandleBuffer);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, materialHandleBuffer);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, handles.size() * sizeof(GLuint64), handles.data(), GL_STATIC_DRAW);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        }
+    }
+
+    void PBRRenderer::SetBenchmarkSphereCount(int count)
+    {
+        if (allMaterials.empty()) return;
+
+        if (count <= 0)
+        {
+            if (benchmarkSphereCount == 0) return;
+            DestroySpheres();
+            for (size_t i = 0; i < savedPositions.size(); ++i)
+                CreateSphere(savedPositions[i], savedMaterialIdx[i]);
+            benchmarkSphereCount = 0;
+        }
+        else
+        {
+            if (benchmarkSphereCount == 0)
+            {
+                savedPositions.clear();
+                savedMaterialIdx.clear();
+                for (Entity sphere : sphereEntities)
+                {
+                    savedPositions.push_back(transforms.Get(sphere).position);
+                    savedMaterialIdx.push_back(materialRefs.Get(sphere).material);
+                }
+            }
+
+            // 立体网格：前表面在原来那排球的位置（z = 2），向 -z 方向延伸
+            DestroySpheres();
+            entities.Reserve(static_cast<size_t>(count) + lightRefs.Size());
+            transforms.Reserve(static_cast<size_t>(count) + lightRefs.Size());
+            renderables.Reserve(static_cast<size_t>(count) + lightRefs.Size());
+            materialRefs.Reserve(static_cast<size_t>(count) + lightRefs.Size());
+            sphereEntities.reserve(count);
+
+            const int side = static_cast<int>(std::ceil(std::cbrt(static_cast<double>(count))));
+            const float spacing = 2.5f;
+            for (int i = 0; i < count; ++i)
+            {
+                int x = i % side;
+                int y = (i / side) % side;
+                int z = i / (side * side);
+                CreateSphere(glm::vec3((x - (side - 1) / 2.0f) * spacing,
+                                       (y - (side - 1) / 2.0f) * spacing,
+                                       2.0f - z * spacing),
+                             i % static_cast<int>(allMaterials.size()));
+            }
+            benchmarkSphereCount = count;
+        }
+
+        std::cout << "[PBRRenderer] Scene spheres: " << sphereEntities.size()
+                  << ", entities: " << entities.Alive() << std::endl;
+    }
+
+    Entity PBRRenderer::CreateSphere(const glm::vec3& position, int material)
+    {
+        Entity entity = entities.Create();
+        transforms.Add(entity, TransformComponent{ position, 1.0f });
+        renderables.Add(entity);
+        materialRefs.Add(entity, MaterialComponent{ material });
+        sphereEntities.push_back(entity);
+        return entity;
+    }
+
+    void PBRRenderer::DestroyEntity(Entity entity)
+    {
+        if (!entities.IsAlive(entity)) return;
+        transforms.Remove(entity);
+        renderables.Remove(entity);
+        materialRefs.Remove(entity);
+        lightRefs.Remove(entity);
+        entities.Destroy(entity);
+    }
+
+    void PBRRenderer::DestroySpheres()
+    {
+        for (Entity sphere : sphereEntities)
+            DestroyEntity(sphere);
+        sphereEntities.clear();
+    }
+
+    void PBRRenderer::ReleaseMaterialTextures()
+    {
+        // 常驻的纹理不能直接删除：句柄表里的句柄要先取消常驻（GetResidentHandle 未建过句柄时为空操作）
+        for (const auto& mat : allMaterials)
         {
-            materialPositions[i] = glm::vec3((i - (N - 1) / 2.0f) * spacing, 0.0f, 2.0f);
-            materials[i] = allMaterials[0]; // 默认第一个材质
+            const unsigned int maps[MaterialArrays::MAP_COUNT] = { mat.albedo, mat.normal, mat.metallic, mat.roughness, mat.ao };
+            for (unsigned int tex : maps)
+                GLExtensions::ReleaseResidentHandle(tex);
+            glDeleteTextures(MaterialArrays::MAP_COUNT, maps);
         }
+        allMaterials.clear();
     }
 
+    int PBRRenderer::GetSphereIndex(Entity entity) const
+    {
+        if (!entities.IsAlive(entity) || lightRefs.Has(entity)) return -1;
+        auto it = std::find(sphereEntities.begin(), sphereEntities.end(), entity);
+        return it == sphereEntities.end() ? -1 : static_cast<int>(it - sphereEntities.begin());
+    }
+
+    Entity PBRRenderer::AddSceneLight(const Light& light)
+    {
+        LightHandle handle = lightManager.Create(light);
+        if (!lightManager.IsValid(handle))
+            return Entity();
+
+        // 光源小球：半径 0.5，使用材质库中的第一个材质
+        Entity entity = entities.Create();
+        lightRefs.Add(entity, handle);
+        transforms.Add(entity, TransformComponent{ light.Position, 0.5f });
+        renderables.Add(entity);
+        materialRefs.Add(entity, MaterialComponent{ 0 });
+        return entity;
+    }
+
+    void PBRRenderer::RemoveSceneLight(Entity entity)
+    {
+        if (!lightRefs.Has(entity)) return;
+        lightManager.Destroy(lightRefs.Get(entity));
+        DestroyEntity(entity);
+    }
+
+    void PBRRenderer::SetBenchmarkLightCount(int count)
+    {
+        // 基准光源 = 只有光源组件、没有小球的实体
+        scratchEntities.clear();
+        for (size_t i = 0; i < lightRefs.Size(); ++i)
+        {
+            if (!renderables.Has(lightRefs.EntityAt(i)))
+                scratchEntities.push_back(lightRefs.EntityAt(i));
+        }
+        for (Entity entity : scratchEntities)
+        {
+            lightManager.Destroy(lightRefs.Get(entity));
+            DestroyEntity(entity);
+        }
+        benchmarkLightCount = 0;
+
+        if (count > 0)
+        {
+            // 分布在材质球周围（含基准球阵向 -z 延伸的部分），颜色随机、半径 1~4
+            std::mt19937 rng(2024);
+            std::uniform_real_distribution<float> px(-15.0f, 15.0f), py(-8.0f, 8.0f), pz(-25.0f, 6.0f);
+            std::uniform_real_distribution<float> pr(1.0f, 4.0f), pc(0.2f, 1.0f);
+            entities.Reserve(entities.Capacity() + count);
+            lightRefs.Reserve(lightRefs.Size() + count);
+            for (int i = 0; i < count; ++i)
+            {
+                glm::vec3 hue(pc(rng), pc(rng), pc(rng));
+                hue /= std::max(hue.r, std::max(hue.g, hue.b));
+                Light light(glm::vec3(px(rng), py(rng), pz(rng)), hue, 1.0f);
+                light.Range = pr(rng);
+                // 亮度与半径匹配：在 Range 处衰减到约 LightManager 的截断值
+                light.Intensity = light.Range * light.Range * lightManager.GetRangeCutoff();
+                LightHandle handle = lightManager.Create(light);
+                if (!lightManager.IsValid(handle))
+                    break;
+                lightRefs.Add(entities.Create(), handle);
+                ++benchmarkLightCount;
+            }
+        }
+        std::cout << "[PBRRenderer] Benchmark lights: " << benchmarkLightCount << std::endl;
+    }
 
     // 单独设置某个球的材质
     void PBRRenderer::SetMaterialForSphere(int sphereIndex, const std::string& folderPath)
@@ -538,22 +1281,21 @@ namespace renderer
         auto it = std::find(materialNames.begin(), materialNames.end(), folderPath);
         if (it == materialNames.end()) return;
         int idx = int(std::distance(materialNames.begin(), it));
-        if (sphereIndex < 0 || sphereIndex >= (int)materials.size()) return;
-        sphereMaterialIdx[sphereIndex] = idx;
-        materials[sphereIndex] = allMaterials[idx];
+        if (sphereIndex < 0 || sphereIndex >= (int)sphereEntities.size()) return;
+        materialRefs.Get(sphereEntities[sphereIndex]).material = idx;
     }
 
     int PBRRenderer::GetSphereMaterialIndex(int sphereIndex) const {
-        if (sphereIndex < 0 || sphereIndex >= (int)sphereMaterialIdx.size()) {
+        if (sphereIndex < 0 || sphereIndex >= (int)sphereEntities.size()) {
             std::cerr << "[PBRRenderer] GetSphereMaterialIndex: invalid sphereIndex=" 
                       << sphereIndex << std::endl;
             return 0;
         }
-        return sphereMaterialIdx[sphereIndex];
+        return materialRefs.Get(sphereEntities[sphereIndex]).material;
     }
 
     void PBRRenderer::SetSphereMaterialIndex(int sphereIndex, int materialIndex) {
-        if (sphereIndex < 0 || sphereIndex >= (int)sphereMaterialIdx.size()) {
+        if (sphereIndex < 0 || sphereIndex >= (int)sphereEntities.size()) {
             std::cerr << "[PBRRenderer] SetSphereMaterialIndex: invalid sphereIndex=" 
                       << sphereIndex << std::endl;
             return;
@@ -563,7 +1305,6 @@ namespace renderer
                       << materialIndex << std::endl;
             return;
         }
-        sphereMaterialIdx[sphereIndex] = materialIndex;
-        materials[sphereIndex]        = allMaterials[materialIndex];
+        materialRefs.Get(sphereEntities[sphereIndex]).material = materialIndex;
     }
 }// namespace renderer
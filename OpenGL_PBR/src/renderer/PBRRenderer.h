@@ -3,6 +3,7 @@
 #include <iostream>
 #include <vector>
 #include <filesystem>
+#include <memory>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -13,11 +14,28 @@
 
 #include "Shader.h"
 #include "Primitives.h"
+#include "MaterialArrays.h"
+#include "GLExtensions.h"
+#include "DeferredPBRRenderer.h"
+#include "LightManager.h"
+#include "ClusteredLighting.h"
+#include "OcclusionCounter.h"
+#include "RenderQueue.h"
+#include "GpuProfiler.h"
+#include "core/Profiler.h"
 #include "core/Camera.h"   
+#include "scene/LodSelector.h"
+#include "scene/FrustumCuller.h"
+#include "scene/Bvh.h"
+#include "scene/TransformBatch.h"
+#include "scene/EntityRegistry.h"
+#include "scene/ComponentPool.h"
+#include "scene/SceneComponents.h"
 #include "utils/TextureLoader.h"  
 #include "imgui/imgui.h"
 
 
+class Model;
 
 namespace renderer {
 
@@ -35,6 +53,8 @@ namespace renderer {
 
         /// 在 Application 初始化时调用，一次性完成各个 framebuffer / 纹理的创建与预计算
         void InitPBR(const std::string& hdrPath);
+        /// 同上，HDR 环境图已由调用方解码（如在作业线程中），上传后释放其像素
+        void InitPBR(utils::TextureLoader::Image& hdrImage);
 
         /// 每帧调用，给定当前摄像机，执行一次 PBR 渲染（填充屏幕）
         void RenderPBRScene(const core::Camera& camera);
@@ -45,12 +65,17 @@ namespace renderer {
         /// ImGui 面板：调用此函数将渲染 GUI 控件
         // void RenderImGui();
 
+        /// 默认场景中一排材质球的数量
+        static const int DEFAULT_SPHERE_COUNT = 5;
+
         // materials
+        /// 把 parentDirectory 下每个子目录加载为一个材质，并为每个材质放一个球
         void LoadMaterialsFromDirectory(const std::string& parentDirectory);
+        /// 加载材质库，并重建 sphereCount 个水平排列的材质球（初始都用第一个材质）
         void LoadAllMaterials(const std::vector<std::string>& materialNames,
-                          const std::string& baseDir);
+                          const std::string& baseDir, int sphereCount = DEFAULT_SPHERE_COUNT);
 
-        /// 给某个球设置材质（只更新 materials[i]）
+        /// 给某个球设置材质（folderPath 为材质文件夹名）
         void SetMaterialForSphere(int sphereIndex, const std::string& folderPath);
 
         /// 获取已经加载的材质文件夹名列表
@@ -65,26 +90,143 @@ namespace renderer {
         /// 更换 HDR 环境图
         // void LoadHDRI(const std::string& hdrPath);
 
-        // ********** 新增：让外部可以访问并修改光源 **********
-        std::vector<glm::vec3> lightPositions;
-        std::vector<glm::vec3> lightColors;
+        /// 场景中的全部动态光源（含基准光源）；修改后下一帧只上传变化的光源
+        LightManager&       GetLightManager() { return lightManager; }
+        const LightManager& GetLightManager() const { return lightManager; }
+
+        /// 场景光源：带光源小球、可在界面上编辑的光源实体（不含基准光源），依次调用 fn(Entity, LightHandle)
+        template <typename Fn>
+        void ForEachSceneLight(Fn&& fn) const
+        {
+            for (size_t i = 0; i < lightRefs.Size(); ++i)
+            {
+                const Entity entity = lightRefs.EntityAt(i);
+                if (renderables.Has(entity))
+                    fn(entity, lightRefs.At(i));
+            }
+        }
+        /// 创建光源和它的小球；光源数达到上限时返回空实体
+        Entity AddSceneLight(const Light& light);
+        void   RemoveSceneLight(Entity entity);
 
         // ********** 如果还想让外部调整其它参数，也可以暴露出去 **********
         // 例如曝光、gamma 等……
         float exposure = 1.0f;
         float gamma = 2.2f;
 
+        // LOD：根据屏幕投影尺寸为球体和光源小球选择细分级别
+        bool        enableLod = true;
+        LodSelector lodSelector;
+
+        /// 上一帧提交的球体索引总数（用于观察 LOD 效果）
+        unsigned int GetSubmittedSphereIndices() const { return submittedSphereIndices; }
+
+        // 视锥剔除：每帧对材质球和光源小球的包围体做一次批量 SIMD 测试，
+        // 或者（useBvhCulling）用 BVH 做层次化的视锥查询
+        bool enableFrustumCulling = true;
+        bool useBvhCulling = false;
+
+        /// 上一帧的剔除统计（测试数 / 可见数 / 耗时；BVH 路径下测试数为访问的节点数）
+        const FrustumCuller::Stats& GetCullStats() const { return cullStats; }
+        /// 上一帧批量重算世界 / 法线矩阵的统计
+        const TransformBatch::Stats& GetTransformStats() const { return sceneTransforms.GetStats(); }
+
+        /// 鼠标拾取：cursorX/Y 为窗口像素坐标（左上角为原点）。
+        /// 返回物体编号（可绘制实体在 renderables 中的稠密下标）；-1 表示未命中
+        int    PickObject(double cursorX, double cursorY, const core::Camera& camera);
+        /// 上一次拾取到的实体；实体已被销毁时返回空实体
+        Entity GetPickedEntity() const { return entities.IsAlive(pickedEntity) ? pickedEntity : Entity(); }
+        bool   IsSceneLight(Entity entity) const { return lightRefs.Has(entity); }
+        /// 实体是第几个材质球；不是材质球时返回 -1
+        int    GetSphereIndex(Entity entity) const;
+        int    GetSphereCount() const { return static_cast<int>(sphereEntities.size()); }
+        /// 当前存活的实体数（材质球 + 光源）
+        size_t GetEntityCount() const { return entities.Alive(); }
+
+        // 实例化：材质贴图放进按分辨率分组的纹理数组，所有球（含光源小球）按 (组, LOD) 分桶，
+        // 每桶一次 glDrawElementsInstanced；关闭时走逐球绑定贴图 + RenderSphere 的旧路径
+        bool useInstancing = true;
+
+        // bindless：驱动支持 GL_ARB_bindless_texture 时，材质贴图以常驻句柄存进 SSBO，
+        // 按 (材质, LOD) 分桶绘制，整帧不再绑定任何材质贴图；不支持时自动退回上面的路径
+        bool useBindless = true;
+
+        // 延迟渲染：几何阶段写紧凑 G-Buffer，光照阶段一次全屏 Cook-Torrance + IBL；
+        // 可随时与前向路径切换做 A/B 对比（需要纹理数组已建立）
+        bool useDeferred = false;
+
+        // 深度预通道：先用空片段着色器只写深度，主通道改用 GL_EQUAL 且不写深度，
+        // 每个像素只对最终可见的那一层执行昂贵的 PBR 着色（延迟路径下不生效）
+        bool useDepthPrepass = false;
+        // 可见物体按观察深度由近到远提交，让 early-z 尽早拒绝被遮挡的片段
+        bool sortFrontToBack = true;
+
+        /// 遮挡查询统计（GL_SAMPLES_PASSED，结果延迟几帧）：
+        /// depthSamples 为预通道通过深度测试的样本数，即不开预通道时按当前顺序会着色的数量；
+        /// shadedSamples 为着色通道实际着色的样本数。未开预通道 / 延迟路径下对应项为 0
+        struct OverdrawStats {
+            uint64_t depthSamples  = 0;
+            uint64_t shadedSamples = 0;
+        };
+        const OverdrawStats& GetOverdrawStats() const { return overdrawStats; }
+
+        /// 上一帧经状态缓存发出 / 跳过的 GL 状态调用，以及渲染队列的绘制包数和排序耗时
+        const GLStateCache::Stats& GetStateCacheStats() const { return stateCache.LastFrame(); }
+        const RenderQueue::Stats&  GetRenderQueueStats() const { return renderQueue.GetStats(); }
+
+        enum class SpherePath { Direct, TextureArray, Bindless, Deferred };
+        /// 上一帧绘制球体实际使用的路径
+        SpherePath GetSpherePath() const { return activeSpherePath; }
+
+        /// 上一帧绘制球体发出的 draw call 数，以及提交球体所花的 CPU 时间
+        unsigned int GetSphereDrawCalls() const { return sphereDrawCalls; }
+        double       GetSphereSubmitMs() const { return sphereSubmitMs; }
+
+        /// 基准场景：用 count 个材质球（立体网格排列，材质轮流使用）替换默认的一排球；
+        /// count <= 0 时恢复原来的球和材质选择
+        void SetBenchmarkSphereCount(int count);
+        int  GetBenchmarkSphereCount() const { return benchmarkSphereCount; }
+
+        /// 额外加入 count 个不绘制小球的随机动态光源（半径 1~4），用于观察数千光源下的开销；0 表示移除
+        void SetBenchmarkLightCount(int count);
+        int  GetBenchmarkLightCount() const { return benchmarkLightCount; }
+
+        /// 上一帧的分簇统计、光源上传统计和光源相关缓冲的显存占用
+        const LightClusterer::Stats&      GetClusterStats() const { return clusteredLighting.GetStats(); }
+        const LightManager::UploadStats& GetLightUploadStats() const { return lightManager.GetUploadStats(); }
+        size_t GetClusterBufferBytes() const { return clusteredLighting.GetBufferBytes() + lightManager.GetBufferBytes(); }
+
+        /// 场景模型：每帧在天空盒之后绘制（视锥剔除 + 按投影尺寸选 LOD，共用上面的 lodSelector / enableLod），
+        /// 着色器为 assets/shaders/modelShader。默认经 Model::DrawBatched 一次画完，
+        /// 关闭 batchSceneModel 时逐 Mesh 经 Model::Draw 绘制（可选 meshlet 剔除）。
+        /// transform 为模型矩阵（LOD 计算假设等比缩放）；传空指针移除
+        void SetSceneModel(std::unique_ptr<Model> model, const glm::mat4& transform);
+        const Model* GetSceneModel() const { return sceneModel.get(); }
+        bool drawSceneModel = true;
+        bool batchSceneModel = true;            // 合并缓冲 + 间接绘制
+        bool sceneModelMeshletCulling = true;   // 逐 Mesh 路径：LOD0 的 Mesh 先做 meshlet 簇剔除再绘制
+
     private:
         unsigned int SCR_WIDTH, SCR_HEIGHT;
 
         // ------------------------------------------------------------
         // 1. Shader 对象
         Shader pbrShader;
+        Shader pbrInstancedShader;
+        Shader depthDirectShader;      // 深度预通道（pbr.vert / pbrInstanced.vert + depthOnly.frag）
+        Shader depthInstancedShader;
+        std::unique_ptr<Shader> pbrBindlessShader;   // 仅在支持 bindless 时创建
+
+        std::unique_ptr<DeferredPBRRenderer> deferredRenderer;
+        LightManager                         lightManager;
+        ClusteredLighting                    clusteredLighting;
         Shader equirectangularToCubemapShader;
         Shader irradianceShader;
         Shader prefilterShader;
         Shader brdfShader;
         Shader backgroundShader;
+        Shader modelShader;
+        GLint  modelMaterialLayersLocation;   // modelShader 的 materialLayers，构造时查询一次
 
         // ------------------------------------------------------------
         // 2. PBR 所需帧缓冲和贴图
@@ -107,9 +249,53 @@ namespace renderer {
 
         std::vector<MaterialTextures> allMaterials;    // 所有扫描到的材质
         std::vector<std::string>      materialNames;   // 对应的文件夹名
-        std::vector<MaterialTextures> materials;       // 每个球当前使用的材质
-        std::vector<glm::vec3>        materialPositions;
-        std::vector<int>              sphereMaterialIdx;  // 每球所选材质 in allMaterials
+
+        // ------------------------------------------------------------
+        // 4. 场景实体：材质球和光源都是实体，数据放在按组件划分的稠密池里
+        //    材质球 = 变换 + 可绘制 + 材质；场景光源 = 光源 + 变换 + 可绘制 + 材质（光源小球）；基准光源只有光源组件
+        EntityRegistry                     entities;
+        ComponentPool<TransformComponent>  transforms;
+        ComponentPool<RenderableComponent> renderables;    // 稠密顺序即本帧的物体编号
+        ComponentPool<MaterialComponent>   materialRefs;
+        ComponentPool<LightHandle>         lightRefs;
+        std::vector<Entity>                sphereEntities;  // 界面上“第 i 个球”的顺序
+        int                                benchmarkLightCount = 0;
+        std::vector<Entity>                scratchEntities;
+
+        // 每帧按 renderables 的稠密顺序从组件池收集一次，之后的包围体 / 剔除 / 排序 / 提交都顺序读取
+        std::vector<glm::vec3> objectPositions;
+        std::vector<float>     objectScales;
+        std::vector<int>       objectMaterials;
+
+        // allMaterials 对应的纹理数组（实例化路径使用）
+        MaterialArrays materialArrays;
+        // allMaterials 的 bindless 句柄表（每材质 5 个 GLuint64，binding = 0）
+        unsigned int   materialHandleBuffer = 0;
+        // 缺失贴图在句柄表中的替身：1x1 黑色（与其它路径采样纹理 0 的结果一致），只在 bindless 路径创建
+        unsigned int   missingMapTexture = 0;
+        SpherePath     activeSpherePath = SpherePath::Direct;
+
+        /// 逐实例数据：世界空间位置 + 均匀缩放，材质层号（与 pbrInstanced.vert 的 location 3/4 对应）
+        struct SphereInstance {
+            glm::vec4 positionScale;
+            float     layer;
+        };
+        unsigned int                instanceVBO = 0;
+        std::vector<SphereInstance> sphereInstances;   // 按 (组, LOD) 排好序，每帧整体上传
+        std::vector<SphereInstance> unsortedInstances;
+        std::vector<unsigned int>   instanceBuckets;   // 每个实例的桶号 group * SPHERE_LOD_COUNT + lod
+        std::vector<unsigned int>   bucketCounts;
+        std::vector<unsigned int>   bucketStarts;
+        std::vector<unsigned int>   bucketCursors;
+        std::vector<uint32_t>       drawOrder;         // 本帧可见物体编号的提交顺序
+        std::vector<std::pair<float, uint32_t>> sortKeys;
+        unsigned int                sphereDrawCalls = 0;
+        double                      sphereSubmitMs = 0.0;
+
+        // 基准场景开启前的球位置和材质选择
+        int                    benchmarkSphereCount = 0;
+        std::vector<glm::vec3> savedPositions;
+        std::vector<int>       savedMaterialIdx;
 
         // 当前选择的材质和 HDR index
         int selectedMaterialIndex = 0;
@@ -119,6 +305,68 @@ namespace renderer {
         std::vector<std::string> hdrPaths;
 
         bool useNormalMap = true;
+
+        unsigned int submittedSphereIndices = 0;
+
+        // 场景物体的世界空间包围体（下标为物体编号）
+        std::vector<BoundingSphere> sceneSpheres;
+        std::vector<AABB>           sceneBoxes;
+        std::vector<unsigned char>  objectVisible;
+        std::vector<uint32_t>       bvhVisible;
+        FrustumCuller               sceneCuller;
+        Bvh                         sceneBvh;
+        FrustumCuller::Stats        cullStats;
+        TransformBatch              sceneTransforms;   // 下标与 drawOrder 中的物体编号一致
+        Entity                      pickedEntity;
+
+        std::unique_ptr<Model> sceneModel;
+        glm::mat4              sceneModelMatrix = glm::mat4(1.0f);
+
+        OcclusionCounter prepassCounter;
+        OcclusionCounter shadingCounter;
+        OverdrawStats    overdrawStats;
+        bool             lastFramePrepass = false;
+
+        // 渲染队列的阶段（键的最高 4 位），按数值顺序执行
+        static const unsigned int PASS_DEPTH_PREPASS = 0;
+        static const unsigned int PASS_OPAQUE        = 1;
+        static const unsigned int PASS_SKYBOX        = 2;
+        RenderQueue  renderQueue;
+        GLStateCache stateCache;
+
+        /// 创建一个材质球实体
+        Entity CreateSphere(const glm::vec3& position, int material);
+        /// 从所有组件池中移除实体的组件并回收实体
+        void   DestroyEntity(Entity entity);
+        void   DestroySpheres();
+        /// 删除 InitPBR 生成的环境贴图和烘焙用 FBO（重新烘焙前、析构时调用）
+        void   ReleaseEnvironment();
+        /// 删除 allMaterials 的贴图（先取消 bindless 句柄常驻）并清空列表
+        void   ReleaseMaterialTextures();
+
+        /// 设置 modelShader 的矩阵和光照后绘制场景模型（调用后 GL 状态需要让状态缓存失效）
+        void RenderSceneModel(const core::Camera& camera, const glm::mat4& view, const glm::mat4& projection);
+
+        /// 从组件池收集本帧物体的位置 / 缩放 / 材质，重新计算包围体，并对 BVH 做重建或增量 refit
+        void UpdateSceneBounds();
+        /// 按当前设置（线性 SIMD / BVH）填充 objectVisible
+        void CullScene(const Frustum& frustum);
+
+        /// 由 objectVisible 生成本帧的 drawOrder（sortFrontToBack 时按观察深度由近到远）
+        void BuildDrawOrder(const glm::mat4& view);
+
+        /// 按 drawOrder 为每个球提交一个绘制包（非实例化路径）；bindMaterials 为 false 时不带材质贴图（深度预通道）
+        void SubmitSpheresDirect(const core::Camera& camera, unsigned int pass, Shader& shader, bool bindMaterials);
+        /// PrepareSphereInstances + SubmitSphereInstances，并立即执行队列（延迟路径的几何阶段使用）
+        void RenderSpheresInstanced(const core::Camera& camera, Shader& shader, bool bindless);
+        /// 生成逐实例数据并按桶排序上传：纹理数组按 (组, LOD)，bindless 按 (材质, LOD)
+        void PrepareSphereInstances(const core::Camera& camera, bool bindless);
+        /// 每个非空桶提交一个实例化绘制包；bindMaterials 为 false 时不带材质（深度预通道）
+        void SubmitSphereInstances(unsigned int pass, Shader& shader, bool bindless, bool bindMaterials);
+
+        /// 为一个世界空间包围球选择 LOD，并更新 currentLod
+        unsigned int SelectSphereLod(const glm::vec3& center, float radius,
+                                     const core::Camera& camera, int& currentLod) const;
     };
 
 } // namespace renderer
@@ -1,4 +1,7 @@
 #include "Primitives.h"
+#include "GpuMemory.h"
+
+#include <algorithm>
 
 
 namespace renderer {
@@ -7,82 +10,163 @@ namespace renderer {
     unsigned int Primitives::sphereVAO = 0;
     unsigned int Primitives::sphereVBO = 0;
     unsigned int Primitives::sphereEBO = 0;
-    unsigned int Primitives::sphereIndexCount = 0;
+    unsigned int Primitives::sphereIndexOffset[Primitives::SPHERE_LOD_COUNT] = {};
+    unsigned int Primitives::sphereIndexCount[Primitives::SPHERE_LOD_COUNT] = {};
+    BoundingSphere Primitives::sphereBounds;
+    AABB           Primitives::sphereAABB;
 
     unsigned int Primitives::cubeVAO = 0;
     unsigned int Primitives::cubeVBO = 0;
+    BoundingSphere Primitives::cubeBounds;
+    AABB           Primitives::cubeAABB;
 
     unsigned int Primitives::quadVAO = 0;
     unsigned int Primitives::quadVBO = 0;
 
 #pragma region Sphere
 
-    void Primitives::RenderSphere() {
+    void Primitives::RenderSphere(unsigned int lod) {
         if (sphereVAO == 0) {
             initSphere();
         }
+        lod = std::min(lod, SPHERE_LOD_COUNT - 1);
         glBindVertexArray(sphereVAO);
-        glDrawElements(GL_TRIANGLE_STRIP, static_cast<GLsizei>(sphereIndexCount), GL_UNSIGNED_INT, 0);
+        glDrawElements(
+            GL_TRIANGLE_STRIP,
+            static_cast<GLsizei>(sphereIndexCount[lod]),
+            GL_UNSIGNED_INT,
+            (void*)(static_cast<size_t>(sphereIndexOffset[lod]) * sizeof(unsigned int))
+        );
         glBindVertexArray(0);
     }
 
-    void Primitives::initSphere() {
-        std::vector<glm::vec3> positions;
-        std::vector<glm::vec2> uv;
-        std::vector<glm::vec3> normals;
-        std::vector<unsigned int> indices;
+    void Primitives::RenderSphereInstanced(unsigned int lod, unsigned int instanceCount) {
+        if (sphereVAO == 0) {
+            initSphere();
+        }
+        if (instanceCount == 0) return;
+        lod = std::min(lod, SPHERE_LOD_COUNT - 1);
+        glBindVertexArray(sphereVAO);
+        glDrawElementsInstanced(
+            GL_TRIANGLE_STRIP,
+            static_cast<GLsizei>(sphereIndexCount[lod]),
+            GL_UNSIGNED_INT,
+            (void*)(static_cast<size_t>(sphereIndexOffset[lod]) * sizeof(unsigned int)),
+            static_cast<GLsizei>(instanceCount)
+        );
+        glBindVertexArray(0);
+    }
+
+    unsigned int Primitives::GetSphereVAO() {
+        if (sphereVAO == 0) {
+            initSphere();
+        }
+        return sphereVAO;
+    }
 
-        const unsigned int X_SEGMENTS = 64;
-        const unsigned int Y_SEGMENTS = 64;
+    unsigned int Primitives::GetSphereIndexCount(unsigned int lod) {
+        if (sphereVAO == 0) {
+            initSphere();
+        }
+        return sphereIndexCount[std::min(lod, SPHERE_LOD_COUNT - 1)];
+    }
+
+    size_t Primitives::GetSphereIndexByteOffset(unsigned int lod) {
+        if (sphereVAO == 0) {
+            initSphere();
+        }
+        return static_cast<size_t>(sphereIndexOffset[std::min(lod, SPHERE_LOD_COUNT - 1)]) * sizeof(unsigned int);
+    }
+
+    const BoundingSphere& Primitives::GetSphereBounds() {
+        if (sphereVAO == 0) {
+            initSphere();
+        }
+        return sphereBounds;
+    }
+
+    const AABB& Primitives::GetSphereAABB() {
+        if (sphereVAO == 0) {
+            initSphere();
+        }
+        return sphereAABB;
+    }
+
+    void Primitives::BuildSphereGeometry(SphereGeometry& out) {
+        std::vector<float>& vertices = out.vertices;
+        std::vector<unsigned int>& indices = out.indices;
+        vertices.clear();
+        indices.clear();
+
+        size_t vertexCount = 0, indexCount = 0;
+        for (unsigned int lod = 0; lod < SPHERE_LOD_COUNT; ++lod) {
+            const size_t segments = 64u >> lod;
+            vertexCount += (segments + 1) * (segments + 1);
+            indexCount += segments * (segments + 1) * 2;
+        }
+        vertices.reserve(vertexCount * 8);
+        indices.reserve(indexCount);
+
+        // 所有 LOD 的顶点依次拼接在同一个 VBO 中，索引直接使用绝对下标
         const float PI = 3.14159265359f;
-        for (unsigned int x = 0; x <= X_SEGMENTS; ++x) {
-            for (unsigned int y = 0; y <= Y_SEGMENTS; ++y) {
+        for (unsigned int lod = 0; lod < SPHERE_LOD_COUNT; ++lod) {
+            const unsigned int X_SEGMENTS = 64u >> lod;
+            const unsigned int Y_SEGMENTS = 64u >> lod;
+            const unsigned int baseVertex = static_cast<unsigned int>(vertices.size() / 8);
+
+            for (unsigned int x = 0; x <= X_SEGMENTS; ++x) {
                 float xSegment = (float)x / (float)X_SEGMENTS;
-                float ySegment = (float)y / (float)Y_SEGMENTS;
-                float xPos = std::cos(xSegment * 2.0f * PI) * std::sin(ySegment * PI);
-                float yPos = std::cos(ySegment * PI);
-                float zPos = std::sin(xSegment * 2.0f * PI) * std::sin(ySegment * PI);
-
-                positions.push_back(glm::vec3(xPos, yPos, zPos));
-                uv.push_back(glm::vec2(xSegment, ySegment));
-                normals.push_back(glm::vec3(xPos, yPos, zPos));
+                float cosPhi = std::cos(xSegment * 2.0f * PI);
+                float sinPhi = std::sin(xSegment * 2.0f * PI);
+                for (unsigned int y = 0; y <= Y_SEGMENTS; ++y) {
+                    float ySegment = (float)y / (float)Y_SEGMENTS;
+                    float sinTheta = std::sin(ySegment * PI);
+                    float xPos = cosPhi * sinTheta;
+                    float yPos = std::cos(ySegment * PI);
+                    float zPos = sinPhi * sinTheta;
+
+                    // 位置、法线（单位球上二者相同）、纹理坐标
+                    const float vertex[8] = { xPos, yPos, zPos, xPos, yPos, zPos, xSegment, ySegment };
+                    vertices.insert(vertices.end(), vertex, vertex + 8);
+                }
             }
-        }
 
-        bool oddRow = false;
-        for (unsigned int y = 0; y < Y_SEGMENTS; ++y) {
-            if (!oddRow) {
-                for (unsigned int x = 0; x <= X_SEGMENTS; ++x) {
-                    indices.push_back(y * (X_SEGMENTS + 1) + x);
-                    indices.push_back((y + 1) * (X_SEGMENTS + 1) + x);
+            out.indexOffset[lod] = static_cast<unsigned int>(indices.size());
+            bool oddRow = false;
+            for (unsigned int y = 0; y < Y_SEGMENTS; ++y) {
+                if (!oddRow) {
+                    for (unsigned int x = 0; x <= X_SEGMENTS; ++x) {
+                        indices.push_back(baseVertex + y * (X_SEGMENTS + 1) + x);
+                        indices.push_back(baseVertex + (y + 1) * (X_SEGMENTS + 1) + x);
+                    }
                 }
-            }
-            else {
-                for (int x = X_SEGMENTS; x >= 0; --x) {
-                    indices.push_back((y + 1) * (X_SEGMENTS + 1) + x);
-                    indices.push_back(y * (X_SEGMENTS + 1) + x);
+                else {
+                    for (int x = X_SEGMENTS; x >= 0; --x) {
+                        indices.push_back(baseVertex + (y + 1) * (X_SEGMENTS + 1) + x);
+                        indices.push_back(baseVertex + y * (X_SEGMENTS + 1) + x);
+                    }
                 }
+                oddRow = !oddRow;
             }
-            oddRow = !oddRow;
+            out.indexCount[lod] = static_cast<unsigned int>(indices.size()) - out.indexOffset[lod];
         }
-        sphereIndexCount = static_cast<unsigned int>(indices.size());
-
-        std::vector<float> data;
-        data.reserve(positions.size() * 8);
-        for (size_t i = 0; i < positions.size(); ++i) {
-            // 位置
-            data.push_back(positions[i].x);
-            data.push_back(positions[i].y);
-            data.push_back(positions[i].z);
-            // 法线
-            data.push_back(normals[i].x);
-            data.push_back(normals[i].y);
-            data.push_back(normals[i].z);
-            // 纹理坐标
-            data.push_back(uv[i].x);
-            data.push_back(uv[i].y);
+    }
+
+    void Primitives::initSphere() {
+        GpuMemory::Scope memoryTag("Primitives");
+        SphereGeometry geometry;
+        BuildSphereGeometry(geometry);
+        const std::vector<float>& data = geometry.vertices;
+        const std::vector<unsigned int>& indices = geometry.indices;
+        for (unsigned int lod = 0; lod < SPHERE_LOD_COUNT; ++lod) {
+            sphereIndexOffset[lod] = geometry.indexOffset[lod];
+            sphereIndexCount[lod] = geometry.indexCount[lod];
         }
 
+        // 包围体由实际顶点计算（各级 LOD 的顶点都在单位球面上，共用一份）
+        sphereBounds = BoundingSphere::FromPoints(data.data(), data.size() / 8, 8 * sizeof(float));
+        sphereAABB   = AABB::FromPoints(data.data(), data.size() / 8, 8 * sizeof(float));
+
         glGenVertexArrays(1, &sphereVAO);
         glGenBuffers(1, &sphereVBO);
         glGenBuffers(1, &sphereEBO);
@@ -122,6 +206,13 @@ namespace renderer {
 
 #pragma region Cube
 
+    unsigned int Primitives::GetCubeVAO() {
+        if (cubeVAO == 0) {
+            initCube();
+        }
+        return cubeVAO;
+    }
+
     void Primitives::RenderCube() {
         if (cubeVAO == 0) {
             initCube();
@@ -131,7 +222,22 @@ namespace renderer {
         glBindVertexArray(0);
     }
 
+    const BoundingSphere& Primitives::GetCubeBounds() {
+        if (cubeVAO == 0) {
+            initCube();
+        }
+        return cubeBounds;
+    }
+
+    const AABB& Primitives::GetCubeAABB() {
+        if (cubeVAO == 0) {
+            initCube();
+        }
+        return cubeAABB;
+    }
+
     void Primitives::initCube() {
+        GpuMemory::Scope memoryTag("Primitives");
         // 36 个顶点，每个顶点：位置(3)、法线(3)、UV(2) 共 8 floats
         float vertices[] = {
             // back face
@@ -178,6 +284,9 @@ namespace renderer {
              -1.0f,  1.0f,  1.0f,   0.0f, 1.0f, 0.0f,     0.0f, 0.0f
         };
 
+        cubeBounds = BoundingSphere::FromPoints(vertices, 36, 8 * sizeof(float));
+        cubeAABB   = AABB::FromPoints(vertices, 36, 8 * sizeof(float));
+
         glGenVertexArrays(1, &cubeVAO);
         glGenBuffers(1, &cubeVBO);
 
@@ -224,6 +333,7 @@ namespace renderer {
     }
 
     void Primitives::initQuad() {
+        GpuMemory::Scope memoryTag("Primitives");
         float quadVertices[] = {
             // positions        // texture Coords
             -1.0f,  1.0f, 0.0f,   0.0f, 1.0f,
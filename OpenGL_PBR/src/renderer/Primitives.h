@@ -6,13 +6,15 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include "scene/Bounds.h"
+
 namespace renderer {
 
     /**
      * Primitives
      * ----------
      * 提供三个静态函数，用于渲染最常用的几何体：
-     *   - RenderSphere(): 渲染一个单位球体（中心在原点，半径 1）
+     *   - RenderSphere(): 渲染一个单位球体（中心在原点，半径 1），支持 SPHERE_LOD_COUNT 级 LOD
      *   - RenderCube():   渲染一个单位立方体（中心在原点，边长 2）
      *   - RenderQuad():   渲染一个覆盖 NDC 的全屏四边形（XY 平面）
      *
@@ -20,11 +22,47 @@ namespace renderer {
      */
     class Primitives {
     public:
-        /// 渲染一个单位球体（中心在原点，半径 1）
-        static void RenderSphere();
+        /// 球体 LOD 级数：第 i 级的经纬分段数为 64 >> i（64、32、16、8）
+        static constexpr unsigned int SPHERE_LOD_COUNT = 4;
+
+        /// 渲染一个单位球体（中心在原点，半径 1），lod 越大越粗糙
+        static void RenderSphere(unsigned int lod = 0);
+
+        /// 实例化渲染 instanceCount 个单位球（第 lod 级），逐实例属性需事先挂到 GetSphereVAO() 上
+        static void RenderSphereInstanced(unsigned int lod, unsigned int instanceCount);
+
+        /// 球体 VAO（首次调用时创建），用于挂接逐实例顶点属性（location 0~2 已被占用）
+        static unsigned int GetSphereVAO();
+
+        /// 第 lod 级球体的索引数量（用于统计提交的顶点数）
+        static unsigned int GetSphereIndexCount(unsigned int lod);
+        /// 第 lod 级球体在索引缓冲中的字节偏移（GL_TRIANGLE_STRIP + GL_UNSIGNED_INT），供 RenderQueue 直接提交
+        static size_t GetSphereIndexByteOffset(unsigned int lod);
+
+        /// 球体几何（CPU 端）：所有 LOD 的交错顶点（位置 3 + 法线 3 + UV 2 个 float）依次拼接，
+        /// 三角形带索引使用绝对下标，第 i 级为 indices[indexOffset[i], indexOffset[i] + indexCount[i])
+        struct SphereGeometry {
+            std::vector<float>        vertices;
+            std::vector<unsigned int> indices;
+            unsigned int              indexOffset[SPHERE_LOD_COUNT] = {};
+            unsigned int              indexCount[SPHERE_LOD_COUNT] = {};
+        };
+
+        /// 生成球体几何，不调用 OpenGL（initSphere 和基准测试共用）
+        static void BuildSphereGeometry(SphereGeometry& out);
+
+        /// 单位球（所有 LOD 共用）的模型空间包围体，用于视锥剔除
+        static const BoundingSphere& GetSphereBounds();
+        static const AABB&           GetSphereAABB();
 
         /// 渲染一个单位立方体（中心在原点，边长 2，法线和纹理坐标已绑定）
         static void RenderCube();
+        /// 立方体 VAO（36 个顶点，GL_TRIANGLES，无索引）
+        static unsigned int GetCubeVAO();
+
+        /// 单位立方体的模型空间包围体
+        static const BoundingSphere& GetCubeBounds();
+        static const AABB&           GetCubeAABB();
 
         /// 渲染一个全屏四边形（覆盖 NDC 平面，纹理坐标 [0,1]×[0,1]）
         static void RenderQuad();
@@ -34,11 +72,16 @@ namespace renderer {
         static unsigned int   sphereVAO;
         static unsigned int   sphereVBO;
         static unsigned int   sphereEBO;
-        static unsigned int   sphereIndexCount;
+        static unsigned int   sphereIndexOffset[SPHERE_LOD_COUNT]; // 各级在 EBO 中的起始索引
+        static unsigned int   sphereIndexCount[SPHERE_LOD_COUNT];
+        static BoundingSphere sphereBounds;
+        static AABB           sphereAABB;
 
         // 立方体缓存
         static unsigned int   cubeVAO;
         static unsigned int   cubeVBO;
+        static BoundingSphere cubeBounds;
+        static AABB           cubeAABB;
 
         // 四边形缓存
         static unsigned int   quadVAO;
@@ -0,0 +1,186 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace renderer {
+
+    void RenderQueue::Clear()
+    {
+        m_Packets.clear();
+        m_Sorted.clear();
+        m_Textures.clear();
+        m_Transforms.clear();
+        m_NormalMatrices.clear();
+        m_Stats = Stats();
+    }
+
+    void RenderQueue::SetPassState(unsigned int pass, const PassState& state)
+    {
+        if (pass < MAX_PASSES)
+            m_Passes[pass] = state;
+    }
+
+    void RenderQueue::SetInstanceLayout(GLuint buffer, std::initializer_list<InstanceAttribute> attributes)
+    {
+        m_InstanceBuffer = buffer;
+        m_InstanceAttributes.assign(attributes.begin(), attributes.end());
+    }
+
+    uint64_t RenderQueue::MakeKey(unsigned int pass, const Shader& shader, uint32_t material, uint32_t order)
+    {
+        // 程序按首次出现的顺序编号，只占 8 位
+        auto it = m_ProgramIds.find(shader.serial);
+        if (it == m_ProgramIds.end())
+            it = m_ProgramIds.emplace(shader.serial, static_cast<uint32_t>(m_ProgramIds.size())).first;
+
+        return (static_cast<uint64_t>(pass & 0xF) << 60)
+             | (static_cast<uint64_t>(it->second & 0xFF) << 52)
+             | (static_cast<uint64_t>(material & 0xFFFFF) << 32)
+             | order;
+    }
+
+    uint32_t RenderQueue::DepthOrder(float viewDepth)
+    {
+        // 非负 IEEE float 的位模式与数值大小顺序一致
+        float depth = std::max(viewDepth, 0.0f);
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return bits;
+    }
+
+    uint32_t RenderQueue::AddTextures(std::initializer_list<TextureBinding> textures)
+    {
+        const uint32_t first = static_cast<uint32_t>(m_Textures.size());
+        m_Textures.insert(m_Textures.end(), textures.begin(), textures.end());
+        return first;
+    }
+
+    int32_t RenderQueue::AddTransform(const glm::mat4& model, const glm::mat3& normalMatrix)
+    {
+        m_Transforms.push_back(model);
+        m_NormalMatrices.push_back(normalMatrix);
+        return static_cast<int32_t>(m_Transforms.size() - 1);
+    }
+
+    void RenderQueue::Submit(const DrawPacket& packet)
+    {
+        m_Sorted.emplace_back(packet.key, static_cast<uint32_t>(m_Packets.size()));
+        m_Packets.push_back(packet);
+    }
+
+    void RenderQueue::Sort()
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::sort(m_Sorted.begin(), m_Sorted.end());
+        auto end = std::chrono::high_resolution_clock::now();
+        m_Stats.packets = static_cast<unsigned int>(m_Packets.size());
+        m_Stats.sortMs = std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    const RenderQueue::ProgramUniforms& RenderQueue::UniformsOf(const Shader& shader)
+    {
+        auto it = m_ProgramUniforms.find(shader.serial);
+        if (it == m_ProgramUniforms.end())
+        {
+            ProgramUniforms uniforms;
+            uniforms.model = glGetUniformLocation(shader.ID, "model");
+            uniforms.normalMatrix = glGetUniformLocation(shader.ID, "normalMatrix");
+            uniforms.materialIndex = glGetUniformLocation(shader.ID, "materialIndex");
+            it = m_ProgramUniforms.emplace(shader.serial, uniforms).first;
+        }
+        return it->second;
+    }
+
+    void RenderQueue::Execute(GLStateCache& cache)
+    {
+        int    currentPass = -1;
+        GLuint lastInstanceVao = 0;
+        size_t lastInstanceOffset = SIZE_MAX;
+        int32_t lastMaterialIndex = -1;
+        GLuint  lastMaterialProgram = 0;
+
+        for (const auto& entry : m_Sorted)
+        {
+            const DrawPacket& packet = m_Packets[entry.second];
+
+            // 1. 阶段切换：结束上一阶段，应用新阶段的固定状态
+            const int pass = static_cast<int>(packet.key >> 60);
+            if (pass != currentPass)
+            {
+                if (currentPass >= 0 && m_Passes[currentPass].onEnd)
+                    m_Passes[currentPass].onEnd();
+                currentPass = pass;
+                const PassState& state = m_Passes[pass];
+                cache.DepthFunc(state.depthFunc);
+                cache.DepthMask(state.depthWrite);
+                cache.ColorMask(state.colorWrite);
+                if (state.onBegin)
+                    state.onBegin();
+                ++m_Stats.passes;
+            }
+
+            // 2. 程序、VAO、纹理：与当前状态相同的由缓存跳过
+            const GLuint program = packet.shader->ID;
+            cache.UseProgram(program);
+            cache.BindVertexArray(packet.vao);
+            for (uint32_t t = 0; t < packet.textureCount; ++t)
+            {
+                const TextureBinding& binding = m_Textures[packet.firstTexture + t];
+                cache.BindTexture(binding.unit, binding.target, binding.texture);
+            }
+
+            const ProgramUniforms& uniforms = UniformsOf(*packet.shader);
+            if (packet.transform >= 0)
+            {
+                const glm::mat4& model = m_Transforms[packet.transform];
+                glUniformMatrix4fv(uniforms.model, 1, GL_FALSE, &model[0][0]);
+                if (uniforms.normalMatrix >= 0)
+                    glUniformMatrix3fv(uniforms.normalMatrix, 1, GL_FALSE, &m_NormalMatrices[packet.transform][0][0]);
+            }
+            if (packet.materialIndex >= 0
+                && (packet.materialIndex != lastMaterialIndex || program != lastMaterialProgram))
+            {
+                glUniform1i(uniforms.materialIndex, packet.materialIndex);
+                lastMaterialIndex = packet.materialIndex;
+                lastMaterialProgram = program;
+            }
+
+            // 3. 实例化：把逐实例属性的起点移到本包的数据（同一 VAO、同一偏移时跳过）
+            if (packet.instanceCount > 0 && (packet.vao != lastInstanceVao || packet.instanceOffset != lastInstanceOffset))
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBuffer);
+                for (const InstanceAttribute& attribute : m_InstanceAttributes)
+                {
+                    glVertexAttribPointer(attribute.location, attribute.size, GL_FLOAT, GL_FALSE, attribute.stride,
+                                          (void*)(packet.instanceOffset + attribute.offset));
+                }
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                lastInstanceVao = packet.vao;
+                lastInstanceOffset = packet.instanceOffset;
+            }
+
+            // 4. 绘制
+            if (packet.indexType == 0)
+            {
+                if (packet.instanceCount > 0)
+                    glDrawArraysInstanced(packet.mode, static_cast<GLint>(packet.indexOffset), packet.count, packet.instanceCount);
+                else
+                    glDrawArrays(packet.mode, static_cast<GLint>(packet.indexOffset), packet.count);
+            }
+            else
+            {
+                if (packet.instanceCount > 0)
+                    glDrawElementsInstanced(packet.mode, packet.count, packet.indexType,
+                                            (void*)packet.indexOffset, packet.instanceCount);
+                else
+                    glDrawElements(packet.mode, packet.count, packet.indexType, (void*)packet.indexOffset);
+            }
+        }
+
+        if (currentPass >= 0 && m_Passes[currentPass].onEnd)
+            m_Passes[currentPass].onEnd();
+    }
+
+} // namespace renderer
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <initializer_list>
+#include <utility>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "GLStateCache.h"
+#include "Shader.h"
+
+namespace renderer {
+
+    /**
+     * RenderQueue
+     * -----------
+     * 先收集一帧的绘制包（DrawPacket），按 64 位键排序后统一经 GLStateCache 提交：
+     *
+     *   63..60  pass      渲染阶段（深度预通道 / 不透明 / 天空盒 ...），每个阶段的深度 / 颜色状态由 SetPassState 指定
+     *   59..52  program   着色器程序（按首次出现的顺序编号）
+     *   51..32  material  材质（纹理组合）
+     *   31..0   order     观察深度（非负 float 的位模式保持大小顺序）或调用方给定的序号
+     *
+     * 同一阶段内相同程序、相同材质的包相邻，状态缓存可以跳过重复的程序 / VAO / 纹理切换；
+     * 材质相同时再按由近到远提交。
+     */
+    class RenderQueue {
+    public:
+        static const unsigned int MAX_PASSES = 16;
+
+        /// 一次纹理绑定
+        struct TextureBinding {
+            unsigned int unit;
+            GLenum       target;
+            GLuint       texture;
+        };
+
+        /// 逐实例顶点属性（GL 3.3 没有 baseInstance，每个包按 instanceOffset 重新指定属性起点）
+        struct InstanceAttribute {
+            GLuint  location;
+            GLint   size;
+            GLsizei stride;
+            size_t  offset;
+        };
+
+        struct DrawPacket {
+            uint64_t key = 0;
+            const Shader* shader = nullptr;
+            GLuint   vao = 0;
+            GLenum   mode = GL_TRIANGLES;
+            GLsizei  count = 0;
+            GLenum   indexType = 0;          // 0 表示 glDrawArrays
+            size_t   indexOffset = 0;        // 索引缓冲中的字节偏移；glDrawArrays 时为起始顶点
+            GLsizei  instanceCount = 0;      // 0 表示非实例化
+            size_t   instanceOffset = 0;     // 逐实例属性在实例缓冲中的字节偏移
+            uint32_t firstTexture = 0;       // AddTextures 返回的下标
+            uint32_t textureCount = 0;
+            int32_t  transform = -1;         // AddTransform 返回的下标，设置 model / normalMatrix
+            int32_t  materialIndex = -1;     // >= 0 时设置 uniform materialIndex（bindless 路径）
+        };
+
+        /// 一个渲染阶段开始时应用的固定状态，以及可选的开始 / 结束回调（例如遮挡查询）
+        struct PassState {
+            GLenum depthFunc  = GL_LESS;
+            bool   depthWrite = true;
+            bool   colorWrite = true;
+            std::function<void()> onBegin;
+            std::function<void()> onEnd;
+        };
+
+        struct Stats {
+            unsigned int packets = 0;
+            unsigned int passes  = 0;
+            double       sortMs  = 0.0;
+        };
+
+        void Clear();
+
+        void SetPassState(unsigned int pass, const PassState& state);
+        void SetInstanceLayout(GLuint buffer, std::initializer_list<InstanceAttribute> attributes);
+
+        uint64_t MakeKey(unsigned int pass, const Shader& shader, uint32_t material, uint32_t order);
+        /// 观察深度转为可直接比较的 32 位键（负值按 0 处理）
+        static uint32_t DepthOrder(float viewDepth);
+
+        uint32_t AddTextures(std::initializer_list<TextureBinding> textures);
+        /// 模型矩阵和预先算好的法线矩阵（见 TransformBatch），Execute 时直接上传
+        int32_t  AddTransform(const glm::mat4& model, const glm::mat3& normalMatrix);
+        void     Submit(const DrawPacket& packet);
+
+        void Sort();
+        void Execute(GLStateCache& cache);
+
+        size_t       Size() const { return m_Packets.size(); }
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        struct ProgramUniforms {
+            GLint model = -1;
+            GLint normalMatrix = -1;
+            GLint materialIndex = -1;
+        };
+
+        std::vector<DrawPacket>     m_Packets;
+        std::vector<std::pair<uint64_t, uint32_t>> m_Sorted;   // (键, 包下标)，键相同时保持提交顺序
+        std::vector<TextureBinding> m_Textures;
+        std::vector<glm::mat4>      m_Transforms;
+        std::vector<glm::mat3>      m_NormalMatrices;
+
+        PassState m_Passes[MAX_PASSES];
+        GLuint    m_InstanceBuffer = 0;
+        std::vector<InstanceAttribute> m_InstanceAttributes;
+
+        // 按 Shader::serial 而不是程序 ID 记录：ID 在程序删除后会被新程序复用，旧的 uniform 位置不再有效
+        std::unordered_map<uint32_t, uint32_t>        m_ProgramIds;
+        std::unordered_map<uint32_t, ProgramUniforms> m_ProgramUniforms;
+        Stats m_Stats;
+
+        const ProgramUniforms& UniformsOf(const Shader& shader);
+    };
+
+} // namespace renderer
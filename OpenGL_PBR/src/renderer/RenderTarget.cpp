@@ -0,0 +1,98 @@
+#include "RenderTarget.h"
+#include "GpuMemory.h"
+
+#include <cstdio>
+#include <iostream>
+
+namespace renderer {
+
+    RenderTarget::RenderTarget(int width, int height)
+        : m_Width(width), m_Height(height)
+    {
+        GpuMemory::Scope memoryTag("Render Targets");
+        GLint previousFBO = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+
+        glGenTextures(1, &m_Color);
+        glBindTexture(GL_TEXTURE_2D, m_Color);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glGenRenderbuffers(1, &m_DepthStencil);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_DepthStencil);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &m_Framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_Color, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthStencil);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cerr << "[RenderTarget] Framebuffer is not complete" << std::endl;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFBO));
+    }
+
+    RenderTarget::~RenderTarget()
+    {
+        glDeleteFramebuffers(1, &m_Framebuffer);
+        glDeleteRenderbuffers(1, &m_DepthStencil);
+        glDeleteTextures(1, &m_Color);
+    }
+
+    void RenderTarget::Bind() const
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+        glViewport(0, 0, m_Width, m_Height);
+    }
+
+    void RenderTarget::ReadPixels(std::vector<unsigned char>& rgba) const
+    {
+        rgba.resize(static_cast<size_t>(m_Width) * m_Height * 4);
+
+        GLint previousFBO = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFBO));
+    }
+
+    bool RenderTarget::SavePPM(const std::string& path) const
+    {
+        std::vector<unsigned char> rgba;
+        ReadPixels(rgba);
+        return WritePPM(path, rgba, m_Width, m_Height);
+    }
+
+    bool RenderTarget::WritePPM(const std::string& path, const std::vector<unsigned char>& rgba, int width, int height)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+        {
+            std::cerr << "[RenderTarget] Failed to open " << path << std::endl;
+            return false;
+        }
+        std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+        std::vector<unsigned char> row(static_cast<size_t>(width) * 3);
+        for (int y = height - 1; y >= 0; --y)
+        {
+            const unsigned char* src = rgba.data() + static_cast<size_t>(y) * width * 4;
+            for (int x = 0; x < width; ++x)
+            {
+                row[x * 3 + 0] = src[x * 4 + 0];
+                row[x * 3 + 1] = src[x * 4 + 1];
+                row[x * 3 + 2] = src[x * 4 + 2];
+            }
+            std::fwrite(row.data(), 1, row.size(), file);
+        }
+        const bool ok = std::fclose(file) == 0;
+        std::cout << "[RenderTarget] Wrote " << path << std::endl;
+        return ok;
+    }
+
+} // namespace renderer
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace renderer {
+
+    /**
+     * RenderTarget
+     * ------------
+     * 离屏渲染目标：RGBA8 颜色纹理 + 24 位深度 / 8 位模板渲染缓冲组成的 FBO。
+     * 无窗口模式下代替默认帧缓冲，场景渲染前 Bind()，结束后可读回像素检查结果。
+     */
+    class RenderTarget {
+    public:
+        RenderTarget(int width, int height);
+        ~RenderTarget();
+
+        RenderTarget(const RenderTarget&) = delete;
+        RenderTarget& operator=(const RenderTarget&) = delete;
+
+        /// 绑定为当前帧缓冲并设置视口
+        void Bind() const;
+
+        /// 读回颜色缓冲（RGBA8，自下而上的行顺序），会等待 GPU 完成
+        void ReadPixels(std::vector<unsigned char>& rgba) const;
+        /// 读回颜色缓冲并写成二进制 PPM（P6，上下翻转为自上而下）
+        bool SavePPM(const std::string& path) const;
+
+        /// 把 RGBA8 像素（自下而上的行顺序）写成二进制 PPM
+        static bool WritePPM(const std::string& path, const std::vector<unsigned char>& rgba, int width, int height);
+
+        GLuint GetFramebuffer() const { return m_Framebuffer; }
+        GLuint GetColorTexture() const { return m_Color; }
+        int    GetWidth() const { return m_Width; }
+        int    GetHeight() const { return m_Height; }
+
+    private:
+        int    m_Width;
+        int    m_Height;
+        GLuint m_Framebuffer = 0;
+        GLuint m_Color = 0;
+        GLuint m_DepthStencil = 0;
+    };
+
+} // namespace renderer
@@ -9,12 +9,20 @@
 
 namespace renderer {
 
-    /// 一个简单的光源结构体，包含位置、颜色、强度
+    enum class LightType { Point = 0, Spot = 1, Directional = 2 };
+
+    /// 一个简单的光源结构体，包含位置、颜色、强度；辐射度为 Color * Intensity
     struct Light {
         glm::vec3 Position;
         glm::vec3 Color;
         float     Intensity;
 
+        LightType Type      = LightType::Point;
+        glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f);  // 聚光灯 / 方向光的照射方向
+        float     Range     = 0.0f;    // 影响半径；<= 0 时由 LightManager 按亮度自动计算
+        float     InnerCone = 20.0f;   // 聚光灯内 / 外半角（度），之间平滑衰减
+        float     OuterCone = 30.0f;
+
         Light()
             : Position(glm::vec3(0.0f)),
             Color(glm::vec3(1.0f)),
@@ -1,5 +1,54 @@
 #include "shader.h"
 
+namespace {
+
+    /// 展开 #include "相对路径"（相对于当前文件所在目录），被包含的文件可以继续 #include
+    std::string ExpandIncludes(const std::string& code, const std::string& path, int depth = 0)
+    {
+        if (depth > 8)
+        {
+            std::cout << "ERROR::SHADER::INCLUDE_TOO_DEEP: " << path << std::endl;
+            return code;
+        }
+
+        const size_t slash = path.find_last_of("/\\");
+        const std::string directory = slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+
+        std::stringstream input(code), output;
+        std::string line;
+        while (std::getline(input, line))
+        {
+            const size_t directive = line.find_first_not_of(" \t");
+            if (directive == std::string::npos || line.compare(directive, 8, "#include") != 0)
+            {
+                output << line << '\n';
+                continue;
+            }
+
+            const size_t open = line.find('"', directive);
+            const size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+            if (close == std::string::npos)
+            {
+                std::cout << "ERROR::SHADER::INVALID_INCLUDE: " << line << std::endl;
+                continue;
+            }
+
+            const std::string includePath = directory + line.substr(open + 1, close - open - 1);
+            std::ifstream file(includePath);
+            if (!file)
+            {
+                std::cout << "ERROR::SHADER::INCLUDE_NOT_FOUND: " << includePath << std::endl;
+                continue;
+            }
+            std::stringstream included;
+            included << file.rdbuf();
+            output << ExpandIncludes(included.str(), includePath, depth + 1);
+        }
+        return output.str();
+    }
+
+} // namespace
+
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath)
 {
@@ -22,8 +71,8 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geo
         vShaderFile.close();
         fShaderFile.close();
 
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+        vertexCode = ExpandIncludes(vShaderStream.str(), vertexPath);
+        fragmentCode = ExpandIncludes(fShaderStream.str(), fragmentPath);
 
         if (geometryPath != nullptr)
         {
@@ -31,7 +80,7 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geo
             std::stringstream gShaderStream;
             gShaderStream << gShaderFile.rdbuf();
             gShaderFile.close();
-            geometryCode = gShaderStream.str();
+            geometryCode = ExpandIncludes(gShaderStream.str(), geometryPath);
         }
     }
     catch (std::ifstream::failure& e)
@@ -39,6 +88,8 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geo
         std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
     }
 
+    bindless = fragmentCode.find("GL_ARB_bindless_texture") != std::string::npos;
+
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
@@ -63,6 +114,9 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geo
         checkCompileErrors(geometry, "GEOMETRY");
     }
 
+    // 着色器只在主线程创建，普通计数器即可
+    static uint32_t s_NextSerial = 0;
+    serial = ++s_NextSerial;
     ID = glCreateProgram();
     glAttachShader(ID, vertex);
     glAttachShader(ID, fragment);
@@ -82,64 +136,64 @@ void Shader::use()
     glUseProgram(ID);
 }
 
-void Shader::setBool(const std::string& name, bool value) const
+void Shader::setBool(const char* name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    glUniform1i(glGetUniformLocation(ID, name), (int)value);
 }
 
-void Shader::setInt(const std::string& name, int value) const
+void Shader::setInt(const char* name, int value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1i(glGetUniformLocation(ID, name), value);
 }
 
-void Shader::setFloat(const std::string& name, float value) const
+void Shader::setFloat(const char* name, float value) const
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1f(glGetUniformLocation(ID, name), value);
 }
 
-void Shader::setVec2(const std::string& name, const glm::vec2& value) const
+void Shader::setVec2(const char* name, const glm::vec2& value) const
 {
-    glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    glUniform2fv(glGetUniformLocation(ID, name), 1, &value[0]);
 }
 
-void Shader::setVec2(const std::string& name, float x, float y) const
+void Shader::setVec2(const char* name, float x, float y) const
 {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+    glUniform2f(glGetUniformLocation(ID, name), x, y);
 }
 
-void Shader::setVec3(const std::string& name, const glm::vec3& value) const
+void Shader::setVec3(const char* name, const glm::vec3& value) const
 {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    glUniform3fv(glGetUniformLocation(ID, name), 1, &value[0]);
 }
 
-void Shader::setVec3(const std::string& name, float x, float y, float z) const
+void Shader::setVec3(const char* name, float x, float y, float z) const
 {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+    glUniform3f(glGetUniformLocation(ID, name), x, y, z);
 }
 
-void Shader::setVec4(const std::string& name, const glm::vec4& value) const
+void Shader::setVec4(const char* name, const glm::vec4& value) const
 {
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+    glUniform4fv(glGetUniformLocation(ID, name), 1, &value[0]);
 }
 
-void Shader::setVec4(const std::string& name, float x, float y, float z, float w)
+void Shader::setVec4(const char* name, float x, float y, float z, float w)
 {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+    glUniform4f(glGetUniformLocation(ID, name), x, y, z, w);
 }
 
-void Shader::setMat2(const std::string& name, const glm::mat2& mat) const
+void Shader::setMat2(const char* name, const glm::mat2& mat) const
 {
-    glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniformMatrix2fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setMat3(const std::string& name, const glm::mat3& mat) const
+void Shader::setMat3(const char* name, const glm::mat3& mat) const
 {
-    glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniformMatrix3fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& mat) const
+void Shader::setMat4(const char* name, const glm::mat4& mat) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
 }
 
 void Shader::checkCompileErrors(GLuint shader, std::string type)
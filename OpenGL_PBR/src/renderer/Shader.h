@@ -10,27 +10,46 @@
 #include <glm/glm.hpp>
 
 #include <string>
+#include <cstdint>
 
 class Shader
 {
 public:
     unsigned int ID;
+    /// 进程内唯一的编号：程序删除后 GL 会复用 ID，编号不会，按程序缓存数据时用它作键
+    uint32_t serial;
+    /// 片段着色器启用了 GL_ARB_bindless_texture（sampler 可直接用 64 位句柄赋值）
+    bool bindless = false;
 
     Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
     void use();
 
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec2(const std::string& name, const glm::vec2& value) const;
-    void setVec2(const std::string& name, float x, float y) const;
-    void setVec3(const std::string& name, const glm::vec3& value) const;
-    void setVec3(const std::string& name, float x, float y, float z) const;
-    void setVec4(const std::string& name, const glm::vec4& value) const;
-    void setVec4(const std::string& name, float x, float y, float z, float w);
-    void setMat2(const std::string& name, const glm::mat2& mat) const;
-    void setMat3(const std::string& name, const glm::mat3& mat) const;
-    void setMat4(const std::string& name, const glm::mat4& mat) const;
+    // 名字用 const char*：字符串常量直接传入，不构造临时 std::string（超过短字符串长度的名字每次都要分配堆内存）
+    void setBool(const char* name, bool value) const;
+    void setInt(const char* name, int value) const;
+    void setFloat(const char* name, float value) const;
+    void setVec2(const char* name, const glm::vec2& value) const;
+    void setVec2(const char* name, float x, float y) const;
+    void setVec3(const char* name, const glm::vec3& value) const;
+    void setVec3(const char* name, float x, float y, float z) const;
+    void setVec4(const char* name, const glm::vec4& value) const;
+    void setVec4(const char* name, float x, float y, float z, float w);
+    void setMat2(const char* name, const glm::mat2& mat) const;
+    void setMat3(const char* name, const glm::mat3& mat) const;
+    void setMat4(const char* name, const glm::mat4& mat) const;
+
+    void setBool(const std::string& name, bool value) const { setBool(name.c_str(), value); }
+    void setInt(const std::string& name, int value) const { setInt(name.c_str(), value); }
+    void setFloat(const std::string& name, float value) const { setFloat(name.c_str(), value); }
+    void setVec2(const std::string& name, const glm::vec2& value) const { setVec2(name.c_str(), value); }
+    void setVec2(const std::string& name, float x, float y) const { setVec2(name.c_str(), x, y); }
+    void setVec3(const std::string& name, const glm::vec3& value) const { setVec3(name.c_str(), value); }
+    void setVec3(const std::string& name, float x, float y, float z) const { setVec3(name.c_str(), x, y, z); }
+    void setVec4(const std::string& name, const glm::vec4& value) const { setVec4(name.c_str(), value); }
+    void setVec4(const std::string& name, float x, float y, float z, float w) { setVec4(name.c_str(), x, y, z, w); }
+    void setMat2(const std::string& name, const glm::mat2& mat) const { setMat2(name.c_str(), mat); }
+    void setMat3(const std::string& name, const glm::mat3& mat) const { setMat3(name.c_str(), mat); }
+    void setMat4(const std::string& name, const glm::mat4& mat) const { setMat4(name.c_str(), mat); }
 
 private:
     void checkCompileErrors(GLuint shader, std::string type);
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+/// 包围球：用于 LOD 选择时计算物体在屏幕上的投影尺寸，以及视锥剔除
+struct BoundingSphere {
+    glm::vec3 Center = glm::vec3(0.0f);
+    float     Radius = 0.0f;
+
+    /// 从一组顶点位置计算包围球（AABB 中心 + 最远点距离，足够紧且只需两次遍历）
+    /// positions 指向第一个顶点的位置，stride 为相邻两个顶点之间的字节跨度
+    static BoundingSphere FromPoints(const float* positions, size_t count, size_t stride)
+    {
+        BoundingSphere s;
+        if (count == 0) return s;
+
+        const unsigned char* base = reinterpret_cast<const unsigned char*>(positions);
+        glm::vec3 mn(positions[0], positions[1], positions[2]);
+        glm::vec3 mx = mn;
+        for (size_t i = 1; i < count; ++i) {
+            const float* p = reinterpret_cast<const float*>(base + i * stride);
+            mn = glm::min(mn, glm::vec3(p[0], p[1], p[2]));
+            mx = glm::max(mx, glm::vec3(p[0], p[1], p[2]));
+        }
+        s.Center = (mn + mx) * 0.5f;
+
+        float r2 = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            const float* p = reinterpret_cast<const float*>(base + i * stride);
+            glm::vec3 d = glm::vec3(p[0], p[1], p[2]) - s.Center;
+            r2 = std::max(r2, glm::dot(d, d));
+        }
+        s.Radius = std::sqrt(r2);
+        return s;
+    }
+};
+
+/// 轴对齐包围盒：对细长或扁平物体比包围球更紧，视锥剔除时与包围球取较紧者
+struct AABB {
+    glm::vec3 Min = glm::vec3(0.0f);
+    glm::vec3 Max = glm::vec3(0.0f);
+
+    glm::vec3 Center()  const { return (Min + Max) * 0.5f; }
+    glm::vec3 Extents() const { return (Max - Min) * 0.5f; }
+
+    static AABB FromPoints(const float* positions, size_t count, size_t stride)
+    {
+        AABB box;
+        if (count == 0) return box;
+
+        const unsigned char* base = reinterpret_cast<const unsigned char*>(positions);
+        box.Min = box.Max = glm::vec3(positions[0], positions[1], positions[2]);
+        for (size_t i = 1; i < count; ++i) {
+            const float* p = reinterpret_cast<const float*>(base + i * stride);
+            box.Min = glm::min(box.Min, glm::vec3(p[0], p[1], p[2]));
+            box.Max = glm::max(box.Max, glm::vec3(p[0], p[1], p[2]));
+        }
+        return box;
+    }
+
+    /// 经仿射变换后的包围盒（Arvo：|M| * extents），结果仍然保守
+    AABB Transformed(const glm::mat4& m) const
+    {
+        glm::vec3 c = glm::vec3(m * glm::vec4(Center(), 1.0f));
+        glm::vec3 e = Extents();
+        glm::vec3 r(
+            std::fabs(m[0][0]) * e.x + std::fabs(m[1][0]) * e.y + std::fabs(m[2][0]) * e.z,
+            std::fabs(m[0][1]) * e.x + std::fabs(m[1][1]) * e.y + std::fabs(m[2][1]) * e.z,
+            std::fabs(m[0][2]) * e.x + std::fabs(m[1][2]) * e.y + std::fabs(m[2][2]) * e.z);
+        AABB box;
+        box.Min = c - r;
+        box.Max = c + r;
+        return box;
+    }
+};
@@ -0,0 +1,430 @@
+#include "Bvh.h"
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+    const uint32_t INVALID_NODE = 0xFFFFFFFFu;
+
+    /// 包围盒表面积的一半（SAH 只需要相对大小）
+    inline float HalfArea(const glm::vec3& mn, const glm::vec3& mx)
+    {
+        glm::vec3 e = mx - mn;
+        if (e.x < 0.0f || e.y < 0.0f || e.z < 0.0f) return 0.0f;
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+
+    struct Bin {
+        glm::vec3 min = glm::vec3(1e30f);
+        glm::vec3 max = glm::vec3(-1e30f);
+        uint32_t  count = 0;
+    };
+
+    /// 射线与 AABB 的 slab 测试，返回进入距离（未命中时返回 1e30）
+    inline float IntersectAABB(const glm::vec3& origin, const glm::vec3& invDir,
+                               const glm::vec3& mn, const glm::vec3& mx, float maxT)
+    {
+        float tx1 = (mn.x - origin.x) * invDir.x, tx2 = (mx.x - origin.x) * invDir.x;
+        float tmin = std::min(tx1, tx2), tmax = std::max(tx1, tx2);
+        float ty1 = (mn.y - origin.y) * invDir.y, ty2 = (mx.y - origin.y) * invDir.y;
+        tmin = std::max(tmin, std::min(ty1, ty2)); tmax = std::min(tmax, std::max(ty1, ty2));
+        float tz1 = (mn.z - origin.z) * invDir.z, tz2 = (mx.z - origin.z) * invDir.z;
+        tmin = std::max(tmin, std::min(tz1, tz2)); tmax = std::min(tmax, std::max(tz1, tz2));
+        if (tmax >= tmin && tmax > 0.0f && tmin < maxT)
+            return std::max(tmin, 0.0f);
+        return 1e30f;
+    }
+
+    /// 包围盒与 mask 中平面的测试：完全在某平面外侧返回 false；
+    /// 完全在内侧的平面从 mask 中清除，子节点不再测试
+    inline bool BoxInside(const Frustum& frustum, const glm::vec3& mn, const glm::vec3& mx, unsigned int& mask)
+    {
+        const glm::vec3 c = (mn + mx) * 0.5f;
+        const glm::vec3 ext = (mx - mn) * 0.5f;
+        for (int p = 0; p < Frustum::Count; ++p) {
+            if (!(mask & (1u << p))) continue;
+            const glm::vec4& pl = frustum.planes[p];
+            float d = pl.x * c.x + pl.y * c.y + pl.z * c.z + pl.w;
+            float r = std::fabs(pl.x) * ext.x + std::fabs(pl.y) * ext.y + std::fabs(pl.z) * ext.z;
+            if (d + r < 0.0f) return false;
+            if (d - r >= 0.0f) mask &= ~(1u << p);
+        }
+        return true;
+    }
+
+    inline glm::vec3 SafeInverse(const glm::vec3& d)
+    {
+        auto inv = [](float v) { return std::fabs(v) > 1e-20f ? 1.0f / v : (v < 0.0f ? -1e30f : 1e30f); };
+        return glm::vec3(inv(d.x), inv(d.y), inv(d.z));
+    }
+
+} // namespace
+
+void Bvh::Clear()
+{
+    m_Nodes.clear();
+    m_Parents.clear();
+    m_Objects.clear();
+    m_ObjectLeaf.clear();
+    m_ObjectBounds.clear();
+}
+
+void Bvh::Build(const std::vector<AABB>& objectBounds)
+{
+    Clear();
+    if (objectBounds.empty()) return;
+
+    const uint32_t n = static_cast<uint32_t>(objectBounds.size());
+    m_ObjectBounds = objectBounds;
+    m_Objects.resize(n);
+    m_ObjectLeaf.assign(n, 0);
+    std::vector<glm::vec3> centroids(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        m_Objects[i] = i;
+        centroids[i] = objectBounds[i].Center();
+    }
+
+    m_Nodes.reserve(2 * static_cast<size_t>(n));
+    m_Parents.reserve(2 * static_cast<size_t>(n));
+    Node root;
+    root.leftOrFirst = 0;
+    root.count = n;
+    m_Nodes.push_back(root);
+    m_Parents.push_back(INVALID_NODE);
+    UpdateNodeBounds(0);
+
+    // 显式栈代替递归；深度限制在 MAX_DEPTH 以内，查询时可以使用定长栈
+    std::vector<std::pair<uint32_t, unsigned int>> stack;
+    stack.push_back({ 0u, 1u });
+    while (!stack.empty()) {
+        auto [nodeIndex, depth] = stack.back();
+        stack.pop_back();
+        if (depth >= MAX_DEPTH) continue;
+        size_t before = m_Nodes.size();
+        Subdivide(nodeIndex, centroids);
+        if (m_Nodes.size() != before) {
+            stack.push_back({ m_Nodes[nodeIndex].leftOrFirst, depth + 1 });
+            stack.push_back({ m_Nodes[nodeIndex].leftOrFirst + 1, depth + 1 });
+        }
+    }
+
+    for (uint32_t i = 0; i < m_Nodes.size(); ++i) {
+        const Node& node = m_Nodes[i];
+        if (!node.IsLeaf()) continue;
+        for (uint32_t k = 0; k < node.count; ++k)
+            m_ObjectLeaf[m_Objects[node.leftOrFirst + k]] = i;
+    }
+}
+
+void Bvh::UpdateNodeBounds(uint32_t nodeIndex)
+{
+    Node& node = m_Nodes[nodeIndex];
+    if (node.IsLeaf()) {
+        node.min = glm::vec3(1e30f);
+        node.max = glm::vec3(-1e30f);
+        for (uint32_t k = 0; k < node.count; ++k) {
+            const AABB& b = m_ObjectBounds[m_Objects[node.leftOrFirst + k]];
+            node.min = glm::min(node.min, b.Min);
+            node.max = glm::max(node.max, b.Max);
+        }
+    }
+    else {
+        const Node& l = m_Nodes[node.leftOrFirst];
+        const Node& r = m_Nodes[node.leftOrFirst + 1];
+        node.min = glm::min(l.min, r.min);
+        node.max = glm::max(l.max, r.max);
+    }
+}
+
+void Bvh::Subdivide(uint32_t nodeIndex, const std::vector<glm::vec3>& centroids)
+{
+    const uint32_t first = m_Nodes[nodeIndex].leftOrFirst;
+    const uint32_t count = m_Nodes[nodeIndex].count;
+    if (count <= MAX_LEAF_SIZE) return;
+
+    glm::vec3 cmin(1e30f), cmax(-1e30f);
+    for (uint32_t k = 0; k < count; ++k) {
+        const glm::vec3& c = centroids[m_Objects[first + k]];
+        cmin = glm::min(cmin, c);
+        cmax = glm::max(cmax, c);
+    }
+
+    // 在三个轴上分箱，选 SAH 代价最小的切分
+    int   bestAxis  = -1;
+    int   bestSplit = 0;
+    float bestCost  = 1e30f;
+    for (int axis = 0; axis < 3; ++axis) {
+        float extent = cmax[axis] - cmin[axis];
+        if (extent <= 0.0f) continue;
+
+        Bin bins[SAH_BINS];
+        const float scale = SAH_BINS / extent;
+        for (uint32_t k = 0; k < count; ++k) {
+            uint32_t obj = m_Objects[first + k];
+            int b = std::min(static_cast<int>(SAH_BINS) - 1, static_cast<int>((centroids[obj][axis] - cmin[axis]) * scale));
+            bins[b].count++;
+            bins[b].min = glm::min(bins[b].min, m_ObjectBounds[obj].Min);
+            bins[b].max = glm::max(bins[b].max, m_ObjectBounds[obj].Max);
+        }
+
+        // 从左右两侧扫描，得到每个切分位置两边的面积和数量
+        float    leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+        uint32_t leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+        glm::vec3 lmin(1e30f), lmax(-1e30f), rmin(1e30f), rmax(-1e30f);
+        uint32_t lsum = 0, rsum = 0;
+        for (unsigned int i = 0; i < SAH_BINS - 1; ++i) {
+            lsum += bins[i].count;
+            leftCount[i] = lsum;
+            lmin = glm::min(lmin, bins[i].min); lmax = glm::max(lmax, bins[i].max);
+            leftArea[i] = HalfArea(lmin, lmax);
+
+            const unsigned int j = SAH_BINS - 1 - i;
+            rsum += bins[j].count;
+            rightCount[j - 1] = rsum;
+            rmin = glm::min(rmin, bins[j].min); rmax = glm::max(rmax, bins[j].max);
+            rightArea[j - 1] = HalfArea(rmin, rmax);
+        }
+        for (unsigned int i = 0; i < SAH_BINS - 1; ++i) {
+            if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+            float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+            if (cost < bestCost) {
+                bestCost  = cost;
+                bestAxis  = axis;
+                bestSplit = static_cast<int>(i);
+            }
+        }
+    }
+
+    // 无法切分（所有中心重合）或切分不比叶子划算时保留为叶子
+    const Node& node = m_Nodes[nodeIndex];
+    const float leafCost = count * HalfArea(node.min, node.max);
+    if (bestAxis < 0 || bestCost >= leafCost) return;
+
+    const float scale = SAH_BINS / (cmax[bestAxis] - cmin[bestAxis]);
+    auto goesLeft = [&](uint32_t obj) {
+        int b = std::min(static_cast<int>(SAH_BINS) - 1, static_cast<int>((centroids[obj][bestAxis] - cmin[bestAxis]) * scale));
+        return b <= bestSplit;
+    };
+    uint32_t* begin = m_Objects.data() + first;
+    uint32_t* mid = std::partition(begin, begin + count, goesLeft);
+    const uint32_t leftCountFinal = static_cast<uint32_t>(mid - begin);
+    if (leftCountFinal == 0 || leftCountFinal == count) return;
+
+    const uint32_t leftIndex = static_cast<uint32_t>(m_Nodes.size());
+    Node left, right;
+    left.leftOrFirst  = first;
+    left.count        = leftCountFinal;
+    right.leftOrFirst = first + leftCountFinal;
+    right.count       = count - leftCountFinal;
+    m_Nodes.push_back(left);
+    m_Nodes.push_back(right);
+    m_Parents.push_back(nodeIndex);
+    m_Parents.push_back(nodeIndex);
+
+    m_Nodes[nodeIndex].leftOrFirst = leftIndex;
+    m_Nodes[nodeIndex].count = 0;
+    UpdateNodeBounds(leftIndex);
+    UpdateNodeBounds(leftIndex + 1);
+}
+
+void Bvh::UpdateObject(uint32_t object, const AABB& bounds)
+{
+    if (object >= m_ObjectBounds.size()) return;
+    m_ObjectBounds[object] = bounds;
+
+    uint32_t nodeIndex = m_ObjectLeaf[object];
+    while (nodeIndex != INVALID_NODE) {
+        const glm::vec3 oldMin = m_Nodes[nodeIndex].min;
+        const glm::vec3 oldMax = m_Nodes[nodeIndex].max;
+        UpdateNodeBounds(nodeIndex);
+        // 包围盒没有变化时，祖先节点也不会变
+        if (m_Nodes[nodeIndex].min == oldMin && m_Nodes[nodeIndex].max == oldMax)
+            break;
+        nodeIndex = m_Parents[nodeIndex];
+    }
+}
+
+void Bvh::Refit(const std::vector<AABB>& objectBounds)
+{
+    if (objectBounds.size() != m_ObjectBounds.size()) {
+        Build(objectBounds);
+        return;
+    }
+    m_ObjectBounds = objectBounds;
+
+    // 孩子总是在父节点之后创建，倒序遍历即可保证先更新孩子
+    for (size_t i = m_Nodes.size(); i-- > 0;)
+        UpdateNodeBounds(static_cast<uint32_t>(i));
+}
+
+unsigned int Bvh::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& outObjects) const
+{
+    outObjects.clear();
+    if (m_Nodes.empty()) return 0;
+
+    const unsigned int ALL_PLANES = (1u << Frustum::Count) - 1;
+    struct Entry { uint32_t node; unsigned int mask; };
+    Entry stack[MAX_DEPTH + 1];
+    int sp = 0;
+    stack[sp++] = { 0, ALL_PLANES };
+    unsigned int visited = 0;
+
+    while (sp > 0) {
+        Entry e = stack[--sp];
+        const Node& node = m_Nodes[e.node];
+        ++visited;
+
+        // 只测试父节点尚未完全通过的平面
+        unsigned int mask = e.mask;
+        if (mask && !BoxInside(frustum, node.min, node.max, mask))
+            continue;
+
+        if (node.IsLeaf()) {
+            for (uint32_t k = 0; k < node.count; ++k) {
+                uint32_t obj = m_Objects[node.leftOrFirst + k];
+                unsigned int objMask = mask;
+                if (objMask && !BoxInside(frustum, m_ObjectBounds[obj].Min, m_ObjectBounds[obj].Max, objMask))
+                    continue;
+                outObjects.push_back(obj);
+            }
+        }
+        else {
+            stack[sp++] = { node.leftOrFirst + 1, mask };
+            stack[sp++] = { node.leftOrFirst, mask };
+        }
+    }
+    return visited;
+}
+
+Bvh::RayHit Bvh::Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxT, const RayObjectTest& test) const
+{
+    RayHit hit;
+    if (m_Nodes.empty()) return hit;
+
+    const glm::vec3 invDir = SafeInverse(dir);
+    float closest = maxT;
+
+    uint32_t stack[MAX_DEPTH + 1];
+    int sp = 0;
+    if (IntersectAABB(origin, invDir, m_Nodes[0].min, m_Nodes[0].max, closest) >= 1e30f)
+        return hit;
+    stack[sp++] = 0;
+
+    while (sp > 0) {
+        const Node& node = m_Nodes[stack[--sp]];
+        if (node.IsLeaf()) {
+            for (uint32_t k = 0; k < node.count; ++k) {
+                uint32_t obj = m_Objects[node.leftOrFirst + k];
+                float t = 0.0f;
+                bool hitObject;
+                if (test) {
+                    hitObject = test(obj, origin, dir, t);
+                }
+                else {
+                    t = IntersectAABB(origin, invDir, m_ObjectBounds[obj].Min, m_ObjectBounds[obj].Max, closest);
+                    hitObject = t < 1e30f;
+                }
+                if (hitObject && t >= 0.0f && t < closest) {
+                    closest = t;
+                    hit.object = static_cast<int>(obj);
+                    hit.t = t;
+                }
+            }
+            continue;
+        }
+
+        // 先访问较近的孩子：后入栈先出
+        uint32_t a = node.leftOrFirst, b = node.leftOrFirst + 1;
+        float ta = IntersectAABB(origin, invDir, m_Nodes[a].min, m_Nodes[a].max, closest);
+        float tb = IntersectAABB(origin, invDir, m_Nodes[b].min, m_Nodes[b].max, closest);
+        if (ta > tb) { std::swap(a, b); std::swap(ta, tb); }
+        if (tb < 1e30f) stack[sp++] = b;
+        if (ta < 1e30f) stack[sp++] = a;
+    }
+    return hit;
+}
+
+float Bvh::SahCost() const
+{
+    if (m_Nodes.empty()) return 0.0f;
+    const float rootArea = HalfArea(m_Nodes[0].min, m_Nodes[0].max);
+    if (rootArea <= 0.0f) return 0.0f;
+
+    float cost = 0.0f;
+    for (const Node& node : m_Nodes) {
+        float area = HalfArea(node.min, node.max);
+        cost += node.IsLeaf() ? area * node.count : area;
+    }
+    return cost / rootArea;
+}
+
+Bvh::BenchmarkResult Bvh::Benchmark(size_t objectCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    BenchmarkResult result;
+    result.objects = objectCount;
+    if (objectCount == 0) return result;
+
+    // 场景尺寸随物体数增长，保持大致恒定的密度
+    const float half = 10.0f * std::cbrt(static_cast<float>(objectCount));
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos(-half, half);
+    std::uniform_real_distribution<float> size(0.2f, 1.0f);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+
+    std::vector<AABB> bounds(objectCount);
+    for (auto& b : bounds) {
+        glm::vec3 c(pos(rng), pos(rng), pos(rng));
+        glm::vec3 e(size(rng));
+        b.Min = c - e;
+        b.Max = c + e;
+    }
+
+    Bvh bvh;
+    auto t0 = Clock::now();
+    bvh.Build(bounds);
+    auto t1 = Clock::now();
+    result.buildMs = ms(t0, t1);
+
+    // 模拟所有物体小幅移动后整体 refit
+    for (auto& b : bounds) {
+        glm::vec3 d(jitter(rng), jitter(rng), jitter(rng));
+        b.Min += d;
+        b.Max += d;
+    }
+    t0 = Clock::now();
+    bvh.Refit(bounds);
+    t1 = Clock::now();
+    result.refitMs = ms(t0, t1);
+
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, half);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = Frustum::FromMatrix(projection * view);
+    std::vector<uint32_t> visible;
+    visible.reserve(objectCount);
+    t0 = Clock::now();
+    bvh.QueryFrustum(frustum, visible);
+    t1 = Clock::now();
+    result.frustumMs = ms(t0, t1);
+
+    const int rays = 1000;
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    t0 = Clock::now();
+    for (int i = 0; i < rays; ++i) {
+        glm::vec3 dir(unit(rng), unit(rng), unit(rng));
+        if (glm::length(dir) < 1e-3f) dir = glm::vec3(0.0f, 0.0f, -1.0f);
+        bvh.Raycast(glm::vec3(0.0f), glm::normalize(dir));
+    }
+    t1 = Clock::now();
+    result.rayMs = ms(t0, t1) / rays;
+    return result;
+}
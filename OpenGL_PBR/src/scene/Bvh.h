@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#include <glm/glm.hpp>
+
+#include "Bounds.h"
+#include "Frustum.h"
+
+/**
+ * Bvh
+ * ---
+ * 建立在物体包围盒之上的层次包围体（每个叶子最多 MAX_LEAF_SIZE 个物体）。
+ *  - Build：分箱 SAH（Surface Area Heuristic）自顶向下构建
+ *  - UpdateObject + Refit：物体移动后只更新包围盒，不改变树结构
+ *  - QueryFrustum：视锥剔除，完全在视锥内的子树不再逐平面测试
+ *  - Raycast：射线拾取，按近到远遍历子节点并用当前最近距离剪枝
+ *
+ * 物体用构建时的下标（0..N-1）标识。大量移动后树的质量会下降，可以重新 Build。
+ */
+class Bvh {
+public:
+    static const unsigned int MAX_LEAF_SIZE = 4;
+    static const unsigned int SAH_BINS      = 12;
+    static const unsigned int MAX_DEPTH     = 64;   // 超过该深度的节点直接作为叶子，保证遍历栈有界
+
+    struct Node {
+        glm::vec3 min;
+        uint32_t  leftOrFirst = 0; // 内部节点：左孩子下标（右孩子 = 左 + 1）；叶子：第一个物体在 m_Objects 中的位置
+        glm::vec3 max;
+        uint32_t  count = 0;       // 叶子中的物体数，0 表示内部节点
+        bool IsLeaf() const { return count > 0; }
+    };
+
+    struct RayHit {
+        int   object = -1;   // 命中的物体，-1 表示未命中
+        float t      = 0.0f; // 沿射线的距离（direction 为单位向量时即世界距离）
+    };
+
+    /// 精确求交回调：返回 true 表示命中，并写入 t。未提供时用物体包围盒求交
+    using RayObjectTest = std::function<bool(uint32_t object, const glm::vec3& origin, const glm::vec3& dir, float& t)>;
+
+    void Build(const std::vector<AABB>& objectBounds);
+    void Clear();
+
+    /// 修改一个物体的包围盒，并沿父节点向上更新（结构不变）
+    void UpdateObject(uint32_t object, const AABB& bounds);
+    /// 用新的包围盒数组整体自底向上重算所有节点（物体数量必须与构建时一致）
+    void Refit(const std::vector<AABB>& objectBounds);
+
+    /// 收集与视锥相交的物体，返回访问的节点数
+    unsigned int QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& outObjects) const;
+
+    /// 射线最近命中
+    RayHit Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxT = 1e30f,
+                   const RayObjectTest& test = RayObjectTest()) const;
+
+    size_t ObjectCount() const { return m_ObjectBounds.size(); }
+    size_t NodeCount()   const { return m_Nodes.size(); }
+    bool   Empty()       const { return m_Nodes.empty(); }
+
+    /// 整棵树的 SAH 代价（相对根节点面积归一化），用于判断是否需要重建
+    float SahCost() const;
+
+    struct BenchmarkResult {
+        size_t objects   = 0;
+        double buildMs   = 0.0;
+        double refitMs   = 0.0;
+        double frustumMs = 0.0;  // 一次视锥查询
+        double rayMs     = 0.0;  // 一次射线查询（多条取平均）
+    };
+
+    /// 随机生成 objectCount 个物体，测量构建 / 整体 refit / 查询耗时
+    static BenchmarkResult Benchmark(size_t objectCount);
+
+private:
+    std::vector<Node>     m_Nodes;
+    std::vector<uint32_t> m_Parents;      // 每个节点的父节点，根为 UINT32_MAX
+    std::vector<uint32_t> m_Objects;      // 叶子引用的物体下标（按叶子连续排列）
+    std::vector<uint32_t> m_ObjectLeaf;   // 物体 -> 所在叶子
+    std::vector<AABB>     m_ObjectBounds;
+
+    void Subdivide(uint32_t nodeIndex, const std::vector<glm::vec3>& centroids);
+    void UpdateNodeBounds(uint32_t nodeIndex);
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "EntityRegistry.h"
+
+/**
+ * ComponentPool
+ * -------------
+ * 一种组件的稠密存储（sparse set）：
+ *  - 组件数据和所属实体各放一个连续数组，下标 [0, Size()) 之间没有空洞，各阶段可以直接顺序遍历 Data()
+ *  - 稀疏数组按实体编号记录组件在稠密数组中的位置，Has / Get 都是 O(1) 的数组访问
+ *  - Remove 把最后一个元素换到被删除的位置，因此稠密顺序在删除后会变化
+ */
+template <typename T>
+class ComponentPool {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    /// 为实体添加组件；已有时覆盖原值
+    T& Add(Entity entity, const T& value = T())
+    {
+        if (entity.index >= m_Sparse.size())
+            m_Sparse.resize(static_cast<size_t>(entity.index) + 1, NONE);
+
+        uint32_t& slot = m_Sparse[entity.index];
+        if (slot != NONE && m_Entities[slot] == entity)
+        {
+            m_Data[slot] = value;
+            return m_Data[slot];
+        }
+        slot = static_cast<uint32_t>(m_Data.size());
+        m_Entities.push_back(entity);
+        m_Data.push_back(value);
+        return m_Data.back();
+    }
+
+    void Remove(Entity entity)
+    {
+        const uint32_t slot = IndexOf(entity);
+        if (slot == NONE)
+            return;
+        const uint32_t last = static_cast<uint32_t>(m_Data.size() - 1);
+        if (slot != last)
+        {
+            m_Data[slot] = m_Data[last];
+            m_Entities[slot] = m_Entities[last];
+            m_Sparse[m_Entities[slot].index] = slot;
+        }
+        m_Data.pop_back();
+        m_Entities.pop_back();
+        m_Sparse[entity.index] = NONE;
+    }
+
+    /// 组件在稠密数组中的下标；实体没有该组件（或句柄已过期）时返回 NONE
+    uint32_t IndexOf(Entity entity) const
+    {
+        if (entity.index >= m_Sparse.size())
+            return NONE;
+        const uint32_t slot = m_Sparse[entity.index];
+        return (slot != NONE && m_Entities[slot] == entity) ? slot : NONE;
+    }
+
+    bool     Has(Entity entity) const { return IndexOf(entity) != NONE; }
+    /// 调用方保证实体带有该组件
+    T&       Get(Entity entity) { return m_Data[m_Sparse[entity.index]]; }
+    const T& Get(Entity entity) const { return m_Data[m_Sparse[entity.index]]; }
+    T*       TryGet(Entity entity) { const uint32_t slot = IndexOf(entity); return slot == NONE ? nullptr : &m_Data[slot]; }
+
+    // 稠密数组的顺序访问
+    size_t   Size() const { return m_Data.size(); }
+    bool     Empty() const { return m_Data.empty(); }
+    T*       Data() { return m_Data.data(); }
+    const T* Data() const { return m_Data.data(); }
+    T&       At(size_t i) { return m_Data[i]; }
+    const T& At(size_t i) const { return m_Data[i]; }
+    Entity   EntityAt(size_t i) const { return m_Entities[i]; }
+    const std::vector<Entity>& Entities() const { return m_Entities; }
+
+    void Reserve(size_t count)
+    {
+        m_Data.reserve(count);
+        m_Entities.reserve(count);
+    }
+
+    void Clear()
+    {
+        m_Data.clear();
+        m_Entities.clear();
+        m_Sparse.assign(m_Sparse.size(), NONE);
+    }
+
+private:
+    std::vector<uint32_t> m_Sparse;     // 实体编号 -> 稠密下标
+    std::vector<Entity>   m_Entities;
+    std::vector<T>        m_Data;
+};
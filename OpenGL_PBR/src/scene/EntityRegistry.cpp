@@ -0,0 +1,59 @@
+#include "EntityRegistry.h"
+
+namespace {
+    const uint32_t FREE_BIT = 0x80000000u;
+}
+
+Entity EntityRegistry::Create()
+{
+    Entity entity;
+    if (!m_FreeList.empty())
+    {
+        entity.index = m_FreeList.back();
+        m_FreeList.pop_back();
+        // 回收时已经加过代数，这里清掉空闲标记即可
+        m_Generations[entity.index] &= ~FREE_BIT;
+    }
+    else
+    {
+        entity.index = static_cast<uint32_t>(m_Generations.size());
+        m_Generations.push_back(0);
+    }
+    entity.generation = m_Generations[entity.index];
+    ++m_Alive;
+    return entity;
+}
+
+void EntityRegistry::Destroy(Entity entity)
+{
+    if (!IsAlive(entity))
+        return;
+    // 代数只用低 31 位，最高位作空闲标记
+    m_Generations[entity.index] = ((entity.generation + 1) & ~FREE_BIT) | FREE_BIT;
+    m_FreeList.push_back(entity.index);
+    --m_Alive;
+}
+
+bool EntityRegistry::IsAlive(Entity entity) const
+{
+    return entity.index < m_Generations.size() && m_Generations[entity.index] == entity.generation;
+}
+
+void EntityRegistry::Reserve(size_t count)
+{
+    m_Generations.reserve(count);
+    m_FreeList.reserve(count);
+}
+
+void EntityRegistry::Clear()
+{
+    // 不缩小数组：存活的编号加一代并标记为空闲，保留已分配的内存；倒序入表，之后先复用小编号
+    m_FreeList.clear();
+    for (size_t i = m_Generations.size(); i-- > 0;)
+    {
+        if (!(m_Generations[i] & FREE_BIT))
+            m_Generations[i] = ((m_Generations[i] + 1) & ~FREE_BIT) | FREE_BIT;
+        m_FreeList.push_back(static_cast<uint32_t>(i));
+    }
+    m_Alive = 0;
+}
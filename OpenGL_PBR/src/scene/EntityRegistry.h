@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/// 实体：下标 + 代数。实体销毁后下标会被复用，代数随之加一，旧句柄因此失效
+struct Entity {
+    uint32_t index      = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsNull() const { return index == UINT32_MAX; }
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+/**
+ * EntityRegistry
+ * --------------
+ * 只负责分配 / 回收实体编号，本身不保存任何组件数据；组件放在各自的 ComponentPool 里，
+ * 销毁实体时由持有这些池的一方把组件一并移除。
+ * 编号从空闲表复用，实体数量稳定时不会再分配内存。
+ */
+class EntityRegistry {
+public:
+    Entity Create();
+    /// 无效或已销毁的实体直接忽略
+    void   Destroy(Entity entity);
+    bool   IsAlive(Entity entity) const;
+
+    /// 预留 count 个实体编号的空间（大场景一次性分配）
+    void   Reserve(size_t count);
+    /// 销毁全部实体（已发出的句柄全部失效）
+    void   Clear();
+
+    size_t Alive() const { return m_Alive; }
+    /// 曾经分配过的最大编号 + 1，可用作组件池稀疏数组的长度
+    size_t Capacity() const { return m_Generations.size(); }
+
+private:
+    std::vector<uint32_t> m_Generations;   // 每个编号当前的代数；最高位为 1 表示编号空闲
+    std::vector<uint32_t> m_FreeList;
+    size_t                m_Alive = 0;
+};
@@ -0,0 +1,33 @@
+#include "Frustum.h"
+
+Frustum Frustum::FromMatrix(const glm::mat4& m)
+{
+    // glm 为列主序：m[col][row]，先取出四行
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum f;
+    f.planes[Left]   = row3 + row0;
+    f.planes[Right]  = row3 - row0;
+    f.planes[Bottom] = row3 + row1;
+    f.planes[Top]    = row3 - row1;
+    f.planes[Near]   = row3 + row2;
+    f.planes[Far]    = row3 - row2;
+
+    for (auto& p : f.planes) {
+        float len = glm::length(glm::vec3(p));
+        if (len > 0.0f) p /= len;
+    }
+    return f;
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+{
+    for (const auto& p : planes) {
+        if (glm::dot(glm::vec3(p), center) + p.w < -radius)
+            return false;
+    }
+    return true;
+}
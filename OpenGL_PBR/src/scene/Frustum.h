@@ -0,0 +1,21 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+/**
+ * Frustum
+ * -------
+ * 从 (投影 * 视图 [* 模型]) 矩阵中提取 6 个裁剪平面（Gribb & Hartmann）。
+ * 平面以 (n, d) 形式存储并归一化，点 p 在平面内侧当 dot(n, p) + d >= 0。
+ * 传入的矩阵包含模型矩阵时，得到的是模型空间下的平面（要求等比缩放才能保持距离单位）。
+ */
+struct Frustum {
+    enum Plane { Left = 0, Right, Bottom, Top, Near, Far, Count };
+
+    glm::vec4 planes[Count];
+
+    static Frustum FromMatrix(const glm::mat4& m);
+
+    /// 包围球是否与视锥相交（保守测试，可能把视锥角落外的球判为可见）
+    bool IntersectsSphere(const glm::vec3& center, float radius) const;
+};
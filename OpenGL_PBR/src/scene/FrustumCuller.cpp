@@ -0,0 +1,190 @@
+#include "FrustumCuller.h"
+
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "utils/Simd.h"
+
+namespace {
+    // 每个作业至少 1024 块（4096 个物体），再小的话调度开销就比测试本身贵了
+    const size_t CULL_GRAIN_BLOCKS = 1024;
+}
+
+void FrustumCuller::Clear()
+{
+    m_Count = 0;
+    m_CenterX.clear(); m_CenterY.clear(); m_CenterZ.clear(); m_Radius.clear();
+    m_ExtentX.clear(); m_ExtentY.clear(); m_ExtentZ.clear();
+    m_Visible.clear();
+}
+
+void FrustumCuller::Reserve(size_t count)
+{
+    const size_t padded = utils::SimdPadded(count);
+    for (auto* v : { &m_CenterX, &m_CenterY, &m_CenterZ, &m_Radius, &m_ExtentX, &m_ExtentY, &m_ExtentZ })
+        v->reserve(padded);
+    m_Visible.reserve(padded);
+}
+
+size_t FrustumCuller::Add(const BoundingSphere& sphere, const AABB& box)
+{
+    const glm::vec3 c = box.Center();
+    const glm::vec3 e = box.Extents();
+    // 两者中心不同时以 AABB 中心为准，球半径补上中心偏移，保持保守
+    const float r = sphere.Radius + glm::length(sphere.Center - c);
+
+    // 上一次 Cull 留下的补齐元素需要先去掉
+    if (m_Radius.size() != m_Count) {
+        for (auto* v : { &m_CenterX, &m_CenterY, &m_CenterZ, &m_Radius, &m_ExtentX, &m_ExtentY, &m_ExtentZ })
+            v->resize(m_Count);
+        m_Visible.resize(m_Count);
+    }
+
+    m_CenterX.push_back(c.x); m_CenterY.push_back(c.y); m_CenterZ.push_back(c.z);
+    m_Radius.push_back(r);
+    m_ExtentX.push_back(e.x); m_ExtentY.push_back(e.y); m_ExtentZ.push_back(e.z);
+    m_Visible.push_back(0);
+    return m_Count++;
+}
+
+size_t FrustumCuller::Add(const glm::vec3& center, float radius)
+{
+    BoundingSphere s;
+    s.Center = center;
+    s.Radius = radius;
+    AABB box;
+    box.Min = center - glm::vec3(radius);
+    box.Max = center + glm::vec3(radius);
+    return Add(s, box);
+}
+
+const FrustumCuller::Stats& FrustumCuller::Cull(const Frustum& frustum)
+{
+    PBR_PROFILE_SCOPE("Frustum Cull");
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // 补齐到 4 的倍数
+    const size_t padded = utils::SimdPadded(m_Count);
+    for (auto* v : { &m_CenterX, &m_CenterY, &m_CenterZ, &m_ExtentX, &m_ExtentY, &m_ExtentZ })
+        v->resize(padded, 0.0f);
+    m_Radius.resize(padded, -1.0f);
+    m_Visible.resize(padded, 0);
+
+    // 按 4 个物体一块切分：块之间没有共享写入，每块各自统计可见数再汇总
+    const size_t blocks = padded / 4;
+    std::atomic<unsigned int> visibleCount(0);
+    core::JobSystem::ParallelFor(blocks, CULL_GRAIN_BLOCKS, [&](size_t begin, size_t end) {
+        visibleCount += CullRange(frustum, begin * 4, end * 4);
+    });
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_Stats.tested  = static_cast<unsigned int>(m_Count);
+    m_Stats.visible = visibleCount.load();
+    m_Stats.cullMs  = std::chrono::duration<double, std::milli>(end - start).count();
+    return m_Stats;
+}
+
+unsigned int FrustumCuller::CullRange(const Frustum& frustum, size_t first, size_t last)
+{
+#if PBR_SIMD_SSE
+    const __m128 zero = _mm_setzero_ps();
+    __m128 pn[Frustum::Count][4];
+    __m128 pa[Frustum::Count][3];
+    for (int p = 0; p < Frustum::Count; ++p) {
+        const glm::vec4& pl = frustum.planes[p];
+        pn[p][0] = _mm_set1_ps(pl.x); pn[p][1] = _mm_set1_ps(pl.y);
+        pn[p][2] = _mm_set1_ps(pl.z); pn[p][3] = _mm_set1_ps(pl.w);
+        pa[p][0] = _mm_set1_ps(std::fabs(pl.x)); pa[p][1] = _mm_set1_ps(std::fabs(pl.y));
+        pa[p][2] = _mm_set1_ps(std::fabs(pl.z));
+    }
+
+    for (size_t i = first; i < last; i += 4) {
+        const __m128 cx = _mm_loadu_ps(&m_CenterX[i]);
+        const __m128 cy = _mm_loadu_ps(&m_CenterY[i]);
+        const __m128 cz = _mm_loadu_ps(&m_CenterZ[i]);
+        const __m128 r  = _mm_loadu_ps(&m_Radius[i]);
+        const __m128 ex = _mm_loadu_ps(&m_ExtentX[i]);
+        const __m128 ey = _mm_loadu_ps(&m_ExtentY[i]);
+        const __m128 ez = _mm_loadu_ps(&m_ExtentZ[i]);
+
+        __m128 visible = _mm_cmpge_ps(r, zero);
+        for (int p = 0; p < Frustum::Count; ++p) {
+            const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, pn[p][0]), _mm_mul_ps(cy, pn[p][1])),
+                                        _mm_add_ps(_mm_mul_ps(cz, pn[p][2]), pn[p][3]));
+            const __m128 boxR = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, pa[p][0]), _mm_mul_ps(ey, pa[p][1])),
+                                           _mm_mul_ps(ez, pa[p][2]));
+            const __m128 reach = _mm_min_ps(r, boxR);
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(d, reach), zero));
+        }
+
+        const int mask = _mm_movemask_ps(visible);
+        m_Visible[i + 0] = (mask >> 0) & 1;
+        m_Visible[i + 1] = (mask >> 1) & 1;
+        m_Visible[i + 2] = (mask >> 2) & 1;
+        m_Visible[i + 3] = (mask >> 3) & 1;
+    }
+#else
+    for (size_t i = first; i < last; ++i) {
+        bool visible = m_Radius[i] >= 0.0f;
+        for (int p = 0; visible && p < Frustum::Count; ++p) {
+            const glm::vec4& pl = frustum.planes[p];
+            float d = pl.x * m_CenterX[i] + pl.y * m_CenterY[i] + pl.z * m_CenterZ[i] + pl.w;
+            float boxR = std::fabs(pl.x) * m_ExtentX[i] + std::fabs(pl.y) * m_ExtentY[i] + std::fabs(pl.z) * m_ExtentZ[i];
+            visible = d + std::min(m_Radius[i], boxR) >= 0.0f;
+        }
+        m_Visible[i] = visible ? 1 : 0;
+    }
+#endif
+
+    // 补齐元素不计入
+    const size_t real = std::min(last, m_Count);
+    unsigned int visibleCount = 0;
+    for (size_t i = first; i < real; ++i)
+        visibleCount += m_Visible[i];
+    return visibleCount;
+}
+
+double FrustumCuller::Benchmark(size_t objectCount, int iterations)
+{
+    if (objectCount == 0 || iterations <= 0) return 0.0;
+
+    // 固定种子，物体散布在摄像机周围 200 单位见方的立方体内，只有一部分落在视锥内
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+
+    FrustumCuller culler;
+    culler.Reserve(objectCount);
+    for (size_t i = 0; i < objectCount; ++i) {
+        glm::vec3 c(pos(rng), pos(rng), pos(rng));
+        glm::vec3 e(size(rng), size(rng), size(rng));
+        BoundingSphere s;
+        s.Center = c;
+        s.Radius = glm::length(e);
+        AABB box;
+        box.Min = c - e;
+        box.Max = c + e;
+        culler.Add(s, box);
+    }
+
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = Frustum::FromMatrix(projection * view);
+
+    culler.Cull(frustum); // 预热
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        culler.Cull(frustum);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return ms > 0.0 ? static_cast<double>(objectCount) * iterations / ms : 0.0;
+}
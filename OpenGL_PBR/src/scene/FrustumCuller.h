@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "Frustum.h"
+#include "Bounds.h"
+
+/**
+ * FrustumCuller
+ * -------------
+ * 以 SoA 形式保存一批世界空间包围体（包围球 + AABB 半长），每帧一次性做视锥测试。
+ * 对每个平面，物体的“有效半径”取 min(球半径, |n|·extents)，即包围球和 AABB 中更紧的那个，
+ * SSE 下一次处理 4 个物体，否则走标量路径；物体较多时按块交给 core::JobSystem 并行。
+ *
+ * 典型用法：
+ *   culler.Clear();
+ *   for (...) culler.Add(sphere, box);
+ *   culler.Cull(Frustum::FromMatrix(projection * view));
+ *   if (culler.IsVisible(i)) ...
+ */
+class FrustumCuller {
+public:
+    struct Stats {
+        unsigned int tested  = 0;
+        unsigned int visible = 0;
+        double       cullMs  = 0.0;   // 上一次 Cull 的 CPU 耗时
+    };
+
+    void Clear();
+    void Reserve(size_t count);
+
+    /// 添加一个物体，返回其下标
+    size_t Add(const BoundingSphere& sphere, const AABB& box);
+    /// 只有包围球的物体（AABB 取球的外接盒）
+    size_t Add(const glm::vec3& center, float radius);
+
+    size_t Size() const { return m_Count; }
+
+    /// 对所有物体执行视锥测试，结果通过 IsVisible() 查询
+    const Stats& Cull(const Frustum& frustum);
+
+    bool IsVisible(size_t index) const { return m_Visible[index] != 0; }
+    const Stats& GetStats() const { return m_Stats; }
+
+    /// 微基准：随机生成 objectCount 个物体，重复剔除 iterations 次，返回每毫秒测试的物体数
+    static double Benchmark(size_t objectCount, int iterations);
+
+private:
+    size_t m_Count = 0;
+
+    // SoA：按 4 对齐补齐，补齐元素半径为负，永远不可见
+    std::vector<float> m_CenterX, m_CenterY, m_CenterZ, m_Radius;
+    std::vector<float> m_ExtentX, m_ExtentY, m_ExtentZ;
+    std::vector<unsigned char> m_Visible;
+    Stats m_Stats;
+
+    /// 测试 [first, last) 内的物体（first / last 为 4 的倍数），返回其中可见的真实物体数
+    unsigned int CullRange(const Frustum& frustum, size_t first, size_t last);
+};
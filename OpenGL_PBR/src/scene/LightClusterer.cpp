@@ -0,0 +1,223 @@
+#include "LightClusterer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "utils/Simd.h"
+
+void LightClusterer::SetProjection(const glm::mat4& projection, float nearPlane, float farPlane)
+{
+    if (projection == m_Projection && nearPlane == m_Near && farPlane == m_Far && !m_Bounds.empty())
+        return;
+
+    m_Projection = projection;
+    m_Near = nearPlane;
+    m_Far = farPlane;
+    const float logRatio = std::log(m_Far / m_Near);
+    m_SliceScale = static_cast<float>(SLICES) / logRatio;
+    m_SliceBias = -static_cast<float>(SLICES) * std::log(m_Near) / logRatio;
+
+    // 对称透视投影：观察空间距离 d 处，NDC 的 x 对应 x_ndc * d / P[0][0]
+    const float invPx = 1.0f / projection[0][0];
+    const float invPy = 1.0f / projection[1][1];
+
+    m_Bounds.resize(SLICES);
+    for (unsigned int k = 0; k < SLICES; ++k) {
+        const float dNear = m_Near * std::pow(m_Far / m_Near, static_cast<float>(k) / SLICES);
+        const float dFar = m_Near * std::pow(m_Far / m_Near, static_cast<float>(k + 1) / SLICES);
+        SliceBounds& b = m_Bounds[k];
+        // 相机看向 -z
+        b.minZ = -dFar;
+        b.maxZ = -dNear;
+        for (unsigned int j = 0; j < TILES_Y; ++j) {
+            const float y0 = -1.0f + 2.0f * j / TILES_Y;
+            const float y1 = -1.0f + 2.0f * (j + 1) / TILES_Y;
+            for (unsigned int i = 0; i < TILES_X; ++i) {
+                const float x0 = -1.0f + 2.0f * i / TILES_X;
+                const float x1 = -1.0f + 2.0f * (i + 1) / TILES_X;
+                const unsigned int c = i + TILES_X * j;
+                b.minX[c] = std::min(x0 * dNear, x0 * dFar) * invPx;
+                b.maxX[c] = std::max(x1 * dNear, x1 * dFar) * invPx;
+                b.minY[c] = std::min(y0 * dNear, y0 * dFar) * invPy;
+                b.maxY[c] = std::max(y1 * dNear, y1 * dFar) * invPy;
+            }
+        }
+    }
+}
+
+int LightClusterer::SliceOf(float depth) const
+{
+    if (depth <= m_Near) return 0;
+    int k = static_cast<int>(std::floor(std::log(depth) * m_SliceScale + m_SliceBias));
+    return std::max(0, std::min(k, static_cast<int>(SLICES) - 1));
+}
+
+const LightClusterer::Stats& LightClusterer::Assign(const glm::mat4& view, const std::vector<PointLight>& lights)
+{
+    m_InputPositions.resize(lights.size());
+    m_InputRadii.resize(lights.size());
+    for (size_t i = 0; i < lights.size(); ++i) {
+        m_InputPositions[i] = lights[i].position;
+        m_InputRadii[i] = lights[i].radius;
+    }
+    return Assign(view, m_InputPositions.data(), m_InputRadii.data(), lights.size());
+}
+
+const LightClusterer::Stats& LightClusterer::Assign(const glm::mat4& view, const glm::vec3* positions, const float* radii, size_t count)
+{
+    PBR_PROFILE_SCOPE("Light Assign");
+    auto start = std::chrono::high_resolution_clock::now();
+
+    m_Stats = Stats();
+    m_Stats.lights = static_cast<unsigned int>(count);
+    m_Slices.resize(SLICES);
+    for (auto& s : m_Slices) {
+        s.x.clear(); s.y.clear(); s.z.clear(); s.radius2.clear();
+        s.lightIndex.clear();
+    }
+
+    // 1. 光源变换到观察空间，按覆盖的深度范围分到各片
+    for (size_t i = 0; i < count; ++i) {
+        const float radius = radii[i];
+        const glm::vec3 p = glm::vec3(view * glm::vec4(positions[i], 1.0f));
+        const float depth = -p.z;
+        if (radius <= 0.0f || depth + radius < m_Near || depth - radius > m_Far)
+            continue;
+
+        ++m_Stats.lightsInView;
+        const int k0 = SliceOf(depth - radius);
+        const int k1 = SliceOf(depth + radius);
+        for (int k = k0; k <= k1; ++k) {
+            SliceWork& s = m_Slices[k];
+            s.x.push_back(p.x); s.y.push_back(p.y); s.z.push_back(p.z);
+            s.radius2.push_back(radius * radius);
+            s.lightIndex.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    // 2. 各深度片并行求交；光源很少时作业调度开销不划算，直接在当前线程完成
+    const bool runParallel = parallel && m_Stats.lightsInView >= 64;
+    m_Stats.threads = runParallel ? std::min(core::JobSystem::ThreadCount(), SLICES) : 1;
+
+    if (!runParallel) {
+        for (unsigned int k = 0; k < SLICES; ++k)
+            AssignSlice(k);
+    }
+    else {
+        core::JobSystem::ParallelFor(SLICES, 1, [this](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k)
+                AssignSlice(static_cast<unsigned int>(k));
+        });
+    }
+
+    // 3. 按片顺序拼接成紧凑的簇表和索引列表
+    const unsigned int clustersPerSlice = TILES_X * TILES_Y;
+    m_ClusterTable.resize(CLUSTER_COUNT * 2);
+    m_LightIndices.clear();
+    for (unsigned int k = 0; k < SLICES; ++k) {
+        const SliceWork& s = m_Slices[k];
+        const uint32_t sliceBase = static_cast<uint32_t>(m_LightIndices.size());
+        uint32_t offset = sliceBase;
+        for (unsigned int c = 0; c < clustersPerSlice; ++c) {
+            const uint32_t count = s.counts.empty() ? 0 : s.counts[c];
+            m_ClusterTable[(k * clustersPerSlice + c) * 2 + 0] = offset;
+            m_ClusterTable[(k * clustersPerSlice + c) * 2 + 1] = count;
+            offset += count;
+            m_Stats.maxPerCluster = std::max(m_Stats.maxPerCluster, count);
+        }
+        m_LightIndices.insert(m_LightIndices.end(), s.indices.begin(), s.indices.end());
+    }
+    m_Stats.indices = static_cast<unsigned int>(m_LightIndices.size());
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_Stats.assignMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return m_Stats;
+}
+
+void LightClusterer::AssignSlice(unsigned int slice)
+{
+    SliceWork& s = m_Slices[slice];
+    const SliceBounds& b = m_Bounds[slice];
+    const unsigned int clustersPerSlice = TILES_X * TILES_Y;
+
+    s.counts.assign(clustersPerSlice, 0);
+    s.indices.clear();
+    const size_t count = s.lightIndex.size();
+    if (count == 0) return;
+
+    // 补齐到 4 的倍数，补齐元素半径² 为 -1，永远不相交
+    const size_t padded = utils::SimdPadded(count);
+    s.x.resize(padded, 0.0f); s.y.resize(padded, 0.0f); s.z.resize(padded, 0.0f);
+    s.radius2.resize(padded, -1.0f);
+
+    // z 方向的距离与簇的 x/y 无关，整片只算一次
+    std::vector<float>& dz2 = s.dz2;
+    dz2.resize(padded);
+    for (size_t i = 0; i < padded; ++i) {
+        float d = std::max(0.0f, std::max(b.minZ - s.z[i], s.z[i] - b.maxZ));
+        dz2[i] = d * d;
+    }
+
+    for (unsigned int c = 0; c < clustersPerSlice; ++c) {
+        uint32_t hits = 0;
+#if PBR_SIMD_SSE
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 minX = _mm_set1_ps(b.minX[c]), maxX = _mm_set1_ps(b.maxX[c]);
+        const __m128 minY = _mm_set1_ps(b.minY[c]), maxY = _mm_set1_ps(b.maxY[c]);
+        for (size_t i = 0; i < padded; i += 4) {
+            const __m128 x = _mm_loadu_ps(&s.x[i]);
+            const __m128 y = _mm_loadu_ps(&s.y[i]);
+            // 球心到盒的距离：每轴 max(0, min - c, c - max)
+            __m128 dx = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minX, x), _mm_sub_ps(x, maxX)));
+            __m128 dy = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minY, y), _mm_sub_ps(y, maxY)));
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_loadu_ps(&dz2[i]));
+            int mask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_loadu_ps(&s.radius2[i])));
+            while (mask) {
+                int bit = 0;
+                while (!(mask & (1 << bit))) ++bit;
+                mask &= ~(1 << bit);
+                s.indices.push_back(s.lightIndex[i + bit]);
+                ++hits;
+            }
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            float dx = std::max(0.0f, std::max(b.minX[c] - s.x[i], s.x[i] - b.maxX[c]));
+            float dy = std::max(0.0f, std::max(b.minY[c] - s.y[i], s.y[i] - b.maxY[c]));
+            if (dx * dx + dy * dy + dz2[i] <= s.radius2[i]) {
+                s.indices.push_back(s.lightIndex[i]);
+                ++hits;
+            }
+        }
+#endif
+        s.counts[c] = hits;
+    }
+}
+
+double LightClusterer::Benchmark(size_t lightCount, int iterations, bool parallel)
+{
+    LightClusterer clusterer;
+    clusterer.parallel = parallel;
+    clusterer.SetProjection(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f), 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    // 光源分布在相机前方的一个盒子里，半径 1~4
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> px(-30.0f, 30.0f), py(-15.0f, 15.0f), pz(-60.0f, 2.0f), pr(1.0f, 4.0f);
+    std::vector<PointLight> lights(lightCount);
+    for (auto& l : lights)
+        l = PointLight{ glm::vec3(px(rng), py(rng), pz(rng)), pr(rng), glm::vec3(1.0f) };
+
+    clusterer.Assign(view, lights);   // 预热
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        clusterer.Assign(view, lights);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / std::max(1, iterations);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+/**
+ * LightClusterer
+ * --------------
+ * 分簇光照（clustered shading）的 CPU 部分：把视锥在观察空间切成 TILES_X × TILES_Y × SLICES 个簇，
+ * 深度方向按指数划分（每片的远近比相同），每帧为每个簇算出与之相交的点光源列表。
+ *  - 光源先按观察空间深度分到它覆盖的各个深度片
+ *  - 每片内用 SSE 一次测试 4 个光源包围球与簇 AABB 的相交（球到盒距离²与半径²比较）
+ *  - 深度片之间互不依赖，每片一个作业交给 core::JobSystem 并行处理，最后按片顺序拼接成紧凑的索引列表
+ *
+ * 输出与着色器（assets/shaders/common/clusteredLights.glsl）约定：
+ *  - ClusterTable()：每簇 2 个 uint（在 LightIndices 中的起点、数量），簇下标 x + TILES_X * (y + TILES_Y * z)
+ *  - LightIndices()：各簇的光源下标依次拼接
+ */
+class LightClusterer {
+public:
+    static const unsigned int TILES_X = 16;
+    static const unsigned int TILES_Y = 9;
+    static const unsigned int SLICES  = 24;
+    static const unsigned int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+
+    /// 世界空间点光源；radius 之外光照为 0
+    struct PointLight {
+        glm::vec3 position;
+        float     radius;
+        glm::vec3 color;
+    };
+
+    struct Stats {
+        unsigned int lights        = 0;   // 输入光源数
+        unsigned int lightsInView  = 0;   // 至少落入一个深度片的光源数
+        unsigned int indices       = 0;   // 索引列表总长度
+        unsigned int maxPerCluster = 0;
+        unsigned int threads       = 0;
+        double       assignMs      = 0.0;
+    };
+
+    /// false 时全部深度片在当前线程处理（用于对比）
+    bool parallel = true;
+
+    /// 投影（需为对称透视投影）或近远平面变化时重建簇的观察空间 AABB
+    void SetProjection(const glm::mat4& projection, float nearPlane, float farPlane);
+
+    /// 为每个簇分配光源
+    const Stats& Assign(const glm::mat4& view, const std::vector<PointLight>& lights);
+    /// SoA 输入：count 个世界空间位置和半径；半径 <= 0 的光源（如方向光）不参与分簇
+    const Stats& Assign(const glm::mat4& view, const glm::vec3* positions, const float* radii, size_t count);
+
+    const std::vector<uint32_t>& ClusterTable() const { return m_ClusterTable; }
+    const std::vector<uint32_t>& LightIndices() const { return m_LightIndices; }
+    const Stats& GetStats() const { return m_Stats; }
+
+    float NearPlane() const { return m_Near; }
+    float FarPlane() const { return m_Far; }
+    /// 深度片下标 = floor(log(depth) * SliceScale() + SliceBias())
+    float SliceScale() const { return m_SliceScale; }
+    float SliceBias() const { return m_SliceBias; }
+
+    /// 随机分布 lightCount 个光源，返回每次 Assign 的平均耗时（毫秒）
+    static double Benchmark(size_t lightCount, int iterations, bool parallel = true);
+
+private:
+    // 每个深度片内 TILES_X * TILES_Y 个簇的 AABB（SoA，数量是 4 的倍数时无需补齐）
+    struct SliceBounds {
+        float minX[TILES_X * TILES_Y], minY[TILES_X * TILES_Y];
+        float maxX[TILES_X * TILES_Y], maxY[TILES_X * TILES_Y];
+        float minZ = 0.0f, maxZ = 0.0f;
+    };
+
+    // 一个深度片的输入（落在该片的光源，SoA，补齐到 4 的倍数）与输出
+    struct SliceWork {
+        std::vector<float>    x, y, z, radius2;
+        std::vector<float>    dz2;       // 到该片 z 范围的距离²
+        std::vector<uint32_t> lightIndex;
+        std::vector<uint32_t> counts;    // 每簇光源数
+        std::vector<uint32_t> indices;   // 各簇列表依次拼接
+    };
+
+    glm::mat4 m_Projection = glm::mat4(0.0f);
+    float m_Near = 0.1f, m_Far = 100.0f;
+    float m_SliceScale = 0.0f, m_SliceBias = 0.0f;
+
+    std::vector<glm::vec3>   m_InputPositions;
+    std::vector<float>       m_InputRadii;
+    std::vector<SliceBounds> m_Bounds;
+    std::vector<SliceWork>   m_Slices;
+    std::vector<uint32_t>    m_ClusterTable;
+    std::vector<uint32_t>    m_LightIndices;
+    Stats                    m_Stats;
+
+    int  SliceOf(float depth) const;
+    void AssignSlice(unsigned int slice);
+};
@@ -0,0 +1,35 @@
+#include "LodSelector.h"
+
+#include <cmath>
+#include <algorithm>
+
+float LodSelector::ProjectedSize(const glm::vec3& center, float radius,
+                                 const core::Camera& camera, float viewportHeight)
+{
+    float distance = glm::length(center - camera.Position);
+    if (distance <= radius)
+        return viewportHeight * 2.0f; // 摄像机在包围球内部，始终使用最高精度
+
+    float halfFov = glm::radians(camera.Zoom) * 0.5f;
+    return radius / (distance * std::tan(halfFov)) * viewportHeight;
+}
+
+int LodSelector::Select(float screenSize, int currentLod, int lodCount) const
+{
+    if (lodCount <= 1) return 0;
+
+    float size = screenSize * std::exp2(-bias);
+    int lod = std::max(0, std::min(currentLod, lodCount - 1));
+
+    // 第 i 级与第 i+1 级的分界：lod0ScreenSize / 2^i
+    auto threshold = [&](int i) { return lod0ScreenSize * std::exp2(-static_cast<float>(i)); };
+
+    // 变粗：必须明显小于当前级别的下界
+    while (lod < lodCount - 1 && size < threshold(lod) * (1.0f - hysteresis))
+        ++lod;
+    // 变细：必须明显大于上一级别的下界
+    while (lod > 0 && size > threshold(lod - 1) * (1.0f + hysteresis))
+        --lod;
+
+    return lod;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Bounds.h"
+#include "core/Camera.h"
+
+/**
+ * LodSelector
+ * -----------
+ * 根据物体包围球在屏幕上的投影高度（像素）选择 LOD 级别：
+ *   投影高度 > lod0ScreenSize 时使用 LOD0，之后每降一级阈值减半。
+ * 切换时带滞回区间，物体停在阈值附近时不会每帧来回跳变。
+ */
+struct LodSelector {
+    float lod0ScreenSize = 256.0f; // LOD0 / LOD1 分界处的投影高度（像素）
+    float hysteresis     = 0.15f;  // 阈值两侧的相对滞回宽度
+    float bias           = 0.0f;   // 全局偏移：每 +1 相当于投影尺寸减半（更早切到粗糙级别）
+
+    /// 计算世界空间包围球在屏幕上的投影高度（像素），camera.Zoom 为垂直视场角（度）
+    static float ProjectedSize(const glm::vec3& center, float radius,
+                               const core::Camera& camera, float viewportHeight);
+
+    /// 在 currentLod 的基础上按滞回规则选出新的 LOD（范围 [0, lodCount-1]）
+    int Select(float screenSize, int currentLod, int lodCount) const;
+};
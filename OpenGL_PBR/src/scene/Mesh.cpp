@@ -1,22 +1,85 @@
 #include "Mesh.h"
 
-Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures) {
+#include <algorithm>
+
+#include "renderer/GLExtensions.h"
+
+Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures)
+    : Mesh(vertices, indices, textures, { MeshLod{ 0u, static_cast<unsigned int>(indices.size()), 0.0f } })
+{
+}
+
+Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures, vector<MeshLod> lods) {
     this->vertices = vertices;
     this->indices = indices;
     this->textures = textures;
+    this->lods = lods;
+    if (!this->vertices.empty()) {
+        boundingSphere = BoundingSphere::FromPoints(&this->vertices[0].Position.x, this->vertices.size(), sizeof(Vertex));
+        aabb = AABB::FromPoints(&this->vertices[0].Position.x, this->vertices.size(), sizeof(Vertex));
+    }
+    buildMeshlets();
+    buildSamplerNames();
     setupMesh();
 }
 
-void Mesh::Draw(Shader& shader) {
+void Mesh::buildMeshlets() {
+    meshlets.clear();
+    meshletIndices.clear();
+    if (vertices.empty() || lods.empty() || lods[0].indexCount / 3 < MESH_MESHLET_MIN_TRIANGLES)
+        return;
+
+    MeshletBuilder::Build(&vertices[0].Position.x, vertices.size(), sizeof(Vertex),
+                          &indices[lods[0].indexOffset], lods[0].indexCount, meshlets, meshletIndices);
+
+    // meshlet 索引追加在所有 LOD 索引之后，偏移量换算到整个 EBO
+    const unsigned int base = static_cast<unsigned int>(indices.size());
+    for (auto& m : meshlets)
+        m.indexOffset += base;
+    meshletCuller.Build(meshlets);
+}
+
+void Mesh::Draw(Shader& shader, int lod) {
+    bindTextures(shader);
+
+    lod = std::max(0, std::min(lod, static_cast<int>(lods.size()) - 1));
+    const MeshLod& range = lods[lod];
+
+    glBindVertexArray(VAO);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(range.indexCount), GL_UNSIGNED_INT,
+                   (void*)(static_cast<size_t>(range.indexOffset) * sizeof(unsigned int)));
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+const MeshletCuller::Stats& Mesh::DrawCulled(Shader& shader, const glm::mat4& viewProjection,
+                                             const glm::mat4& modelMatrix, const glm::vec3& eye) {
+    // 在模型空间里剔除，避免每帧变换所有 meshlet 包围球
+    Frustum frustum = Frustum::FromMatrix(viewProjection * modelMatrix);
+    glm::vec3 localEye = glm::vec3(glm::inverse(modelMatrix) * glm::vec4(eye, 1.0f));
+    const MeshletCuller::Stats& stats = meshletCuller.Cull(frustum, localEye);
+    if (meshletCuller.Counts().empty())
+        return stats;
+
+    bindTextures(shader);
+    glBindVertexArray(VAO);
+    glMultiDrawElements(GL_TRIANGLES, meshletCuller.Counts().data(), GL_UNSIGNED_INT,
+                        meshletCuller.Offsets().data(), static_cast<GLsizei>(meshletCuller.Counts().size()));
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+    return stats;
+}
+
+void Mesh::buildSamplerNames() {
     unsigned int diffuseNr = 1;
     unsigned int specularNr = 1;
     unsigned int normalNr = 1;
     unsigned int heightNr = 1;
 
-    for (unsigned int i = 0; i < textures.size(); i++) {
-        glActiveTexture(GL_TEXTURE0 + i);
+    samplerNames.clear();
+    for (const auto& texture : textures) {
         string number;
-        string name = textures[i].type;
+        const string& name = texture.type;
         if (name == "texture_diffuse")
             number = std::to_string(diffuseNr++);
         else if (name == "texture_specular")
@@ -25,15 +88,24 @@ void Mesh::Draw(Shader& shader) {
             number = std::to_string(normalNr++);
         else if (name == "texture_height")
             number = std::to_string(heightNr++);
+        samplerNames.push_back(name + number);
+    }
+}
+
+void Mesh::bindTextures(Shader& shader) {
+    // 着色器和驱动都支持 bindless 时，直接把常驻句柄写进 sampler uniform，不占用纹理单元
+    const bool bindless = shader.bindless && renderer::GLExtensions::HasBindlessTexture();
 
-        glUniform1i(glGetUniformLocation(shader.ID, (name + number).c_str()), i);
+    for (unsigned int i = 0; i < textures.size(); i++) {
+        GLint location = glGetUniformLocation(shader.ID, samplerNames[i].c_str());
+        if (bindless) {
+            renderer::GLExtensions::UniformHandle(location, renderer::GLExtensions::GetResidentHandle(textures[i].id));
+            continue;
+        }
+        glActiveTexture(GL_TEXTURE0 + i);
+        glUniform1i(location, i);
         glBindTexture(GL_TEXTURE_2D, textures[i].id);
     }
-
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-    glActiveTexture(GL_TEXTURE0);
 }
 
 void Mesh::setupMesh() {
@@ -46,7 +118,13 @@ void Mesh::setupMesh() {
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    // EBO 布局：[所有 LOD 索引][meshlet 重排后的 LOD0 索引]
+    const size_t lodBytes = indices.size() * sizeof(unsigned int);
+    const size_t meshletBytes = meshletIndices.size() * sizeof(unsigned int);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, lodBytes + meshletBytes, nullptr, GL_STATIC_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, lodBytes, &indices[0]);
+    if (meshletBytes > 0)
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, lodBytes, meshletBytes, meshletIndices.data());
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
@@ -9,11 +9,16 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "renderer/shader.h"
+#include "MeshSimplifier.h"
+#include "Bounds.h"
+#include "Meshlet.h"
 
 
 using namespace std;
 
 #define MAX_BONE_INFLUENCE 4
+#define MESH_LOD_COUNT 4      // 导入时为每个 Mesh 生成的 LOD 级数（含原始网格）
+#define MESH_MESHLET_MIN_TRIANGLES 4096 // LOD0 超过该三角形数时划分 meshlet 做簇剔除
 
 struct Vertex {
     glm::vec3 Position;
@@ -36,12 +41,30 @@ public:
     vector<Vertex> vertices;
     vector<unsigned int> indices;
     vector<Texture> textures;
+    vector<MeshLod> lods;          // lods[0] 为原始网格；indices 是所有级别索引的拼接
+    BoundingSphere boundingSphere; // 模型空间包围球
+    AABB aabb;                     // 模型空间包围盒
+    int currentLod = 0;            // 上一次绘制使用的 LOD（用于滞回）
+    vector<Meshlet> meshlets;      // LOD0 的 meshlet 划分（小网格为空）
+    vector<unsigned int> meshletIndices; // meshlet 重排后的 LOD0 索引，上传时追加在 indices 之后
     unsigned int VAO;
 
     Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures);
-    void Draw(Shader& shader);
+    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures, vector<MeshLod> lods);
+    void Draw(Shader& shader, int lod = 0);
+
+    /// 以 meshlet 为单位做视锥 + 法线锥剔除后，用 glMultiDrawElements 绘制 LOD0
+    /// viewProjection * modelMatrix 用于得到模型空间视锥，eye 为世界空间摄像机位置
+    const MeshletCuller::Stats& DrawCulled(Shader& shader, const glm::mat4& viewProjection,
+                                           const glm::mat4& modelMatrix, const glm::vec3& eye);
+    bool HasMeshlets() const { return !meshlets.empty(); }
 
 private:
     unsigned int VBO, EBO;
+    MeshletCuller meshletCuller;
+    vector<string> samplerNames;   // textures[i] 对应的 sampler uniform 名（texture_diffuse1 ……），构造时拼好
+    void buildMeshlets();
+    void buildSamplerNames();
+    void bindTextures(Shader& shader);
     void setupMesh();
 };
\ No newline at end of file
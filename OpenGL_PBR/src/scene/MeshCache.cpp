@@ -0,0 +1,165 @@
+#include "MeshCache.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+namespace {
+
+    const uint32_t kMagic   = 0x4D524250; // "PBRM"
+    const uint32_t kVersion = 1;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t lodCount;
+        uint32_t meshCount;
+        uint64_t sourceSize;
+        int64_t  sourceTime;
+    };
+
+    bool SourceStamp(const string& sourcePath, uint64_t& size, int64_t& time)
+    {
+        std::error_code ec;
+        size = std::filesystem::file_size(sourcePath, ec);
+        if (ec) return false;
+        auto t = std::filesystem::last_write_time(sourcePath, ec);
+        if (ec) return false;
+        time = static_cast<int64_t>(t.time_since_epoch().count());
+        return true;
+    }
+
+    template <typename T>
+    void WriteArray(std::ofstream& out, const vector<T>& v)
+    {
+        uint32_t n = static_cast<uint32_t>(v.size());
+        out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        if (n) out.write(reinterpret_cast<const char*>(v.data()), sizeof(T) * n);
+    }
+
+    /// 文件中从当前读位置到结尾的字节数；fileSize 为打开时取得的文件大小
+    uint64_t Remaining(std::ifstream& in, uint64_t fileSize)
+    {
+        const std::streampos pos = in.tellg();
+        return (pos < 0 || static_cast<uint64_t>(pos) > fileSize) ? 0 : fileSize - static_cast<uint64_t>(pos);
+    }
+
+    // 读取数组 / 字符串前先用剩余字节数校验文件里的长度，截断或损坏的缓存不会触发巨额分配
+    template <typename T>
+    bool ReadArray(std::ifstream& in, uint64_t fileSize, vector<T>& v)
+    {
+        uint32_t n = 0;
+        if (!in.read(reinterpret_cast<char*>(&n), sizeof(n))) return false;
+        if (static_cast<uint64_t>(n) * sizeof(T) > Remaining(in, fileSize)) return false;
+        v.resize(n);
+        return n == 0 || static_cast<bool>(in.read(reinterpret_cast<char*>(v.data()), sizeof(T) * n));
+    }
+
+    void WriteString(std::ofstream& out, const string& s)
+    {
+        uint32_t n = static_cast<uint32_t>(s.size());
+        out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        out.write(s.data(), n);
+    }
+
+    bool ReadString(std::ifstream& in, uint64_t fileSize, string& s)
+    {
+        uint32_t n = 0;
+        if (!in.read(reinterpret_cast<char*>(&n), sizeof(n))) return false;
+        if (n > Remaining(in, fileSize)) return false;
+        s.resize(n);
+        return n == 0 || static_cast<bool>(in.read(&s[0], n));
+    }
+
+    /// 索引都落在顶点范围内、每级 LOD 的索引区间都在索引数组内
+    bool ValidRanges(const MeshCache::CachedMesh& m)
+    {
+        const size_t vertexCount = m.vertices.size();
+        for (unsigned int index : m.indices)
+            if (index >= vertexCount) return false;
+        for (const MeshLod& lod : m.lods)
+            if (static_cast<uint64_t>(lod.indexOffset) + lod.indexCount > m.indices.size()) return false;
+        return true;
+    }
+
+} // namespace
+
+bool MeshCache::Load(const string& cachePath, const string& sourcePath, unsigned int lodCount,
+                     vector<CachedMesh>& outMeshes)
+{
+    std::error_code ec;
+    const uint64_t fileSize = std::filesystem::file_size(cachePath, ec);
+    if (ec) return false;
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) return false;
+
+    Header h{};
+    uint64_t size = 0;
+    int64_t time = 0;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) return false;
+    if (h.magic != kMagic || h.version != kVersion || h.lodCount != lodCount) return false;
+    if (!SourceStamp(sourcePath, size, time) || h.sourceSize != size || h.sourceTime != time) return false;
+
+    // 源文件没变但缓存内容不可信时返回 false，由调用方重新导入并覆盖缓存
+    auto corrupt = [&cachePath, &outMeshes]() {
+        std::cerr << "[MeshCache] " << cachePath << " is truncated or corrupt, rebuilding" << std::endl;
+        outMeshes.clear();
+        return false;
+    };
+
+    // 每个 Mesh 至少有三个数组长度和一个纹理数（各 4 字节），每个纹理引用至少两个字符串长度
+    const uint64_t minMeshBytes = 4 * sizeof(uint32_t);
+    const uint64_t minTextureBytes = 2 * sizeof(uint32_t);
+    if (h.meshCount * minMeshBytes > Remaining(in, fileSize)) return corrupt();
+
+    outMeshes.clear();
+    outMeshes.resize(h.meshCount);
+    for (auto& m : outMeshes) {
+        if (!ReadArray(in, fileSize, m.vertices) || !ReadArray(in, fileSize, m.indices) ||
+            !ReadArray(in, fileSize, m.lods))
+            return corrupt();
+
+        uint32_t texCount = 0;
+        if (!in.read(reinterpret_cast<char*>(&texCount), sizeof(texCount))) return corrupt();
+        if (texCount * minTextureBytes > Remaining(in, fileSize)) return corrupt();
+        m.textures.resize(texCount);
+        for (auto& t : m.textures) {
+            if (!ReadString(in, fileSize, t.type) || !ReadString(in, fileSize, t.path)) return corrupt();
+        }
+        if (m.lods.empty() || !ValidRanges(m)) return corrupt();
+    }
+    return true;
+}
+
+bool MeshCache::Save(const string& cachePath, const string& sourcePath, unsigned int lodCount,
+                     const vector<Mesh>& meshes)
+{
+    Header h{};
+    h.magic = kMagic;
+    h.version = kVersion;
+    h.lodCount = lodCount;
+    h.meshCount = static_cast<uint32_t>(meshes.size());
+    if (!SourceStamp(sourcePath, h.sourceSize, h.sourceTime)) return false;
+
+    std::ofstream out(cachePath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "[MeshCache] Cannot write cache: " << cachePath << std::endl;
+        return false;
+    }
+
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    for (const auto& m : meshes) {
+        WriteArray(out, m.vertices);
+        WriteArray(out, m.indices);
+        WriteArray(out, m.lods);
+
+        uint32_t texCount = static_cast<uint32_t>(m.textures.size());
+        out.write(reinterpret_cast<const char*>(&texCount), sizeof(texCount));
+        for (const auto& t : m.textures) {
+            WriteString(out, t.type);
+            WriteString(out, t.path);
+        }
+    }
+    return static_cast<bool>(out);
+}
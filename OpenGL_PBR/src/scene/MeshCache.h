@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+
+/**
+ * MeshCache
+ * ---------
+ * Model 导入结果的二进制缓存（<模型文件>.meshcache）。
+ * 保存每个 Mesh 的顶点、包含全部 LOD 的索引、LOD 区间表以及纹理引用，
+ * 命中缓存时既不需要 Assimp 解析，也不需要重新做网格简化。
+ *
+ * 缓存头中记录源文件大小、修改时间和 LOD 级数，任何一项不一致即视为失效。
+ */
+class MeshCache {
+public:
+    struct TextureRef {
+        string type;  // texture_diffuse / texture_normal ...
+        string path;  // 相对模型目录的路径
+    };
+
+    struct CachedMesh {
+        vector<Vertex>       vertices;
+        vector<unsigned int> indices;
+        vector<MeshLod>      lods;
+        vector<TextureRef>   textures;
+    };
+
+    /// 读取缓存；文件不存在、版本不符或源文件已变化时返回 false
+    static bool Load(const string& cachePath, const string& sourcePath, unsigned int lodCount,
+                     vector<CachedMesh>& outMeshes);
+
+    /// 写入缓存；失败时只打印警告（缓存只是加速手段）
+    static bool Save(const string& cachePath, const string& sourcePath, unsigned int lodCount,
+                     const vector<Mesh>& meshes);
+};
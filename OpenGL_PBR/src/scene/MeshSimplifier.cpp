@@ -0,0 +1,348 @@
+#include "MeshSimplifier.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+    /// 对称 4x4 二次误差矩阵，只存上三角 10 个元素
+    struct Quadric {
+        double a2 = 0, ab = 0, ac = 0, ad = 0;
+        double b2 = 0, bc = 0, bd = 0;
+        double c2 = 0, cd = 0;
+        double d2 = 0;
+
+        /// 累加平面 ax + by + cz + d = 0 的误差（按权重 w）
+        void AddPlane(double a, double b, double c, double d, double w)
+        {
+            a2 += w * a * a; ab += w * a * b; ac += w * a * c; ad += w * a * d;
+            b2 += w * b * b; bc += w * b * c; bd += w * b * d;
+            c2 += w * c * c; cd += w * c * d;
+            d2 += w * d * d;
+        }
+
+        Quadric& operator+=(const Quadric& q)
+        {
+            a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+            b2 += q.b2; bc += q.bc; bd += q.bd;
+            c2 += q.c2; cd += q.cd;
+            d2 += q.d2;
+            return *this;
+        }
+
+        /// v^T Q v，v = (x, y, z, 1)
+        double Evaluate(double x, double y, double z) const
+        {
+            return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+                 + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+                 + c2 * z * z + 2.0 * cd * z
+                 + d2;
+        }
+    };
+
+    /// 一次候选坍缩：把 from 合并到 to
+    struct Collapse {
+        double       cost;
+        unsigned int from, to;
+        unsigned int fromVersion, toVersion;
+
+        bool operator>(const Collapse& o) const { return cost > o.cost; }
+    };
+
+    /// 以位置的位模式作为焊接键，只合并完全相同的位置
+    struct PositionKey {
+        uint32_t x, y, z;
+        bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    };
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& k) const
+        {
+            return (size_t(k.x) * 73856093u) ^ (size_t(k.y) * 19349663u) ^ (size_t(k.z) * 83492791u);
+        }
+    };
+
+    inline void TriangleNormal(const float* p0, const float* p1, const float* p2, double n[3])
+    {
+        double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    }
+
+} // namespace
+
+std::vector<unsigned int> MeshSimplifier::Simplify(const float* positions, size_t vertexCount, size_t stride,
+                                                   const std::vector<unsigned int>& indices,
+                                                   size_t targetIndexCount, float maxError, float* outError)
+{
+    if (outError) *outError = 0.0f;
+    // 不足一个三角形时没有可简化的内容（下面会读 tris[0]）
+    if (indices.size() <= targetIndexCount || indices.size() < 3 || vertexCount == 0)
+        return indices;
+
+    const unsigned char* base = reinterpret_cast<const unsigned char*>(positions);
+    auto pos = [&](unsigned int v) { return reinterpret_cast<const float*>(base + size_t(v) * stride); };
+
+    // ------------------------------------------------------------------------
+    // 1. 焊接位置相同的顶点：canon[v] 是 v 在拓扑上的代表顶点
+    // ------------------------------------------------------------------------
+    std::vector<unsigned int> canon(vertexCount);
+    {
+        std::unordered_map<PositionKey, unsigned int, PositionKeyHash> welded;
+        welded.reserve(vertexCount);
+        for (unsigned int v = 0; v < vertexCount; ++v) {
+            PositionKey key;
+            std::memcpy(&key, pos(v), sizeof(key));
+            auto it = welded.emplace(key, v).first;
+            canon[v] = it->second;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // 2. 三角形、邻接表、二次误差
+    // ------------------------------------------------------------------------
+    const size_t triCount = indices.size() / 3;
+    std::vector<unsigned int> tris(indices.begin(), indices.begin() + triCount * 3);
+    std::vector<char> triAlive(triCount, 1);
+    std::vector<std::vector<unsigned int>> vertexTris(vertexCount);
+    std::vector<Quadric> quadrics(vertexCount);
+    size_t aliveCount = 0;
+
+    // 包围盒对角线的一半作为误差归一化尺度
+    float mn[3] = { pos(tris[0])[0], pos(tris[0])[1], pos(tris[0])[2] };
+    float mx[3] = { mn[0], mn[1], mn[2] };
+
+    for (size_t t = 0; t < triCount; ++t) {
+        unsigned int c0 = canon[tris[t * 3 + 0]];
+        unsigned int c1 = canon[tris[t * 3 + 1]];
+        unsigned int c2 = canon[tris[t * 3 + 2]];
+        if (c0 == c1 || c1 == c2 || c0 == c2) {
+            triAlive[t] = 0; // 退化三角形直接丢弃
+            continue;
+        }
+        ++aliveCount;
+
+        double n[3];
+        TriangleNormal(pos(c0), pos(c1), pos(c2), n);
+        double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (len > 0.0) {
+            // 面积加权：|n| = 2 * area
+            double a = n[0] / len, b = n[1] / len, c = n[2] / len;
+            const float* p = pos(c0);
+            double d = -(a * p[0] + b * p[1] + c * p[2]);
+            Quadric q;
+            q.AddPlane(a, b, c, d, len * 0.5);
+            quadrics[c0] += q;
+            quadrics[c1] += q;
+            quadrics[c2] += q;
+        }
+
+        for (unsigned int c : { c0, c1, c2 }) {
+            vertexTris[c].push_back(static_cast<unsigned int>(t));
+            const float* p = pos(c);
+            for (int k = 0; k < 3; ++k) {
+                mn[k] = std::min(mn[k], p[k]);
+                mx[k] = std::max(mx[k], p[k]);
+            }
+        }
+    }
+
+    const double dx = mx[0] - mn[0], dy = mx[1] - mn[1], dz = mx[2] - mn[2];
+    const double scale = std::max(0.5 * std::sqrt(dx * dx + dy * dy + dz * dz), 1e-12);
+
+    // ------------------------------------------------------------------------
+    // 3. 锁定开放边界上的顶点（只被一个三角形使用的边）
+    // ------------------------------------------------------------------------
+    std::vector<char> locked(vertexCount, 0);
+    {
+        std::unordered_map<uint64_t, unsigned int> edgeUse;
+        edgeUse.reserve(aliveCount * 3);
+        for (size_t t = 0; t < triCount; ++t) {
+            if (!triAlive[t]) continue;
+            for (int k = 0; k < 3; ++k) {
+                unsigned int a = canon[tris[t * 3 + k]];
+                unsigned int b = canon[tris[t * 3 + (k + 1) % 3]];
+                uint64_t key = (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+                ++edgeUse[key];
+            }
+        }
+        for (const auto& e : edgeUse) {
+            if (e.second == 1) {
+                locked[unsigned(e.first >> 32)] = 1;
+                locked[unsigned(e.first & 0xffffffffu)] = 1;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // 4. 初始候选边
+    // ------------------------------------------------------------------------
+    std::vector<unsigned int> version(vertexCount, 0);
+    std::vector<char> dead(vertexCount, 0);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+    auto pushEdge = [&](unsigned int a, unsigned int b) {
+        Quadric q = quadrics[a];
+        q += quadrics[b];
+        const float* pa = pos(a);
+        const float* pb = pos(b);
+        double costAB = locked[a] ? HUGE_VAL : q.Evaluate(pb[0], pb[1], pb[2]); // a -> b
+        double costBA = locked[b] ? HUGE_VAL : q.Evaluate(pa[0], pa[1], pa[2]); // b -> a
+        if (costAB == HUGE_VAL && costBA == HUGE_VAL) return;
+        if (costAB <= costBA)
+            heap.push({ costAB, a, b, version[a], version[b] });
+        else
+            heap.push({ costBA, b, a, version[b], version[a] });
+    };
+
+    for (size_t t = 0; t < triCount; ++t) {
+        if (!triAlive[t]) continue;
+        for (int k = 0; k < 3; ++k) {
+            unsigned int a = canon[tris[t * 3 + k]];
+            unsigned int b = canon[tris[t * 3 + (k + 1) % 3]];
+            if (a < b || locked[a] || locked[b]) pushEdge(a, b); // 内部边只在 a < b 的那一侧推入
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // 5. 按代价从小到大坍缩，直到达到目标三角形数
+    // ------------------------------------------------------------------------
+    double reachedError = 0.0;
+    std::vector<std::pair<unsigned int, unsigned int>> wedgeMap;
+    std::vector<unsigned int> neighbours;
+
+    while (aliveCount * 3 > targetIndexCount && !heap.empty()) {
+        Collapse c = heap.top();
+        heap.pop();
+        if (dead[c.from] || dead[c.to] || version[c.from] != c.fromVersion || version[c.to] != c.toVersion)
+            continue; // 过期条目
+
+        double error = std::sqrt(std::max(c.cost, 0.0)) / scale;
+        if (error > maxError)
+            break;
+
+        // 5.1 翻转检查：from 移到 to 之后，剩余三角形法线不能反向
+        bool flips = false;
+        const float* target = pos(c.to);
+        for (unsigned int t : vertexTris[c.from]) {
+            if (!triAlive[t]) continue;
+            unsigned int cc[3] = { canon[tris[t * 3]], canon[tris[t * 3 + 1]], canon[tris[t * 3 + 2]] };
+            if (cc[0] == c.to || cc[1] == c.to || cc[2] == c.to) continue; // 将被删除
+
+            const float* p[3] = { pos(cc[0]), pos(cc[1]), pos(cc[2]) };
+            double before[3], after[3];
+            TriangleNormal(p[0], p[1], p[2], before);
+            for (int k = 0; k < 3; ++k)
+                if (cc[k] == c.from) p[k] = target;
+            TriangleNormal(p[0], p[1], p[2], after);
+            if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0) {
+                flips = true;
+                break;
+            }
+        }
+        if (flips) continue;
+
+        // 5.2 删除同时包含 from 与 to 的三角形，并记录接缝副本的对应关系
+        wedgeMap.clear();
+        for (unsigned int t : vertexTris[c.from]) {
+            if (!triAlive[t]) continue;
+            unsigned int* w = &tris[t * 3];
+            int fromCorner = -1, toCorner = -1;
+            for (int k = 0; k < 3; ++k) {
+                if (canon[w[k]] == c.from) fromCorner = k;
+                else if (canon[w[k]] == c.to) toCorner = k;
+            }
+            if (toCorner < 0) continue;
+            wedgeMap.emplace_back(w[fromCorner], w[toCorner]);
+            triAlive[t] = 0;
+            --aliveCount;
+        }
+
+        // 5.3 剩余三角形改为引用 to（优先使用同一侧接缝上的副本）
+        for (unsigned int t : vertexTris[c.from]) {
+            if (!triAlive[t]) continue;
+            for (int k = 0; k < 3; ++k) {
+                unsigned int& w = tris[t * 3 + k];
+                if (canon[w] != c.from) continue;
+                unsigned int replacement = c.to;
+                for (const auto& m : wedgeMap) {
+                    if (m.first == w) { replacement = m.second; break; }
+                }
+                w = replacement;
+            }
+            vertexTris[c.to].push_back(t);
+        }
+
+        quadrics[c.to] += quadrics[c.from];
+        dead[c.from] = 1;
+        vertexTris[c.from].clear();
+        ++version[c.to];
+        reachedError = std::max(reachedError, error);
+
+        // 5.4 清理 to 的邻接表并为它的邻居重新生成候选边
+        auto& adj = vertexTris[c.to];
+        adj.erase(std::remove_if(adj.begin(), adj.end(), [&](unsigned int t) { return !triAlive[t]; }), adj.end());
+        neighbours.clear();
+        for (unsigned int t : adj) {
+            for (int k = 0; k < 3; ++k) {
+                unsigned int n = canon[tris[t * 3 + k]];
+                if (n != c.to) neighbours.push_back(n);
+            }
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (unsigned int n : neighbours)
+            pushEdge(n, c.to);
+    }
+
+    // ------------------------------------------------------------------------
+    // 6. 输出
+    // ------------------------------------------------------------------------
+    std::vector<unsigned int> result;
+    result.reserve(aliveCount * 3);
+    for (size_t t = 0; t < triCount; ++t) {
+        if (!triAlive[t]) continue;
+        result.push_back(tris[t * 3 + 0]);
+        result.push_back(tris[t * 3 + 1]);
+        result.push_back(tris[t * 3 + 2]);
+    }
+    if (outError) *outError = static_cast<float>(reachedError);
+    return result;
+}
+
+void MeshSimplifier::BuildLodChain(const float* positions, size_t vertexCount, size_t stride,
+                                   const std::vector<unsigned int>& indices, unsigned int lodCount,
+                                   std::vector<unsigned int>& outIndices, std::vector<MeshLod>& outLods,
+                                   float reduction)
+{
+    outIndices = indices;
+    outLods.clear();
+    outLods.push_back({ 0u, static_cast<unsigned int>(indices.size()), 0.0f });
+
+    std::vector<unsigned int> current = indices;
+    float accumulatedError = 0.0f;
+    for (unsigned int lod = 1; lod < lodCount; ++lod) {
+        size_t target = static_cast<size_t>(current.size() / 3 * reduction) * 3;
+        if (target < 12 * 3) break; // 太粗糙了，再简化没有意义
+
+        float error = 0.0f;
+        std::vector<unsigned int> next = Simplify(positions, vertexCount, stride, current, target, 1.0f, &error);
+        // 简化收益不足 10%（多为边界/接缝被锁定），停止生成更低级别
+        if (next.empty() || next.size() > current.size() * 9 / 10) break;
+
+        accumulatedError += error;
+        MeshLod l;
+        l.indexOffset = static_cast<unsigned int>(outIndices.size());
+        l.indexCount  = static_cast<unsigned int>(next.size());
+        l.error       = accumulatedError;
+        outLods.push_back(l);
+        outIndices.insert(outIndices.end(), next.begin(), next.end());
+        current.swap(next);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+/// 一个 LOD 级别在（所有级别拼接而成的）索引数组中的区间
+struct MeshLod {
+    unsigned int indexOffset = 0;  // 起始索引（单位：索引个数，不是字节）
+    unsigned int indexCount  = 0;  // 三角形索引数量
+    float        error       = 0.0f; // 相对包围球半径的几何误差（0 = 原始网格）
+};
+
+/**
+ * MeshSimplifier
+ * --------------
+ * 基于二次误差度量（Garland & Heckbert, QEM）的网格简化。
+ *
+ * 采用 half-edge collapse：每次把一条边的一个端点合并到另一个端点上，
+ * 顶点本身从不移动，因此所有 LOD 共享同一个 VBO，只需要不同的索引数组。
+ *  - 位置完全相同的顶点（UV/法线接缝）在拓扑上视为同一个顶点，坍缩时按相邻三角形选择对应的接缝副本
+ *  - 开放边界上的顶点被锁定，避免模型轮廓收缩
+ *  - 坍缩前检查周围三角形是否翻转
+ */
+class MeshSimplifier {
+public:
+    /**
+     * 把三角形列表简化到不超过 targetIndexCount 个索引。
+     * @param positions   第一个顶点位置（3 个 float）的指针
+     * @param vertexCount 顶点数量
+     * @param stride      相邻两个顶点之间的字节跨度
+     * @param indices     输入三角形索引（GL_TRIANGLES）
+     * @param targetIndexCount 目标索引数量
+     * @param maxError    允许的最大误差（相对包围球半径），超出后提前停止
+     * @param outError    实际达到的误差（相对包围球半径），可为 nullptr
+     * @return            简化后的三角形索引（引用原始顶点）
+     */
+    static std::vector<unsigned int> Simplify(const float* positions, size_t vertexCount, size_t stride,
+                                              const std::vector<unsigned int>& indices,
+                                              size_t targetIndexCount, float maxError = 1.0f,
+                                              float* outError = nullptr);
+
+    /**
+     * 生成最多 lodCount 级的 LOD 链，每级三角形数约为上一级的 reduction 倍。
+     * 所有级别的索引依次拼接到 outIndices，outLods[0] 为原始网格。
+     * 若某一级简化几乎没有效果（例如网格已经很粗糙），会提前结束。
+     */
+    static void BuildLodChain(const float* positions, size_t vertexCount, size_t stride,
+                              const std::vector<unsigned int>& indices, unsigned int lodCount,
+                              std::vector<unsigned int>& outIndices, std::vector<MeshLod>& outLods,
+                              float reduction = 0.5f);
+};
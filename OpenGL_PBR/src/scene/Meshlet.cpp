@@ -0,0 +1,226 @@
+#include "Meshlet.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "Bounds.h"
+#include "utils/Simd.h"
+
+namespace {
+
+    inline glm::vec3 LoadPosition(const unsigned char* base, size_t stride, unsigned int index)
+    {
+        const float* p = reinterpret_cast<const float*>(base + static_cast<size_t>(index) * stride);
+        return glm::vec3(p[0], p[1], p[2]);
+    }
+
+    /// 计算 meshlet 的包围球和法线锥（写回 m）
+    void ComputeBounds(Meshlet& m, const unsigned char* base, size_t stride,
+                       const unsigned int* tris, const std::vector<unsigned int>& uniqueVerts)
+    {
+        std::vector<glm::vec3> points;
+        points.reserve(uniqueVerts.size());
+        for (unsigned int v : uniqueVerts)
+            points.push_back(LoadPosition(base, stride, v));
+
+        BoundingSphere sphere = BoundingSphere::FromPoints(&points[0].x, points.size(), sizeof(glm::vec3));
+        m.center = sphere.Center;
+        m.radius = sphere.Radius;
+
+        // 法线锥：轴取面法线平均值，张角取与轴的最小点积
+        std::vector<glm::vec3> normals;
+        normals.reserve(m.triangleCount);
+        glm::vec3 axis(0.0f);
+        for (unsigned int t = 0; t < m.triangleCount; ++t) {
+            glm::vec3 a = LoadPosition(base, stride, tris[t * 3 + 0]);
+            glm::vec3 b = LoadPosition(base, stride, tris[t * 3 + 1]);
+            glm::vec3 c = LoadPosition(base, stride, tris[t * 3 + 2]);
+            glm::vec3 n = glm::cross(b - a, c - a);
+            float len = glm::length(n);
+            if (len <= 0.0f) continue; // 退化三角形不影响可见性
+            n /= len;
+            normals.push_back(n);
+            axis += n;
+        }
+
+        float axisLen = glm::length(axis);
+        if (normals.empty() || axisLen <= 1e-6f) {
+            m.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+            m.coneCutoff = 1.0f;
+            return;
+        }
+        axis /= axisLen;
+
+        float minDot = 1.0f;
+        for (const auto& n : normals)
+            minDot = std::min(minDot, glm::dot(n, axis));
+
+        m.coneAxis = axis;
+        // 张角超过 90° 时锥体无法给出保守的背面结论
+        m.coneCutoff = minDot <= 0.0f ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+    }
+
+} // namespace
+
+void MeshletBuilder::Build(const float* positions, size_t vertexCount, size_t stride,
+                           const unsigned int* indices, size_t indexCount,
+                           std::vector<Meshlet>& outMeshlets, std::vector<unsigned int>& outIndices,
+                           unsigned int maxVertices, unsigned int maxTriangles)
+{
+    outMeshlets.clear();
+    outIndices.clear();
+    if (vertexCount == 0 || indexCount < 3) return;
+
+    const unsigned char* base = reinterpret_cast<const unsigned char*>(positions);
+    outIndices.reserve(indexCount);
+
+    // 记录顶点最近一次被哪个 meshlet 引用，避免每个 meshlet 都清空一张表
+    std::vector<unsigned int> lastMeshlet(vertexCount, ~0u);
+    std::vector<unsigned int> uniqueVerts;
+    uniqueVerts.reserve(maxVertices);
+
+    Meshlet current;
+    auto flush = [&]() {
+        if (current.triangleCount == 0) return;
+        current.vertexCount = static_cast<unsigned int>(uniqueVerts.size());
+        ComputeBounds(current, base, stride, &outIndices[current.indexOffset], uniqueVerts);
+        outMeshlets.push_back(current);
+        current = Meshlet();
+        current.indexOffset = static_cast<unsigned int>(outIndices.size());
+        uniqueVerts.clear();
+    };
+
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        const unsigned int tri[3] = { indices[i], indices[i + 1], indices[i + 2] };
+        unsigned int id = static_cast<unsigned int>(outMeshlets.size());
+
+        unsigned int newVerts = 0;
+        for (int k = 0; k < 3; ++k) {
+            bool dup = (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+            if (!dup && lastMeshlet[tri[k]] != id) ++newVerts;
+        }
+
+        // 装不下就结束当前 meshlet；新 meshlet 为空，三个顶点一定放得下
+        if (uniqueVerts.size() + newVerts > maxVertices || current.triangleCount + 1 > maxTriangles) {
+            flush();
+            id = static_cast<unsigned int>(outMeshlets.size());
+        }
+
+        for (int k = 0; k < 3; ++k) {
+            if (lastMeshlet[tri[k]] != id) {
+                lastMeshlet[tri[k]] = id;
+                uniqueVerts.push_back(tri[k]);
+            }
+            outIndices.push_back(tri[k]);
+        }
+        ++current.triangleCount;
+    }
+    flush();
+}
+
+void MeshletCuller::Build(const std::vector<Meshlet>& meshlets)
+{
+    m_Count = meshlets.size();
+    const size_t padded = utils::SimdPadded(m_Count);
+
+    for (auto* v : { &m_CenterX, &m_CenterY, &m_CenterZ, &m_AxisX, &m_AxisY, &m_AxisZ })
+        v->assign(padded, 0.0f);
+    m_Radius.assign(padded, -1.0f);
+    m_Cutoff.assign(padded, 1.0f);
+    m_IndexOffset.resize(m_Count);
+    m_TriangleCount.resize(m_Count);
+    m_Visible.assign(padded, 0);
+    m_TotalTriangles = 0;
+
+    for (size_t i = 0; i < m_Count; ++i) {
+        const Meshlet& m = meshlets[i];
+        m_CenterX[i] = m.center.x; m_CenterY[i] = m.center.y; m_CenterZ[i] = m.center.z;
+        m_Radius[i]  = m.radius;
+        m_AxisX[i] = m.coneAxis.x; m_AxisY[i] = m.coneAxis.y; m_AxisZ[i] = m.coneAxis.z;
+        m_Cutoff[i] = m.coneCutoff;
+        m_IndexOffset[i]   = m.indexOffset;
+        m_TriangleCount[i] = m.triangleCount;
+        m_TotalTriangles  += m.triangleCount;
+    }
+}
+
+const MeshletCuller::Stats& MeshletCuller::Cull(const Frustum& frustum, const glm::vec3& eye, bool coneCulling)
+{
+    m_Counts.clear();
+    m_Offsets.clear();
+    m_Stats = Stats();
+    m_Stats.totalMeshlets  = static_cast<unsigned int>(m_Count);
+    m_Stats.totalTriangles = m_TotalTriangles;
+    if (m_Count == 0) return m_Stats;
+
+    const size_t padded = utils::SimdPadded(m_Count);
+
+#if PBR_SIMD_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 ex = _mm_set1_ps(eye.x), ey = _mm_set1_ps(eye.y), ez = _mm_set1_ps(eye.z);
+    const __m128 coneMask = coneCulling ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+
+    for (size_t i = 0; i < padded; i += 4) {
+        const __m128 cx = _mm_loadu_ps(&m_CenterX[i]);
+        const __m128 cy = _mm_loadu_ps(&m_CenterY[i]);
+        const __m128 cz = _mm_loadu_ps(&m_CenterZ[i]);
+        const __m128 r  = _mm_loadu_ps(&m_Radius[i]);
+        const __m128 negR = _mm_sub_ps(zero, r);
+
+        // 补齐元素半径为负，直接判为不可见
+        __m128 visible = _mm_cmpge_ps(r, zero);
+        for (int p = 0; p < Frustum::Count; ++p) {
+            const glm::vec4& pl = frustum.planes[p];
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(pl.x)), _mm_mul_ps(cy, _mm_set1_ps(pl.y))),
+                                  _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(pl.z)), _mm_set1_ps(pl.w)));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(d, negR));
+        }
+
+        // 法线锥：dot(c - eye, axis) >= cutoff * |c - eye| + r 时整簇背向
+        const __m128 dx = _mm_sub_ps(cx, ex), dy = _mm_sub_ps(cy, ey), dz = _mm_sub_ps(cz, ez);
+        const __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        const __m128 proj = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&m_AxisX[i])),
+                                                  _mm_mul_ps(dy, _mm_loadu_ps(&m_AxisY[i]))),
+                                       _mm_mul_ps(dz, _mm_loadu_ps(&m_AxisZ[i])));
+        const __m128 limit = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_Cutoff[i]), dist), r);
+        const __m128 backfacing = _mm_and_ps(coneMask, _mm_cmpge_ps(proj, limit));
+        visible = _mm_andnot_ps(backfacing, visible);
+
+        const int mask = _mm_movemask_ps(visible);
+        m_Visible[i + 0] = (mask >> 0) & 1;
+        m_Visible[i + 1] = (mask >> 1) & 1;
+        m_Visible[i + 2] = (mask >> 2) & 1;
+        m_Visible[i + 3] = (mask >> 3) & 1;
+    }
+#else
+    for (size_t i = 0; i < padded; ++i) {
+        const glm::vec3 c(m_CenterX[i], m_CenterY[i], m_CenterZ[i]);
+        bool visible = m_Radius[i] >= 0.0f && frustum.IntersectsSphere(c, m_Radius[i]);
+        if (visible && coneCulling) {
+            const glm::vec3 d = c - eye;
+            const glm::vec3 axis(m_AxisX[i], m_AxisY[i], m_AxisZ[i]);
+            if (glm::dot(d, axis) >= m_Cutoff[i] * glm::length(d) + m_Radius[i])
+                visible = false;
+        }
+        m_Visible[i] = visible ? 1 : 0;
+    }
+#endif
+
+    // 把相邻的可见 meshlet 合并成一个绘制区间（构建时它们在 EBO 中是连续的）
+    for (size_t i = 0; i < m_Count; ++i) {
+        if (!m_Visible[i]) continue;
+
+        const unsigned int begin = m_IndexOffset[i];
+        unsigned int triangles = 0;
+        while (i < m_Count && m_Visible[i]) {
+            triangles += m_TriangleCount[i];
+            ++m_Stats.visibleMeshlets;
+            ++i;
+        }
+        m_Stats.visibleTriangles += triangles;
+        m_Counts.push_back(static_cast<GLsizei>(triangles * 3));
+        m_Offsets.push_back(reinterpret_cast<const void*>(static_cast<size_t>(begin) * sizeof(unsigned int)));
+    }
+    m_Stats.drawRanges = static_cast<unsigned int>(m_Counts.size());
+    return m_Stats;
+}
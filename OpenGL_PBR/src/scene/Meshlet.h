@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Frustum.h"
+
+/// 一个 meshlet：一小簇相邻三角形，在索引数组中连续存放（GL_TRIANGLES）
+struct Meshlet {
+    unsigned int indexOffset   = 0;   // 在 EBO 中的起始索引
+    unsigned int triangleCount = 0;
+    unsigned int vertexCount   = 0;   // 引用的不同顶点数
+
+    // 模型空间包围球
+    glm::vec3 center = glm::vec3(0.0f);
+    float     radius = 0.0f;
+
+    // 法线锥：所有三角形法线都落在以 coneAxis 为轴的锥内。
+    // 当 dot(center - eye, coneAxis) >= coneCutoff * |center - eye| + radius 时整簇背向摄像机。
+    // coneCutoff = 1 表示法线分布太散，永不做背面剔除。
+    glm::vec3 coneAxis   = glm::vec3(0.0f, 0.0f, 1.0f);
+    float     coneCutoff = 1.0f;
+};
+
+/**
+ * MeshletBuilder
+ * --------------
+ * 按索引顺序贪心地把三角形装进 meshlet，直到顶点数或三角形数达到上限。
+ * 输出的索引仍是原始顶点下标，可以直接追加到 Mesh 的 EBO 中。
+ */
+class MeshletBuilder {
+public:
+    static const unsigned int MAX_VERTICES  = 64;
+    static const unsigned int MAX_TRIANGLES = 124;
+
+    static void Build(const float* positions, size_t vertexCount, size_t stride,
+                      const unsigned int* indices, size_t indexCount,
+                      std::vector<Meshlet>& outMeshlets, std::vector<unsigned int>& outIndices,
+                      unsigned int maxVertices = MAX_VERTICES, unsigned int maxTriangles = MAX_TRIANGLES);
+};
+
+/**
+ * MeshletCuller
+ * -------------
+ * 把 meshlet 的包围球和法线锥保存为 SoA 数组，每帧用 SIMD 一次测试 4 个 meshlet：
+ *   1) 包围球 vs 6 个视锥平面
+ *   2) 法线锥背面剔除
+ * 可见的 meshlet 被合并成尽量少的连续区间，输出为 glMultiDrawElements 的参数。
+ */
+class MeshletCuller {
+public:
+    struct Stats {
+        unsigned int visibleMeshlets  = 0;
+        unsigned int visibleTriangles = 0;
+        unsigned int totalMeshlets    = 0;
+        unsigned int totalTriangles   = 0;
+        unsigned int drawRanges       = 0;
+    };
+
+    /// 根据 meshlet 列表建立 SoA 数据（模型空间）
+    void Build(const std::vector<Meshlet>& meshlets);
+
+    /// 执行剔除；frustum 与 eye 均位于模型空间。结果保存在 Counts() / Offsets() 中
+    const Stats& Cull(const Frustum& frustum, const glm::vec3& eye, bool coneCulling = true);
+
+    const std::vector<GLsizei>&     Counts()  const { return m_Counts; }
+    const std::vector<const void*>& Offsets() const { return m_Offsets; }
+    bool Empty() const { return m_Count == 0; }
+
+private:
+    size_t m_Count = 0;
+
+    // SoA：按 4 对齐补齐，补齐部分半径为负，永远不可见
+    std::vector<float> m_CenterX, m_CenterY, m_CenterZ, m_Radius;
+    std::vector<float> m_AxisX, m_AxisY, m_AxisZ, m_Cutoff;
+    std::vector<unsigned int> m_IndexOffset, m_TriangleCount;
+    unsigned int m_TotalTriangles = 0;
+
+    std::vector<unsigned char> m_Visible;
+    std::vector<GLsizei>       m_Counts;
+    std::vector<const void*>   m_Offsets;
+    Stats                      m_Stats;
+};
@@ -1,5 +1,11 @@
 #include "model.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "core/JobSystem.h"
+#include "renderer/GpuMemory.h"
+
 //#define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
 
@@ -10,14 +16,155 @@ Model::Model(string const& path, bool gamma) : gammaCorrection(gamma)
     loadModel(path);
 }
 
+Model::Model(vector<Mesh> meshes, bool gamma) : meshes(std::move(meshes)), gammaCorrection(gamma)
+{
+}
+
+std::unique_ptr<Model> Model::CreateGrid(unsigned int tiles, unsigned int resolution, float tileSize)
+{
+    renderer::GpuMemory::Scope memoryTag("Models");
+    resolution = std::max(resolution, 2u);
+
+    struct Tile {
+        vector<Vertex>       vertices;
+        vector<unsigned int> indices;
+        vector<MeshLod>      lods;
+    };
+    vector<Tile> built(static_cast<size_t>(tiles) * tiles);
+
+    // 顶点和 LOD 链只涉及 CPU，按块并行生成；高度按世界坐标计算，相邻块的边缘严丝合缝
+    core::JobSystem::ParallelFor(built.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t)
+        {
+            const float originX = static_cast<float>(t % tiles) * tileSize;
+            const float originZ = static_cast<float>(t / tiles) * tileSize;
+
+            vector<Vertex> vertices(static_cast<size_t>(resolution) * resolution);
+            for (unsigned int y = 0; y < resolution; ++y)
+            {
+                for (unsigned int x = 0; x < resolution; ++x)
+                {
+                    const float u = static_cast<float>(x) / (resolution - 1);
+                    const float v = static_cast<float>(y) / (resolution - 1);
+                    const float wx = originX + u * tileSize;
+                    const float wz = originZ + v * tileSize;
+                    // 高度 h = 0.3 sin(1.2x) cos(0.9z)，法线和切线由偏导数得到
+                    const float dhdx = 0.36f * std::cos(1.2f * wx) * std::cos(0.9f * wz);
+                    const float dhdz = -0.27f * std::sin(1.2f * wx) * std::sin(0.9f * wz);
+
+                    Vertex& vertex = vertices[static_cast<size_t>(y) * resolution + x];
+                    vertex = Vertex();
+                    vertex.Position  = glm::vec3(wx, 0.3f * std::sin(1.2f * wx) * std::cos(0.9f * wz), wz);
+                    vertex.Normal    = glm::normalize(glm::vec3(-dhdx, 1.0f, -dhdz));
+                    vertex.TexCoords = glm::vec2(u, v);
+                    vertex.Tangent   = glm::normalize(glm::vec3(1.0f, dhdx, 0.0f));
+                    vertex.Bitangent = glm::normalize(glm::vec3(0.0f, dhdz, 1.0f));
+                }
+            }
+
+            vector<unsigned int> indices;
+            indices.reserve(static_cast<size_t>(resolution - 1) * (resolution - 1) * 6);
+            for (unsigned int y = 0; y + 1 < resolution; ++y)
+            {
+                for (unsigned int x = 0; x + 1 < resolution; ++x)
+                {
+                    const unsigned int i = y * resolution + x;
+                    indices.insert(indices.end(), { i, i + resolution, i + 1, i + 1, i + resolution, i + resolution + 1 });
+                }
+            }
+
+            Tile& tile = built[t];
+            tile.vertices = std::move(vertices);
+            MeshSimplifier::BuildLodChain(reinterpret_cast<const float*>(tile.vertices.data()), tile.vertices.size(),
+                                          sizeof(Vertex), indices, MESH_LOD_COUNT, tile.indices, tile.lods);
+        }
+    });
+
+    // 建 meshlet 和上传缓冲在主线程
+    vector<Mesh> meshes;
+    meshes.reserve(built.size());
+    for (Tile& tile : built)
+        meshes.emplace_back(std::move(tile.vertices), std::move(tile.indices), vector<Texture>(), std::move(tile.lods));
+    return std::make_unique<Model>(std::move(meshes));
+}
+
 void Model::Draw(Shader& shader)
 {
     for (unsigned int i = 0; i < meshes.size(); i++)
         meshes[i].Draw(shader);
 }
 
+void Model::Draw(Shader& shader, const core::Camera& camera, const glm::mat4& modelMatrix,
+                 const glm::mat4& projection, float viewportHeight, const LodSelector& selector,
+                 bool meshletCulling)
+{
+    lodStats = LodStats();
+    meshletStats = MeshletCuller::Stats();
+    const glm::mat4 viewProjection = projection * camera.GetViewMatrix();
+
+    // 等比缩放下，取第一列长度作为包围球半径的缩放系数
+    float scale = glm::length(glm::vec3(modelMatrix[0]));
+
+    meshCuller.Clear();
+    meshCuller.Reserve(meshes.size());
+    for (const auto& mesh : meshes)
+    {
+        BoundingSphere world;
+        world.Center = glm::vec3(modelMatrix * glm::vec4(mesh.boundingSphere.Center, 1.0f));
+        world.Radius = mesh.boundingSphere.Radius * scale;
+        meshCuller.Add(world, mesh.aabb.Transformed(modelMatrix));
+    }
+    meshCuller.Cull(Frustum::FromMatrix(viewProjection));
+
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        if (!meshCuller.IsVisible(i))
+            continue;
+
+        Mesh& mesh = meshes[i];
+        glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(mesh.boundingSphere.Center, 1.0f));
+        float size = LodSelector::ProjectedSize(center, mesh.boundingSphere.Radius * scale, camera, viewportHeight);
+        mesh.currentLod = selector.Select(size, mesh.currentLod, static_cast<int>(mesh.lods.size()));
+        ++lodStats.meshes[std::min(mesh.currentLod, MESH_LOD_COUNT - 1)];
+        lodStats.indices += mesh.lods[mesh.currentLod].indexCount;
+
+        if (meshletCulling && mesh.currentLod == 0 && mesh.HasMeshlets())
+        {
+            const MeshletCuller::Stats& s = mesh.DrawCulled(shader, viewProjection, modelMatrix, camera.Position);
+            meshletStats.visibleMeshlets  += s.visibleMeshlets;
+            meshletStats.visibleTriangles += s.visibleTriangles;
+            meshletStats.totalMeshlets    += s.totalMeshlets;
+            meshletStats.totalTriangles   += s.totalTriangles;
+            meshletStats.drawRanges       += s.drawRanges;
+        }
+        else
+        {
+            mesh.Draw(shader, mesh.currentLod);
+        }
+    }
+}
+
+void Model::DrawBatched(Shader& shader, const core::Camera& camera, const glm::mat4& modelMatrix,
+                        const glm::mat4& projection, float viewportHeight, const LodSelector& selector)
+{
+    if (!batch)
+    {
+        batch = std::make_unique<ModelBatch>();
+        batch->Build(meshes);
+    }
+    batch->Draw(shader, camera, modelMatrix, projection, viewportHeight, selector);
+}
+
 void Model::loadModel(string const& path)
 {
+    directory = path.substr(0, path.find_last_of('/'));
+    // 网格缓冲和贴图都记在模型名下
+    renderer::GpuMemory::Scope memoryTag("Models");
+
+    // 命中二进制缓存时跳过 Assimp 解析和 LOD 生成
+    if (loadFromCache(path))
+        return;
+
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
 
@@ -27,8 +174,26 @@ void Model::loadModel(string const& path)
         return;
     }
 
-    directory = path.substr(0, path.find_last_of('/'));
     processNode(scene->mRootNode, scene);
+
+    MeshCache::Save(path + ".meshcache", path, MESH_LOD_COUNT, meshes);
+}
+
+bool Model::loadFromCache(string const& path)
+{
+    vector<MeshCache::CachedMesh> cached;
+    if (!MeshCache::Load(path + ".meshcache", path, MESH_LOD_COUNT, cached))
+        return false;
+
+    meshes.reserve(cached.size());
+    for (auto& c : cached)
+    {
+        vector<Texture> textures;
+        for (const auto& ref : c.textures)
+            textures.push_back(loadTexture(ref.path, ref.type));
+        meshes.emplace_back(std::move(c.vertices), std::move(c.indices), std::move(textures), std::move(c.lods));
+    }
+    return true;
 }
 
 void Model::processNode(aiNode* node, const aiScene* scene)
@@ -45,11 +210,13 @@ void Model::processNode(aiNode* node, const aiScene* scene)
     }
 }
 
-Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
+void Model::ConvertMesh(const aiMesh* mesh, vector<Vertex>& vertices,
+                        vector<unsigned int>& lodIndices, vector<MeshLod>& lods)
 {
-    vector<Vertex> vertices;
+    vertices.clear();
+    vertices.reserve(mesh->mNumVertices);
     vector<unsigned int> indices;
-    vector<Texture> textures;
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 
     for (unsigned int i = 0; i < mesh->mNumVertices; i++)
     {
@@ -96,11 +263,26 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
 
     for (unsigned int i = 0; i < mesh->mNumFaces; i++)
     {
-        aiFace face = mesh->mFaces[i];
+        const aiFace& face = mesh->mFaces[i];
         for (unsigned int j = 0; j < face.mNumIndices; j++)
             indices.push_back(face.mIndices[j]);
     }
 
+    // 导入时生成 LOD 链：所有级别共享顶点，索引依次拼接
+    lodIndices.clear();
+    lods.clear();
+    MeshSimplifier::BuildLodChain(reinterpret_cast<const float*>(vertices.data()), vertices.size(), sizeof(Vertex),
+                                  indices, MESH_LOD_COUNT, lodIndices, lods);
+}
+
+Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
+{
+    vector<Vertex> vertices;
+    vector<unsigned int> lodIndices;
+    vector<MeshLod> lods;
+    vector<Texture> textures;
+    ConvertMesh(mesh, vertices, lodIndices, lods);
+
     aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
     vector<Texture> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
@@ -115,7 +297,7 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
     vector<Texture> heightMaps = loadMaterialTextures(material, aiTextureType_AMBIENT, "texture_height");
     textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
 
-    return Mesh(vertices, indices, textures);
+    return Mesh(vertices, lodIndices, textures, lods);
 }
 
 vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, string typeName)
@@ -125,31 +307,27 @@ vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type,
     {
         aiString str;
         mat->GetTexture(type, i, &str);
-
-        bool skip = false;
-        for (unsigned int j = 0; j < textures_loaded.size(); j++)
-        {
-            if (std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
-            {
-                textures.push_back(textures_loaded[j]);
-                skip = true;
-                break;
-            }
-        }
-
-        if (!skip)
-        {
-            Texture texture;
-            texture.id = TextureFromFile(str.C_Str(), this->directory);
-            texture.type = typeName;
-            texture.path = str.C_Str();
-            textures.push_back(texture);
-            textures_loaded.push_back(texture);
-        }
+        textures.push_back(loadTexture(str.C_Str(), typeName));
     }
     return textures;
 }
 
+Texture Model::loadTexture(const string& path, const string& typeName)
+{
+    for (unsigned int j = 0; j < textures_loaded.size(); j++)
+    {
+        if (textures_loaded[j].path == path)
+            return textures_loaded[j];
+    }
+
+    Texture texture;
+    texture.id = TextureFromFile(path.c_str(), this->directory);
+    texture.type = typeName;
+    texture.path = path;
+    textures_loaded.push_back(texture);
+    return texture;
+}
+
 unsigned int TextureFromFile(const char* path, const string& directory, bool gamma)
 {
     string filename = string(path);
@@ -4,6 +4,7 @@
 #include <vector>
 #include <map>
 #include <iostream>
+#include <memory>
 
 #include <glad/glad.h>
 
@@ -16,7 +17,12 @@
 
 
 #include "mesh.h"
+#include "MeshCache.h"
+#include "LodSelector.h"
+#include "FrustumCuller.h"
+#include "ModelBatch.h"
 #include "renderer/shader.h"
+#include "core/Camera.h"
 
 using namespace std;
 
@@ -31,11 +37,57 @@ public:
     bool gammaCorrection;            // 是否启用伽马校正
 
     Model(string const& path, bool gamma = false);
+    /// 由已经建好的网格构造（程序生成的几何、基准测试），没有贴图目录
+    explicit Model(vector<Mesh> meshes, bool gamma = false);
+
+    /// 程序生成的起伏地面：tiles × tiles 块，每块一个 Mesh（resolution × resolution 个顶点，带 LOD 链，
+    /// 三角形数超过 MESH_MESHLET_MIN_TRIANGLES 时带 meshlet），块边长 tileSize，从原点沿 +X / +Z 铺开。
+    /// 没有外部模型文件时给场景一个走 Model 绘制路径的物体；需要有效的 GL 上下文
+    static std::unique_ptr<Model> CreateGrid(unsigned int tiles, unsigned int resolution, float tileSize);
     void Draw(Shader& shader);
 
+    /// 先按包围体做视锥剔除，再按每个 Mesh 的屏幕投影尺寸选择 LOD 后绘制
+    /// modelMatrix 用于把包围体变换到世界空间（LOD 计算假设为等比缩放）
+    /// 选中 LOD0 且已划分 meshlet 的 Mesh 会先做簇剔除，再用 glMultiDrawElements 绘制
+    void Draw(Shader& shader, const core::Camera& camera, const glm::mat4& modelMatrix,
+              const glm::mat4& projection, float viewportHeight, const LodSelector& selector,
+              bool meshletCulling = true);
+
+    /// 上一次 Draw 各 LOD 级别绘制的 Mesh 数和所选级别的索引总数（不含被剔除的 Mesh，meshlet 剔除之前）
+    struct LodStats {
+        unsigned int meshes[MESH_LOD_COUNT] = {};
+        unsigned int indices = 0;
+    };
+    const LodStats& GetLodStats() const { return lodStats; }
+
+    /// 上一次 Draw 的 meshlet 剔除统计（所有 Mesh 累加）
+    const MeshletCuller::Stats& GetMeshletStats() const { return meshletStats; }
+
+    /// 合并缓冲 + 间接绘制：整个模型一次 draw 调用（首次调用时建立合并缓冲）。
+    /// shader 需为 assets/shaders/modelShader，且已 use() 并设置好矩阵和光照 uniform
+    void DrawBatched(Shader& shader, const core::Camera& camera, const glm::mat4& modelMatrix,
+                     const glm::mat4& projection, float viewportHeight, const LodSelector& selector);
+
+    /// 合并绘制的统计（未调用过 DrawBatched 时为空）
+    ModelBatch::Stats GetBatchStats() const { return batch ? batch->GetStats() : ModelBatch::Stats(); }
+
+    /// 上一次 Draw 的 Mesh 级视锥剔除统计
+    const FrustumCuller::Stats& GetCullStats() const { return meshCuller.GetStats(); }
+
+    /// Assimp 网格 -> 顶点数组 + LOD 链（导入时的 CPU 部分，不加载贴图、不调用 OpenGL）
+    static void ConvertMesh(const aiMesh* mesh, vector<Vertex>& vertices,
+                            vector<unsigned int>& lodIndices, vector<MeshLod>& lods);
+
 private:
+    LodStats lodStats;
+    MeshletCuller::Stats meshletStats;
+    FrustumCuller meshCuller;
+    std::unique_ptr<ModelBatch> batch;
+
     void loadModel(string const& path);
+    bool loadFromCache(string const& path);
     void processNode(aiNode* node, const aiScene* scene);
     Mesh processMesh(aiMesh* mesh, const aiScene* scene);
     vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, string typeName);
+    Texture loadTexture(const string& path, const string& typeName);
 };
\ No newline at end of file
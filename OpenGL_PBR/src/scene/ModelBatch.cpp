@@ -0,0 +1,293 @@
+#include "ModelBatch.h"
+
+#include <iostream>
+#include <algorithm>
+
+#include "renderer/GpuMemory.h"
+#include "utils/TextureLoader.h"
+
+namespace {
+
+    /// 在 textures 中查找 id，不存在时追加；返回层号
+    int LayerOf(std::vector<unsigned int>& textures, unsigned int id)
+    {
+        auto it = std::find(textures.begin(), textures.end(), id);
+        if (it != textures.end())
+            return static_cast<int>(it - textures.begin());
+        textures.push_back(id);
+        return static_cast<int>(textures.size()) - 1;
+    }
+
+    /// Mesh 中第一张指定类型的贴图，没有则返回 0
+    unsigned int FirstTexture(const Mesh& mesh, const char* type)
+    {
+        for (const auto& t : mesh.textures)
+            if (t.type == type)
+                return t.id;
+        return 0;
+    }
+
+} // namespace
+
+ModelBatch::~ModelBatch()
+{
+    Release();
+}
+
+void ModelBatch::Release()
+{
+    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
+    GLuint buffers[] = { m_VBO, m_MaterialVBO, m_EBO, m_IndirectBuffer };
+    for (GLuint b : buffers)
+        if (b) glDeleteBuffers(1, &b);
+    GLuint arrays[] = { m_DiffuseArray, m_NormalArray, m_SpecularArray };
+    for (GLuint t : arrays)
+        if (t) glDeleteTextures(1, &t);
+
+    m_VAO = m_VBO = m_MaterialVBO = m_EBO = m_IndirectBuffer = 0;
+    m_DiffuseArray = m_NormalArray = m_SpecularArray = 0;
+    m_Draws.clear();
+    m_MaterialLayers.clear();
+    m_UniformShader = 0;
+}
+
+void ModelBatch::Build(const std::vector<Mesh>& meshes)
+{
+    Release();
+    if (meshes.empty()) return;
+    renderer::GpuMemory::Scope memoryTag("Models");
+
+    // 1. 合并顶点和索引；每个 Mesh 成为一个 draw
+    size_t vertexTotal = 0, indexTotal = 0;
+    for (const auto& mesh : meshes) {
+        vertexTotal += mesh.vertices.size();
+        indexTotal  += mesh.indices.size();
+    }
+
+    std::vector<Vertex>       vertices;
+    std::vector<unsigned int> indices;
+    std::vector<GLint>        vertexMaterials;
+    vertices.reserve(vertexTotal);
+    indices.reserve(indexTotal);
+    vertexMaterials.reserve(vertexTotal);
+
+    std::vector<unsigned int> diffuseTextures, normalTextures, specularTextures;
+    std::vector<GLint> materialKeys; // 每个材质对应的原始纹理 ID（用于去重）
+
+    size_t skipped = 0;
+    for (const auto& mesh : meshes) {
+        // 绘制时按 LOD 区间取索引，没有 LOD 链（不经 MeshSimplifier 构建）的 Mesh 无从绘制
+        if (mesh.lods.empty()) {
+            ++skipped;
+            continue;
+        }
+
+        DrawInfo draw;
+        draw.baseVertex = static_cast<GLint>(vertices.size());
+        draw.sphere = mesh.boundingSphere;
+        draw.box = mesh.aabb;
+
+        const unsigned int base = static_cast<unsigned int>(indices.size());
+        for (MeshLod lod : mesh.lods) {
+            lod.indexOffset += base;
+            draw.lods.push_back(lod);
+        }
+        indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+        vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+
+        // 材质：由 (diffuse, normal, specular) 三张贴图唯一确定
+        const GLint key[3] = {
+            static_cast<GLint>(FirstTexture(mesh, "texture_diffuse")),
+            static_cast<GLint>(FirstTexture(mesh, "texture_normal")),
+            static_cast<GLint>(FirstTexture(mesh, "texture_specular")),
+        };
+        int material = -1;
+        for (size_t m = 0; m * 3 < materialKeys.size(); ++m) {
+            if (std::equal(key, key + 3, materialKeys.begin() + m * 3)) {
+                material = static_cast<int>(m);
+                break;
+            }
+        }
+        if (material < 0) {
+            if (materialKeys.size() / 3 >= MAX_MATERIALS) {
+                std::cerr << "[ModelBatch] Too many materials (max " << MAX_MATERIALS
+                          << "), reusing material 0" << std::endl;
+                material = 0;
+            }
+            else {
+                material = static_cast<int>(materialKeys.size() / 3);
+                materialKeys.insert(materialKeys.end(), key, key + 3);
+                m_MaterialLayers.push_back(key[0] ? LayerOf(diffuseTextures,  key[0]) : -1);
+                m_MaterialLayers.push_back(key[1] ? LayerOf(normalTextures,   key[1]) : -1);
+                m_MaterialLayers.push_back(key[2] ? LayerOf(specularTextures, key[2]) : -1);
+                m_MaterialLayers.push_back(0);
+            }
+        }
+        vertexMaterials.insert(vertexMaterials.end(), mesh.vertices.size(), material);
+
+        m_Draws.push_back(draw);
+    }
+
+    if (skipped)
+        std::cerr << "[ModelBatch] Skipped " << skipped << " mesh(es) without LOD ranges" << std::endl;
+    if (m_Draws.empty()) return;
+
+    // 2. 上传缓冲；顶点布局与 Mesh::setupMesh 一致，额外的材质下标放在 location 7
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_MaterialVBO);
+    glGenBuffers(1, &m_EBO);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_MaterialVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexMaterials.size() * sizeof(GLint), vertexMaterials.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(7);
+    glVertexAttribIPointer(7, 1, GL_INT, sizeof(GLint), (void*)0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
+    if (renderer::GLExtensions::HasMultiDrawIndirect()) {
+        glGenBuffers(1, &m_IndirectBuffer);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Draws.size() * sizeof(renderer::DrawElementsIndirectCommand),
+                     nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    // 3. 纹理数组
+    m_DiffuseArray  = BuildTextureArray(diffuseTextures);
+    m_NormalArray   = BuildTextureArray(normalTextures);
+    m_SpecularArray = BuildTextureArray(specularTextures);
+
+    m_Commands.reserve(m_Draws.size());
+    m_Counts.reserve(m_Draws.size());
+    m_Offsets.reserve(m_Draws.size());
+    m_BaseVertices.reserve(m_Draws.size());
+
+    std::cout << "[ModelBatch] Merged " << m_Draws.size() << " meshes, " << vertices.size() << " vertices, "
+              << m_MaterialLayers.size() / 4 << " materials" << std::endl;
+}
+
+GLuint ModelBatch::BuildTextureArray(const std::vector<unsigned int>& textures)
+{
+    if (textures.empty()) return 0;
+
+    // 以最大的贴图尺寸作为层尺寸，其余贴图用线性过滤放大
+    GLint width = 1, height = 1;
+    for (unsigned int tex : textures) {
+        GLint w = 0, h = 0;
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+        width = std::max(width, w);
+        height = std::max(height, h);
+    }
+    width = std::min(width, static_cast<GLint>(MAX_ARRAY_SIZE));
+    height = std::min(height, static_cast<GLint>(MAX_ARRAY_SIZE));
+
+    return utils::TextureLoader::BuildArray(textures, width, height);
+}
+
+void ModelBatch::Draw(Shader& shader, const core::Camera& camera, const glm::mat4& modelMatrix,
+                      const glm::mat4& projection, float viewportHeight, const LodSelector& selector)
+{
+    m_Stats = Stats();
+    m_Stats.totalDraws = static_cast<unsigned int>(m_Draws.size());
+    if (m_Draws.empty()) return;
+
+    // 1. 剔除
+    const float scale = glm::length(glm::vec3(modelMatrix[0]));
+    m_Culler.Clear();
+    m_Culler.Reserve(m_Draws.size());
+    for (const auto& draw : m_Draws) {
+        BoundingSphere world;
+        world.Center = glm::vec3(modelMatrix * glm::vec4(draw.sphere.Center, 1.0f));
+        world.Radius = draw.sphere.Radius * scale;
+        m_Culler.Add(world, draw.box.Transformed(modelMatrix));
+    }
+    m_Culler.Cull(Frustum::FromMatrix(projection * camera.GetViewMatrix()));
+
+    // 2. 为可见 draw 选择 LOD 并生成命令
+    m_Commands.clear();
+    for (size_t i = 0; i < m_Draws.size(); ++i) {
+        if (!m_Culler.IsVisible(i)) continue;
+
+        DrawInfo& draw = m_Draws[i];
+        glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(draw.sphere.Center, 1.0f));
+        float size = LodSelector::ProjectedSize(center, draw.sphere.Radius * scale, camera, viewportHeight);
+        draw.currentLod = selector.Select(size, draw.currentLod, static_cast<int>(draw.lods.size()));
+
+        const MeshLod& lod = draw.lods[draw.currentLod];
+        renderer::DrawElementsIndirectCommand cmd;
+        cmd.count         = lod.indexCount;
+        cmd.instanceCount = 1;
+        cmd.firstIndex    = lod.indexOffset;
+        cmd.baseVertex    = draw.baseVertex;
+        cmd.baseInstance  = 0;
+        m_Commands.push_back(cmd);
+    }
+    m_Stats.visibleDraws = static_cast<unsigned int>(m_Commands.size());
+    if (m_Commands.empty()) return;
+
+    // 3. 材质表和纹理数组只绑定一次
+    if (m_UniformShader != shader.serial) {
+        m_UniformShader = shader.serial;
+        m_Uniforms.materialLayers = glGetUniformLocation(shader.ID, "materialLayers");
+        m_Uniforms.diffuseArray   = glGetUniformLocation(shader.ID, "diffuseArray");
+        m_Uniforms.normalArray    = glGetUniformLocation(shader.ID, "normalArray");
+        m_Uniforms.specularArray  = glGetUniformLocation(shader.ID, "specularArray");
+    }
+    glUniform4iv(m_Uniforms.materialLayers, static_cast<GLsizei>(m_MaterialLayers.size() / 4), m_MaterialLayers.data());
+    glUniform1i(m_Uniforms.diffuseArray, 0);
+    glUniform1i(m_Uniforms.normalArray, 1);
+    glUniform1i(m_Uniforms.specularArray, 2);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_DiffuseArray);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_NormalArray);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_SpecularArray);
+
+    glBindVertexArray(m_VAO);
+    const GLsizei drawCount = static_cast<GLsizei>(m_Commands.size());
+    if (!forceFallback && m_IndirectBuffer && renderer::GLExtensions::HasMultiDrawIndirect()) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, m_Commands.size() * sizeof(renderer::DrawElementsIndirectCommand),
+                        m_Commands.data());
+        renderer::GLExtensions::MultiDrawElementsIndirect()(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, drawCount, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        m_Stats.indirect = true;
+    }
+    else {
+        m_Counts.clear();
+        m_Offsets.clear();
+        m_BaseVertices.clear();
+        for (const auto& cmd : m_Commands) {
+            m_Counts.push_back(static_cast<GLsizei>(cmd.count));
+            m_Offsets.push_back(reinterpret_cast<const void*>(static_cast<size_t>(cmd.firstIndex) * sizeof(unsigned int)));
+            m_BaseVertices.push_back(cmd.baseVertex);
+        }
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_Counts.data(), GL_UNSIGNED_INT,
+                                      m_Offsets.data(), drawCount,
+                                      m_BaseVertices.data());
+    }
+    m_Stats.apiCalls = 1;
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+}
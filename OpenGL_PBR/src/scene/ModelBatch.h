@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "Mesh.h"
+#include "LodSelector.h"
+#include "FrustumCuller.h"
+#include "core/Camera.h"
+#include "renderer/Shader.h"
+#include "renderer/GLExtensions.h"
+
+/**
+ * ModelBatch
+ * ----------
+ * 把一个 Model 的所有静态 Mesh 合并到同一组 VAO/VBO/EBO 中，一次调用画完整个模型：
+ *  - 每个 Mesh 的所有 LOD 索引依次拼接进同一个 EBO，索引保持 Mesh 局部下标，用 baseVertex 偏移
+ *  - 同类贴图（diffuse / normal / specular）缩放到统一分辨率后放入 GL_TEXTURE_2D_ARRAY，
+ *    材质只记录层号；每个顶点额外带一个所属 draw 的材质下标，着色器据此查表
+ *  - 每帧在 CPU 上做视锥剔除和 LOD 选择，生成 DrawElementsIndirectCommand 列表：
+ *    支持 GL 4.3 / ARB_multi_draw_indirect 时用 glMultiDrawElementsIndirect，
+ *    否则退回 GL 3.3 的 glMultiDrawElementsBaseVertex（参数来自同一份命令列表）
+ *
+ * 配合 assets/shaders/modelShader 使用。
+ */
+class ModelBatch {
+public:
+    static const unsigned int MAX_MATERIALS   = 64;   // 与 model.frag 中的 MAX_MATERIALS 一致
+    static const int          MAX_ARRAY_SIZE  = 2048; // 纹理数组单层的最大边长
+
+    struct Stats {
+        unsigned int totalDraws   = 0;
+        unsigned int visibleDraws = 0;
+        unsigned int apiCalls     = 0;   // 实际发出的 draw 调用数（正常为 1）
+        bool         indirect     = false;
+    };
+
+    ModelBatch() = default;
+    ~ModelBatch();
+    ModelBatch(const ModelBatch&) = delete;
+    ModelBatch& operator=(const ModelBatch&) = delete;
+
+    /// 从 Mesh 列表建立合并缓冲和纹理数组（需要有效的 GL 上下文）；没有 LOD 链的 Mesh 被跳过
+    void Build(const std::vector<Mesh>& meshes);
+    void Release();
+    bool Empty() const { return m_Draws.empty(); }
+
+    /// 剔除 + LOD 选择后一次性绘制；shader 需为 modelShader 且已 use()
+    void Draw(Shader& shader, const core::Camera& camera, const glm::mat4& modelMatrix,
+              const glm::mat4& projection, float viewportHeight, const LodSelector& selector);
+
+    /// 强制使用 glMultiDrawElementsBaseVertex 回退路径（便于对比）
+    bool forceFallback = false;
+
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    struct DrawInfo {
+        std::vector<MeshLod> lods;      // indexOffset 为合并 EBO 中的绝对位置
+        GLint          baseVertex = 0;
+        BoundingSphere sphere;
+        AABB           box;
+        int            currentLod = 0;
+    };
+
+    GLuint m_VAO = 0, m_VBO = 0, m_MaterialVBO = 0, m_EBO = 0, m_IndirectBuffer = 0;
+    GLuint m_DiffuseArray = 0, m_NormalArray = 0, m_SpecularArray = 0;
+
+    std::vector<DrawInfo> m_Draws;
+    std::vector<GLint>    m_MaterialLayers;   // 每个材质 4 个 int：diffuse / normal / specular / 保留
+
+    // 每帧重建的命令列表及回退路径参数
+    std::vector<renderer::DrawElementsIndirectCommand> m_Commands;
+    std::vector<GLsizei>     m_Counts;
+    std::vector<const void*> m_Offsets;
+    std::vector<GLint>       m_BaseVertices;
+
+    FrustumCuller m_Culler;
+    Stats         m_Stats;
+
+    // 材质表和三个纹理数组采样器的 uniform 位置：按 Shader::serial 记录，换着色器时才重新查询
+    struct Uniforms {
+        GLint materialLayers = -1;
+        GLint diffuseArray   = -1;
+        GLint normalArray    = -1;
+        GLint specularArray  = -1;
+    };
+    uint32_t m_UniformShader = 0;
+    Uniforms m_Uniforms;
+
+    /// 把一组 2D 纹理复制进纹理数组（按需缩放），返回数组纹理 ID
+    static GLuint BuildTextureArray(const std::vector<unsigned int>& textures);
+};
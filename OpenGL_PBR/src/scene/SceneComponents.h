@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+/**
+ * SceneComponents
+ * ---------------
+ * 场景实体可以挂的组件（各自存放在一个 ComponentPool 中）。
+ * 组件都是不含指针的小结构体，池里按值连续存放，10 万个实体也只是几个大数组。
+ * 光源组件直接使用 renderer::LightHandle（光源参数保存在 LightManager 中）。
+ */
+
+/// 世界空间变换：位置 + 等比缩放（实例化路径的逐实例数据只有 位置 + 缩放）
+struct TransformComponent {
+    glm::vec3 position = glm::vec3(0.0f);
+    float     scale    = 1.0f;
+};
+
+enum class RenderMesh : uint8_t {
+    Sphere
+};
+
+/// 可绘制：带此组件的实体参与包围体更新、剔除、排序和提交
+struct RenderableComponent {
+    RenderMesh mesh = RenderMesh::Sphere;
+    int        lod  = 0;   // 上一帧选中的 LOD（滞回需要）
+};
+
+/// 材质：材质库（PBRRenderer::allMaterials）中的下标
+struct MaterialComponent {
+    int material = 0;
+};
@@ -0,0 +1,417 @@
+#include "TransformBatch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "utils/Simd.h"
+
+namespace {
+
+    // 每个作业至少 512 块（4096 个物体）
+    const size_t UPDATE_GRAIN_BLOCKS = 512;
+
+#if PBR_SIMD_SSE
+    // 同一套公式分别用 SSE（4 宽）和 AVX（8 宽）实例化
+    struct Sse {
+        using V = __m128;
+        static V Load(const float* p) { return _mm_loadu_ps(p); }
+        static V Set1(float v) { return _mm_set1_ps(v); }
+        static V Zero() { return _mm_setzero_ps(); }
+        static V Add(V a, V b) { return _mm_add_ps(a, b); }
+        static V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+        static V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+        static V Div(V a, V b) { return _mm_div_ps(a, b); }
+    };
+
+#if PBR_SIMD_AVX
+    struct Avx {
+        using V = __m256;
+        static V Load(const float* p) { return _mm256_loadu_ps(p); }
+        static V Set1(float v) { return _mm256_set1_ps(v); }
+        static V Zero() { return _mm256_setzero_ps(); }
+        static V Add(V a, V b) { return _mm256_add_ps(a, b); }
+        static V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        static V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static V Div(V a, V b) { return _mm256_div_ps(a, b); }
+    };
+#endif
+
+    /// 一块物体的输入指针（都指向 SoA 数组中块的起点）
+    struct BlockInput {
+        const float *px, *py, *pz;
+        const float *qx, *qy, *qz, *qw;
+        const float *sx, *sy, *sz;
+    };
+
+    /// world[col * 4 + row]、normal[col * 3 + row]：每个寄存器是整块物体的同一个矩阵元素
+    template <typename Ops>
+    void ComputeBlock(const BlockInput& in, bool uniformBlock, typename Ops::V* world, typename Ops::V* normal)
+    {
+        using V = typename Ops::V;
+        const V one = Ops::Set1(1.0f), two = Ops::Set1(2.0f), zero = Ops::Zero();
+
+        const V x = Ops::Load(in.qx), y = Ops::Load(in.qy), z = Ops::Load(in.qz), w = Ops::Load(in.qw);
+        const V xx = Ops::Mul(x, x), yy = Ops::Mul(y, y), zz = Ops::Mul(z, z);
+        const V xy = Ops::Mul(x, y), xz = Ops::Mul(x, z), yz = Ops::Mul(y, z);
+        const V wx = Ops::Mul(w, x), wy = Ops::Mul(w, y), wz = Ops::Mul(w, z);
+
+        // 四元数转旋转矩阵（与 glm::mat3_cast 相同，按列）
+        V r[9];
+        r[0] = Ops::Sub(one, Ops::Mul(two, Ops::Add(yy, zz)));
+        r[1] = Ops::Mul(two, Ops::Add(xy, wz));
+        r[2] = Ops::Mul(two, Ops::Sub(xz, wy));
+        r[3] = Ops::Mul(two, Ops::Sub(xy, wz));
+        r[4] = Ops::Sub(one, Ops::Mul(two, Ops::Add(xx, zz)));
+        r[5] = Ops::Mul(two, Ops::Add(yz, wx));
+        r[6] = Ops::Mul(two, Ops::Add(xz, wy));
+        r[7] = Ops::Mul(two, Ops::Sub(yz, wx));
+        r[8] = Ops::Sub(one, Ops::Mul(two, Ops::Add(xx, yy)));
+
+        const V s[3] = { Ops::Load(in.sx), Ops::Load(in.sy), Ops::Load(in.sz) };
+        for (int c = 0; c < 3; ++c)
+        {
+            for (int row = 0; row < 3; ++row)
+                world[c * 4 + row] = Ops::Mul(r[c * 3 + row], s[c]);
+            world[c * 4 + 3] = zero;
+        }
+        world[12] = Ops::Load(in.px);
+        world[13] = Ops::Load(in.py);
+        world[14] = Ops::Load(in.pz);
+        world[15] = one;
+
+        // 法线矩阵：整块等比缩放时就是 R，否则 R * S⁻¹
+        if (uniformBlock)
+        {
+            for (int e = 0; e < 9; ++e)
+                normal[e] = r[e];
+        }
+        else
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const V inv = Ops::Div(one, s[c]);
+                for (int row = 0; row < 3; ++row)
+                    normal[c * 3 + row] = Ops::Mul(r[c * 3 + row], inv);
+            }
+        }
+    }
+
+    /// 把 4 个物体的 SoA 结果转置成逐物体连续的矩阵写出
+    void StoreBlock4(const __m128* world, const __m128* normal, glm::mat4* outWorld, glm::mat3* outNormal)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            __m128 a = world[c * 4 + 0], b = world[c * 4 + 1], d = world[c * 4 + 2], e = world[c * 4 + 3];
+            _MM_TRANSPOSE4_PS(a, b, d, e);
+            _mm_storeu_ps(&outWorld[0][c][0], a);
+            _mm_storeu_ps(&outWorld[1][c][0], b);
+            _mm_storeu_ps(&outWorld[2][c][0], d);
+            _mm_storeu_ps(&outWorld[3][c][0], e);
+        }
+        for (int c = 0; c < 3; ++c)
+        {
+            __m128 v[4] = { normal[c * 3 + 0], normal[c * 3 + 1], normal[c * 3 + 2], _mm_setzero_ps() };
+            _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+            // mat3 的列只有 3 个 float，分两次写，避免越过矩阵末尾
+            for (int j = 0; j < 4; ++j)
+            {
+                float* dst = &outNormal[j][c][0];
+                _mm_storel_pi(reinterpret_cast<__m64*>(dst), v[j]);
+                _mm_store_ss(dst + 2, _mm_movehl_ps(v[j], v[j]));
+            }
+        }
+    }
+#endif
+
+} // namespace
+
+void TransformBatch::Resize(size_t count)
+{
+    const size_t padded = utils::SimdPadded8(count);
+    // 缩小时把不再使用的物体恢复为单位变换，补齐元素保持合法
+    for (size_t i = count; i < std::min(m_Count, padded); ++i)
+    {
+        m_PosX[i] = m_PosY[i] = m_PosZ[i] = 0.0f;
+        m_RotX[i] = m_RotY[i] = m_RotZ[i] = 0.0f;
+        m_RotW[i] = 1.0f;
+        m_ScaleX[i] = m_ScaleY[i] = m_ScaleZ[i] = 1.0f;
+        m_Dirty[i] = 0;
+        m_Uniform[i] = 1;
+    }
+
+    m_PosX.resize(padded, 0.0f); m_PosY.resize(padded, 0.0f); m_PosZ.resize(padded, 0.0f);
+    m_RotX.resize(padded, 0.0f); m_RotY.resize(padded, 0.0f); m_RotZ.resize(padded, 0.0f);
+    m_RotW.resize(padded, 1.0f);
+    m_ScaleX.resize(padded, 1.0f); m_ScaleY.resize(padded, 1.0f); m_ScaleZ.resize(padded, 1.0f);
+    m_Dirty.resize(padded, 0);
+    m_Uniform.resize(padded, 1);
+    m_World.resize(padded, glm::mat4(1.0f));
+    m_Normal.resize(padded, glm::mat3(1.0f));
+
+    for (size_t i = m_Count; i < count; ++i)
+        m_Dirty[i] = 1;
+    m_Count = count;
+}
+
+size_t TransformBatch::Add(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+{
+    const size_t index = m_Count;
+    Resize(m_Count + 1);
+    SetPosition(index, position);
+    SetRotation(index, rotation);
+    SetScale(index, scale);
+    return index;
+}
+
+void TransformBatch::SetPosition(size_t index, const glm::vec3& position)
+{
+    if (m_PosX[index] == position.x && m_PosY[index] == position.y && m_PosZ[index] == position.z)
+        return;
+    m_PosX[index] = position.x;
+    m_PosY[index] = position.y;
+    m_PosZ[index] = position.z;
+    m_Dirty[index] = 1;
+}
+
+void TransformBatch::SetRotation(size_t index, const glm::quat& rotation)
+{
+    if (m_RotX[index] == rotation.x && m_RotY[index] == rotation.y
+        && m_RotZ[index] == rotation.z && m_RotW[index] == rotation.w)
+        return;
+    m_RotX[index] = rotation.x;
+    m_RotY[index] = rotation.y;
+    m_RotZ[index] = rotation.z;
+    m_RotW[index] = rotation.w;
+    m_Dirty[index] = 1;
+}
+
+void TransformBatch::SetScale(size_t index, const glm::vec3& scale)
+{
+    if (m_ScaleX[index] == scale.x && m_ScaleY[index] == scale.y && m_ScaleZ[index] == scale.z)
+        return;
+    m_ScaleX[index] = scale.x;
+    m_ScaleY[index] = scale.y;
+    m_ScaleZ[index] = scale.z;
+    m_Uniform[index] = (scale.x == scale.y && scale.y == scale.z) ? 1 : 0;
+    m_Dirty[index] = 1;
+}
+
+void TransformBatch::MarkAllDirty()
+{
+    std::fill(m_Dirty.begin(), m_Dirty.begin() + m_Count, 1);
+}
+
+const TransformBatch::Stats& TransformBatch::Update()
+{
+    PBR_PROFILE_SCOPE("Transform Update");
+    auto start = std::chrono::high_resolution_clock::now();
+
+    m_Stats = Stats();
+    m_Stats.objects = static_cast<unsigned int>(m_Count);
+
+    // 以 8 个物体为单位切分给作业系统：和 AVX 块对齐，各范围写入的矩阵和脏标记互不重叠
+    std::atomic<unsigned int> updated(0), uniform(0);
+    const size_t blocks = (m_Count + 7) / 8;
+    core::JobSystem::ParallelFor(blocks, UPDATE_GRAIN_BLOCKS, [&](size_t begin, size_t end) {
+        Stats local;
+        UpdateRange(begin * 8, end * 8, local);
+        updated += local.updated;
+        uniform += local.uniform;
+    });
+    m_Stats.updated = updated.load();
+    m_Stats.uniform = uniform.load();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_Stats.updateMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return m_Stats;
+}
+
+void TransformBatch::UpdateRange(size_t first, size_t last, Stats& stats)
+{
+    // 按块检查脏标记：块内任一物体变化就整块重算，比先收集脏下标再 gather 简单，也更适合全部变化的情形
+#if PBR_SIMD_AVX
+    if (useSimd)
+    {
+        for (size_t i = first; i < last; i += 8)
+        {
+            uint64_t dirty;
+            std::memcpy(&dirty, &m_Dirty[i], sizeof(dirty));
+            if (dirty == 0) continue;
+            UpdateBlock8(i, stats);
+            std::memset(&m_Dirty[i], 0, 8);
+        }
+    }
+    else
+#elif PBR_SIMD_SSE
+    if (useSimd)
+    {
+        for (size_t i = first; i < last; i += 4)
+        {
+            uint32_t dirty;
+            std::memcpy(&dirty, &m_Dirty[i], sizeof(dirty));
+            if (dirty == 0) continue;
+            UpdateBlock4(i, stats);
+            std::memset(&m_Dirty[i], 0, 4);
+        }
+    }
+    else
+#endif
+    {
+        last = std::min(last, m_Count);
+        for (size_t i = first; i < last; ++i)
+        {
+            if (!m_Dirty[i]) continue;
+            UpdateScalar(i, stats);
+            m_Dirty[i] = 0;
+        }
+    }
+}
+
+void TransformBatch::UpdateScalar(size_t i, Stats& stats)
+{
+    const float x = m_RotX[i], y = m_RotY[i], z = m_RotZ[i], w = m_RotW[i];
+    const float xx = x * x, yy = y * y, zz = z * z;
+    const float xy = x * y, xz = x * z, yz = y * z;
+    const float wx = w * x, wy = w * y, wz = w * z;
+
+    const glm::vec3 r0(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy));
+    const glm::vec3 r1(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx));
+    const glm::vec3 r2(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
+
+    glm::mat4& world = m_World[i];
+    world[0] = glm::vec4(r0 * m_ScaleX[i], 0.0f);
+    world[1] = glm::vec4(r1 * m_ScaleY[i], 0.0f);
+    world[2] = glm::vec4(r2 * m_ScaleZ[i], 0.0f);
+    world[3] = glm::vec4(m_PosX[i], m_PosY[i], m_PosZ[i], 1.0f);
+
+    glm::mat3& normal = m_Normal[i];
+    if (m_Uniform[i])
+    {
+        normal = glm::mat3(r0, r1, r2);
+        ++stats.uniform;
+    }
+    else
+        normal = glm::mat3(r0 / m_ScaleX[i], r1 / m_ScaleY[i], r2 / m_ScaleZ[i]);
+    ++stats.updated;
+}
+
+void TransformBatch::UpdateBlock4(size_t first, Stats& stats)
+{
+#if PBR_SIMD_SSE
+    const BlockInput in = {
+        &m_PosX[first], &m_PosY[first], &m_PosZ[first],
+        &m_RotX[first], &m_RotY[first], &m_RotZ[first], &m_RotW[first],
+        &m_ScaleX[first], &m_ScaleY[first], &m_ScaleZ[first] };
+    uint32_t uniform;
+    std::memcpy(&uniform, &m_Uniform[first], sizeof(uniform));
+    const bool uniformBlock = uniform == 0x01010101u;
+
+    __m128 world[16], normal[9];
+    ComputeBlock<Sse>(in, uniformBlock, world, normal);
+    StoreBlock4(world, normal, &m_World[first], &m_Normal[first]);
+
+    stats.updated += 4;
+    if (uniformBlock) stats.uniform += 4;
+#else
+    for (size_t i = first; i < first + 4; ++i)
+        UpdateScalar(i, stats);
+#endif
+}
+
+void TransformBatch::UpdateBlock8(size_t first, Stats& stats)
+{
+#if PBR_SIMD_AVX
+    const BlockInput in = {
+        &m_PosX[first], &m_PosY[first], &m_PosZ[first],
+        &m_RotX[first], &m_RotY[first], &m_RotZ[first], &m_RotW[first],
+        &m_ScaleX[first], &m_ScaleY[first], &m_ScaleZ[first] };
+    uint64_t uniform;
+    std::memcpy(&uniform, &m_Uniform[first], sizeof(uniform));
+    const bool uniformBlock = uniform == 0x0101010101010101ull;
+
+    __m256 world[16], normal[9];
+    ComputeBlock<Avx>(in, uniformBlock, world, normal);
+
+    // 拆成两个 128 位半块，沿用 SSE 的转置写出
+    __m128 worldHalf[16], normalHalf[9];
+    for (int half = 0; half < 2; ++half)
+    {
+        for (int e = 0; e < 16; ++e)
+            worldHalf[e] = half ? _mm256_extractf128_ps(world[e], 1) : _mm256_castps256_ps128(world[e]);
+        for (int e = 0; e < 9; ++e)
+            normalHalf[e] = half ? _mm256_extractf128_ps(normal[e], 1) : _mm256_castps256_ps128(normal[e]);
+        StoreBlock4(worldHalf, normalHalf, &m_World[first + half * 4], &m_Normal[first + half * 4]);
+    }
+
+    stats.updated += 8;
+    if (uniformBlock) stats.uniform += 8;
+#else
+    UpdateBlock4(first, stats);
+    UpdateBlock4(first + 4, stats);
+#endif
+}
+
+TransformBatch::BenchmarkResult TransformBatch::Benchmark(size_t objectCount, int iterations)
+{
+    BenchmarkResult result;
+    result.objects = objectCount;
+    iterations = std::max(1, iterations);
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> pos(-100.0f, 100.0f), unit(-1.0f, 1.0f), scale(0.5f, 2.0f);
+    TransformBatch batch;
+    std::vector<glm::vec3> positions(objectCount), scales(objectCount);
+    std::vector<glm::quat> rotations(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        positions[i] = glm::vec3(pos(rng), pos(rng), pos(rng));
+        rotations[i] = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+        const float s = scale(rng);
+        scales[i] = (i % 2 == 0) ? glm::vec3(s) : glm::vec3(s, scale(rng), scale(rng));
+        batch.Add(positions[i], rotations[i], scales[i]);
+    }
+
+    auto run = [&](bool simd) {
+        batch.useSimd = simd;
+        batch.MarkAllDirty();
+        batch.Update();   // 预热
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int it = 0; it < iterations; ++it)
+        {
+            batch.MarkAllDirty();
+            batch.Update();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        return seconds > 0.0 ? static_cast<double>(objectCount) * iterations / seconds : 0.0;
+    };
+    result.simdPerSec = run(true);
+    result.scalarPerSec = run(false);
+
+    // 对照：逐物体用 glm 构造矩阵并对 3x3 部分求逆转置
+    std::vector<glm::mat4> world(objectCount);
+    std::vector<glm::mat3> normal(objectCount);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int it = 0; it < iterations; ++it)
+    {
+        for (size_t i = 0; i < objectCount; ++i)
+        {
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), positions[i]) * glm::mat4_cast(rotations[i]);
+            model = glm::scale(model, scales[i]);
+            world[i] = model;
+            normal[i] = glm::transpose(glm::inverse(glm::mat3(model)));
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    result.glmPerSec = seconds > 0.0 ? static_cast<double>(objectCount) * iterations / seconds : 0.0;
+    return result;
+}
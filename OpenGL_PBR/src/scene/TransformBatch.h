@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+/**
+ * TransformBatch
+ * --------------
+ * 以 SoA 形式保存一批物体的平移 / 旋转（四元数）/ 缩放，按需批量计算世界矩阵和法线矩阵。
+ *  - Set* 只在数值变化时标记脏，Update() 只重算含脏物体的块（AVX 8 个 / SSE 4 个一块，否则逐个标量），
+ *    物体较多时按块范围交给 core::JobSystem 并行
+ *  - 世界矩阵 = T * R * S；没有切变，法线矩阵 transpose(inverse(RS)) 直接写成 R * S⁻¹，
+ *    整块都是等比缩放时连 S⁻¹ 也省掉，法线矩阵就是 R（着色器里会重新归一化法线）
+ *  - 结果按物体连续存放（glm::mat4 / glm::mat3），可以直接作为 uniform 上传
+ *
+ * 典型用法：
+ *   batch.Resize(count);
+ *   batch.SetPosition(i, p); ...
+ *   batch.Update();
+ *   shader.setMat4("model", batch.World(i));
+ */
+class TransformBatch {
+public:
+    struct Stats {
+        unsigned int objects  = 0;
+        unsigned int updated  = 0;   // 上一次 Update 重算的矩阵数（按块计，含块内未变化的物体）
+        unsigned int uniform  = 0;   // 其中整块等比缩放、跳过求逆的数量
+        double       updateMs = 0.0;
+    };
+
+    /// false 时强制走标量路径（用于对比）
+    bool useSimd = true;
+
+    /// 调整物体数量；新增物体为单位变换并标记为脏
+    void Resize(size_t count);
+    size_t Size() const { return m_Count; }
+
+    /// 添加一个物体，返回其下标
+    size_t Add(const glm::vec3& position, const glm::quat& rotation = glm::quat(), const glm::vec3& scale = glm::vec3(1.0f));
+
+    void SetPosition(size_t index, const glm::vec3& position);
+    void SetRotation(size_t index, const glm::quat& rotation);
+    void SetScale(size_t index, const glm::vec3& scale);
+    void SetScale(size_t index, float scale) { SetScale(index, glm::vec3(scale)); }
+    void MarkAllDirty();
+
+    /// 重算所有脏物体的世界矩阵和法线矩阵
+    const Stats& Update();
+
+    const glm::mat4& World(size_t index) const { return m_World[index]; }
+    const glm::mat3& Normal(size_t index) const { return m_Normal[index]; }
+    const Stats& GetStats() const { return m_Stats; }
+
+    struct BenchmarkResult {
+        size_t objects      = 0;
+        double simdPerSec   = 0.0;   // 每秒计算的矩阵对（世界 + 法线）
+        double scalarPerSec = 0.0;
+        double glmPerSec    = 0.0;   // 逐物体 glm 构造矩阵 + transpose(inverse(mat3))，即原来的做法
+    };
+
+    /// 随机生成 objectCount 个物体（一半等比缩放），全部标记为脏后重复 Update iterations 次
+    static BenchmarkResult Benchmark(size_t objectCount, int iterations);
+
+private:
+    size_t m_Count = 0;
+
+    // SoA：补齐到 8 的倍数，补齐元素为单位变换
+    std::vector<float> m_PosX, m_PosY, m_PosZ;
+    std::vector<float> m_RotX, m_RotY, m_RotZ, m_RotW;
+    std::vector<float> m_ScaleX, m_ScaleY, m_ScaleZ;
+    std::vector<unsigned char> m_Dirty;
+    std::vector<unsigned char> m_Uniform;
+
+    std::vector<glm::mat4> m_World;
+    std::vector<glm::mat3> m_Normal;
+    Stats m_Stats;
+
+    // 各线程各自累计 stats，最后在 Update 中汇总
+    void UpdateRange(size_t first, size_t last, Stats& stats);
+    void UpdateScalar(size_t index, Stats& stats);
+    void UpdateBlock4(size_t first, Stats& stats);
+    void UpdateBlock8(size_t first, Stats& stats);
+};
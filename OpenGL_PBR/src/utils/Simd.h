@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Simd.h
+ * ------
+ * SIMD 开关：x64（MSVC 默认开启 SSE2）或显式启用 SSE2 的编译器上使用 SSE 内建函数，
+ * 其余平台走标量回退路径。各模块统一通过 PBR_SIMD_SSE 判断，不要直接检测编译器宏。
+ * 以 /arch:AVX（或 -mavx）编译时另外定义 PBR_SIMD_AVX，可一次处理 8 个 float。
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PBR_SIMD_SSE 1
+#include <emmintrin.h>
+#else
+#define PBR_SIMD_SSE 0
+#endif
+
+#if PBR_SIMD_SSE && defined(__AVX__)
+#define PBR_SIMD_AVX 1
+#include <immintrin.h>
+#else
+#define PBR_SIMD_AVX 0
+#endif
+
+namespace utils {
+
+    /// SoA 数组按 4 个元素一组处理时需要的补齐长度
+    inline size_t SimdPadded(size_t count) { return (count + 3) & ~size_t(3); }
+    /// 按 8 个元素一组（AVX）处理时需要的补齐长度
+    inline size_t SimdPadded8(size_t count) { return (count + 7) & ~size_t(7); }
+
+} // namespace utils
@@ -3,33 +3,63 @@
 //#define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
 
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+
 
 namespace utils {
 
-    unsigned int TextureLoader::Load2D(const std::string& path, bool gamma) {
-        unsigned int textureID;
-        glGenTextures(1, &textureID);
+    TextureLoader::Image TextureLoader::Decode(const std::string& path, bool hdr) {
+        PBR_PROFILE_SCOPE("Decode Image");
 
-        // stb_image: 默认从 top-left 读取，需要翻转为 OpenGL 的 bottom-left
-        stbi_set_flip_vertically_on_load(true);
+        // stb_image: 默认从 top-left 读取，需要翻转为 OpenGL 的 bottom-left。
+        // 用线程局部的开关，多个作业线程同时解码时互不影响
+        stbi_set_flip_vertically_on_load_thread(1);
 
-        int width, height, nrComponents;
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrComponents, 0);
-        if (!data) {
+        Image image;
+        image.hdr = hdr;
+        if (hdr)
+            image.pixels = stbi_loadf(path.c_str(), &image.width, &image.height, &image.components, 0);
+        else
+            image.pixels = stbi_load(path.c_str(), &image.width, &image.height, &image.components, 0);
+
+        if (!image.pixels) {
             std::cout << "[TextureLoader] Failed to load texture at path: " << path << std::endl;
+        }
+        return image;
+    }
+
+    void TextureLoader::Free(Image& image) {
+        if (image.pixels) {
+            stbi_image_free(image.pixels);
+            image.pixels = nullptr;
+        }
+    }
+
+    unsigned int TextureLoader::Load2D(const std::string& path, bool gamma) {
+        Image image = Decode(path);
+        return Upload2D(image, gamma);
+    }
+
+    unsigned int TextureLoader::Upload2D(Image& image, bool gamma) {
+        if (!image.Valid()) {
             return 0;
         }
+        PBR_PROFILE_SCOPE("Upload Texture");
+
+        unsigned int textureID;
+        glGenTextures(1, &textureID);
 
         GLenum internalFormat;
         GLenum dataFormat;
-        if (nrComponents == 1) {
+        if (image.components == 1) {
             internalFormat = dataFormat = GL_RED;
         }
-        else if (nrComponents == 3) {
+        else if (image.components == 3) {
             internalFormat = gamma ? GL_SRGB : GL_RGB;
             dataFormat = GL_RGB;
         }
-        else if (nrComponents == 4) {
+        else if (image.components == 4) {
             internalFormat = gamma ? GL_SRGB_ALPHA : GL_RGBA;
             dataFormat = GL_RGBA;
         }
@@ -43,12 +73,12 @@ namespace utils {
             GL_TEXTURE_2D,
             0,
             internalFormat,
-            width,
-            height,
+            image.width,
+            image.height,
             0,
             dataFormat,
             GL_UNSIGNED_BYTE,
-            data
+            image.pixels
         );
         glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -58,8 +88,65 @@ namespace utils {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        stbi_image_free(data);
+        Free(image);
         return textureID;
     }
 
+    std::vector<unsigned int> TextureLoader::LoadMany(const std::vector<std::string>& paths, bool gamma) {
+        // 解码（文件读取 + PNG 解压）占加载时间的大头，每张图一个作业；上传必须留在主线程
+        std::vector<Image> images(paths.size());
+        core::JobSystem::ParallelFor(paths.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                images[i] = Decode(paths[i]);
+        });
+
+        std::vector<unsigned int> textures(paths.size(), 0);
+        for (size_t i = 0; i < images.size(); ++i)
+            textures[i] = Upload2D(images[i], gamma);
+        return textures;
+    }
+
+    unsigned int TextureLoader::BuildArray(const std::vector<unsigned int>& textures,
+                                           int width, int height, GLenum internalFormat) {
+        if (textures.empty()) return 0;
+
+        const GLenum dataFormat = (internalFormat == GL_R8) ? GL_RED : GL_RGBA;
+        unsigned int array = 0;
+        glGenTextures(1, &array);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat, width, height, static_cast<GLsizei>(textures.size()),
+                     0, dataFormat, GL_UNSIGNED_BYTE, nullptr);
+
+        // 用 FBO blit 把每张 2D 贴图复制（缩放）到对应的层
+        GLint previousFBO = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFBO);
+        GLuint fbos[2];
+        glGenFramebuffers(2, fbos);
+        for (size_t layer = 0; layer < textures.size(); ++layer) {
+            if (textures[layer] == 0) continue;
+
+            GLint w = 0, h = 0;
+            glBindTexture(GL_TEXTURE_2D, textures[layer]);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, fbos[0]);
+            glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textures[layer], 0);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbos[1]);
+            glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, array, 0, static_cast<GLint>(layer));
+            glBlitFramebuffer(0, 0, w, h, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFBO));
+        glDeleteFramebuffers(2, fbos);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return array;
+    }
+
 } // namespace utils
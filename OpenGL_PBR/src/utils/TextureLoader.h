@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <iostream>
 
 #include <glad/glad.h>
@@ -11,6 +12,7 @@
  * -------------
  * 提供静态方法 Load2D，从给定文件路径加载一张 2D 纹理（PNG/JPG 等），
  * 并返回对应的 OpenGL 纹理 ID。内部使用 stb_image 进行图片数据加载。
+ * 加载分为两步：Decode 只读文件、解码像素，可以放到作业线程并行执行；Upload2D 在主线程创建 GL 纹理。
  *
  * 用法示例：
  *   unsigned int texID = TextureLoader::Load2D("assets/textures/foo.png", true);
@@ -20,6 +22,29 @@ namespace utils {
 
     class TextureLoader {
     public:
+        /// 解码后的像素（CPU 内存），由 Decode 产生，上传后用 Free 释放
+        struct Image {
+            int   width      = 0;
+            int   height     = 0;
+            int   components = 0;
+            bool  hdr        = false;     // true 时 pixels 为 float*，否则为 unsigned char*
+            void* pixels     = nullptr;
+
+            bool Valid() const { return pixels != nullptr; }
+        };
+
+        /// 读取并解码图片（已垂直翻转为 OpenGL 的 bottom-left 原点），不调用 OpenGL，可在任意线程执行。
+        /// hdr=true 时按浮点解码（.hdr 环境图）；失败时返回的 Image 无效
+        static Image Decode(const std::string& path, bool hdr = false);
+        static void  Free(Image& image);
+
+        /// 把 Decode 得到的 8 位图片上传为 2D 纹理（生成 mipmap），并释放像素。必须在 GL 上下文所在线程调用
+        static unsigned int Upload2D(Image& image, bool gamma = false);
+
+        /// 用作业系统并行解码 paths 中的全部贴图，再在当前线程依次上传；
+        /// 返回的纹理 ID 与 paths 一一对应，加载失败的项为 0
+        static std::vector<unsigned int> LoadMany(const std::vector<std::string>& paths, bool gamma = false);
+
         /**
          * 从文件 path 加载一张 2D 纹理，返回 OpenGL 纹理 ID。
          * @param path   纹理文件的相对或绝对路径
@@ -27,6 +52,15 @@ namespace utils {
          * @return       GLuint 纹理 ID；若加载失败，则返回 0
          */
         static unsigned int Load2D(const std::string& path, bool gamma = false);
+
+        /**
+         * 把一组已上传的 2D 纹理依次复制到一个 GL_TEXTURE_2D_ARRAY 的各层（FBO blit，尺寸不同时线性缩放），
+         * 并生成 mipmap。textures 中为 0 的项对应的层保持未初始化。
+         * @param internalFormat 数组的内部格式（如 GL_RGBA8；单通道贴图可用 GL_R8，blit 时只保留红色通道）
+         * @return               数组纹理 ID；textures 为空时返回 0
+         */
+        static unsigned int BuildArray(const std::vector<unsigned int>& textures,
+                                       int width, int height, GLenum internalFormat = GL_RGBA8);
     };
 
 } // namespace utils
\ No newline at end of file